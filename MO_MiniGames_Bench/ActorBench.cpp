@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "ActorScheduler.h"
+#include "BoundedMailbox.h"
+
+// 방 액터 실행 모델 처리량 (방 수만큼 액터, IOCP 워커 대신 생산자 스레드가 메일박스에 넣음)
+// 워커 수를 늘려가며 처리량과 메시지당 힙 할당을 잼. 메시지 처리 = 방 상태를 조금 바꾸는 정도의 작은 연산
+// 코어 수보다 워커가 많으면 의미 없으므로 하드웨어 스레드 수까지만 측정
+
+namespace
+{
+    constexpr int32_t ACTOR_BENCH_WORKER_COUNTS[] = { 1, 2, 4, 8 };
+    constexpr size_t ACTOR_BENCH_ROOMS = 1024;
+    constexpr size_t ACTOR_BENCH_MAILBOX = 64;
+    constexpr int32_t ACTOR_BENCH_PRODUCERS = 2;
+
+    struct BenchMessage
+    {
+        int64_t sessionId;
+        uint32_t value;
+    };
+
+    class CBenchRoomActor : public CActor
+    {
+    public:
+        CBenchRoomActor(CActorWorkerPool& pool, std::atomic<uint64_t>& processed)
+            : CActor(pool)
+            , _mailbox(ACTOR_BENCH_MAILBOX)
+            , _processed(processed)
+            , _state(0)
+        {
+        }
+
+        bool Post(int64_t sessionId, uint32_t value)
+        {
+            if (!_mailbox.TryPush([&](BenchMessage& msg) { msg.sessionId = sessionId; msg.value = value; }))
+            {
+                return false;
+            }
+            Notify();
+            return true;
+        }
+
+        uint64_t GetState() const { return _state; }
+
+    protected:
+        void ProcessMessages(size_t budget) override
+        {
+            size_t count = 0;
+            while (count < budget && _mailbox.TryConsume([this](const BenchMessage& msg)
+            {
+                _state = (_state ^ (static_cast<uint64_t>(msg.sessionId) + msg.value)) * 0x9E3779B97F4A7C15ull;
+            }))
+            {
+                ++count;
+            }
+            _processed.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        bool HasPendingMessages() const override { return _mailbox.HasPending(); }
+
+    private:
+        CBoundedMailbox<BenchMessage> _mailbox;
+        std::atomic<uint64_t>& _processed;
+        uint64_t _state; // 워커 전용
+    };
+}
+
+void RunActorBench(size_t iterations)
+{
+    int32_t hardwareThreads = static_cast<int32_t>((std::max)(1u, std::thread::hardware_concurrency()));
+    size_t messagesPerProducer = (std::max)(iterations, static_cast<size_t>(10000));
+
+    std::printf("[Room actors] Mmsgs/s, %zu rooms, %d producers x %zu msgs, %d hardware threads\n\n",
+        ACTOR_BENCH_ROOMS, ACTOR_BENCH_PRODUCERS, messagesPerProducer, hardwareThreads);
+    std::printf("%8s %14s %14s %14s\n", "workers", "Mmsgs/s", "scale", "allocs/msg");
+    std::printf("%s\n", std::string(53, '-').c_str());
+
+    double baseRate = 0.0;
+    for (int32_t workerCount : ACTOR_BENCH_WORKER_COUNTS)
+    {
+        if (workerCount > hardwareThreads)
+        {
+            break;
+        }
+
+        std::atomic<uint64_t> processed{ 0 };
+        CActorWorkerPool pool(workerCount, ACTOR_BENCH_ROOMS);
+        std::vector<std::unique_ptr<CBenchRoomActor>> rooms;
+        rooms.reserve(ACTOR_BENCH_ROOMS);
+        for (size_t i = 0; i < ACTOR_BENCH_ROOMS; ++i)
+        {
+            rooms.push_back(std::make_unique<CBenchRoomActor>(pool, processed));
+        }
+        pool.Start();
+
+        uint64_t total = static_cast<uint64_t>(messagesPerProducer) * ACTOR_BENCH_PRODUCERS;
+        uint64_t allocsBefore = g_benchHeapAllocs;
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> producers;
+        for (int32_t p = 0; p < ACTOR_BENCH_PRODUCERS; ++p)
+        {
+            producers.emplace_back([&, p]
+            {
+                for (size_t i = 0; i < messagesPerProducer; ++i)
+                {
+                    // 여러 방에 고르게 (실제로는 세션마다 자기 방으로)
+                    CBenchRoomActor& room = *rooms[(i * 7 + p * 131) % ACTOR_BENCH_ROOMS];
+                    while (!room.Post(p + 1, static_cast<uint32_t>(i)))
+                    {
+                        std::this_thread::yield(); // 벤치에서는 버리지 않고 기다림
+                    }
+                }
+            });
+        }
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+        while (processed.load(std::memory_order_relaxed) < total)
+        {
+            std::this_thread::yield();
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        uint64_t heapAllocs = g_benchHeapAllocs - allocsBefore; // 생산자 스레드 생성분 포함
+        pool.Stop();
+
+        for (const auto& room : rooms)
+        {
+            g_benchSink = g_benchSink + room->GetState();
+        }
+
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        double rate = static_cast<double>(total) * 1000.0 / ns;
+        if (workerCount == 1)
+        {
+            baseRate = rate;
+        }
+
+        std::printf("%8d %14.2f %13.2fx %14.3f\n", workerCount, rate, rate / baseRate,
+            static_cast<double>(heapAllocs) / static_cast<double>(total));
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// __________________________________________________________________
+//
+// 벤치마크 공용 도구
+// __________________________________________________________________
+
+// 최적화로 루프가 사라지지 않도록 결과를 모아두는 곳
+extern volatile uint64_t g_benchSink;
+
+// 전역 operator new 호출 횟수 (mainBench.cpp에서 교체). 핫 경로의 힙 할당 여부 확인용
+extern std::atomic<uint64_t> g_benchHeapAllocs;
+
+struct BenchResult
+{
+    double nsPerOp;
+    double mbPerSec;
+};
+
+template <typename Func>
+BenchResult RunBench(size_t iterations, size_t bytesPerOp, Func&& func)
+{
+    // 워밍업
+    for (size_t i = 0; i < iterations / 10; ++i)
+    {
+        g_benchSink = g_benchSink + func(i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    uint64_t acc = 0;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        acc += func(i);
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    g_benchSink = g_benchSink + acc;
+
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    BenchResult result;
+    result.nsPerOp = ns / iterations;
+    result.mbPerSec = (ns > 0.0) ? (static_cast<double>(bytesPerOp) * iterations * 1000.0) / ns : 0.0;
+    return result;
+}
+
+// 벤치마크 항목
+void RunCodecBench(size_t iterations);
+void RunRoomManagerBench();
+void RunSessionTableBench(size_t iterations);
+void RunShardBench(size_t iterations);
+void RunActorBench(size_t iterations);
+void RunTickBench();
+void RunTimerWheelBench(size_t iterations);
+void RunTetrisBench(size_t iterations);
+void RunLockstepBench(size_t iterations);
+void RunBoardStreamBench(size_t iterations);
+void RunSpectatorBench();
+void RunReplayBench();
@@ -0,0 +1,195 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "Bench.h"
+#include "BoardStream.h"
+
+// 보드 화면 스트림 (방 하나, 10명)
+// 무작위 입력으로 보드 10장을 60Hz로 돌리며 프레임마다 CBoardStream::Encode (탈락한 보드는 바로 다시 시작)
+// 받은 쪽처럼 매 메시지를 디코딩해서 서버 보드와 같은지도 확인
+//  - B/s      : 받는 쪽 한 명이 받는 바이트 / 초 (헤더 포함)
+//  - B/update : 보드 델타 하나의 평균 바이트 (slot 포함)
+//  - key B    : 키프레임 메시지 평균 바이트 (헤더 포함)
+//  - ns/frame : 보드 화면 뜨기 + 델타 인코딩 (프레임 하나, 보드 10장)
+//  - raw B/s  : 비교용. 매 프레임 보드 전부를 행 uint16 20개로 보낸다면
+//  - allocs   : 측정 구간 힙 할당 (0이어야 함)
+
+namespace
+{
+    constexpr int32_t BOARD_BENCH_PLAYERS = ROOM_MAX_PLAYERS;
+    constexpr size_t BOARD_BENCH_RAW_BOARD_SIZE = TETRIS_VISIBLE_HEIGHT * sizeof(uint16_t);
+
+    struct BoardStreamBenchResult
+    {
+        double bytesPerSecond;
+        double bytesPerUpdate;
+        double keyframeBytes;
+        double nsPerFrame;
+        uint64_t mismatches;
+        uint64_t allocs;
+    };
+
+    uint8_t NextBoardInput(uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        uint32_t roll = state >> 24;
+        if (roll < 6)
+        {
+            return TETRIS_INPUT_HARD_DROP;
+        }
+        if (roll < 40)
+        {
+            return static_cast<uint8_t>(TETRIS_INPUT_LEFT << ((state >> 16) & 1));
+        }
+        if (roll < 60)
+        {
+            return TETRIS_INPUT_ROTATE_CW;
+        }
+        return TETRIS_INPUT_NONE;
+    }
+
+    BoardStreamBenchResult RunStream(int32_t fullBoards, size_t frames)
+    {
+        CTetrisBoardBatch boards(BOARD_BENCH_PLAYERS);
+        uint32_t seed = 1;
+        for (int32_t board = 0; board < BOARD_BENCH_PLAYERS; ++board)
+        {
+            boards.Start(static_cast<size_t>(board), seed++);
+        }
+
+        CBoardStream stream;
+        stream.Reset(BOARD_BENCH_PLAYERS);
+        for (int32_t board = 0; board < fullBoards; ++board)
+        {
+            stream.SetDetail(board, BoardStreamDetail::FULL);
+        }
+
+        BoardView received[ROOM_MAX_PLAYERS];
+        for (BoardView& view : received)
+        {
+            view.Clear();
+        }
+
+        uint32_t state = 4242;
+        uint8_t inputs[ROOM_MAX_PLAYERS];
+        TetrisStepResult results[ROOM_MAX_PLAYERS];
+        char buffer[BOARD_STREAM_MSG_MAX_SIZE];
+        uint64_t bytes = 0;
+        uint64_t keyframeBytes = 0;
+        uint64_t mismatches = 0;
+        std::chrono::nanoseconds encodeTime(0);
+
+        uint64_t allocsBefore = g_benchHeapAllocs.load();
+
+        for (uint32_t frame = 0; frame < frames; ++frame)
+        {
+            for (int32_t board = 0; board < BOARD_BENCH_PLAYERS; ++board)
+            {
+                inputs[board] = NextBoardInput(state);
+            }
+            boards.StepAll(BOARD_BENCH_PLAYERS, inputs, results);
+
+            auto start = std::chrono::steady_clock::now();
+            CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+            bool sent = stream.Encode(frame, boards, writer);
+            encodeTime += std::chrono::steady_clock::now() - start;
+
+            if (sent)
+            {
+                bytes += writer.GetSize();
+                if (stream.WasKeyframe())
+                {
+                    keyframeBytes += writer.GetSize();
+                }
+
+                // 받는 쪽 디코딩
+                CMsgReader reader(buffer, writer.GetSize(), sizeof(MsgHeader));
+                MSG_S2C_BOARD_STREAM msg;
+                if (!msg.Decode(reader))
+                {
+                    ++mismatches;
+                    continue;
+                }
+
+                CMsgReader updates(reinterpret_cast<const char*>(msg.updates), msg.updatesSize, 0);
+                for (uint8_t i = 0; i < msg.updateCount; ++i)
+                {
+                    uint8_t slot;
+                    if (!updates.ReadUInt8(slot) || slot >= BOARD_BENCH_PLAYERS || !DecodeBoardDelta(updates, received[slot]))
+                    {
+                        ++mismatches;
+                        break;
+                    }
+                }
+            }
+
+            // 이번 프레임에 갱신한 보드는 서버 화면과 같아야 함 (작은 화면은 고정된 칸만)
+            for (int32_t board = 0; sent && board < BOARD_BENCH_PLAYERS; ++board)
+            {
+                BoardStreamDetail detail = stream.GetDetail(board);
+                if (detail == BoardStreamDetail::MINI && !stream.WasKeyframe() && frame % BOARD_STREAM_MINI_INTERVAL != 0)
+                {
+                    continue;
+                }
+
+                BoardView expected;
+                expected.Capture(boards.GetEngine(static_cast<size_t>(board)), detail == BoardStreamDetail::FULL);
+                for (int32_t y = 0; y < TETRIS_VISIBLE_HEIGHT; ++y)
+                {
+                    if (expected.rows[y] != received[board].rows[y])
+                    {
+                        ++mismatches;
+                        break;
+                    }
+                }
+            }
+
+            // 탈락한 보드는 다시 시작 (받는 쪽은 다음 델타로 따라옴)
+            for (int32_t board = 0; board < BOARD_BENCH_PLAYERS; ++board)
+            {
+                if (results[board].gameOver)
+                {
+                    boards.Start(static_cast<size_t>(board), seed++);
+                }
+            }
+        }
+
+        BoardStreamBenchResult result;
+        double seconds = static_cast<double>(frames) / TETRIS_FRAME_RATE;
+        result.bytesPerSecond = static_cast<double>(bytes) / seconds;
+        result.bytesPerUpdate = stream.GetBoardUpdateCount() > 0
+            ? static_cast<double>(stream.GetUpdateBytes()) / stream.GetBoardUpdateCount() : 0.0;
+        result.keyframeBytes = stream.GetKeyframeCount() > 0
+            ? static_cast<double>(keyframeBytes) / stream.GetKeyframeCount() : 0.0;
+        result.nsPerFrame = static_cast<double>(encodeTime.count()) / frames;
+        result.mismatches = mismatches;
+        result.allocs = g_benchHeapAllocs.load() - allocsBefore;
+        return result;
+    }
+}
+
+void RunBoardStreamBench(size_t iterations)
+{
+    size_t frames = (iterations < 1000) ? 1000 : iterations;
+    double rawBytesPerSecond = static_cast<double>(BOARD_BENCH_RAW_BOARD_SIZE * BOARD_BENCH_PLAYERS * TETRIS_FRAME_RATE);
+
+    std::printf("[Board stream] %d boards, %zu frames, mini every %u frames, keyframe every %u frames\n\n",
+        BOARD_BENCH_PLAYERS, frames, BOARD_STREAM_MINI_INTERVAL, BOARD_STREAM_KEYFRAME_INTERVAL);
+    std::printf("%-14s %10s %10s %8s %10s %10s %6s %8s\n", "detail", "B/s", "B/update", "key B", "ns/frame", "raw B/s", "bad", "allocs");
+    std::printf("%s\n", std::string(84, '-').c_str());
+
+    struct Mode
+    {
+        const char* name;
+        int32_t fullBoards;
+    };
+
+    for (const Mode& mode : { Mode{ "all mini", 0 }, Mode{ "1 full+9 mini", 1 }, Mode{ "all full", BOARD_BENCH_PLAYERS } })
+    {
+        BoardStreamBenchResult result = RunStream(mode.fullBoards, frames);
+        std::printf("%-14s %10.0f %10.2f %8.1f %10.1f %10.0f %6llu %8llu\n", mode.name, result.bytesPerSecond,
+            result.bytesPerUpdate, result.keyframeBytes, result.nsPerFrame, rawBytesPerSecond,
+            static_cast<unsigned long long>(result.mismatches), static_cast<unsigned long long>(result.allocs));
+    }
+}
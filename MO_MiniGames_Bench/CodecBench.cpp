@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "Protocol.h"
+#include "RoomListSnapshot.h"
+
+// 메시지 타입별 인코딩/디코딩 처리량
+// 가변 길이 메시지는 CMsgWriter/CMsgReader, 고정 크기 패킷은 복사 후 필드 읽기
+
+namespace
+{
+    constexpr size_t BENCH_BUFFER_SIZE = 4096;
+
+    // 고정 크기 패킷은 연산이 너무 단순해서 컴파일러가 루프 밖으로 빼버림.
+    // volatile 포인터를 매번 다시 읽게 해서 실제 메모리 읽기/쓰기가 일어나도록 한다.
+    char g_fixedBuffer[BENCH_BUFFER_SIZE];
+    char* volatile g_fixedBufferPtr = g_fixedBuffer;
+
+    void PrintHeader()
+    {
+        std::printf("%-28s %8s %12s %12s %12s %12s\n",
+            "message", "bytes", "enc ns/op", "enc MB/s", "dec ns/op", "dec MB/s");
+        std::printf("%s\n", std::string(89, '-').c_str());
+    }
+
+    void PrintResult(const char* name, size_t bytes, const BenchResult& enc, const BenchResult& dec)
+    {
+        std::printf("%-28s %8zu %12.1f %12.1f %12.1f %12.1f\n",
+            name, bytes, enc.nsPerOp, enc.mbPerSec, dec.nsPerOp, dec.mbPerSec);
+    }
+
+    // 방 목록에 들어갈 샘플 방 (제목 길이/인원을 섞어서 varint 길이가 고르게 나오도록)
+    std::vector<std::string> MakeSampleTitles(size_t count)
+    {
+        std::vector<std::string> titles;
+        titles.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            titles.push_back("Room_" + std::to_string(i * 37) + std::string(i % 24, 'x'));
+        }
+        return titles;
+    }
+
+    RoomInfo MakeRoomInfo(const std::vector<std::string>& titles, size_t index)
+    {
+        RoomInfo info;
+        info.roomId = static_cast<int32_t>(index * 131 + 1);
+        info.title = titles[index % titles.size()];
+        info.currentPlayers = static_cast<int32_t>(index % 4);
+        info.maxPlayers = 4;
+        info.status = static_cast<uint8_t>(index & 1);
+        return info;
+    }
+
+    // 헤더 + 본문을 인코딩하고 전체 크기를 반환
+    template <typename EncodeFunc>
+    size_t EncodePacket(char* buffer, MsgType type, EncodeFunc&& encodeBody)
+    {
+        CMsgWriter writer(buffer, BENCH_BUFFER_SIZE, sizeof(MsgHeader));
+        encodeBody(writer);
+
+        MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+        header->size = static_cast<uint16_t>(writer.GetSize());
+        header->type = type;
+        return writer.IsOverflow() ? 0 : writer.GetSize();
+    }
+
+    // 방 목록/페이지 본문 뒤에 붙는 RoomInfo 배열 디코딩
+    uint64_t DecodeRoomInfos(CMsgReader& reader, uint32_t count)
+    {
+        uint64_t acc = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            RoomInfo info;
+            if (!info.Decode(reader))
+                return 0;
+
+            acc += static_cast<uint64_t>(info.roomId) + info.title.size();
+        }
+        return acc;
+    }
+
+    void BenchRoomList(size_t iterations, uint32_t roomCount)
+    {
+        std::vector<std::string> titles = MakeSampleTitles(roomCount);
+        char buffer[BENCH_BUFFER_SIZE];
+
+        auto encodeBody = [&](CMsgWriter& writer, size_t seed)
+        {
+            MSG_S2C_ROOM_LIST msg;
+            msg.requestId = static_cast<uint32_t>(seed);
+            msg.roomCount = roomCount;
+            msg.Encode(writer);
+            for (uint32_t i = 0; i < roomCount; ++i)
+            {
+                MakeRoomInfo(titles, i).Encode(writer);
+            }
+        };
+
+        size_t bytes = EncodePacket(buffer, MsgType::S2C_ROOM_LIST, [&](CMsgWriter& w) { encodeBody(w, 1); });
+
+        BenchResult enc = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return EncodePacket(buffer, MsgType::S2C_ROOM_LIST, [&](CMsgWriter& w) { encodeBody(w, i); });
+        });
+
+        bytes = EncodePacket(buffer, MsgType::S2C_ROOM_LIST, [&](CMsgWriter& w) { encodeBody(w, 1); });
+        BenchResult dec = RunBench(iterations, bytes, [&](size_t) -> uint64_t
+        {
+            CMsgReader reader(buffer, bytes, sizeof(MsgHeader));
+            MSG_S2C_ROOM_LIST msg;
+            if (!msg.Decode(reader))
+                return 0;
+
+            return DecodeRoomInfos(reader, msg.roomCount);
+        });
+
+        std::string name = "S2C_ROOM_LIST x" + std::to_string(roomCount);
+        PrintResult(name.c_str(), bytes, enc, dec);
+    }
+
+    // 서버 쪽 S2C_ROOM_LIST 작성: 요청마다 스냅샷에서 다시 인코딩 vs 게시할 때 캐시해둔 본문 복사
+    // 접속 직후 목록 요청이 몰릴 때 요청 1건의 비용
+    void BenchCachedRoomList(size_t iterations, uint32_t roomCount)
+    {
+        std::vector<std::string> titles = MakeSampleTitles(roomCount);
+
+        RoomListSnapshot snapshot;
+        for (uint32_t i = 0; i < roomCount; ++i)
+        {
+            // 최근 생성 순 (roomId 내림차순)
+            RoomInfo info = MakeRoomInfo(titles, roomCount - 1 - i);
+            RoomSummary summary;
+            summary.roomId = info.roomId;
+            summary.currentPlayers = info.currentPlayers;
+            summary.maxPlayers = info.maxPlayers;
+            summary.status = static_cast<RoomStatus>(info.status);
+            summary.titleLength = static_cast<uint8_t>(info.title.size());
+            std::memcpy(summary.title, info.title.data(), info.title.size());
+            snapshot.rooms.push_back(summary);
+        }
+        snapshot.CacheListPayload();
+
+        char buffer[(std::max)(BENCH_BUFFER_SIZE, ROOM_LIST_MSG_MAX_SIZE)]; // EncodePacket은 BENCH_BUFFER_SIZE로 씀
+        auto encodePerRequest = [&](uint32_t requestId) -> size_t
+        {
+            RoomPageQuery query;
+            query.pageSize = ROOM_PAGE_MAX_SIZE;
+            const RoomSummary* rooms[ROOM_PAGE_MAX_SIZE];
+            int32_t count = 0;
+            snapshot.QueryPage(query, rooms, count);
+
+            return EncodePacket(buffer, MsgType::S2C_ROOM_LIST, [&](CMsgWriter& writer)
+            {
+                MSG_S2C_ROOM_LIST msg;
+                msg.requestId = requestId;
+                msg.roomCount = static_cast<uint32_t>(count);
+                msg.Encode(writer);
+                for (int32_t r = 0; r < count; ++r)
+                {
+                    rooms[r]->Encode(writer);
+                }
+            });
+        };
+
+        // 두 경로가 같은 바이트를 만드는지 먼저 확인
+        char expected[sizeof(buffer)];
+        size_t bytes = encodePerRequest(1);
+        std::memcpy(expected, buffer, bytes);
+        if (snapshot.WriteRoomListMsg(buffer, 1) != bytes || std::memcmp(expected, buffer, bytes) != 0)
+        {
+            std::printf("S2C_ROOM_LIST cached payload mismatch\n");
+            return;
+        }
+
+        BenchResult perRequest = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return encodePerRequest(static_cast<uint32_t>(i));
+        });
+
+        BenchResult cached = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return snapshot.WriteRoomListMsg(buffer, static_cast<uint32_t>(i));
+        });
+
+        BenchResult none = {}; // 디코딩은 위 S2C_ROOM_LIST 행과 같음
+        PrintResult("S2C_ROOM_LIST (per request)", bytes, perRequest, none);
+        PrintResult("S2C_ROOM_LIST (cached)", bytes, cached, none);
+    }
+
+    void BenchRoomPage(size_t iterations, uint32_t roomCount)
+    {
+        std::vector<std::string> titles = MakeSampleTitles(roomCount);
+        char buffer[BENCH_BUFFER_SIZE];
+
+        auto encodeBody = [&](CMsgWriter& writer, size_t seed)
+        {
+            MSG_S2C_ROOM_PAGE msg;
+            msg.requestId = static_cast<uint32_t>(seed);
+            msg.nextCursor = 4096;
+            msg.roomCount = roomCount;
+            msg.Encode(writer);
+            for (uint32_t i = 0; i < roomCount; ++i)
+            {
+                MakeRoomInfo(titles, i).Encode(writer);
+            }
+        };
+
+        size_t bytes = EncodePacket(buffer, MsgType::S2C_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, 1); });
+
+        BenchResult enc = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return EncodePacket(buffer, MsgType::S2C_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, i); });
+        });
+
+        bytes = EncodePacket(buffer, MsgType::S2C_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, 1); });
+        BenchResult dec = RunBench(iterations, bytes, [&](size_t) -> uint64_t
+        {
+            CMsgReader reader(buffer, bytes, sizeof(MsgHeader));
+            MSG_S2C_ROOM_PAGE msg;
+            if (!msg.Decode(reader))
+                return 0;
+
+            return DecodeRoomInfos(reader, msg.roomCount) + static_cast<uint64_t>(msg.nextCursor);
+        });
+
+        std::string name = "S2C_ROOM_PAGE x" + std::to_string(roomCount);
+        PrintResult(name.c_str(), bytes, enc, dec);
+    }
+
+    void BenchRoomPageRequest(size_t iterations)
+    {
+        char buffer[BENCH_BUFFER_SIZE];
+
+        auto encodeBody = [&](CMsgWriter& writer, size_t seed)
+        {
+            MSG_C2S_REQUEST_ROOM_PAGE msg;
+            msg.requestId = static_cast<uint32_t>(seed);
+            msg.cursor = 4096;
+            msg.pageSize = ROOM_PAGE_DEFAULT_SIZE;
+            msg.filterFlags = ROOM_FILTER_JOINABLE | ROOM_FILTER_TITLE_PREFIX;
+            msg.status = 0;
+            msg.minFreeSlots = 0;
+            msg.titlePrefix = "Tetris";
+            msg.Encode(writer);
+        };
+
+        size_t bytes = EncodePacket(buffer, MsgType::C2S_REQUEST_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, 1); });
+
+        BenchResult enc = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return EncodePacket(buffer, MsgType::C2S_REQUEST_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, i); });
+        });
+
+        bytes = EncodePacket(buffer, MsgType::C2S_REQUEST_ROOM_PAGE, [&](CMsgWriter& w) { encodeBody(w, 1); });
+        BenchResult dec = RunBench(iterations, bytes, [&](size_t) -> uint64_t
+        {
+            CMsgReader reader(buffer, bytes, sizeof(MsgHeader));
+            MSG_C2S_REQUEST_ROOM_PAGE msg;
+            if (!msg.Decode(reader))
+                return 0;
+
+            return msg.requestId + static_cast<uint64_t>(msg.cursor) + msg.pageSize + msg.titlePrefix.size();
+        });
+
+        PrintResult("C2S_REQUEST_ROOM_PAGE", bytes, enc, dec);
+    }
+
+    void BenchCreateRoom(size_t iterations)
+    {
+        const std::string title = "Tetris 1v1 - beginners welcome";
+        char buffer[BENCH_BUFFER_SIZE];
+
+        auto encodeBody = [&](CMsgWriter& writer, size_t seed)
+        {
+            MSG_C2S_CREATE_ROOM msg;
+            msg.requestId = static_cast<uint32_t>(seed);
+            msg.title = title;
+            msg.maxPlayers = 4;
+            msg.Encode(writer);
+        };
+
+        size_t bytes = EncodePacket(buffer, MsgType::C2S_CREATE_ROOM, [&](CMsgWriter& w) { encodeBody(w, 1); });
+
+        BenchResult enc = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return EncodePacket(buffer, MsgType::C2S_CREATE_ROOM, [&](CMsgWriter& w) { encodeBody(w, i); });
+        });
+
+        bytes = EncodePacket(buffer, MsgType::C2S_CREATE_ROOM, [&](CMsgWriter& w) { encodeBody(w, 1); });
+        BenchResult dec = RunBench(iterations, bytes, [&](size_t) -> uint64_t
+        {
+            CMsgReader reader(buffer, bytes, sizeof(MsgHeader));
+            MSG_C2S_CREATE_ROOM msg;
+            if (!msg.Decode(reader))
+                return 0;
+
+            return msg.title.size() + static_cast<uint64_t>(msg.maxPlayers);
+        });
+
+        PrintResult("C2S_CREATE_ROOM", bytes, enc, dec);
+    }
+
+    void BenchError(size_t iterations)
+    {
+        char buffer[BENCH_BUFFER_SIZE];
+
+        auto encodeBody = [&](CMsgWriter& writer, size_t seed)
+        {
+            MSG_S2C_ERROR msg;
+            msg.requestId = static_cast<uint32_t>(seed);
+            msg.code = ErrorCode::ROOM_FULL;
+            msg.argCount = 2;
+            msg.args[0] = 1234;
+            msg.args[1] = 4;
+            msg.Encode(writer);
+        };
+
+        size_t bytes = EncodePacket(buffer, MsgType::S2C_ERROR, [&](CMsgWriter& w) { encodeBody(w, 1); });
+
+        BenchResult enc = RunBench(iterations, bytes, [&](size_t i) -> uint64_t
+        {
+            return EncodePacket(buffer, MsgType::S2C_ERROR, [&](CMsgWriter& w) { encodeBody(w, i); });
+        });
+
+        bytes = EncodePacket(buffer, MsgType::S2C_ERROR, [&](CMsgWriter& w) { encodeBody(w, 1); });
+        BenchResult dec = RunBench(iterations, bytes, [&](size_t) -> uint64_t
+        {
+            CMsgReader reader(buffer, bytes, sizeof(MsgHeader));
+            MSG_S2C_ERROR msg;
+            if (!msg.Decode(reader))
+                return 0;
+
+            return static_cast<uint64_t>(msg.code) + static_cast<uint64_t>(msg.args[0]);
+        });
+
+        PrintResult("S2C_ERROR", bytes, enc, dec);
+    }
+
+    // 고정 크기 패킷: 인코딩은 필드 채우고 복사, 디코딩은 크기 검사 후 필드 읽기
+    template <typename MsgT, typename FillFunc, typename ReadFunc>
+    void BenchFixed(const char* name, size_t iterations, MsgType type, FillFunc&& fill, ReadFunc&& read)
+    {
+        BenchResult enc = RunBench(iterations, sizeof(MsgT), [&](size_t i) -> uint64_t
+        {
+            char* buffer = g_fixedBufferPtr;
+            MsgT msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.header.size = sizeof(MsgT);
+            msg.header.type = type;
+            fill(msg, i);
+            std::memcpy(buffer, &msg, sizeof(msg));
+            return static_cast<uint8_t>(buffer[sizeof(MsgT) - 1]);
+        });
+
+        BenchResult dec = RunBench(iterations, sizeof(MsgT), [&](size_t) -> uint64_t
+        {
+            const char* buffer = g_fixedBufferPtr;
+            const MsgHeader* header = reinterpret_cast<const MsgHeader*>(buffer);
+            if (header->size < sizeof(MsgT) || header->type != type)
+                return 0;
+
+            return read(*reinterpret_cast<const MsgT*>(buffer));
+        });
+
+        PrintResult(name, sizeof(MsgT), enc, dec);
+    }
+}
+
+void RunCodecBench(size_t iterations)
+{
+    std::printf("[Codec] %zu iterations per case\n\n", iterations);
+    PrintHeader();
+
+    // 가변 길이 메시지
+    BenchRoomList(iterations / 10, ROOM_PAGE_MAX_SIZE);
+    BenchCachedRoomList(iterations / 10, ROOM_PAGE_MAX_SIZE);
+    BenchRoomPage(iterations / 10, ROOM_PAGE_DEFAULT_SIZE);
+    BenchRoomPageRequest(iterations);
+    BenchCreateRoom(iterations);
+    BenchError(iterations);
+
+    // 고정 크기 메시지
+    BenchFixed<MSG_C2S_REQUEST_ROOM_LIST>("C2S_REQUEST_ROOM_LIST", iterations, MsgType::C2S_REQUEST_ROOM_LIST,
+        [](MSG_C2S_REQUEST_ROOM_LIST& msg, size_t i) { msg.requestId = static_cast<uint32_t>(i); },
+        [](const MSG_C2S_REQUEST_ROOM_LIST& msg) -> uint64_t { return msg.requestId; });
+
+    BenchFixed<MSG_C2S_JOIN_ROOM>("C2S_JOIN_ROOM", iterations, MsgType::C2S_JOIN_ROOM,
+        [](MSG_C2S_JOIN_ROOM& msg, size_t i) { msg.requestId = static_cast<uint32_t>(i); msg.roomId = 1234; },
+        [](const MSG_C2S_JOIN_ROOM& msg) -> uint64_t { return msg.requestId + static_cast<uint64_t>(msg.roomId); });
+
+    BenchFixed<MSG_S2C_ROOM_JOINED>("S2C_ROOM_JOINED", iterations, MsgType::S2C_ROOM_JOINED,
+        [](MSG_S2C_ROOM_JOINED& msg, size_t i) { msg.requestId = static_cast<uint32_t>(i); msg.roomId = 1234; msg.success = 1; },
+        [](const MSG_S2C_ROOM_JOINED& msg) -> uint64_t { return msg.requestId + msg.success; });
+}
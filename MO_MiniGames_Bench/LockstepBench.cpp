@@ -0,0 +1,158 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "Bench.h"
+#include "LockstepRelay.h"
+
+// 락스텝 릴레이 (방 액터 한 개 분량)
+// 방 인원별로, 모든 플레이어가 2프레임마다 입력 묶음을 보내는 상황을 프레임 단위로 재현
+//  - ns/frame  : 입력 검증 + 확정 + 서버 보드 진행 + S2C_GAME_FRAMES 인코딩 (방 하나, 한 프레임)
+//  - up B/f    : 플레이어 한 명이 보내는 바이트 / 프레임 (헤더 포함)
+//  - down B/f  : 플레이어 한 명이 받는 바이트 / 프레임 (헤더 포함)
+//  - state B/f : 비교용. 프레임마다 방 전원의 보드 상태(보이는 행 + 블록 4바이트)를 받는다면
+//  - allocs    : 측정 구간 힙 할당 (0이어야 함)
+// 게임이 끝나면 같은 방에서 바로 다시 시작
+
+namespace
+{
+    constexpr uint8_t LOCKSTEP_BENCH_BATCH_FRAMES = 2;
+    constexpr size_t LOCKSTEP_BENCH_BOARD_STATE_SIZE = TETRIS_VISIBLE_HEIGHT * sizeof(uint16_t) + 4;
+
+    struct LockstepBenchResult
+    {
+        double nsPerFrame;
+        double upBytesPerFrame;
+        double downBytesPerFrame;
+        uint64_t allocs;
+        uint64_t games;
+    };
+
+    uint8_t NextLockstepInput(uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        uint32_t roll = state >> 24;
+        if (roll < 6)
+        {
+            return TETRIS_INPUT_HARD_DROP;
+        }
+        if (roll < 40)
+        {
+            return static_cast<uint8_t>(TETRIS_INPUT_LEFT << ((state >> 16) & 1));
+        }
+        if (roll < 60)
+        {
+            return TETRIS_INPUT_ROTATE_CW;
+        }
+        return TETRIS_INPUT_NONE;
+    }
+
+    LockstepBenchResult RunRoom(int32_t playerCount, size_t frames)
+    {
+        CLockstepRelay relay;
+        uint32_t state = 777;
+        uint32_t seed = 1;
+        relay.Start(seed, playerCount);
+
+        uint8_t batches[ROOM_MAX_PLAYERS][LOCKSTEP_MAX_INPUTS_PER_MSG] = {};
+        uint32_t nextFrame = 0; // 다음 묶음의 첫 프레임 (모든 플레이어 같이 진행)
+        uint8_t batchCount = 0;
+
+        LockstepFrameBatch confirmed;
+        char upBuffer[GAME_INPUT_MSG_MAX_SIZE];
+        char downBuffer[GAME_FRAMES_MSG_MAX_SIZE];
+        uint64_t upBytes = 0;
+        uint64_t downBytes = 0;
+        uint64_t games = 0;
+
+        uint64_t allocsBefore = g_benchHeapAllocs.load();
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (int32_t slot = 0; slot < playerCount; ++slot)
+            {
+                batches[slot][batchCount] = NextLockstepInput(state);
+            }
+
+            if (++batchCount < LOCKSTEP_BENCH_BATCH_FRAMES)
+            {
+                continue;
+            }
+
+            // 클라가 보내는 패킷을 인코딩 -> 서버가 디코딩해서 릴레이에 넣음
+            for (int32_t slot = 0; slot < playerCount; ++slot)
+            {
+                MSG_C2S_GAME_INPUT msg;
+                msg.firstFrame = nextFrame;
+                msg.count = batchCount;
+                msg.inputs = batches[slot];
+
+                CMsgWriter writer(upBuffer, sizeof(upBuffer), sizeof(MsgHeader));
+                msg.Encode(writer);
+                upBytes += writer.GetSize();
+
+                CMsgReader reader(upBuffer, writer.GetSize(), sizeof(MsgHeader));
+                MSG_C2S_GAME_INPUT received;
+                if (received.Decode(reader))
+                {
+                    relay.SubmitInputs(slot, received.firstFrame, received.inputs, received.count);
+                }
+            }
+            nextFrame += batchCount;
+            batchCount = 0;
+
+            // 방 액터가 하는 것처럼 확정 프레임을 꺼내 한 번 인코딩 (전원에게 같은 바이트)
+            MSG_S2C_GAME_FRAMES msg;
+            msg.playerCount = static_cast<uint8_t>(playerCount);
+            msg.inputs = confirmed.inputs;
+            msg.garbage = confirmed.garbage;
+            while (relay.PopConfirmed(confirmed) > 0)
+            {
+                msg.firstFrame = confirmed.firstFrame;
+                msg.frameCount = static_cast<uint8_t>(confirmed.frameCount);
+                msg.garbageCount = static_cast<uint8_t>(confirmed.garbageCount);
+                CMsgWriter writer(downBuffer, sizeof(downBuffer), sizeof(MsgHeader));
+                msg.Encode(writer);
+                downBytes += writer.GetSize();
+                g_benchSink = g_benchSink + static_cast<uint8_t>(downBuffer[writer.GetSize() - 1]);
+            }
+
+            if (relay.IsFinished())
+            {
+                ++games;
+                relay.Start(++seed, playerCount);
+                nextFrame = 0;
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        LockstepBenchResult result;
+        result.nsPerFrame = ns / frames;
+        result.upBytesPerFrame = static_cast<double>(upBytes) / playerCount / frames;
+        result.downBytesPerFrame = static_cast<double>(downBytes) / frames;
+        result.allocs = g_benchHeapAllocs.load() - allocsBefore;
+        result.games = games;
+        return result;
+    }
+}
+
+void RunLockstepBench(size_t iterations)
+{
+    size_t frames = (iterations < 1000) ? 1000 : iterations;
+
+    std::printf("[Lockstep relay] one room, %zu frames, inputs sent every %u frames\n\n",
+        frames, static_cast<unsigned>(LOCKSTEP_BENCH_BATCH_FRAMES));
+    std::printf("%-8s %12s %10s %10s %10s %8s %8s\n", "players", "ns/frame", "up B/f", "down B/f", "state B/f", "games", "allocs");
+    std::printf("%s\n", std::string(72, '-').c_str());
+
+    for (int32_t players : { 2, 4, 10 })
+    {
+        LockstepBenchResult result = RunRoom(players, frames);
+        std::printf("%-8d %12.1f %10.2f %10.2f %10zu %8llu %8llu\n", players, result.nsPerFrame,
+            result.upBytesPerFrame, result.downBytesPerFrame, LOCKSTEP_BENCH_BOARD_STATE_SIZE * players,
+            static_cast<unsigned long long>(result.games), static_cast<unsigned long long>(result.allocs));
+    }
+}
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "Bench.h"
+#include "ReplayReader.h"
+#include "ReplayWriter.h"
+
+// 경기 리플레이 (기록 -> 파일 -> 메모리 매핑 재생)
+// 무작위 입력으로 CLockstepRelay를 돌리며 방 액터처럼 확정 묶음마다 CReplayRecorder에 넘기고, 기록 스레드가 임시 디렉터리에 씀
+// 입력은 사람처럼 누른 상태를 몇 프레임씩 유지 (6 ~ 30프레임마다 바뀜). 최대 1분(3600프레임)에서 끊음
+//  - frames       : 경기당 평균 확정 프레임 수 (먼저 탈락해서 끝나면 짧음)
+//  - bytes        : 경기당 파일 크기 (헤더 + 트레일러 포함)
+//  - KB/min       : 게임 1분당 파일 크기
+//  - raw KB/min   : 비교용. 확정 프레임 입력을 그대로 (프레임 x 인원 바이트) 남길 때
+//  - record ns    : PopConfirmed 묶음 하나의 방 액터 쪽 기록 비용 (중앙값)
+//  - mismatch     : 재생한 보드와 서버 보드의 체크섬이 다른 횟수 / 확인한 체크섬 수 (0이어야 함)
+//  - ffwd Mfps    : 빨리 감기 속도 (백만 보드-프레임 / 초 = 프레임 x 인원)
+//  - seek us      : 무작위 위치로 Seek 평균 (체크포인트에서 다시 진행). 틀린 보드는 seek err
+namespace
+{
+    constexpr int32_t REPLAY_BENCH_MATCHES = 4;
+    constexpr uint32_t REPLAY_BENCH_MAX_FRAMES = 3600;
+    constexpr uint32_t REPLAY_BENCH_SUBMIT_FRAMES = 4; // 클라가 한 번에 보내는 프레임 수
+    constexpr int32_t REPLAY_BENCH_SEEKS = 200;
+
+    struct ReplayBenchResult
+    {
+        double frames;
+        double bytes;
+        double kbPerMinute;
+        double rawKbPerMinute;
+        double recordNs;
+        uint32_t checksums;
+        uint32_t mismatches;
+        double fastForwardMfps;
+        double seekUs;
+        int32_t seekErrors;
+        bool ok;
+    };
+
+    // 슬롯 하나의 누른 상태 (hold 프레임 동안 유지)
+    struct HeldInput
+    {
+        uint8_t input = TETRIS_INPUT_NONE;
+        uint32_t hold = 0;
+    };
+
+    uint8_t NextHeldInput(HeldInput& held, uint32_t& state)
+    {
+        if (held.hold == 0)
+        {
+            state = state * 1664525u + 1013904223u;
+            uint32_t roll = state >> 24;
+            held.hold = 6 + ((state >> 8) % 25);
+            if (roll < 10)
+            {
+                held.input = TETRIS_INPUT_HARD_DROP;
+            }
+            else if (roll < 70)
+            {
+                held.input = static_cast<uint8_t>(TETRIS_INPUT_LEFT << ((state >> 16) & 1));
+            }
+            else if (roll < 100)
+            {
+                held.input = TETRIS_INPUT_ROTATE_CW;
+            }
+            else if (roll < 120)
+            {
+                held.input = TETRIS_INPUT_SOFT_DROP;
+            }
+            else
+            {
+                held.input = TETRIS_INPUT_NONE;
+            }
+        }
+        --held.hold;
+        return held.input;
+    }
+
+    uint32_t HashBoards(const CReplayReader& reader)
+    {
+        uint32_t hash = REPLAY_CHECKSUM_SEED;
+        for (int32_t slot = 0; slot < reader.GetPlayerCount(); ++slot)
+        {
+            hash = UpdateReplayChecksum(hash, reader.GetBoard(slot));
+        }
+        return hash;
+    }
+
+    // 경기 하나를 방 액터처럼 돌리며 기록. 기록 비용은 묶음마다 recordTimes에
+    uint32_t RecordMatch(CReplayWriter& writer, int32_t roomId, int32_t playerCount, uint32_t seed, std::vector<int64_t>& recordTimes)
+    {
+        CLockstepRelay relay;
+        CReplayRecorder recorder(&writer);
+        relay.Start(seed, playerCount);
+        recorder.Begin(roomId, seed, playerCount);
+
+        HeldInput held[ROOM_MAX_PLAYERS];
+        uint32_t state = seed * 2654435761u + 1;
+        LockstepFrameBatch batch;
+
+        for (uint32_t frame = 0; frame < REPLAY_BENCH_MAX_FRAMES && !relay.IsFinished(); frame += REPLAY_BENCH_SUBMIT_FRAMES)
+        {
+            for (int32_t slot = 0; slot < playerCount; ++slot)
+            {
+                uint8_t inputs[REPLAY_BENCH_SUBMIT_FRAMES];
+                for (uint8_t& input : inputs)
+                {
+                    input = NextHeldInput(held[slot], state);
+                }
+                relay.SubmitInputs(slot, frame, inputs, REPLAY_BENCH_SUBMIT_FRAMES);
+
+                // 가끔 공격 대상 방식을 바꿈 (대상 레코드)
+                if (((state >> 4) & 0x3FF) == 0)
+                {
+                    GarbageTargetMode mode = static_cast<GarbageTargetMode>((state >> 20) % static_cast<uint32_t>(GarbageTargetMode::COUNT));
+                    relay.SetTargetMode(slot, mode);
+                    recorder.OnTargetMode(relay.GetConfirmedFrameCount(), slot, mode);
+                }
+            }
+
+            while (!relay.IsFinished() && relay.PopConfirmed(batch) > 0)
+            {
+                auto start = std::chrono::steady_clock::now();
+                recorder.OnFrames(batch, relay.GetBoards());
+                recordTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+
+        recorder.End(relay.GetConfirmedFrameCount(), relay.IsFinished() ? relay.GetWinner() : -1, relay.GetBoards());
+        return relay.GetConfirmedFrameCount();
+    }
+
+    ReplayBenchResult RunReplay(int32_t playerCount, const std::filesystem::path& directory)
+    {
+        ReplayBenchResult result = {};
+        result.ok = true;
+
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+
+        std::vector<int64_t> recordTimes;
+        uint64_t totalFrames = 0;
+        {
+            CReplayWriter writer(directory.string(), 64);
+            if (!writer.Start())
+            {
+                result.ok = false;
+                return result;
+            }
+
+            for (int32_t match = 0; match < REPLAY_BENCH_MATCHES; ++match)
+            {
+                totalFrames += RecordMatch(writer, match + 1, playerCount, 1000u + static_cast<uint32_t>(match * 7919), recordTimes);
+            }
+            writer.Stop();
+
+            if (writer.GetFinishedMatches() != static_cast<uint64_t>(REPLAY_BENCH_MATCHES))
+            {
+                result.ok = false;
+            }
+        }
+
+        // 재생: 처음부터 끝까지 빨리 감기 (체크섬 확인) -> 프레임별 보드 해시 -> 무작위 Seek가 같은 보드인지
+        uint64_t totalBytes = 0;
+        std::chrono::nanoseconds fastForwardTime(0);
+        std::chrono::nanoseconds seekTime(0);
+        uint64_t boardFrames = 0;
+        int32_t seeks = 0;
+        uint32_t state = 777;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        {
+            CReplayReader reader;
+            if (!reader.Open(entry.path().string()) || !reader.HasTrailer())
+            {
+                result.ok = false;
+                continue;
+            }
+            totalBytes += reader.GetFileSize();
+
+            auto start = std::chrono::steady_clock::now();
+            reader.Advance(reader.GetFrameCount());
+            fastForwardTime += std::chrono::steady_clock::now() - start;
+            boardFrames += static_cast<uint64_t>(reader.GetFrameCount()) * reader.GetPlayerCount();
+
+            result.checksums += reader.GetChecksumsVerified();
+            result.mismatches += reader.GetChecksumMismatches();
+            if (reader.HasDecodeError() || reader.GetCurrentFrame() != reader.GetFrameCount())
+            {
+                result.ok = false;
+            }
+
+            std::vector<uint32_t> hashes;
+            hashes.reserve(reader.GetFrameCount() + 1);
+            reader.Rewind();
+            hashes.push_back(HashBoards(reader));
+            while (reader.Advance(1) == 1)
+            {
+                hashes.push_back(HashBoards(reader));
+            }
+
+            for (int32_t i = 0; i < REPLAY_BENCH_SEEKS; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                uint32_t target = (state >> 8) % (reader.GetFrameCount() + 1);
+
+                auto seekStart = std::chrono::steady_clock::now();
+                bool ok = reader.Seek(target);
+                seekTime += std::chrono::steady_clock::now() - seekStart;
+                ++seeks;
+
+                if (!ok || HashBoards(reader) != hashes[target])
+                {
+                    ++result.seekErrors;
+                }
+            }
+        }
+        std::filesystem::remove_all(directory, error);
+
+        double minutes = static_cast<double>(totalFrames) / (TETRIS_FRAME_RATE * 60.0);
+        result.frames = static_cast<double>(totalFrames) / REPLAY_BENCH_MATCHES;
+        result.bytes = static_cast<double>(totalBytes) / REPLAY_BENCH_MATCHES;
+        result.kbPerMinute = minutes > 0.0 ? totalBytes / 1024.0 / minutes : 0.0;
+        result.rawKbPerMinute = TETRIS_FRAME_RATE * 60.0 * playerCount / 1024.0;
+        if (!recordTimes.empty())
+        {
+            std::nth_element(recordTimes.begin(), recordTimes.begin() + recordTimes.size() / 2, recordTimes.end());
+            result.recordNs = static_cast<double>(recordTimes[recordTimes.size() / 2]);
+        }
+        result.fastForwardMfps = fastForwardTime.count() > 0 ? static_cast<double>(boardFrames) * 1000.0 / fastForwardTime.count() : 0.0;
+        result.seekUs = seeks > 0 ? static_cast<double>(seekTime.count()) / 1000.0 / seeks : 0.0;
+        return result;
+    }
+}
+
+void RunReplayBench()
+{
+    std::printf("[Match replay] %d matches per row, up to %u frames, random held inputs\n\n",
+        REPLAY_BENCH_MATCHES, REPLAY_BENCH_MAX_FRAMES);
+    std::printf("%-8s %8s %8s %8s %11s %10s %12s %10s %9s %9s\n",
+        "players", "frames", "bytes", "KB/min", "raw KB/min", "record ns", "mismatch", "ffwd Mfps", "seek us", "seek err");
+    std::printf("%s\n", std::string(102, '-').c_str());
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "mo_replay_bench";
+    for (int32_t players : { 2, 4, ROOM_MAX_PLAYERS })
+    {
+        ReplayBenchResult result = RunReplay(players, directory);
+        char mismatch[32];
+        std::snprintf(mismatch, sizeof(mismatch), "%u/%u", result.mismatches, result.checksums);
+        std::printf("%-8d %8.0f %8.0f %8.2f %11.1f %10.0f %12s %10.1f %9.1f %9d%s\n",
+            players, result.frames, result.bytes, result.kbPerMinute, result.rawKbPerMinute, result.recordNs,
+            mismatch, result.fastForwardMfps, result.seekUs, result.seekErrors, result.ok ? "" : "  (FAILED)");
+    }
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "AsyncLogger.h"
+#include "RoomManager.h"
+
+// CRoomManager 방 생성/제목 검색/삭제 비용이 방 개수에 따라 어떻게 변하는지 측정
+// 방 개수가 늘어도 ns/op가 그대로면 O(1)
+// 측정 구간의 힙 할당 횟수도 같이 출력 (풀이 한 번 채워진 뒤로는 0이어야 함)
+
+namespace
+{
+    constexpr size_t ROOM_BENCH_BATCH = 1000;
+    constexpr size_t ROOM_BENCH_ROUNDS = 5; // 라운드별 최소값 사용 (잡음 제거)
+    constexpr size_t ROOM_BENCH_CHECKPOINTS[] = { 1000, 10000, 50000 };
+    constexpr size_t ROOM_BENCH_MAX_ROOMS = 50000 + ROOM_BENCH_BATCH;
+
+    double NsPerOp(std::chrono::steady_clock::time_point start, size_t ops)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ops;
+    }
+}
+
+void RunRoomManagerBench()
+{
+    std::printf("[RoomManager] ns/op, batch %zu x %zu rounds (min) at each room count\n\n", ROOM_BENCH_BATCH, ROOM_BENCH_ROUNDS);
+    std::printf("%10s %14s %14s %16s %14s\n", "rooms", "create", "find title", "delete oldest", "heap allocs");
+    std::printf("%s\n", std::string(72, '-').c_str());
+
+    // CreateRoom/DeleteRoom 정보 로그는 측정에서 뺌 (레벨 필터에서 바로 걸러짐)
+    CAsyncLogger::Get().SetMinLevel(LogLevel::Warning);
+
+    CRoomManager manager(ROOM_BENCH_MAX_ROOMS);
+
+    // 생성 순 roomId 링 버퍼 (head: 가장 오래된 방). 측정 중 할당이 섞이지 않도록 고정 크기
+    std::vector<int32_t> liveRooms(ROOM_BENCH_MAX_ROOMS);
+    size_t liveHead = 0;
+    size_t liveCount = 0;
+    size_t titleSeq = 0;
+
+    auto makeTitle = [](size_t seq) { return "Room_" + std::to_string(seq); };
+
+    auto createRoom = [&](const std::string& title)
+    {
+        CRoom* room = manager.CreateRoom(title, 4);
+        liveRooms[(liveHead + liveCount++) % liveRooms.size()] = room->GetRoomId();
+    };
+
+    auto deleteOldestRoom = [&]()
+    {
+        manager.DeleteRoom(liveRooms[liveHead]);
+        liveHead = (liveHead + 1) % liveRooms.size();
+        --liveCount;
+    };
+
+    std::vector<std::string> titles(ROOM_BENCH_BATCH);
+    std::vector<std::string> lookups(ROOM_BENCH_BATCH);
+
+    for (size_t checkpoint : ROOM_BENCH_CHECKPOINTS)
+    {
+        while (liveCount + ROOM_BENCH_BATCH < checkpoint)
+        {
+            createRoom(makeTitle(titleSeq++));
+        }
+
+        // 라운드마다 BATCH개 생성 -> 검색 -> 가장 오래된 BATCH개 삭제 (방 개수는 checkpoint 근처 유지)
+        double createNs = 1e18, findNs = 1e18, deleteNs = 1e18;
+        uint64_t heapAllocs = 0;
+        for (size_t round = 0; round < ROOM_BENCH_ROUNDS; ++round)
+        {
+            // 생성 (제목 문자열 만드는 비용은 측정에서 제외)
+            for (size_t i = 0; i < ROOM_BENCH_BATCH; ++i)
+            {
+                titles[i] = makeTitle(titleSeq++);
+            }
+
+            uint64_t allocsBefore = g_benchHeapAllocs;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < ROOM_BENCH_BATCH; ++i)
+            {
+                createRoom(titles[i]);
+            }
+            createNs = std::min(createNs, NsPerOp(start, ROOM_BENCH_BATCH));
+            uint64_t createAllocs = g_benchHeapAllocs - allocsBefore;
+
+            // 제목 검색 (HandleCreateRoom의 중복 체크 경로). 있는 제목과 없는 제목 반반
+            for (size_t i = 0; i < ROOM_BENCH_BATCH; ++i)
+            {
+                lookups[i] = (i & 1) ? makeTitle((i * 7919) % titleSeq) : "Missing_" + std::to_string(i);
+            }
+
+            allocsBefore = g_benchHeapAllocs;
+            start = std::chrono::steady_clock::now();
+            uint64_t found = 0;
+            for (size_t i = 0; i < ROOM_BENCH_BATCH; ++i)
+            {
+                found += manager.FindRoomByTitle(lookups[i]) ? 1 : 0;
+            }
+            findNs = std::min(findNs, NsPerOp(start, ROOM_BENCH_BATCH));
+            g_benchSink = g_benchSink + found;
+
+            // 가장 오래된 방부터 삭제 (최근 생성 순 리스트의 끝쪽)
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < ROOM_BENCH_BATCH; ++i)
+            {
+                deleteOldestRoom();
+            }
+            deleteNs = std::min(deleteNs, NsPerOp(start, ROOM_BENCH_BATCH));
+
+            // 마지막 라운드 기준 (첫 라운드는 노드 풀이 늘어나는 중일 수 있음)
+            heapAllocs = createAllocs + (g_benchHeapAllocs - allocsBefore);
+        }
+
+        std::printf("%10zu %14.1f %14.1f %16.1f %14llu\n", checkpoint, createNs, findNs, deleteNs,
+            static_cast<unsigned long long>(heapAllocs));
+    }
+
+    CAsyncLogger::Get().SetMinLevel(LogLevel::Info);
+}
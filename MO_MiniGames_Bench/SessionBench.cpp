@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "HandleTable.h"
+#include "Player.h"
+#include "SessionSlotTable.h"
+
+// sessionId -> CPlayer 조회 비용 비교 (DispatchDataReceived가 패킷마다 하는 조회)
+// map: 이전 구조 (unordered_map<sessionId, PlayerHandle> + 핸들 테이블)
+// slot: 세션 슬롯 index 배열 + uniqueId 검증
+
+namespace
+{
+    constexpr size_t SESSION_BENCH_COUNTS[] = { 1000, 10000, 60000 };
+    constexpr size_t SESSION_BENCH_ROUNDS = 5; // 라운드별 최소값 사용
+
+    // CSession::MakeSessionId와 같은 비트 배치 (상위 16비트 index, 하위 48비트 uniqueId)
+    int64_t MakeBenchSessionId(uint16_t index, int64_t uniqueId)
+    {
+        return (static_cast<int64_t>(index) << 48) | (uniqueId & 0x0000FFFFFFFFFFFFLL);
+    }
+
+    uint16_t BenchSessionIndex(int64_t sessionId) { return static_cast<uint16_t>((sessionId >> 48) & 0xFFFF); }
+    int64_t BenchSessionUniqueId(int64_t sessionId) { return sessionId & 0x0000FFFFFFFFFFFFLL; }
+}
+
+void RunSessionTableBench(size_t iterations)
+{
+    std::printf("[Session -> Player] ns/op, %zu lookups x %zu rounds (min), random live sessions\n\n", iterations, SESSION_BENCH_ROUNDS);
+    std::printf("%10s %14s %14s %14s %14s\n", "sessions", "map lookup", "slot lookup", "map churn", "slot churn");
+    std::printf("%s\n", std::string(70, '-').c_str());
+
+    std::mt19937 rng(12345);
+
+    for (size_t sessionCount : SESSION_BENCH_COUNTS)
+    {
+        CHandleTable<CPlayer> players(sessionCount);
+        std::unordered_map<int64_t, PlayerHandle> sessionMap;
+        CSessionSlotTable<CPlayer> sessionSlots(sessionCount);
+        sessionMap.reserve(sessionCount);
+
+        // 네트워크 레이어처럼 index는 순서 없이 재사용되고 uniqueId는 계속 증가
+        std::vector<uint16_t> indices(sessionCount);
+        for (size_t i = 0; i < sessionCount; ++i)
+        {
+            indices[i] = static_cast<uint16_t>(i);
+        }
+        std::shuffle(indices.begin(), indices.end(), rng);
+
+        int64_t nextUniqueId = 1;
+        std::vector<int64_t> liveSessions(sessionCount);
+        for (size_t i = 0; i < sessionCount; ++i)
+        {
+            int64_t sessionId = MakeBenchSessionId(indices[i], nextUniqueId++);
+            PlayerHandle handle = players.Create(sessionId);
+            CPlayer* player = players.Get(handle);
+            player->SetHandle(handle);
+
+            sessionMap.emplace(sessionId, handle);
+            sessionSlots.Insert(indices[i], BenchSessionUniqueId(sessionId), player);
+            liveSessions[i] = sessionId;
+        }
+
+        // 패킷 도착 순서 (조회 대상 세션을 미리 뽑아둠)
+        std::vector<int64_t> lookups(iterations);
+        std::uniform_int_distribution<size_t> pick(0, sessionCount - 1);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            lookups[i] = liveSessions[pick(rng)];
+        }
+
+        double mapNs = 1e18, slotNs = 1e18;
+        for (size_t round = 0; round < SESSION_BENCH_ROUNDS; ++round)
+        {
+            BenchResult map = RunBench(iterations, 0, [&](size_t i) -> uint64_t
+            {
+                auto it = sessionMap.find(lookups[i]);
+                const CPlayer* player = (it != sessionMap.end()) ? players.Get(it->second) : nullptr;
+                return player ? static_cast<uint64_t>(player->GetSessionId()) : 0;
+            });
+
+            BenchResult slot = RunBench(iterations, 0, [&](size_t i) -> uint64_t
+            {
+                int64_t sessionId = lookups[i];
+                const CPlayer* player = sessionSlots.Find(BenchSessionIndex(sessionId), BenchSessionUniqueId(sessionId));
+                return player ? static_cast<uint64_t>(player->GetSessionId()) : 0;
+            });
+
+            mapNs = std::min(mapNs, map.nsPerOp);
+            slotNs = std::min(slotNs, slot.nsPerOp);
+        }
+
+        // 접속 종료 + 같은 슬롯으로 재접속 (uniqueId만 바뀜). 두 테이블이 각자 세션 목록을 가짐
+        size_t churnOps = std::min(iterations, sessionCount * 4);
+        std::vector<int64_t> mapSessions = liveSessions;
+        std::vector<int64_t> slotSessions = liveSessions;
+        int64_t mapUniqueId = nextUniqueId;
+        int64_t slotUniqueId = nextUniqueId;
+
+        BenchResult mapChurn = RunBench(churnOps, 0, [&](size_t i) -> uint64_t
+        {
+            int64_t& sessionId = mapSessions[i % sessionCount];
+            int64_t newId = MakeBenchSessionId(BenchSessionIndex(sessionId), mapUniqueId++);
+
+            auto it = sessionMap.find(sessionId);
+            PlayerHandle handle = it->second;
+            sessionMap.erase(it);
+            sessionMap.emplace(newId, handle);
+            sessionId = newId;
+            return handle.index;
+        });
+
+        BenchResult slotChurn = RunBench(churnOps, 0, [&](size_t i) -> uint64_t
+        {
+            int64_t& sessionId = slotSessions[i % sessionCount];
+            uint16_t index = BenchSessionIndex(sessionId);
+            int64_t newUniqueId = slotUniqueId++;
+
+            CPlayer* player = sessionSlots.Find(index, BenchSessionUniqueId(sessionId));
+            sessionSlots.Erase(index, BenchSessionUniqueId(sessionId));
+            sessionSlots.Insert(index, newUniqueId, player);
+            sessionId = MakeBenchSessionId(index, newUniqueId);
+            return index;
+        });
+
+        std::printf("%10zu %14.1f %14.1f %14.1f %14.1f\n", sessionCount, mapNs, slotNs, mapChurn.nsPerOp, slotChurn.nsPerOp);
+    }
+}
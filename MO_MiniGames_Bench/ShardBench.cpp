@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "AsyncLogger.h"
+#include "HandleTable.h"
+#include "Player.h"
+#include "ShardedRoomManager.h"
+
+// 로직 스레드 수에 따른 방 처리량 비교 (방 생성 + 입장 -> 퇴장(빈 방 삭제) 1사이클)
+// global : CRoomManager 하나를 모든 스레드가 mutex로 나눠 씀 (요청 1개 = 락 1번)
+// sharded: CShardedRoomManager, 스레드마다 자기 샤드 + 멤버십 예약/확정/해제 (실제 분산형 서버 경로)
+// 코어 수보다 스레드가 많으면 의미 없으므로 하드웨어 스레드 수까지만 측정
+
+namespace
+{
+    constexpr int32_t SHARD_BENCH_THREAD_COUNTS[] = { 1, 2, 4, 8 };
+    constexpr size_t SHARD_BENCH_TITLES = 64; // 스레드별 제목 (사이클마다 방이 삭제되므로 돌려씀)
+    constexpr size_t SHARD_BENCH_MAX_ROOMS = 1024;
+
+    // 모든 스레드를 동시에 출발시키고 전체 경과 시간(ns)을 잼
+    template <typename Func>
+    double RunThreads(int32_t threadCount, Func&& func)
+    {
+        std::atomic<bool> go{ false };
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                while (!go.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                func(t);
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    std::vector<std::string> MakeTitles(int32_t thread)
+    {
+        std::vector<std::string> titles(SHARD_BENCH_TITLES);
+        for (size_t i = 0; i < SHARD_BENCH_TITLES; ++i)
+        {
+            titles[i] = "Shard_" + std::to_string(thread) + "_" + std::to_string(i);
+        }
+        return titles;
+    }
+}
+
+void RunShardBench(size_t iterations)
+{
+    int32_t hardwareThreads = static_cast<int32_t>((std::max)(1u, std::thread::hardware_concurrency()));
+    size_t cyclesPerThread = (std::max)(iterations / 10, static_cast<size_t>(1000));
+
+    std::printf("[Room shards] Mcycles/s (create+join, leave), %zu cycles per thread, %d hardware threads\n\n",
+        cyclesPerThread, hardwareThreads);
+    std::printf("%8s %14s %14s %14s %14s\n", "threads", "global+mutex", "sharded", "shard scale", "allocs/cycle");
+    std::printf("%s\n", std::string(68, '-').c_str());
+
+    // CreateRoom/DeleteRoom 정보 로그는 측정에서 뺌 (레벨 필터에서 바로 걸러짐)
+    CAsyncLogger::Get().SetMinLevel(LogLevel::Warning);
+
+    double shardedBase = 0.0;
+    for (int32_t threadCount : SHARD_BENCH_THREAD_COUNTS)
+    {
+        if (threadCount > hardwareThreads)
+        {
+            break;
+        }
+
+        std::vector<std::vector<std::string>> titles(threadCount);
+        for (int32_t t = 0; t < threadCount; ++t)
+        {
+            titles[t] = MakeTitles(t);
+        }
+
+        // 스레드별 플레이어 1명 (플레이어 테이블은 어느 쪽이든 스레드 전용이라 비교에서 제외)
+        std::vector<std::unique_ptr<CHandleTable<CPlayer>>> players(threadCount);
+        std::vector<CPlayer*> threadPlayers(threadCount);
+        for (int32_t t = 0; t < threadCount; ++t)
+        {
+            players[t] = std::make_unique<CHandleTable<CPlayer>>(1);
+            PlayerHandle handle = players[t]->Create(static_cast<int64_t>(t + 1));
+            threadPlayers[t] = players[t]->Get(handle);
+            threadPlayers[t]->SetHandle(handle);
+        }
+
+        // global: 모든 스레드가 같은 관리자 + mutex
+        CRoomManager globalManager(SHARD_BENCH_MAX_ROOMS * threadCount);
+        std::mutex globalMutex;
+        double globalNs = RunThreads(threadCount, [&](int32_t t)
+        {
+            CPlayer& player = *threadPlayers[t];
+            for (size_t i = 0; i < cyclesPerThread; ++i)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(globalMutex);
+                    CRoom* room = globalManager.CreateRoom(titles[t][i % SHARD_BENCH_TITLES], 4);
+                    globalManager.JoinRoom(*room, player);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(globalMutex);
+                    globalManager.LeaveRoom(player);
+                }
+            }
+        });
+
+        // sharded: 스레드 t가 샤드 t 전담, 멤버십은 세션 슬롯 t
+        CShardedRoomManager sharded(threadCount, SHARD_BENCH_MAX_ROOMS, static_cast<size_t>(threadCount));
+        uint64_t allocsBefore = g_benchHeapAllocs;
+        double shardedNs = RunThreads(threadCount, [&](int32_t t)
+        {
+            CRoomManager& manager = sharded.GetShard(t);
+            CRoomMembershipTable& membership = sharded.GetMembership();
+            CPlayer& player = *threadPlayers[t];
+            uint16_t slot = static_cast<uint16_t>(t);
+            int64_t uniqueId = t + 1;
+
+            for (size_t i = 0; i < cyclesPerThread; ++i)
+            {
+                membership.TryReserve(slot, uniqueId, t);
+                CRoom* room = manager.CreateRoom(titles[t][i % SHARD_BENCH_TITLES], 4);
+                manager.JoinRoom(*room, player);
+                membership.Commit(slot, uniqueId, t, room->GetRoomId());
+
+                int32_t roomId = room->GetRoomId();
+                manager.LeaveRoom(player);
+                membership.Release(slot, uniqueId, roomId);
+            }
+        });
+        uint64_t heapAllocs = g_benchHeapAllocs - allocsBefore; // 스레드 생성분 포함 (사이클당으로 나누면 0에 수렴)
+
+        double totalCycles = static_cast<double>(cyclesPerThread) * threadCount;
+        double globalRate = totalCycles * 1000.0 / globalNs;   // Mcycles/s
+        double shardedRate = totalCycles * 1000.0 / shardedNs;
+        if (threadCount == 1)
+        {
+            shardedBase = shardedRate;
+        }
+
+        std::printf("%8d %14.2f %14.2f %13.2fx %14.3f\n", threadCount, globalRate, shardedRate,
+            shardedRate / shardedBase, static_cast<double>(heapAllocs) / totalCycles);
+    }
+
+    CAsyncLogger::Get().SetMinLevel(LogLevel::Info);
+}
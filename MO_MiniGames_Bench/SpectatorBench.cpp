@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "SpectatorRelay.h"
+
+// 관전 팬아웃 (방 하나, 10명 게임을 관전자 N명이 봄)
+// 무작위 입력으로 보드 10장을 돌리며 확정 프레임마다 CSpectatorFeed에 넘김 (SPECTATOR_STREAM_INTERVAL마다 인코딩)
+// 방 쪽은 60Hz의 SPECTATOR_BENCH_SPEEDUP배로 돌림 (관전자 수 x 인코딩 빈도만큼 트리가 실제로 보내야 함)
+// 릴레이 트리는 로비와 같은 모양으로 미리 만듦 (릴레이당 세션 64, 자식 4, 너비 우선). 전송은 세션 송신 큐 복사 흉내 (memcpy)
+//  - room ns      : 인코딩하는 프레임의 방 액터 쪽 비용 중앙값 (인코딩 + 첫 릴레이에 넘기기). 관전자 수와 관계없어야 함
+//                   코어가 워커 수 + 1보다 적으면 첫 릴레이를 깨우는 순간 워커에게 코어를 넘겨서 팬아웃 시간까지 들어감
+//  - direct ns    : 비교용. 방 액터가 한 번 인코딩한 바이트를 관전자마다 직접 보낼 때의 방 쪽 비용 (인코딩 하나당 평균)
+//  - Msends/s     : 트리 전체가 관전자에게 보낸 메시지 / 초 (워커 전체, 게임 시작부터 마지막 전송까지. 방 쪽 속도에 묶임)
+//  - delivered    : 보낸 메시지 / (첫 릴레이에 넘긴 메시지 수 x 관전자 수). 트리 안에서 밀려서 버린 메시지가 있으면 100% 미만
+//  - skipped      : 빈 버퍼가 없어서 건너뛴 인코딩 (다음 델타에 합쳐짐)
+//  - allocs       : 측정 구간 힙 할당 (0이어야 함)
+
+namespace
+{
+    constexpr int32_t SPECTATOR_BENCH_PLAYERS = ROOM_MAX_PLAYERS;
+    constexpr int32_t SPECTATOR_BENCH_WORKERS = 4;
+    constexpr int32_t SPECTATOR_BENCH_ROOM_ID = 1;
+    constexpr size_t SPECTATOR_BENCH_FRAMES = 1200; // 20초 게임
+    constexpr int32_t SPECTATOR_BENCH_SPEEDUP = 10;
+
+    struct SpectatorBenchResult
+    {
+        size_t relays;
+        int32_t depth;
+        double roomNsPerEncode;
+        double sendsPerSecond;
+        double delivered;
+        uint64_t skipped;
+        uint64_t allocs;
+    };
+
+    // 세션 송신 큐에 복사하는 비용만 흉내
+    void BenchSend(int64_t sessionId, const char* data, size_t size)
+    {
+        thread_local char sendQueue[SPECTATOR_FRAME_MAX_SIZE];
+        std::memcpy(sendQueue, data, size);
+        g_benchSink = g_benchSink + static_cast<uint64_t>(sessionId) + static_cast<uint8_t>(sendQueue[size - 1]);
+    }
+
+    uint8_t NextSpectatorInput(uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        uint32_t roll = state >> 24;
+        if (roll < 6)
+        {
+            return TETRIS_INPUT_HARD_DROP;
+        }
+        if (roll < 40)
+        {
+            return static_cast<uint8_t>(TETRIS_INPUT_LEFT << ((state >> 16) & 1));
+        }
+        if (roll < 60)
+        {
+            return TETRIS_INPUT_ROTATE_CW;
+        }
+        return TETRIS_INPUT_NONE;
+    }
+
+    void StepBoards(CTetrisBoardBatch& boards, uint32_t& state, uint32_t& seed)
+    {
+        uint8_t inputs[ROOM_MAX_PLAYERS];
+        TetrisStepResult results[ROOM_MAX_PLAYERS];
+        for (int32_t board = 0; board < SPECTATOR_BENCH_PLAYERS; ++board)
+        {
+            inputs[board] = NextSpectatorInput(state);
+        }
+        boards.StepAll(SPECTATOR_BENCH_PLAYERS, inputs, results);
+
+        // 탈락한 보드는 다시 시작 (관전 화면은 다음 델타로 따라옴)
+        for (int32_t board = 0; board < SPECTATOR_BENCH_PLAYERS; ++board)
+        {
+            if (results[board].gameOver)
+            {
+                boards.Start(static_cast<size_t>(board), seed++);
+            }
+        }
+    }
+
+    // 방 액터가 관전자마다 직접 보낼 때 (릴레이 없음)
+    double RunDirect(int32_t spectators, size_t frames)
+    {
+        CTetrisBoardBatch boards(SPECTATOR_BENCH_PLAYERS);
+        uint32_t seed = 1;
+        for (int32_t board = 0; board < SPECTATOR_BENCH_PLAYERS; ++board)
+        {
+            boards.Start(static_cast<size_t>(board), seed++);
+        }
+
+        CBoardStream stream;
+        stream.Reset(SPECTATOR_BENCH_PLAYERS);
+        char buffer[SPECTATOR_FRAME_MAX_SIZE];
+        uint32_t state = 4242;
+        std::chrono::nanoseconds roomTime(0);
+        size_t encodes = 0;
+
+        for (uint32_t frame = 1; frame <= frames; ++frame)
+        {
+            StepBoards(boards, state, seed);
+            if (frame % SPECTATOR_STREAM_INTERVAL != 0)
+            {
+                continue;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+            if (stream.Encode(frame - 1, boards, writer))
+            {
+                for (int32_t spectator = 0; spectator < spectators; ++spectator)
+                {
+                    BenchSend(spectator, buffer, writer.GetSize());
+                }
+            }
+            roomTime += std::chrono::steady_clock::now() - start;
+            ++encodes;
+        }
+
+        return encodes > 0 ? static_cast<double>(roomTime.count()) / encodes : 0.0;
+    }
+
+    SpectatorBenchResult RunTree(int32_t spectators, uint32_t delayFrames, size_t frames)
+    {
+        SpectatorBenchResult result = {};
+
+        CActorWorkerPool pool(SPECTATOR_BENCH_WORKERS, 4096);
+        size_t relayCount = static_cast<size_t>((spectators + SPECTATOR_RELAY_SESSIONS - 1) / SPECTATOR_RELAY_SESSIONS);
+        std::vector<std::unique_ptr<CSpectatorRelay>> relays;
+        relays.reserve(relayCount);
+        for (size_t i = 0; i < relayCount; ++i)
+        {
+            relays.push_back(std::make_unique<CSpectatorRelay>(pool, static_cast<uint32_t>(i), BenchSend));
+        }
+
+        // 로비와 같은 모양: i번 릴레이는 (i - 1) / 자식 수 번 아래 (너비 우선)
+        int32_t depth = relayCount > 0 ? 1 : 0;
+        for (size_t i = 0; i < relayCount; ++i)
+        {
+            relays[i]->PostAttach(SPECTATOR_BENCH_ROOM_ID);
+            if (i > 0)
+            {
+                relays[(i - 1) / SPECTATOR_RELAY_CHILDREN]->PostAddChild(relays[i].get());
+            }
+
+            int32_t level = 1;
+            for (size_t node = i; node > 0; node = (node - 1) / SPECTATOR_RELAY_CHILDREN)
+            {
+                ++level;
+            }
+            depth = (std::max)(depth, level);
+        }
+        for (int32_t spectator = 0; spectator < spectators; ++spectator)
+        {
+            relays[static_cast<size_t>(spectator / SPECTATOR_RELAY_SESSIONS)]->PostSubscribe(spectator);
+        }
+
+        // 관전 스트림 (방 액터 몫은 이 스레드)
+        CSpectatorFeed feed(delayFrames);
+        feed.SetRoot(relays.empty() ? nullptr : relays[0].get());
+        feed.StartGame(SPECTATOR_BENCH_ROOM_ID, SPECTATOR_BENCH_PLAYERS);
+
+        CTetrisBoardBatch boards(SPECTATOR_BENCH_PLAYERS);
+        uint32_t seed = 1;
+        for (int32_t board = 0; board < SPECTATOR_BENCH_PLAYERS; ++board)
+        {
+            boards.Start(static_cast<size_t>(board), seed++);
+        }
+
+        pool.Start();
+
+        // 버퍼 할당 + 첫 키프레임은 측정 밖
+        uint32_t state = 4242;
+        uint32_t frame = 0;
+        for (uint32_t warmup = 0; warmup < SPECTATOR_STREAM_INTERVAL; ++warmup)
+        {
+            StepBoards(boards, state, seed);
+            feed.OnConfirmedFrames(++frame, boards);
+        }
+
+        std::vector<int64_t> encodeTimes;
+        encodeTimes.reserve(frames / SPECTATOR_STREAM_INTERVAL + 1);
+        uint64_t allocsBefore = g_benchHeapAllocs.load();
+        auto wallStart = std::chrono::steady_clock::now();
+        auto frameTime = std::chrono::nanoseconds(1000000000LL / (TETRIS_FRAME_RATE * SPECTATOR_BENCH_SPEEDUP));
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            // 다음 확정 프레임 시각까지 (sleep은 해상도가 거칠어서 양보만)
+            auto due = wallStart + frameTime * static_cast<int64_t>(i);
+            while (std::chrono::steady_clock::now() < due)
+            {
+                std::this_thread::yield();
+            }
+
+            StepBoards(boards, state, seed);
+
+            uint64_t encoded = feed.GetEncodedCount();
+            auto start = std::chrono::steady_clock::now();
+            feed.OnConfirmedFrames(++frame, boards);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (feed.GetEncodedCount() != encoded)
+            {
+                encodeTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        MSG_S2C_GAME_OVER gameOver;
+        gameOver.frameCount = frame;
+        gameOver.winnerSlot = LOCKSTEP_SLOT_NONE;
+        char gameOverMsg[GAME_OVER_MSG_MAX_SIZE];
+        CMsgWriter writer(gameOverMsg, sizeof(gameOverMsg), sizeof(MsgHeader));
+        gameOver.Encode(writer);
+        MsgHeader* header = reinterpret_cast<MsgHeader*>(gameOverMsg);
+        header->size = static_cast<uint16_t>(writer.GetSize());
+        header->type = MsgType::S2C_GAME_OVER;
+        auto endTime = std::chrono::steady_clock::now();
+        feed.EndGame(frame, boards, gameOverMsg, writer.GetSize());
+
+        // 지연 중인 화면은 게임 중과 같은 간격으로 마저 나감 (방 쪽과 같은 SPEEDUP배 시계)
+        while (feed.IsDraining())
+        {
+            auto now = std::chrono::steady_clock::now();
+            feed.Drain(endTime + (now - endTime) * SPECTATOR_BENCH_SPEEDUP);
+            std::this_thread::yield();
+        }
+
+        // 마지막 전송까지 (버린 메시지가 있으면 목표에 못 미치므로 잠시 조용해지면 끝)
+        uint64_t expected = feed.GetDeliveredCount() * static_cast<uint64_t>(spectators);
+        uint64_t sent = 0;
+        uint64_t lastSent = UINT64_MAX;
+        auto quietSince = std::chrono::steady_clock::now();
+        while (true)
+        {
+            sent = 0;
+            for (const auto& relay : relays)
+            {
+                sent += relay->GetSentCount();
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (sent >= expected || now - quietSince > std::chrono::milliseconds(200))
+            {
+                break;
+            }
+            if (sent != lastSent)
+            {
+                lastSent = sent;
+                quietSince = now;
+            }
+            std::this_thread::yield();
+        }
+        auto wallTime = std::chrono::steady_clock::now() - wallStart;
+        uint64_t allocs = g_benchHeapAllocs.load() - allocsBefore;
+        pool.Stop();
+
+        result.relays = relayCount;
+        result.depth = depth;
+        std::nth_element(encodeTimes.begin(), encodeTimes.begin() + encodeTimes.size() / 2, encodeTimes.end());
+        result.roomNsPerEncode = encodeTimes.empty() ? 0.0 : static_cast<double>(encodeTimes[encodeTimes.size() / 2]);
+        result.sendsPerSecond = static_cast<double>(sent) / std::chrono::duration<double>(wallTime).count();
+        result.delivered = expected > 0 ? static_cast<double>(sent) / expected : 0.0;
+        result.skipped = feed.GetSkippedCount();
+        result.allocs = allocs;
+        return result;
+    }
+}
+
+void RunSpectatorBench()
+{
+    size_t frames = SPECTATOR_BENCH_FRAMES;
+
+    std::printf("[Spectator fan-out] %d boards, %zu frames at %dx speed, stream every %u frames, %d workers, %d sessions / %d children per relay\n\n",
+        SPECTATOR_BENCH_PLAYERS, frames, SPECTATOR_BENCH_SPEEDUP, SPECTATOR_STREAM_INTERVAL, SPECTATOR_BENCH_WORKERS,
+        SPECTATOR_RELAY_SESSIONS, SPECTATOR_RELAY_CHILDREN);
+    std::printf("%-18s %7s %6s %10s %10s %10s %10s %8s %7s\n",
+"spectators", "relays", "depth", "room ns", "direct ns", "Msends/s", "delivered", "skipped", "allocs");
+    std::printf("%s\n", std::string(100, '-').c_str());
+
+    struct Mode
+    {
+        const char* name;
+        int32_t spectators;
+        uint32_t delayFrames;
+    };
+
+    for (const Mode& mode : { Mode{ "64", 64, 0 }, Mode{ "512", 512, 0 }, Mode{ "4096", 4096, 0 },
+        Mode{ "4096 (3s delay)", 4096, 180 } })
+    {
+        SpectatorBenchResult result = RunTree(mode.spectators, mode.delayFrames, frames);
+        double direct = RunDirect(mode.spectators, frames);
+        std::printf("%-18s %7zu %6d %10.0f %10.0f %10.2f %9.1f%% %8llu %7llu\n", mode.name, result.relays, result.depth,
+            result.roomNsPerEncode, direct, result.sendsPerSecond / 1e6, result.delivered * 100.0,
+            static_cast<unsigned long long>(result.skipped), static_cast<unsigned long long>(result.allocs));
+    }
+}
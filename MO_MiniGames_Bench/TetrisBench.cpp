@@ -0,0 +1,192 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "TetrisBoardBatch.h"
+#include "TetrisEngine.h"
+
+// 서버 쪽 보드 시뮬레이션 비용
+// 방 1000개 x 10명 = 보드 10000개를 프레임마다 전부 Step (입력은 보드마다 의사 난수, 가끔 하드 드롭)
+//  - ns/board : 보드 하나 한 프레임
+//  - boards   : 60Hz 프레임 하나(16.6ms)를 코어 하나로 채울 수 있는 보드 수
+//  - allocs   : Step 경로 힙 할당 (0이어야 함)
+// 보드 묶음 커널 (CTetrisBoardBatch, 같은 보드 10000개를 수준별로)
+//  - full rows / used rows : 보드마다 꽉 찬 행 / 쌓인 행 비트마스크
+//  - garbage               : 보드마다 방해 줄 1~4줄 삽입
+//  - probe                 : 충돌 검사 하나 (보드 무작위, 수준과 관계없이 같은 경로)
+
+namespace
+{
+    constexpr size_t TETRIS_BENCH_BOARDS = 10000;
+    constexpr size_t TETRIS_BENCH_KERNEL_ROUNDS = 200;
+    constexpr size_t TETRIS_BENCH_GARBAGE_ROUNDS = 4; // 보드가 넘치기 전에 다시 시작
+
+    // 사람 입력 흉내: 대부분 빈 프레임, 이따금 좌우/회전, 40프레임 정도에 한 번 하드 드롭
+    uint8_t NextBenchInput(uint32_t& state)
+    {
+        state = state * 1664525u + 1013904223u;
+        uint32_t roll = state >> 24;
+        if (roll < 6)
+        {
+            return TETRIS_INPUT_HARD_DROP;
+        }
+        if (roll < 40)
+        {
+            return static_cast<uint8_t>(TETRIS_INPUT_LEFT << ((state >> 16) & 1));
+        }
+        if (roll < 60)
+        {
+            return TETRIS_INPUT_ROTATE_CW;
+        }
+        if (roll < 70)
+        {
+            return TETRIS_INPUT_SOFT_DROP;
+        }
+        return TETRIS_INPUT_NONE;
+    }
+
+    // 보드마다 몇 초 분량을 진행해서 쌓인 모양을 만듦
+    void FillBatch(CTetrisBoardBatch& batch)
+    {
+        std::vector<uint8_t> inputs(TETRIS_BENCH_BOARDS);
+        std::vector<TetrisStepResult> results(TETRIS_BENCH_BOARDS);
+        uint32_t state = 12345;
+        for (size_t i = 0; i < TETRIS_BENCH_BOARDS; ++i)
+        {
+            batch.Start(i, static_cast<uint32_t>(i + 1));
+        }
+        for (int32_t frame = 0; frame < TETRIS_FRAME_RATE * 5; ++frame)
+        {
+            for (size_t i = 0; i < TETRIS_BENCH_BOARDS; ++i)
+            {
+                inputs[i] = NextBenchInput(state);
+            }
+            batch.StepAll(TETRIS_BENCH_BOARDS, inputs.data(), results.data());
+        }
+    }
+
+    template <typename Func>
+    double MeasureNs(size_t rounds, Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            func();
+        }
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void RunBatchKernels()
+    {
+        std::printf("\n[Tetris board batch kernels] %zu boards, cpu supports %s\n\n", TETRIS_BENCH_BOARDS, GetSimdLevelName(DetectSimdLevel()));
+        std::printf("%-8s %16s %16s %14s %12s\n", "level", "full rows ns/bd", "used rows ns/bd", "garbage ns/bd", "probe ns");
+        std::printf("%s\n", std::string(70, '-').c_str());
+
+        CTetrisBoardBatch batch(TETRIS_BENCH_BOARDS);
+        FillBatch(batch);
+
+        std::vector<uint32_t> masks(TETRIS_BENCH_BOARDS);
+        std::vector<uint8_t> lines(TETRIS_BENCH_BOARDS);
+        std::vector<uint8_t> holes(TETRIS_BENCH_BOARDS);
+        std::vector<uint8_t> alive(TETRIS_BENCH_BOARDS);
+        std::vector<TetrisProbe> probes(TETRIS_BENCH_BOARDS);
+        std::vector<uint8_t> hits(TETRIS_BENCH_BOARDS);
+
+        uint32_t state = 777;
+        for (size_t i = 0; i < TETRIS_BENCH_BOARDS; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            lines[i] = static_cast<uint8_t>(1 + ((state >> 8) & 3));
+            holes[i] = static_cast<uint8_t>((state >> 12) % TETRIS_BOARD_WIDTH);
+
+            const CTetrisEngine& engine = batch.GetEngine((state >> 16) % TETRIS_BENCH_BOARDS);
+            probes[i].board = (state >> 16) % TETRIS_BENCH_BOARDS;
+            probes[i].piece = engine.GetPiece();
+            probes[i].rotation = static_cast<uint8_t>(engine.GetRotation());
+            probes[i].x = static_cast<int8_t>(engine.GetPieceX());
+            probes[i].y = static_cast<int8_t>(engine.GetPieceY() - 1);
+        }
+
+        double boardOps = static_cast<double>(TETRIS_BENCH_BOARDS * TETRIS_BENCH_KERNEL_ROUNDS);
+        const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2 };
+        for (SimdLevel level : levels)
+        {
+            if (level > DetectSimdLevel())
+            {
+                continue;
+            }
+            batch.SetSimdLevel(level);
+
+            double fullNs = MeasureNs(TETRIS_BENCH_KERNEL_ROUNDS, [&] { batch.FindFullRows(TETRIS_BENCH_BOARDS, masks.data()); g_benchSink = g_benchSink + masks[0]; });
+            double usedNs = MeasureNs(TETRIS_BENCH_KERNEL_ROUNDS, [&] { batch.FindUsedRows(TETRIS_BENCH_BOARDS, masks.data()); g_benchSink = g_benchSink + masks[0]; });
+            double probeNs = MeasureNs(TETRIS_BENCH_KERNEL_ROUNDS, [&] { batch.TestCollisions(probes.data(), TETRIS_BENCH_BOARDS, hits.data()); g_benchSink = g_benchSink + hits[0]; });
+
+            // 방해 줄은 보드를 바꾸므로 몇 번 넣고 다시 채움 (채우는 시간은 제외)
+            double garbageNs = 0.0;
+            for (size_t round = 0; round < TETRIS_BENCH_KERNEL_ROUNDS / (TETRIS_BENCH_GARBAGE_ROUNDS * 10); ++round)
+            {
+                FillBatch(batch);
+                garbageNs += MeasureNs(TETRIS_BENCH_GARBAGE_ROUNDS, [&] { batch.InsertGarbage(TETRIS_BENCH_BOARDS, lines.data(), holes.data(), alive.data()); });
+            }
+            double garbageOps = static_cast<double>(TETRIS_BENCH_BOARDS * TETRIS_BENCH_GARBAGE_ROUNDS * (TETRIS_BENCH_KERNEL_ROUNDS / (TETRIS_BENCH_GARBAGE_ROUNDS * 10)));
+
+            std::printf("%-8s %16.2f %16.2f %14.2f %12.2f\n", GetSimdLevelName(level),
+                fullNs / boardOps, usedNs / boardOps, garbageNs / garbageOps, probeNs / boardOps);
+        }
+    }
+}
+
+void RunTetrisBench(size_t iterations)
+{
+    size_t frames = (iterations / TETRIS_BENCH_BOARDS > 0) ? iterations / TETRIS_BENCH_BOARDS : 1;
+    std::printf("[Tetris simulation] %zu boards x %zu frames, sizeof(CTetrisEngine) = %zu\n\n",
+        TETRIS_BENCH_BOARDS, frames, sizeof(CTetrisEngine));
+
+    auto boards = std::make_unique<CTetrisEngine[]>(TETRIS_BENCH_BOARDS);
+    auto inputStates = std::make_unique<uint32_t[]>(TETRIS_BENCH_BOARDS);
+    for (size_t i = 0; i < TETRIS_BENCH_BOARDS; ++i)
+    {
+        boards[i].Start(static_cast<uint32_t>(i + 1));
+        inputStates[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    uint64_t allocsBefore = g_benchHeapAllocs;
+    uint64_t locks = 0;
+    uint64_t lines = 0;
+    uint64_t restarts = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        for (size_t i = 0; i < TETRIS_BENCH_BOARDS; ++i)
+        {
+            TetrisStepResult result = boards[i].Step(NextBenchInput(inputStates[i]));
+            locks += result.locked;
+            lines += result.linesCleared;
+            if (result.gameOver)
+            {
+                boards[i].Start(inputStates[i]);
+                ++restarts;
+            }
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocs = g_benchHeapAllocs - allocsBefore;
+
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    double nsPerBoard = ns / static_cast<double>(frames * TETRIS_BENCH_BOARDS);
+    double frameBudgetNs = 1e9 / TETRIS_FRAME_RATE;
+
+    std::printf("%-12s %12s %16s %10s\n", "engine", "ns/board", "boards/frame", "allocs");
+    std::printf("%s\n", std::string(54, '-').c_str());
+    std::printf("%-12s %12.1f %16.0f %10llu\n", "bitboard", nsPerBoard, frameBudgetNs / nsPerBoard, static_cast<unsigned long long>(allocs));
+    std::printf("\nlocks %llu, lines %llu, restarts %llu\n", static_cast<unsigned long long>(locks),
+        static_cast<unsigned long long>(lines), static_cast<unsigned long long>(restarts));
+
+    g_benchSink = g_benchSink + locks + lines;
+
+    RunBatchKernels();
+}
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "TickScheduler.h"
+
+// 로직 스레드 대기 방식 비교
+// 1) 이벤트 지연: 생산자 스레드(IOCP 워커 역할)가 큐에 넣은 시각 -> 로직 스레드가 꺼낸 시각
+//    spin      : 기존 기본값 (mainlogicTickMs = -1), 큐를 계속 확인
+//    sleep 1ms : 기존 mainlogicTickMs = 1
+//    scheduler : CTickScheduler (틱 20ms, 이벤트가 들어오면 Notify로 깨어남)
+//    loops/s   : 로직 스레드 루프 횟수 (잠들지 않고 도는 만큼 CPU를 씀)
+// 2) 틱 간격 유지: 틱마다 3ms 일을 하면서 1초 동안 몇 틱을 돌았는지 (기대값 50)
+//    sleep_for(20ms)는 일한 시간 + 타이머 오차만큼 매 틱 밀림
+// 3) 로비 폭주: 처리 능력보다 많은 로비 이벤트(각 10us)가 1초 동안 들어오는 중에 게임 이벤트가 2ms마다 섞여 들어옴
+//    drain    : 큐를 다 비운 뒤에 틱 (기존 CCentralizedServer). 큐가 비지 않으면 틱도 게임 이벤트도 멈춤
+//    budgeted : 게임 이벤트 먼저 (틱의 30%), 로비 이벤트는 대기열에서 틱의 20%만큼, 남으면 잠들지 않고 이어서 처리
+//    ticks    : 1초 동안 실행한 틱 (기대값 50), game p99 / max : 게임 이벤트가 큐에 들어와서 처리될 때까지
+
+namespace
+{
+    constexpr size_t TICK_BENCH_EVENTS = 300;
+    constexpr auto TICK_BENCH_EVENT_GAP = std::chrono::milliseconds(2);
+    constexpr auto TICK_BENCH_INTERVAL = std::chrono::milliseconds(20);
+    constexpr auto TICK_BENCH_TICK_WORK = std::chrono::milliseconds(3);
+    constexpr auto TICK_BENCH_DRIFT_DURATION = std::chrono::seconds(1);
+
+    enum class WaitMode
+    {
+        Spin,
+        Sleep1ms,
+        Scheduler
+    };
+
+    // 네트워크 이벤트 큐 대신 (넣은 시각만 담음)
+    struct BenchEventQueue
+    {
+        std::mutex mutex;
+        std::deque<std::chrono::steady_clock::time_point> events;
+    };
+
+    struct LatencyResult
+    {
+        double avgUs;
+        double p99Us;
+        double maxUs;
+        double loopsPerSec;
+    };
+
+    LatencyResult RunLatency(WaitMode mode)
+    {
+        BenchEventQueue queue;
+        CTickScheduler scheduler(TICK_BENCH_INTERVAL);
+        std::atomic<bool> running{ true };
+        std::vector<double> latenciesUs;
+        latenciesUs.reserve(TICK_BENCH_EVENTS);
+        uint64_t loops = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread logic([&]
+        {
+            scheduler.Start();
+            while (running.load(std::memory_order_relaxed))
+            {
+                ++loops;
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    auto now = std::chrono::steady_clock::now();
+                    while (!queue.events.empty())
+                    {
+                        latenciesUs.push_back(std::chrono::duration<double, std::micro>(now - queue.events.front()).count());
+                        queue.events.pop_front();
+                    }
+                }
+
+                switch (mode)
+                {
+                case WaitMode::Spin:
+                    break;
+                case WaitMode::Sleep1ms:
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    break;
+                case WaitMode::Scheduler:
+                    scheduler.WaitAndRunTicks([] {});
+                    break;
+                }
+            }
+        });
+
+        for (size_t i = 0; i < TICK_BENCH_EVENTS; ++i)
+        {
+            std::this_thread::sleep_for(TICK_BENCH_EVENT_GAP);
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.events.push_back(std::chrono::steady_clock::now());
+            }
+            scheduler.Notify();
+        }
+
+        // 마지막 이벤트까지 꺼낼 시간을 주고 종료
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        running.store(false, std::memory_order_relaxed);
+        scheduler.Notify();
+        logic.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LatencyResult result{ 0.0, 0.0, 0.0, static_cast<double>(loops) / seconds };
+        if (!latenciesUs.empty())
+        {
+            std::sort(latenciesUs.begin(), latenciesUs.end());
+            double sum = 0.0;
+            for (double us : latenciesUs)
+            {
+                sum += us;
+            }
+            result.avgUs = sum / latenciesUs.size();
+            result.p99Us = latenciesUs[(latenciesUs.size() * 99) / 100];
+            result.maxUs = latenciesUs.back();
+        }
+        return result;
+    }
+
+    void BusyWork(std::chrono::steady_clock::duration work)
+    {
+        auto end = std::chrono::steady_clock::now() + work;
+        uint64_t acc = 0;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            acc = acc * 31 + 7;
+        }
+        g_benchSink = g_benchSink + acc;
+    }
+
+    constexpr auto TICK_BENCH_FLOOD_DURATION = std::chrono::seconds(1);
+    constexpr size_t TICK_BENCH_FLOOD_LOBBY_PER_GAP = 300; // 2ms마다 로비 이벤트 수 (3ms 분량 -> 처리 능력의 1.5배)
+    constexpr auto TICK_BENCH_LOBBY_WORK = std::chrono::microseconds(10);
+    constexpr auto TICK_BENCH_FLOOD_TICK_WORK = std::chrono::milliseconds(1);
+
+    struct FloodEvent
+    {
+        std::chrono::steady_clock::time_point pushed;
+        bool game;
+    };
+
+    struct FloodResult
+    {
+        uint64_t ticks;
+        uint64_t skippedTicks;
+        int64_t maxJitterUs;
+        double gameP99Us;
+        double gameMaxUs;
+        size_t gameHandled;
+        size_t gameSent;
+        size_t lobbyHandled;
+    };
+
+    FloodResult RunFlood(bool budgeted)
+    {
+        std::mutex mutex;
+        std::deque<FloodEvent> queue;
+        CTickScheduler scheduler(TICK_BENCH_INTERVAL);
+        CPhaseBudget gameBudget("GameEvents", TICK_BENCH_INTERVAL * 30 / 100);
+        CPhaseBudget lobbyBudget("LobbyEvents", TICK_BENCH_INTERVAL * 20 / 100);
+        std::atomic<bool> running{ true };
+        std::vector<double> gameLatenciesUs;
+        size_t lobbyHandled = 0;
+
+        auto pop = [&](FloodEvent& event)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty())
+            {
+                return false;
+            }
+            event = queue.front();
+            queue.pop_front();
+            return true;
+        };
+        auto handleGame = [&](const FloodEvent& event)
+        {
+            gameLatenciesUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - event.pushed).count());
+        };
+        auto handleLobby = [&]
+        {
+            BusyWork(TICK_BENCH_LOBBY_WORK);
+            ++lobbyHandled;
+        };
+
+        std::thread logic([&]
+        {
+            std::deque<FloodEvent> lobbyBacklog;
+            scheduler.Start();
+            while (running.load(std::memory_order_relaxed))
+            {
+                FloodEvent event;
+                bool backlog = false;
+                if (!budgeted)
+                {
+                    while (pop(event))
+                    {
+                        event.game ? handleGame(event) : handleLobby();
+                    }
+                }
+                else
+                {
+                    // CCentralizedServer::ProcessNetworkEvents와 같은 순서
+                    uint64_t items = 0;
+                    gameBudget.Begin();
+                    while ((items == 0 || !gameBudget.IsOver()) && pop(event))
+                    {
+                        ++items;
+                        event.game ? handleGame(event) : lobbyBacklog.push_back(event);
+                    }
+                    backlog = items > 0 && gameBudget.IsOver();
+                    gameBudget.End(items, backlog);
+
+                    items = 0;
+                    lobbyBudget.Begin();
+                    while (!lobbyBacklog.empty() && (items == 0 || !lobbyBudget.IsOver()))
+                    {
+                        lobbyBacklog.pop_front();
+                        handleLobby();
+                        ++items;
+                    }
+                    lobbyBudget.End(items, !lobbyBacklog.empty());
+                    backlog = backlog || !lobbyBacklog.empty();
+                }
+
+                scheduler.WaitAndRunTicks([] { BusyWork(TICK_BENCH_FLOOD_TICK_WORK); }, !backlog);
+            }
+        });
+
+        size_t gameSent = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < TICK_BENCH_FLOOD_DURATION)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto now = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < TICK_BENCH_FLOOD_LOBBY_PER_GAP; ++i)
+                {
+                    queue.push_back({ now, false });
+                    if (i == TICK_BENCH_FLOOD_LOBBY_PER_GAP / 2)
+                    {
+                        queue.push_back({ now, true });
+                        ++gameSent;
+                    }
+                }
+            }
+            scheduler.Notify();
+            std::this_thread::sleep_for(TICK_BENCH_EVENT_GAP);
+        }
+
+        // 폭주 구간만 측정 (남은 로비 이벤트는 버림)
+        running.store(false, std::memory_order_relaxed);
+        scheduler.Notify();
+        logic.join();
+
+        TickStats stats = scheduler.TakeStats();
+        FloodResult result{ stats.ticks, stats.skippedTicks, stats.maxJitterUs, 0.0, 0.0, gameLatenciesUs.size(), gameSent, lobbyHandled };
+        if (!gameLatenciesUs.empty())
+        {
+            std::sort(gameLatenciesUs.begin(), gameLatenciesUs.end());
+            result.gameP99Us = gameLatenciesUs[(gameLatenciesUs.size() * 99) / 100];
+            result.gameMaxUs = gameLatenciesUs.back();
+        }
+        return result;
+    }
+}
+
+void RunTickBench()
+{
+    std::printf("[Logic thread wait] event latency, %zu events every %lld ms\n\n",
+        TICK_BENCH_EVENTS, static_cast<long long>(TICK_BENCH_EVENT_GAP.count()));
+    std::printf("%-12s %12s %12s %12s %14s\n", "mode", "avg us", "p99 us", "max us", "loops/s");
+    std::printf("%s\n", std::string(66, '-').c_str());
+
+    const struct
+    {
+        WaitMode mode;
+        const char* name;
+    } modes[] = {
+        { WaitMode::Spin, "spin" },
+        { WaitMode::Sleep1ms, "sleep 1ms" },
+        { WaitMode::Scheduler, "scheduler" },
+    };
+
+    for (const auto& entry : modes)
+    {
+        LatencyResult result = RunLatency(entry.mode);
+        std::printf("%-12s %12.1f %12.1f %12.1f %14.0f\n", entry.name, result.avgUs, result.p99Us, result.maxUs, result.loopsPerSec);
+    }
+
+    long long expectedTicks = static_cast<long long>(TICK_BENCH_DRIFT_DURATION / TICK_BENCH_INTERVAL);
+    std::printf("\n[Logic tick drift] %lld ms tick with %lld ms work, %lld ticks expected in 1 s\n\n",
+        static_cast<long long>(TICK_BENCH_INTERVAL.count()), static_cast<long long>(TICK_BENCH_TICK_WORK.count()), expectedTicks);
+
+    // sleep_for 반복 (기존 방식)
+    uint64_t sleepTicks = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < TICK_BENCH_DRIFT_DURATION)
+    {
+        BusyWork(TICK_BENCH_TICK_WORK);
+        ++sleepTicks;
+        std::this_thread::sleep_for(TICK_BENCH_INTERVAL);
+    }
+
+    // 고정 간격 스케줄러
+    CTickScheduler scheduler(TICK_BENCH_INTERVAL);
+    scheduler.Start();
+    start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < TICK_BENCH_DRIFT_DURATION)
+    {
+        scheduler.WaitAndRunTicks([] { BusyWork(TICK_BENCH_TICK_WORK); });
+    }
+    TickStats stats = scheduler.TakeStats();
+
+    std::printf("%-12s %8llu ticks\n", "sleep_for", static_cast<unsigned long long>(sleepTicks));
+    std::printf("%-12s %8llu ticks (jitter avg %lld us, max %lld us, overruns %llu)\n", "scheduler",
+        static_cast<unsigned long long>(stats.ticks), static_cast<long long>(stats.avgJitterUs),
+        static_cast<long long>(stats.maxJitterUs), static_cast<unsigned long long>(stats.overruns));
+
+    std::printf("\n[Lobby flood] %zu lobby events (%lld us each) + 1 game event every %lld ms for 1 s, %lld ms tick with %lld ms work\n\n",
+        TICK_BENCH_FLOOD_LOBBY_PER_GAP, static_cast<long long>(TICK_BENCH_LOBBY_WORK.count()), static_cast<long long>(TICK_BENCH_EVENT_GAP.count()),
+        static_cast<long long>(TICK_BENCH_INTERVAL.count()), static_cast<long long>(TICK_BENCH_FLOOD_TICK_WORK.count()));
+    std::printf("%-10s %7s %8s %13s %12s %12s %12s %8s\n", "mode", "ticks", "skipped", "max jitter us", "game p99 us", "game max us", "game done", "lobby");
+    std::printf("%s\n", std::string(89, '-').c_str());
+
+    for (bool budgeted : { false, true })
+    {
+        FloodResult result = RunFlood(budgeted);
+        char gameDone[32];
+        std::snprintf(gameDone, sizeof(gameDone), "%zu/%zu", result.gameHandled, result.gameSent);
+        std::printf("%-10s %7llu %8llu %13lld %12.0f %12.0f %12s %8zu\n", budgeted ? "budgeted" : "drain",
+            static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.skippedTicks),
+            static_cast<long long>(result.maxJitterUs), result.gameP99Us, result.gameMaxUs, gameDone, result.lobbyHandled);
+    }
+}
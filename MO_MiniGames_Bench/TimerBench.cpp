@@ -0,0 +1,188 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "TimerWheel.h"
+
+// 타이머 휠 vs 정렬 컨테이너
+// 방 10000개 x 타이머 4개가 걸려 있는 상태에서 "타이머 하나 취소 + 새로 걸기"를 반복하고 ops마다 1틱씩 진행
+// (잠수 검사 재설정, 라운드 타이머 교체 같은 패턴)
+//  - wheel   : CTimerWheel
+//  - pq lazy : std::priority_queue + 취소는 세대 번호로 표시만 (만료 때 버림, 큐에는 남음)
+//  - set     : std::set<(만료 틱, id)> + 취소 시 실제 삭제
+
+namespace
+{
+    constexpr size_t TIMER_BENCH_LIVE = 40000;
+    constexpr size_t TIMER_BENCH_OPS_PER_TICK = 40;
+    constexpr uint32_t TIMER_BENCH_MAX_DELAY = 3000; // 20ms 틱이면 1분
+
+    struct TimerBenchResult
+    {
+        double nsPerOp;
+        double allocsPerOp;
+        uint64_t expired;
+    };
+
+    template <typename Func>
+    TimerBenchResult MeasureTimerOps(size_t iterations, Func&& op)
+    {
+        uint64_t allocsBefore = g_benchHeapAllocs;
+        auto start = std::chrono::steady_clock::now();
+        uint64_t expired = 0;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            expired += op(i);
+        }
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        uint64_t allocs = g_benchHeapAllocs - allocsBefore;
+        return TimerBenchResult{ ns / iterations, static_cast<double>(allocs) / iterations, expired };
+    }
+}
+
+void RunTimerWheelBench(size_t iterations)
+{
+    std::printf("[Timer service] %zu live timers, cancel + schedule per op, 1 tick per %zu ops, %zu ops\n\n",
+        TIMER_BENCH_LIVE, TIMER_BENCH_OPS_PER_TICK, iterations);
+    std::printf("%-10s %12s %14s %12s\n", "container", "ns/op", "allocs/op", "expired");
+    std::printf("%s\n", std::string(52, '-').c_str());
+
+    // 모든 방식이 같은 지연 값 순서를 쓰도록 미리 만들어 둠
+    std::mt19937 rng(7);
+    std::vector<uint32_t> delays(TIMER_BENCH_LIVE + iterations);
+    std::vector<uint32_t> victims(iterations);
+    for (uint32_t& delay : delays)
+    {
+        delay = 1 + rng() % TIMER_BENCH_MAX_DELAY;
+    }
+    for (uint32_t& victim : victims)
+    {
+        victim = rng() % TIMER_BENCH_LIVE;
+    }
+
+    // wheel
+    {
+        CTimerWheel wheel(TIMER_BENCH_LIVE * 2);
+        std::vector<TimerHandle> handles(TIMER_BENCH_LIVE);
+        TimerEvent event;
+        event.type = TimerType::PLAYER_AFK_CHECK;
+        for (size_t i = 0; i < TIMER_BENCH_LIVE; ++i)
+        {
+            event.param = static_cast<uint32_t>(i);
+            handles[i] = wheel.Schedule(delays[i], event);
+        }
+
+        TimerBenchResult result = MeasureTimerOps(iterations, [&](size_t i)
+        {
+            uint32_t victim = victims[i];
+            wheel.Cancel(handles[victim]);
+            event.param = victim;
+            handles[victim] = wheel.Schedule(delays[TIMER_BENCH_LIVE + i], event);
+
+            if ((i % TIMER_BENCH_OPS_PER_TICK) != 0)
+            {
+                return static_cast<uint64_t>(0);
+            }
+
+            // 만료된 타이머는 다시 걸어서 살아있는 수를 유지
+            return static_cast<uint64_t>(wheel.Advance(1, [&](const TimerEvent& expired)
+            {
+                handles[expired.param] = wheel.Schedule(delays[(expired.param + i) % delays.size()], expired);
+            }));
+        });
+        std::printf("%-10s %12.1f %14.3f %12llu\n", "wheel", result.nsPerOp, result.allocsPerOp, static_cast<unsigned long long>(result.expired));
+    }
+
+    // priority_queue + 지연 취소
+    {
+        struct Entry
+        {
+            uint64_t expireTick;
+            uint32_t id;
+            uint32_t generation;
+            bool operator>(const Entry& other) const { return expireTick > other.expireTick; }
+        };
+
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::vector<uint32_t> generations(TIMER_BENCH_LIVE, 0);
+        uint64_t now = 0;
+        for (size_t i = 0; i < TIMER_BENCH_LIVE; ++i)
+        {
+            queue.push(Entry{ now + delays[i], static_cast<uint32_t>(i), 0 });
+        }
+
+        TimerBenchResult result = MeasureTimerOps(iterations, [&](size_t i)
+        {
+            uint32_t victim = victims[i];
+            ++generations[victim];
+            queue.push(Entry{ now + delays[TIMER_BENCH_LIVE + i], victim, generations[victim] });
+
+            if ((i % TIMER_BENCH_OPS_PER_TICK) != 0)
+            {
+                return static_cast<uint64_t>(0);
+            }
+
+            ++now;
+            uint64_t expired = 0;
+            while (!queue.empty() && queue.top().expireTick <= now)
+            {
+                Entry entry = queue.top();
+                queue.pop();
+                if (entry.generation != generations[entry.id])
+                {
+                    continue; // 취소된 항목
+                }
+
+                ++expired;
+                queue.push(Entry{ now + delays[(entry.id + i) % delays.size()], entry.id, entry.generation });
+            }
+            return expired;
+        });
+        std::printf("%-10s %12.1f %14.3f %12llu\n", "pq lazy", result.nsPerOp, result.allocsPerOp, static_cast<unsigned long long>(result.expired));
+    }
+
+    // set + 실제 삭제
+    {
+        std::set<std::pair<uint64_t, uint32_t>> timers;
+        std::vector<uint64_t> expireTicks(TIMER_BENCH_LIVE);
+        uint64_t now = 0;
+        for (size_t i = 0; i < TIMER_BENCH_LIVE; ++i)
+        {
+            expireTicks[i] = now + delays[i];
+            timers.emplace(expireTicks[i], static_cast<uint32_t>(i));
+        }
+
+        TimerBenchResult result = MeasureTimerOps(iterations, [&](size_t i)
+        {
+            uint32_t victim = victims[i];
+            timers.erase({ expireTicks[victim], victim });
+            expireTicks[victim] = now + delays[TIMER_BENCH_LIVE + i];
+            timers.emplace(expireTicks[victim], victim);
+
+            if ((i % TIMER_BENCH_OPS_PER_TICK) != 0)
+            {
+                return static_cast<uint64_t>(0);
+            }
+
+            ++now;
+            uint64_t expired = 0;
+            while (!timers.empty() && timers.begin()->first <= now)
+            {
+                uint32_t id = timers.begin()->second;
+                timers.erase(timers.begin());
+                ++expired;
+                expireTicks[id] = now + delays[(id + i) % delays.size()];
+                timers.emplace(expireTicks[id], id);
+            }
+            return expired;
+        });
+        std::printf("%-10s %12.1f %14.3f %12llu\n", "set", result.nsPerOp, result.allocsPerOp, static_cast<unsigned long long>(result.expired));
+    }
+}
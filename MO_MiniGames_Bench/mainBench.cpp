@@ -0,0 +1,156 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Bench.h"
+#include "AsyncLogger.h"
+
+// __________________________________________________________________
+//
+// MO_MiniGames 벤치마크
+// 사용법: MO_MiniGames_Bench.exe [all|codec|room|session|shard|actor|tick|timer|tetris|lockstep|board|spectate|replay] [반복 횟수]
+// 와이어 포맷이나 자료구조를 바꿀 때 변경 전/후 수치를 커밋 메시지에 같이 남길 것.
+// __________________________________________________________________
+
+constexpr size_t DEFAULT_ITERATIONS = 1000000;
+
+volatile uint64_t g_benchSink = 0;
+std::atomic<uint64_t> g_benchHeapAllocs{ 0 };
+
+// 할당 횟수만 세고 실제 할당은 malloc에 맡김 (shard 벤치는 여러 스레드에서 호출)
+void* operator new(size_t size)
+{
+    g_benchHeapAllocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* target = (argc > 1) ? argv[1] : "all";
+
+    size_t iterations = DEFAULT_ITERATIONS;
+    if (argc > 2)
+    {
+        long long value = std::atoll(argv[2]);
+        if (value > 0)
+        {
+            iterations = static_cast<size_t>(value);
+        }
+    }
+
+    // 벤치 대상 코드의 경고/에러 로그 출력용
+    CAsyncLogger::Get().Start();
+
+    bool all = std::strcmp(target, "all") == 0;
+    bool ran = false;
+
+    if (all || std::strcmp(target, "codec") == 0)
+    {
+        RunCodecBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "room") == 0)
+    {
+        RunRoomManagerBench();
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "session") == 0)
+    {
+        RunSessionTableBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "shard") == 0)
+    {
+        RunShardBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "actor") == 0)
+    {
+        RunActorBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "tick") == 0)
+    {
+        RunTickBench();
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "timer") == 0)
+    {
+        RunTimerWheelBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "tetris") == 0)
+    {
+        RunTetrisBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "lockstep") == 0)
+    {
+        RunLockstepBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "board") == 0)
+    {
+        RunBoardStreamBench(iterations);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "spectate") == 0)
+    {
+        RunSpectatorBench();
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (all || std::strcmp(target, "replay") == 0)
+    {
+        RunReplayBench();
+        std::printf("\n");
+        ran = true;
+    }
+
+    CAsyncLogger::Get().Stop();
+
+    if (!ran)
+    {
+        std::printf("Unknown bench: %s (all|codec|room|session|shard|actor|tick|timer|tetris|lockstep|board|spectate|replay)\n", target);
+        return 1;
+    }
+
+    std::printf("(sink: %llu)\n", static_cast<unsigned long long>(g_benchSink));
+    return 0;
+}
@@ -4,11 +4,18 @@
 #include <cstring>
 #include <iostream>
 
+// 수신 버퍼 (MsgHeader::size 최대값이 들어가는 크기)
+constexpr size_t RECV_BUFFER_SIZE = 65536;
+
+// 응답을 이 시간 넘게 기다린 요청은 요청 테이블에서 지움
+constexpr std::chrono::seconds PENDING_REQUEST_TIMEOUT(10);
+
 CClientNetwork::CClientNetwork()
     : _socket(INVALID_SOCKET)
     , _connected(false)
     , _running(false)
     , _gameInstance(nullptr)
+    , _nextRequestId(REQUEST_ID_NONE + 1)
 {
 }
 
@@ -84,16 +91,24 @@ void CClientNetwork::Disconnect()
 
     WSACleanup();
 
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingRequests.clear();
+    }
+
     std::wcout << L"\nDisconnected from server." << std::endl;
 }
 
 void CClientNetwork::RecvThread()
 {
-    char buffer[4096];
+    // TCP는 패킷 경계가 없으므로 받은 바이트를 이어 붙여 헤더 size 단위로 잘라 처리
+    // (게임 중에는 작은 프레임 패킷이 연달아 와서 recv 한 번에 여러 개가 붙어 옴)
+    std::vector<char> buffer(RECV_BUFFER_SIZE);
+    size_t buffered = 0;
 
     while (_running && _connected)
     {
-        int bytesReceived = recv(_socket, buffer, sizeof(buffer), 0);
+        int bytesReceived = recv(_socket, buffer.data() + buffered, static_cast<int>(buffer.size() - buffered), 0);
 
         if (bytesReceived <= 0)
         {
@@ -106,7 +121,36 @@ void CClientNetwork::RecvThread()
             break;
         }
 
-        HandleServerMessage(buffer, bytesReceived);
+        buffered += static_cast<size_t>(bytesReceived);
+
+        size_t offset = 0;
+        while (buffered - offset >= sizeof(MsgHeader))
+        {
+            const MsgHeader* header = reinterpret_cast<const MsgHeader*>(buffer.data() + offset);
+            if (header->size < sizeof(MsgHeader))
+            {
+                // 이후 바이트의 경계를 알 수 없으므로 연결을 끊음
+                std::wcerr << L"\nInvalid message size, closing connection." << std::endl;
+                _connected = false;
+                _running = false;
+                return;
+            }
+
+            if (buffered - offset < header->size)
+            {
+                break; // 나머지는 다음 recv에서
+            }
+
+            HandleServerMessage(buffer.data() + offset, header->size);
+            offset += header->size;
+        }
+
+        // 처리하지 못한 조각을 앞으로
+        if (offset > 0)
+        {
+            std::memmove(buffer.data(), buffer.data() + offset, buffered - offset);
+            buffered -= offset;
+        }
     }
 }
 
@@ -127,48 +171,311 @@ bool CClientNetwork::SendPacket(const char* data, size_t length)
     return true;
 }
 
-void CClientNetwork::RequestRoomList()
+uint32_t CClientNetwork::AddPendingRequest(PendingRequest&& request)
+{
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+
+    uint32_t requestId = _nextRequestId++;
+    if (_nextRequestId == REQUEST_ID_NONE)
+    {
+        _nextRequestId = REQUEST_ID_NONE + 1; // 한 바퀴 돈 경우 0은 건너뜀
+    }
+
+    request.sentTime = std::chrono::steady_clock::now();
+    _pendingRequests[requestId] = std::move(request);
+    return requestId;
+}
+
+bool CClientNetwork::TakePendingRequest(uint32_t requestId, PendingRequest& outRequest)
+{
+    if (requestId == REQUEST_ID_NONE)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    auto it = _pendingRequests.find(requestId);
+    if (it == _pendingRequests.end())
+    {
+        return false;
+    }
+
+    outRequest = std::move(it->second);
+    _pendingRequests.erase(it);
+    return true;
+}
+
+void CClientNetwork::RemovePendingRequest(uint32_t requestId)
+{
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    _pendingRequests.erase(requestId);
+}
+
+size_t CClientNetwork::ExpirePendingRequests()
+{
+    // 서버가 응답하지 않은 요청 (응답 전에 방이 사라졌거나 응답이 유실된 경우)이 테이블에 계속 쌓이지 않도록 정리
+    auto expireTime = std::chrono::steady_clock::now() - PENDING_REQUEST_TIMEOUT;
+    size_t expired = 0;
+
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    for (auto it = _pendingRequests.begin(); it != _pendingRequests.end();)
+    {
+        if (it->second.sentTime < expireTime)
+        {
+            it = _pendingRequests.erase(it);
+            ++expired;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return expired;
+}
+
+size_t CClientNetwork::GetPendingRequestCount() const
 {
-    MsgHeader header;
-    header.size = sizeof(MsgHeader);
-    header.type = MsgType::C2S_REQUEST_ROOM_LIST;
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    return _pendingRequests.size();
+}
+
+uint32_t CClientNetwork::RequestRoomList()
+{
+    PendingRequest request;
+    request.type = MsgType::C2S_REQUEST_ROOM_LIST;
+
+    MSG_C2S_REQUEST_ROOM_LIST msg;
+    msg.header.size = sizeof(MSG_C2S_REQUEST_ROOM_LIST);
+    msg.header.type = MsgType::C2S_REQUEST_ROOM_LIST;
+    msg.requestId = AddPendingRequest(std::move(request));
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
 
-    SendPacket(reinterpret_cast<const char*>(&header), sizeof(header));
     std::wcout << L"Requesting room list..." << std::endl;
+    return msg.requestId;
 }
 
-void CClientNetwork::RequestCreateRoom(const std::string& title, int32_t maxPlayers)
+uint32_t CClientNetwork::RequestRoomPage(int32_t cursor, uint16_t pageSize, uint8_t filterFlags,
+    uint8_t status, uint8_t minFreeSlots, const std::string& titlePrefix)
 {
+    PendingRequest request;
+    request.type = MsgType::C2S_REQUEST_ROOM_PAGE;
+
+    // 접두어는 길이 + 바이트로만 보냄 (접두어가 없으면 1바이트)
+    char buffer[ROOM_PAGE_REQUEST_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+
+    MSG_C2S_REQUEST_ROOM_PAGE msg;
+    msg.requestId = AddPendingRequest(std::move(request));
+    msg.cursor = cursor;
+    msg.pageSize = pageSize;
+    msg.filterFlags = filterFlags;
+    msg.status = status;
+    msg.minFreeSlots = minFreeSlots;
+    msg.titlePrefix = titlePrefix;
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::C2S_REQUEST_ROOM_PAGE;
+
+    if (!SendPacket(buffer, writer.GetSize()))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+
+    std::wcout << L"Requesting room page..." << std::endl;
+    return msg.requestId;
+}
+
+uint32_t CClientNetwork::RequestCreateRoom(const std::string& title, int32_t maxPlayers)
+{
+    // 응답(S2C_ROOM_CREATED)에는 roomId만 오므로 제목/인원은 요청 테이블에 보관
+    PendingRequest request;
+    request.type = MsgType::C2S_CREATE_ROOM;
+    request.title = title;
+    request.maxPlayers = maxPlayers;
+
+    char buffer[sizeof(MsgHeader) + MAX_VARINT32_SIZE * 3 + ROOM_TITLE_MAX_LEN];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+
     MSG_C2S_CREATE_ROOM msg;
-    msg.header.size = sizeof(MSG_C2S_CREATE_ROOM);
-    msg.header.type = MsgType::C2S_CREATE_ROOM;
-    strncpy_s(msg.title, title.c_str(), sizeof(msg.title) - 1);
-    msg.title[sizeof(msg.title) - 1] = '\0';
+    msg.requestId = AddPendingRequest(std::move(request));
+    msg.title = title;
     msg.maxPlayers = maxPlayers;
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::C2S_CREATE_ROOM;
+
+    if (!SendPacket(buffer, writer.GetSize()))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
 
-    SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg));
     std::wcout << L"Requesting to create room: " << title.c_str() << L" (Max: " << maxPlayers << L")" << std::endl;
+    return msg.requestId;
 }
 
-void CClientNetwork::RequestJoinRoom(int32_t roomId)
+uint32_t CClientNetwork::RequestQuickJoin(uint8_t maxPlayers)
 {
+    // 응답에 방 정보가 같이 오므로 요청 테이블에는 종류만 보관
+    PendingRequest request;
+    request.type = MsgType::C2S_QUICK_JOIN;
+    request.maxPlayers = maxPlayers;
+
+    MSG_C2S_QUICK_JOIN msg;
+    msg.header.size = sizeof(MSG_C2S_QUICK_JOIN);
+    msg.header.type = MsgType::C2S_QUICK_JOIN;
+    msg.requestId = AddPendingRequest(std::move(request));
+    msg.maxPlayers = maxPlayers;
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+
+    std::wcout << L"Requesting quick join..." << std::endl;
+    return msg.requestId;
+}
+
+uint32_t CClientNetwork::RequestJoinRoom(int32_t roomId)
+{
+    PendingRequest request;
+    request.type = MsgType::C2S_JOIN_ROOM;
+    request.roomId = roomId;
+
     MSG_C2S_JOIN_ROOM msg;
     msg.header.size = sizeof(MSG_C2S_JOIN_ROOM);
     msg.header.type = MsgType::C2S_JOIN_ROOM;
+    msg.requestId = AddPendingRequest(std::move(request));
     msg.roomId = roomId;
 
-    SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg));
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+
     std::wcout << L"Requesting to join room: " << roomId << std::endl;
+    return msg.requestId;
 }
 
-void CClientNetwork::RequestLeaveRoom()
+uint32_t CClientNetwork::RequestLeaveRoom()
 {
+    PendingRequest request;
+    request.type = MsgType::C2S_LEAVE_ROOM;
+
     MSG_C2S_LEAVE_ROOM msg;
     msg.header.size = sizeof(MSG_C2S_LEAVE_ROOM);
     msg.header.type = MsgType::C2S_LEAVE_ROOM;
+    msg.requestId = AddPendingRequest(std::move(request));
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
 
-    SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg));
     std::wcout << L"Requesting to leave room..." << std::endl;
+    return msg.requestId;
+}
+
+uint32_t CClientNetwork::RequestGameStart()
+{
+    PendingRequest request;
+    request.type = MsgType::C2S_GAME_START;
+
+    MSG_C2S_GAME_START msg;
+    msg.header.size = sizeof(MSG_C2S_GAME_START);
+    msg.header.type = MsgType::C2S_GAME_START;
+    msg.requestId = AddPendingRequest(std::move(request));
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+
+    std::wcout << L"Requesting game start..." << std::endl;
+    return msg.requestId;
+}
+
+uint32_t CClientNetwork::RequestSpectateRoom(int32_t roomId)
+{
+    PendingRequest request;
+    request.type = MsgType::C2S_SPECTATE_ROOM;
+    request.roomId = roomId;
+
+    MSG_C2S_SPECTATE_ROOM msg;
+    msg.header.size = sizeof(MSG_C2S_SPECTATE_ROOM);
+    msg.header.type = MsgType::C2S_SPECTATE_ROOM;
+    msg.requestId = AddPendingRequest(std::move(request));
+    msg.roomId = roomId;
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+
+    std::wcout << L"Requesting to spectate room: " << roomId << std::endl;
+    return msg.requestId;
+}
+
+uint32_t CClientNetwork::RequestStopSpectate()
+{
+    PendingRequest request;
+    request.type = MsgType::C2S_STOP_SPECTATE;
+
+    MSG_C2S_STOP_SPECTATE msg;
+    msg.header.size = sizeof(MSG_C2S_STOP_SPECTATE);
+    msg.header.type = MsgType::C2S_STOP_SPECTATE;
+    msg.requestId = AddPendingRequest(std::move(request));
+
+    if (!SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg)))
+    {
+        RemovePendingRequest(msg.requestId);
+        return REQUEST_ID_NONE;
+    }
+    return msg.requestId;
+}
+
+bool CClientNetwork::SendGameInput(uint32_t firstFrame, const uint8_t* inputs, uint8_t count)
+{
+    // 초당 수십 번 보내므로 요청 테이블 / 로그 없음
+    char buffer[GAME_INPUT_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+
+    MSG_C2S_GAME_INPUT msg;
+    msg.firstFrame = firstFrame;
+    msg.count = count;
+    msg.inputs = inputs;
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::C2S_GAME_INPUT;
+
+    return SendPacket(buffer, writer.GetSize());
+}
+
+bool CClientNetwork::SendGameTarget(GarbageTargetMode mode)
+{
+    MSG_C2S_GAME_TARGET msg;
+    msg.header.size = sizeof(MSG_C2S_GAME_TARGET);
+    msg.header.type = MsgType::C2S_GAME_TARGET;
+    msg.mode = static_cast<uint8_t>(mode);
+
+    return SendPacket(reinterpret_cast<const char*>(&msg), sizeof(msg));
 }
 
 void CClientNetwork::HandleServerMessage(const char* data, size_t length)
@@ -195,42 +502,171 @@ void CClientNetwork::HandleServerMessage(const char* data, size_t length)
     switch (header->type)
     {
     case MsgType::S2C_ROOM_LIST:
-        if (length >= sizeof(MSG_S2C_ROOM_LIST))
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_ROOM_LIST msg;
+        std::vector<RoomInfo> rooms;
+        if (msg.Decode(reader) && DecodeRoomInfos(reader, msg.roomCount, rooms))
         {
-            _gameInstance->OnRoomListReceived(reinterpret_cast<const MSG_S2C_ROOM_LIST*>(data), length);
+            PendingRequest request;
+            TakePendingRequest(msg.requestId, request); // 접속 직후 목록은 요청 없이 옴
+            _gameInstance->OnRoomListReceived(msg, rooms);
         }
         break;
+    }
 
     case MsgType::S2C_ROOM_CREATED:
         if (length >= sizeof(MSG_S2C_ROOM_CREATED))
         {
-            _gameInstance->OnRoomCreated(reinterpret_cast<const MSG_S2C_ROOM_CREATED*>(data));
+            auto msg = reinterpret_cast<const MSG_S2C_ROOM_CREATED*>(data);
+            PendingRequest request;
+            if (!TakePendingRequest(msg->requestId, request))
+            {
+                std::wcerr << L"Unknown requestId: " << msg->requestId << std::endl;
+            }
+            _gameInstance->OnRoomCreated(msg, request);
         }
         break;
 
     case MsgType::S2C_ROOM_JOINED:
         if (length >= sizeof(MSG_S2C_ROOM_JOINED))
         {
-            _gameInstance->OnRoomJoined(reinterpret_cast<const MSG_S2C_ROOM_JOINED*>(data));
+            auto msg = reinterpret_cast<const MSG_S2C_ROOM_JOINED*>(data);
+            PendingRequest request;
+            TakePendingRequest(msg->requestId, request);
+            _gameInstance->OnRoomJoined(msg);
         }
         break;
 
     case MsgType::S2C_ROOM_LEFT:
         if (length >= sizeof(MSG_S2C_ROOM_LEFT))
         {
-            _gameInstance->OnRoomLeft(reinterpret_cast<const MSG_S2C_ROOM_LEFT*>(data));
+            auto msg = reinterpret_cast<const MSG_S2C_ROOM_LEFT*>(data);
+            PendingRequest request;
+            TakePendingRequest(msg->requestId, request);
+            _gameInstance->OnRoomLeft(msg);
+        }
+        break;
+
+    case MsgType::S2C_QUICK_JOINED:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_QUICK_JOINED msg;
+        if (msg.Decode(reader))
+        {
+            PendingRequest request;
+            TakePendingRequest(msg.requestId, request);
+            _gameInstance->OnQuickJoined(msg);
+        }
+        break;
+    }
+
+    case MsgType::S2C_ROOM_PAGE:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_ROOM_PAGE msg;
+        std::vector<RoomInfo> rooms;
+        if (msg.Decode(reader) && DecodeRoomInfos(reader, msg.roomCount, rooms))
+        {
+            PendingRequest request;
+            TakePendingRequest(msg.requestId, request);
+            _gameInstance->OnRoomPageReceived(msg, rooms);
+        }
+        break;
+    }
+
+    case MsgType::S2C_GAME_STARTED:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_GAME_STARTED msg;
+        if (msg.Decode(reader))
+        {
+            PendingRequest request;
+            TakePendingRequest(msg.requestId, request); // 방장이 아니면 요청 없이 옴
+            _gameInstance->OnGameStarted(msg);
+        }
+        break;
+    }
+
+    case MsgType::S2C_GAME_FRAMES:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_GAME_FRAMES msg;
+        if (msg.Decode(reader))
+        {
+            _gameInstance->OnGameFrames(msg);
+        }
+        break;
+    }
+
+    case MsgType::S2C_GAME_OVER:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_GAME_OVER msg;
+        if (msg.Decode(reader))
+        {
+            _gameInstance->OnGameOver(msg);
+        }
+        break;
+    }
+
+    case MsgType::S2C_SPECTATE_STATE:
+        if (length >= sizeof(MSG_S2C_SPECTATE_STATE))
+        {
+            auto msg = reinterpret_cast<const MSG_S2C_SPECTATE_STATE*>(data);
+            PendingRequest request;
+            TakePendingRequest(msg->requestId, request); // 방이 없어지거나 입장해서 끝난 경우 요청 없이 옴
+            _gameInstance->OnSpectateState(msg);
         }
         break;
 
+    case MsgType::S2C_BOARD_STREAM:
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_BOARD_STREAM msg;
+        if (msg.Decode(reader))
+        {
+            _gameInstance->OnBoardStream(msg);
+        }
+        break;
+    }
+
     case MsgType::S2C_ERROR:
-        if (length >= sizeof(MSG_S2C_ERROR))
+    {
+        CMsgReader reader(data, header->size, sizeof(MsgHeader));
+        MSG_S2C_ERROR msg;
+        if (msg.Decode(reader))
         {
-            _gameInstance->OnError(reinterpret_cast<const MSG_S2C_ERROR*>(data));
+            // 에러는 같은 requestId의 본 응답과 함께 오므로 요청 테이블은 건드리지 않음
+            _gameInstance->OnError(msg);
         }
         break;
+    }
 
     default:
         std::wcerr << L"Unknown message type: " << static_cast<int>(header->type) << std::endl;
         break;
     }
+}
+
+bool CClientNetwork::DecodeRoomInfos(CMsgReader& reader, uint32_t roomCount, std::vector<RoomInfo>& outRooms)
+{
+    // roomCount를 그대로 믿지 않고 남은 바이트로 상한 체크 (RoomInfo 최소 5바이트)
+    if (roomCount > reader.GetRemainSize() / 5)
+    {
+        std::wcerr << L"Invalid room count" << std::endl;
+        return false;
+    }
+
+    outRooms.resize(roomCount);
+    for (auto& room : outRooms)
+    {
+        if (!room.Decode(reader))
+        {
+            std::wcerr << L"Invalid room info" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
 }
\ No newline at end of file
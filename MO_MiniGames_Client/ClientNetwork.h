@@ -6,13 +6,27 @@
 #define NOMINMAX
 #include <Windows.h>
 #include <string>
+#include <vector>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <chrono>
 #include <functional>
+#include <unordered_map>
 
 #pragma comment(lib, "ws2_32.lib")
 
-class CGameInstance; //  
+class CGameInstance; // 전방 선언
+
+// 응답을 기다리는 요청 (응답에는 requestId만 오므로 요청 당시 정보를 여기에 보관)
+struct PendingRequest
+{
+    MsgType type = MsgType::S2C_ERROR;
+    int32_t roomId = -1;
+    std::string title;
+    int32_t maxPlayers = 0;
+    std::chrono::steady_clock::time_point sentTime;
+};
 
 class CClientNetwork
 {
@@ -24,30 +38,62 @@ public:
     void Disconnect();
     bool IsConnected() const { return _connected; }
 
-    // Ŷ 
+    // 패킷 전송
     bool SendPacket(const char* data, size_t length);
 
-    //  û 
-    void RequestRoomList();
-    void RequestCreateRoom(const std::string& title, int32_t maxPlayers);
-    void RequestJoinRoom(int32_t roomId);
-    void RequestLeaveRoom();
+    // 서버로 요청 전송 (반환값: requestId, 응답을 기다리지 않고 연달아 보낼 수 있음)
+    // 전송에 실패하면 요청 테이블에서 지우고 REQUEST_ID_NONE
+    uint32_t RequestRoomList();
+    uint32_t RequestRoomPage(int32_t cursor, uint16_t pageSize, uint8_t filterFlags,
+        uint8_t status, uint8_t minFreeSlots, const std::string& titlePrefix);
+    uint32_t RequestCreateRoom(const std::string& title, int32_t maxPlayers);
+    uint32_t RequestJoinRoom(int32_t roomId);
+    uint32_t RequestLeaveRoom();
+    uint32_t RequestQuickJoin(uint8_t maxPlayers); // maxPlayers 0: 인원 상관없음
+    uint32_t RequestGameStart();
+    uint32_t RequestSpectateRoom(int32_t roomId);
+    uint32_t RequestStopSpectate();
+
+    // 프레임 입력 (게임 중 몇 프레임마다, 응답 없음)
+    bool SendGameInput(uint32_t firstFrame, const uint8_t* inputs, uint8_t count);
+
+    // 공격 대상 고르기 방식 변경 (게임 중, 응답 없음)
+    bool SendGameTarget(GarbageTargetMode mode);
+
+    // 응답 대기 중인 요청 수
+    size_t GetPendingRequestCount() const;
 
-    // GameInstance  (Ŷ ڵ鷯 ݹ)
+    // 응답이 오지 않고 오래된 요청 정리 (메인 루프에서 주기적으로 호출). 반환값은 지운 개수
+    size_t ExpirePendingRequests();
+
+    // GameInstance 설정 (패킷 핸들러 콜백용)
     void SetGameInstance(CGameInstance* instance) { _gameInstance = instance; }
 
 private:
-    //  
+    // 수신 스레드
     void RecvThread();
 
-    //   ó
+    // 서버 응답 처리
     void HandleServerMessage(const char* data, size_t length);
 
+    // 요청 테이블 (송신 전에 등록, 응답 수신 시 꺼냄)
+    uint32_t AddPendingRequest(PendingRequest&& request);
+    bool TakePendingRequest(uint32_t requestId, PendingRequest& outRequest);
+    void RemovePendingRequest(uint32_t requestId); // 전송 실패한 요청
+
+    // 가변 길이 방 목록 디코딩 (RoomInfo.title은 수신 버퍼를 가리킴)
+    bool DecodeRoomInfos(CMsgReader& reader, uint32_t roomCount, std::vector<RoomInfo>& outRooms);
+
 private:
     SOCKET _socket;
     std::atomic<bool> _connected;
     std::atomic<bool> _running;
     std::thread _recvThread;
 
-    CGameInstance* _gameInstance; // Ŷ   ݹ
+    CGameInstance* _gameInstance; // 패킷 수신 시 콜백용
+
+    // requestId -> 요청 정보 (메인 스레드에서 등록, 수신 스레드에서 제거)
+    std::unordered_map<uint32_t, PendingRequest> _pendingRequests;
+    mutable std::mutex _pendingMutex;
+    uint32_t _nextRequestId;
 };
\ No newline at end of file
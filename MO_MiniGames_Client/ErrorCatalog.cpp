@@ -0,0 +1,52 @@
+﻿//
+#include "ErrorCatalog.h"
+#include <cstdio>
+
+// ErrorCode 순서 그대로 (인자는 args 순서대로 %d에 대응)
+static const wchar_t* const ERROR_TEXTS[] =
+{
+    L"Unknown error",                       // NONE
+    L"Invalid room parameters",             // INVALID_ROOM_PARAMS
+    L"Room title already exists",           // ROOM_TITLE_EXISTS
+    L"Failed to join created room (ID: %d)", // CREATED_ROOM_JOIN_FAILED
+    L"Room %d does not exist",              // ROOM_NOT_FOUND
+    L"Room %d is full (Max: %d)",           // ROOM_FULL
+    L"Already in room %d",                  // ALREADY_IN_ROOM
+    L"Not in a room",                       // NOT_IN_ROOM
+    L"Failed to join room %d",              // ROOM_JOIN_FAILED
+    L"Server room limit reached (Max: %d)", // ROOM_LIMIT_REACHED
+    L"Server is busy, please try again",    // SERVER_BUSY
+    L"Removed from room %d after %d s idle", // AFK_KICKED
+    L"Only the room owner can start the game", // NOT_ROOM_OWNER
+    L"Not enough players (%d/%d)",          // NOT_ENOUGH_PLAYERS
+    L"Room %d is already playing",          // GAME_IN_PROGRESS
+    L"No spectator slots left for room %d", // SPECTATOR_LIMIT
+};
+
+static_assert(sizeof(ERROR_TEXTS) / sizeof(ERROR_TEXTS[0]) == static_cast<size_t>(ErrorCode::COUNT),
+    "ERROR_TEXTS must match ErrorCode");
+
+std::wstring CErrorCatalog::Format(const MSG_S2C_ERROR& msg)
+{
+    int32_t args[ERROR_MAX_ARGS] = {};
+    for (uint8_t i = 0; i < msg.argCount && i < ERROR_MAX_ARGS; ++i)
+    {
+        args[i] = msg.args[i];
+    }
+
+    wchar_t buffer[256];
+    swprintf(buffer, sizeof(buffer) / sizeof(buffer[0]), GetText(msg.code), args[0], args[1]);
+    return buffer;
+}
+
+const wchar_t* CErrorCatalog::GetText(ErrorCode code)
+{
+    size_t index = static_cast<size_t>(code);
+    if (index >= static_cast<size_t>(ErrorCode::COUNT))
+    {
+        // 서버가 더 최신 버전인 경우
+        return L"Unknown error";
+    }
+
+    return ERROR_TEXTS[index];
+}
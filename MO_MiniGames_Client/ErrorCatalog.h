@@ -0,0 +1,15 @@
+﻿#pragma once
+
+#include "Protocol.h"
+#include <string>
+
+// 서버 에러 코드 -> 표시 문구 카탈로그 (클라 전용)
+// 서버는 ErrorCode와 인자만 보내고, 문구 조립은 여기서 한다.
+class CErrorCatalog
+{
+public:
+    static std::wstring Format(const MSG_S2C_ERROR& msg);
+
+private:
+    static const wchar_t* GetText(ErrorCode code);
+};
@@ -1,4 +1,5 @@
 ﻿#include "GameInstance.h"
+#include "ErrorCatalog.h"
 #include <iostream>
 #define NOMINMAX
 #include <Windows.h>
@@ -8,6 +9,10 @@
 
 CGameInstance::CGameInstance()
     : _running(false)
+    , _roomFilterFlags(ROOM_FILTER_NONE)
+    , _roomFilterMinFree(0)
+    , _nextRoomCursor(0)
+    , _refreshRoomView(true)
 {
 }
 
@@ -20,6 +25,7 @@ bool CGameInstance::Initialize()
 {
     _network.SetGameInstance(this); // 여기서 연결
     _room.SetNetwork(&_network);
+    _spectator.SetNetwork(&_network);
 
     // 콘솔 창 설정
     HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -87,15 +93,24 @@ void CGameInstance::Run()
     // 메인 루프
     while (_running && _network.IsConnected())
     {
-        if (_room.IsInRoom())
+        if (_room.IsPlaying())
+        {
+            ProcessGameInput();
+        }
+        else if (_room.IsInRoom())
         {
             ProcessRoomInput();
         }
+        else if (_spectator.IsWatching())
+        {
+            ProcessSpectateInput();
+        }
         else
         {
             ProcessLobbyInput();
         }
 
+        _network.ExpirePendingRequests();
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 }
@@ -111,37 +126,48 @@ bool CGameInstance::ConnectToServer(const std::string& serverIp, int port)
     return _network.Connect(serverIp, port);
 }
 
-void CGameInstance::OnRoomListReceived(const MSG_S2C_ROOM_LIST* msg, size_t msgSize)
+void CGameInstance::OnRoomListReceived(const MSG_S2C_ROOM_LIST& msg, const std::vector<RoomInfo>& rooms)
 {
     std::wcout << L"==================================" << std::endl;
-    std::wcout << L"ROOM LIST (Total: " << msg->roomCount << L" rooms)" << std::endl;
+    std::wcout << L"ROOM LIST (Total: " << msg.roomCount << L" rooms)" << std::endl;
     std::wcout << L"==================================" << std::endl;
 
-    if (msg->roomCount == 0)
+    if (rooms.empty())
     {
         std::wcout << L"No rooms available." << std::endl;
         std::wcout << L"==================================" << std::endl;
         return;
     }
 
-    const RoomInfo* roomInfoArray = reinterpret_cast<const RoomInfo*>(
-        reinterpret_cast<const char*>(msg) + sizeof(MSG_S2C_ROOM_LIST));
+    _room.DisplayRoomList(rooms);
+}
+
+void CGameInstance::OnRoomPageReceived(const MSG_S2C_ROOM_PAGE& msg, const std::vector<RoomInfo>& rooms)
+{
+    _nextRoomCursor = msg.nextCursor;
+
+    std::wcout << L"==================================" << std::endl;
+    std::wcout << L"ROOM LIST (" << msg.roomCount << L" rooms"
+               << (msg.nextCursor != 0 ? L", more available)" : L")") << std::endl;
+    std::wcout << L"==================================" << std::endl;
 
-    std::vector<RoomInfo> rooms;
-    for (int32_t i = 0; i < msg->roomCount; ++i)
+    if (rooms.empty())
     {
-        rooms.push_back(roomInfoArray[i]);
+        std::wcout << L"No rooms on this page." << std::endl;
+    }
+    else
+    {
+        _room.DisplayRoomList(rooms);
     }
-
-    _room.DisplayRoomList(rooms);
 }
 
-void CGameInstance::OnRoomCreated(const MSG_S2C_ROOM_CREATED* msg)
+void CGameInstance::OnRoomCreated(const MSG_S2C_ROOM_CREATED* msg, const PendingRequest& request)
 {
     std::wcout << L"\n==================================" << std::endl;
     if (msg->success)
     {
-        _room.OnRoomCreated(msg->roomId);
+        _room.OnRoomCreated(msg->roomId, request.title, request.maxPlayers);
+        _refreshRoomView = true;
         std::wcout << L"Room created successfully!" << std::endl;
         std::wcout << L"Room ID: " << msg->roomId << std::endl;
     }
@@ -158,6 +184,7 @@ void CGameInstance::OnRoomJoined(const MSG_S2C_ROOM_JOINED* msg)
     if (msg->success)
     {
         _room.OnRoomJoined(msg->roomId);
+        _refreshRoomView = true;
         std::wcout << L"Joined room successfully!" << std::endl;
         std::wcout << L"Room ID: " << msg->roomId << std::endl;
     }
@@ -168,6 +195,24 @@ void CGameInstance::OnRoomJoined(const MSG_S2C_ROOM_JOINED* msg)
     std::wcout << L"==================================" << std::endl;
 }
 
+void CGameInstance::OnQuickJoined(const MSG_S2C_QUICK_JOINED& msg)
+{
+    std::wcout << L"\n==================================" << std::endl;
+    if (msg.result != QuickJoinResult::FAILED)
+    {
+        _room.OnRoomJoined(msg.room.roomId, std::string(msg.room.title), msg.room.maxPlayers);
+        _refreshRoomView = true;
+        std::wcout << ((msg.result == QuickJoinResult::CREATED) ? L"Created a new room and joined!" : L"Joined room successfully!") << std::endl;
+        std::wcout << L"Room ID: " << msg.room.roomId
+                   << L" (" << msg.room.currentPlayers << L"/" << msg.room.maxPlayers << L")" << std::endl;
+    }
+    else
+    {
+        std::wcout << L"Quick join failed." << std::endl;
+    }
+    std::wcout << L"==================================" << std::endl;
+}
+
 void CGameInstance::OnRoomLeft(const MSG_S2C_ROOM_LEFT* msg)
 {
     std::wcout << L"\n==================================" << std::endl;
@@ -183,13 +228,47 @@ void CGameInstance::OnRoomLeft(const MSG_S2C_ROOM_LEFT* msg)
     std::wcout << L"==================================" << std::endl;
 }
 
-void CGameInstance::OnError(const MSG_S2C_ERROR* msg)
+void CGameInstance::OnError(const MSG_S2C_ERROR& msg)
 {
     std::wcout << L"\n==================================" << std::endl;
-    std::wcout << L"[ERROR] " << msg->message << std::endl;
+    std::wcout << L"[ERROR] " << CErrorCatalog::Format(msg) << std::endl;
     std::wcout << L"==================================" << std::endl;
 }
 
+void CGameInstance::OnGameStarted(const MSG_S2C_GAME_STARTED& msg)
+{
+    // 화면은 메인 스레드의 게임 루프가 그림
+    _room.OnGameStarted(msg);
+}
+
+void CGameInstance::OnGameFrames(const MSG_S2C_GAME_FRAMES& msg)
+{
+    _room.OnGameFrames(msg);
+}
+
+void CGameInstance::OnGameOver(const MSG_S2C_GAME_OVER& msg)
+{
+    // 방 밖에서는 관전 중인 방의 게임 종료
+    if (!_room.IsInRoom())
+    {
+        _spectator.OnGameOver(msg);
+        return;
+    }
+
+    _room.OnGameOver(msg);
+    _refreshRoomView = true;
+}
+
+void CGameInstance::OnSpectateState(const MSG_S2C_SPECTATE_STATE* msg)
+{
+    _spectator.OnSpectateState(msg);
+}
+
+void CGameInstance::OnBoardStream(const MSG_S2C_BOARD_STREAM& msg)
+{
+    _spectator.OnBoardStream(msg);
+}
+
 int CGameInstance::ShowMainMenuWithSelection()
 {
     int selectedIndex = 0; // 0: Single, 1: Multi, 2: Exit
@@ -282,6 +361,10 @@ void CGameInstance::ShowLobbyMenu()
     std::wcout << L"[1] View Room List" << std::endl;
     std::wcout << L"[2] Create Room" << std::endl;
     std::wcout << L"[3] Join Room" << std::endl;
+    std::wcout << L"[4] Next Page" << std::endl;
+    std::wcout << L"[5] Room Filter" << std::endl;
+    std::wcout << L"[6] Quick Join" << std::endl;
+    std::wcout << L"[7] Spectate Room" << std::endl;
     std::wcout << L"[0] Disconnect" << std::endl;
     std::wcout << L"==================================" << std::endl;
     std::wcout << L"Select: ";
@@ -305,7 +388,7 @@ void CGameInstance::ProcessLobbyInput()
     switch (choice)
     {
     case 1:
-        _network.RequestRoomList();
+        RequestRoomPage(0);
         break;
     case 2:
     {
@@ -319,7 +402,7 @@ void CGameInstance::ProcessLobbyInput()
         std::wcout << L"Enter max players (2-10): ";
         std::wcin >> maxPlayers;
 
-        if (maxPlayers < 2 || maxPlayers > 10)
+        if (maxPlayers < ROOM_MIN_PLAYERS || maxPlayers > ROOM_MAX_PLAYERS)
         {
             std::wcout << L"Invalid max players. Must be between 2 and 10." << std::endl;
             break;
@@ -337,6 +420,46 @@ void CGameInstance::ProcessLobbyInput()
         _room.RequestJoinRoom(roomId);
         break;
     }
+    case 4:
+    {
+        int32_t cursor = _nextRoomCursor;
+        if (cursor == 0)
+        {
+            std::wcout << L"No more rooms." << std::endl;
+            break;
+        }
+        RequestRoomPage(cursor);
+        break;
+    }
+    case 5:
+        // 필터 입력에서 줄 단위로 읽었으므로 아래 ignore를 거치지 않고 반환
+        EditRoomFilter();
+        RequestRoomPage(0);
+        return;
+    case 6:
+    {
+        int32_t maxPlayers;
+        std::wcout << L"Enter max players (0: any, " << ROOM_MIN_PLAYERS << L"-" << ROOM_MAX_PLAYERS << L"): ";
+        std::wcin >> maxPlayers;
+
+        if (maxPlayers != 0 && (maxPlayers < ROOM_MIN_PLAYERS || maxPlayers > ROOM_MAX_PLAYERS))
+        {
+            std::wcout << L"Invalid max players." << std::endl;
+            break;
+        }
+
+        _room.RequestQuickJoin(static_cast<uint8_t>(maxPlayers));
+        break;
+    }
+    case 7:
+    {
+        int32_t roomId;
+        std::wcout << L"Enter room ID: ";
+        std::wcin >> roomId;
+
+        _spectator.RequestSpectateRoom(roomId);
+        break;
+    }
     case 0:
         std::wcout << L"Disconnecting..." << std::endl;
         _running = false;
@@ -350,27 +473,69 @@ void CGameInstance::ProcessLobbyInput()
     std::wcin.ignore(10000, L'\n');
 }
 
-void CGameInstance::ProcessRoomInput()
+void CGameInstance::RequestRoomPage(int32_t cursor)
 {
-    _room.DisplayRoomView();
+    _network.RequestRoomPage(cursor, ROOM_PAGE_DEFAULT_SIZE, _roomFilterFlags,
+        static_cast<uint8_t>(0), _roomFilterMinFree, _roomFilterTitlePrefix);
+}
 
-    int choice;
-    std::wcin >> choice;
+void CGameInstance::EditRoomFilter()
+{
+    std::wstring input;
+    std::wcin.ignore();
 
-    if (std::wcin.fail())
+    _roomFilterFlags = ROOM_FILTER_NONE;
+    _roomFilterMinFree = 0;
+    _roomFilterTitlePrefix.clear();
+
+    std::wcout << L"Joinable rooms only? (y/N): ";
+    std::getline(std::wcin, input);
+    if (input == L"y" || input == L"Y")
+    {
+        _roomFilterFlags |= ROOM_FILTER_JOINABLE;
+    }
+
+    std::wcout << L"Minimum free slots (0-9, default: 0): ";
+    std::getline(std::wcin, input);
+    if (!input.empty() && input[0] >= L'1' && input[0] <= L'9')
+    {
+        _roomFilterFlags |= ROOM_FILTER_MIN_FREE;
+        _roomFilterMinFree = static_cast<uint8_t>(input[0] - L'0');
+    }
+
+    std::wcout << L"Title prefix (empty: any): ";
+    std::getline(std::wcin, input);
+    if (!input.empty())
+    {
+        _roomFilterFlags |= ROOM_FILTER_TITLE_PREFIX;
+        _roomFilterTitlePrefix.assign(input.begin(), input.end());
+    }
+}
+
+void CGameInstance::ProcessRoomInput()
+{
+    if (_refreshRoomView.exchange(false))
+    {
+        _room.DisplayRoomView();
+    }
+
+    if (!_kbhit())
     {
-        std::wcin.clear();
-        std::wcin.ignore(10000, L'\n');
-        std::wcout << L"Invalid input. Please enter a number." << std::endl;
         return;
     }
 
-    switch (choice)
+    int key = _getch();
+    std::wcout << static_cast<wchar_t>(key) << std::endl;
+
+    switch (key)
     {
-    case 1:
+    case L'1':
         _room.RequestLeaveRoom();
         break;
-    case 0:
+    case L'2':
+        _room.RequestGameStart();
+        break;
+    case L'0':
         std::wcout << L"Disconnecting..." << std::endl;
         _running = false;
         break;
@@ -379,6 +544,118 @@ void CGameInstance::ProcessRoomInput()
         break;
     }
 
-    std::wcin.clear();
-    std::wcin.ignore(10000, L'\n');
+    _refreshRoomView = true;
+}
+
+void CGameInstance::ProcessGameInput()
+{
+    // 키 입력은 프레임 입력 비트로 모았다가 프레임마다 CRoom::UpdateGame에서 보냄
+    // 보드는 서버가 확정한 프레임이 올 때만 진행하므로 여기서는 입력과 화면만
+    const auto frameInterval = std::chrono::microseconds(1000000 / TETRIS_FRAME_RATE);
+    const auto renderInterval = std::chrono::milliseconds(100);
+
+    CTetris& tetris = _room.GetTetris();
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    bool leaving = false;
+
+    system("cls");
+    auto nextFrame = std::chrono::steady_clock::now();
+    auto nextRender = nextFrame;
+
+    while (_running && _network.IsConnected() && _room.IsPlaying())
+    {
+        while (_kbhit())
+        {
+            int key = _getch();
+            if (key == 224 || key == 0) // 방향키는 2바이트
+            {
+                key = _getch();
+                switch (key)
+                {
+                case 75: tetris.MoveLeft(); break;  // ←
+                case 77: tetris.MoveRight(); break; // →
+                case 72: tetris.Rotate(); break;    // ↑
+                case 80: tetris.SoftDrop(); break;  // ↓
+                default: break;
+                }
+                continue;
+            }
+
+            switch (key)
+            {
+            case ' ': tetris.Drop(); break;
+            case 'z': case 'Z': tetris.RotateCcw(); break;
+            case 'c': case 'C': tetris.Hold(); break;
+            case 't': case 'T': _room.CycleTargetMode(); break;
+            case 27: // ESC: 퇴장 (서버는 기권으로 처리, 응답이 오면 루프를 빠져나감)
+                if (!leaving)
+                {
+                    leaving = true;
+                    _room.RequestLeaveRoom();
+                }
+                break;
+            default: break;
+            }
+        }
+
+        _room.UpdateGame();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextRender)
+        {
+            // 지우지 않고 커서만 처음으로 (깜빡임 방지)
+            nextRender = now + renderInterval;
+            SetConsoleCursorPosition(hConsole, COORD{ 0, 0 });
+            _room.DisplayRoomView();
+        }
+
+        nextFrame += frameInterval;
+        std::this_thread::sleep_until(nextFrame);
+    }
+
+    system("cls");
+    if (_room.IsInRoom())
+    {
+        int32_t winner = _room.GetLastWinner();
+        std::wcout << L"\n==================================" << std::endl;
+        std::wcout << L"GAME OVER - " << ((winner < 0) ? L"Draw" : (winner == _room.GetMySlot() ? L"You win!" : L"You lose")) << std::endl;
+        std::wcout << L"==================================" << std::endl;
+    }
+    _refreshRoomView = true;
+}
+
+void CGameInstance::ProcessSpectateInput()
+{
+    // 화면은 서버가 보낸 보드 스트림을 그대로 그림 (입력 전송 없음)
+    const auto renderInterval = std::chrono::milliseconds(100);
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    bool stopping = false;
+
+    system("cls");
+    while (_running && _network.IsConnected() && _spectator.IsWatching() && !_room.IsInRoom())
+    {
+        while (_kbhit())
+        {
+            int key = _getch();
+            if (key == 224 || key == 0) // 방향키는 2바이트
+            {
+                _getch();
+                continue;
+            }
+
+            if (key == 27 && !stopping) // ESC: 그만두기 (응답이 오면 루프를 빠져나감)
+            {
+                stopping = true;
+                _spectator.RequestStopSpectate();
+            }
+        }
+
+        // 지우지 않고 커서만 처음으로 (깜빡임 방지)
+        SetConsoleCursorPosition(hConsole, COORD{ 0, 0 });
+        _spectator.DisplaySpectatorView();
+
+        std::this_thread::sleep_for(renderInterval);
+    }
+
+    system("cls");
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "ClientNetwork.h"
 #include "Room.h"
+#include "Spectator.h"
 #include <memory>
 #include <string>
 
@@ -11,29 +12,52 @@ public:
     CGameInstance();
     ~CGameInstance();
 
-    // ʱȭ  
+    // 초기화 및 실행
     bool Initialize();
     void Run();
     void Shutdown();
 
-    // Ʈũ 
+    // 네트워크 연결
     bool ConnectToServer(const std::string& serverIp, int port);
 
-    // Ŷ ڵ鷯 (CClientNetworkκ ȣ)
-    void OnRoomListReceived(const MSG_S2C_ROOM_LIST* msg, size_t msgSize);
-    void OnRoomCreated(const MSG_S2C_ROOM_CREATED* msg);
+    // 패킷 핸들러 (CClientNetwork로부터 호출됨)
+    void OnRoomListReceived(const MSG_S2C_ROOM_LIST& msg, const std::vector<RoomInfo>& rooms);
+    void OnRoomPageReceived(const MSG_S2C_ROOM_PAGE& msg, const std::vector<RoomInfo>& rooms);
+    void OnRoomCreated(const MSG_S2C_ROOM_CREATED* msg, const PendingRequest& request);
     void OnRoomJoined(const MSG_S2C_ROOM_JOINED* msg);
     void OnRoomLeft(const MSG_S2C_ROOM_LEFT* msg);
-    void OnError(const MSG_S2C_ERROR* msg);
+    void OnQuickJoined(const MSG_S2C_QUICK_JOINED& msg);
+    void OnError(const MSG_S2C_ERROR& msg);
+    void OnGameStarted(const MSG_S2C_GAME_STARTED& msg);
+    void OnGameFrames(const MSG_S2C_GAME_FRAMES& msg);
+    void OnGameOver(const MSG_S2C_GAME_OVER& msg);
+    void OnSpectateState(const MSG_S2C_SPECTATE_STATE* msg);
+    void OnBoardStream(const MSG_S2C_BOARD_STREAM& msg);
 
 private:
-    int ShowMainMenuWithSelection(); // Ű ϴ ޴
+    int ShowMainMenuWithSelection(); // 방향키로 선택하는 메뉴
     void ShowLobbyMenu();
     void ProcessLobbyInput();
-    void ProcessRoomInput();
+    void ProcessRoomInput(); // 키 하나씩 확인 (게임 시작이 언제든 올 수 있으므로 막히지 않음)
+    void ProcessGameInput(); // 게임이 끝날 때까지 TETRIS_FRAME_RATE로 입력 전송 + 화면 갱신
+    void ProcessSpectateInput(); // 관전이 끝날 때까지 화면 갱신 (ESC: 그만두기)
+
+    // 방 목록 페이지 조회 (현재 필터 유지)
+    void RequestRoomPage(int32_t cursor);
+    void EditRoomFilter();
 
 private:
     CClientNetwork _network;
     CRoom _room;
+    CSpectator _spectator;
     bool _running;
+
+    // 방 목록 페이지 상태
+    uint8_t _roomFilterFlags;
+    uint8_t _roomFilterMinFree;
+    std::string _roomFilterTitlePrefix;
+    std::atomic<int32_t> _nextRoomCursor; // 0: 다음 페이지 없음
+
+    // 방 화면을 다시 그려야 함 (입장, 게임 종료, 키 입력 뒤)
+    std::atomic<bool> _refreshRoomView;
 };
\ No newline at end of file
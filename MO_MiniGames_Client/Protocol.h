@@ -1,103 +0,0 @@
-#pragma once
-
-#include <cstdint>
-
-// Ŷ Ÿ (ȥ   L7 Msg ǥ)
-enum class MsgType : uint16_t
-{
-    // C2S: Client to Server
-    // S2C: Server to Client
-
-    C2S_REQUEST_ROOM_LIST = 1000,
-    S2C_ROOM_LIST,
-
-    C2S_CREATE_ROOM,
-    S2C_ROOM_CREATED,
-
-    C2S_JOIN_ROOM,
-    S2C_ROOM_JOINED,
-
-    C2S_LEAVE_ROOM,
-    S2C_ROOM_LEFT,
-
-    S2C_ERROR
-};
-
-// Ŷ  ( Ŷ )
-#pragma pack(push, 1)
-struct MsgHeader
-{
-    uint16_t size;        // Ŷ ü ũ ( )
-    MsgType type;      // Ŷ Ÿ
-};
-
-//   (Ͽ)
-struct RoomInfo
-{
-    int32_t roomId;
-    char title[64];
-    int32_t currentPlayers;
-    int32_t maxPlayers;
-    uint8_t status; // 0: WAITING, 1: PLAYING
-};
-
-// S2C:    ( )
-struct MSG_S2C_ROOM_LIST
-{
-    MsgHeader header;
-    int32_t roomCount;
-    // RoomInfo rooms[roomCount]; //  迭
-};
-
-// C2S:   û
-struct MSG_C2S_CREATE_ROOM
-{
-    MsgHeader header;
-    char title[64];
-    int32_t maxPlayers;
-};
-
-// S2C:   
-struct MSG_S2C_ROOM_CREATED
-{
-    MsgHeader header;
-    int32_t roomId;
-    uint8_t success; // 0: , 1: 
-};
-
-// C2S:   û
-struct MSG_C2S_JOIN_ROOM
-{
-    MsgHeader header;
-    int32_t roomId;
-};
-
-// S2C:   
-struct MSG_S2C_ROOM_JOINED
-{
-    MsgHeader header;
-    int32_t roomId;
-    uint8_t success;
-};
-
-// C2S:   û
-struct MSG_C2S_LEAVE_ROOM
-{
-    MsgHeader header;
-};
-
-// S2C:   
-struct MSG_S2C_ROOM_LEFT
-{
-    MsgHeader header;
-    uint8_t success;
-};
-
-// S2C:  
-struct MSG_S2C_ERROR
-{
-    MsgHeader header;
-    char message[256];
-};
-
-#pragma pack(pop)
\ No newline at end of file
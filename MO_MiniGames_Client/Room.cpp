@@ -5,12 +5,72 @@
 #include <algorithm>
 #include <iostream>
 
+// 입력을 몇 프레임씩 묶어 보낼지 (2프레임 = 33ms 지연, 패킷 수 절반)
+constexpr uint8_t LOCKSTEP_CLIENT_BATCH_FRAMES = 2;
+static_assert(LOCKSTEP_CLIENT_BATCH_FRAMES <= LOCKSTEP_MAX_INPUTS_PER_MSG, "input batch must fit one C2S_GAME_INPUT");
+
+// 큰 화면 안쪽 폭 (칸 하나 = 두 글자)
+constexpr size_t ROOM_VIEW_BOARD_WIDTH = TETRIS_BOARD_WIDTH * 2 + 1;
+
+static const wchar_t* GetTargetModeName(GarbageTargetMode mode)
+{
+    switch (mode)
+    {
+    case GarbageTargetMode::RANDOM: return L"RANDOM";
+    case GarbageTargetMode::EVEN: return L"EVEN";
+    case GarbageTargetMode::KO: return L"KO";
+    case GarbageTargetMode::ATTACKERS: return L"ATTACKERS";
+    default: return L"?";
+    }
+}
+
+// 보드 하나를 큰 화면 줄로 (맨 위 줄이 보이는 가장 높은 행)
+static std::vector<std::wstring> BuildBoardScreen(const CTetrisEngine& board, const std::wstring& status)
+{
+    std::wstring border = L"+" + std::wstring(ROOM_VIEW_BOARD_WIDTH, L'-') + L"+";
+    std::wstring header = status + L" L:" + std::to_wstring(board.GetLines()) + L" S:" + std::to_wstring(board.GetScore());
+    header.resize(ROOM_VIEW_BOARD_WIDTH, L' ');
+
+    std::vector<std::wstring> lines;
+    lines.push_back(border);
+    lines.push_back(L"|" + header + L"|");
+    lines.push_back(border);
+
+    for (int32_t y = TETRIS_VISIBLE_HEIGHT - 1; y >= 0; --y)
+    {
+        uint16_t row = board.GetRow(y);
+        if (!board.IsGameOver())
+        {
+            row |= board.GetPieceRowMask(y);
+        }
+
+        std::wstring line = L"|";
+        for (int32_t x = 0; x < TETRIS_BOARD_WIDTH; ++x)
+        {
+            line += ((row >> (x + TETRIS_WALL_BITS)) & 1) ? L"[]" : L" .";
+        }
+        line += L" |";
+        lines.push_back(line);
+    }
+
+    lines.push_back(border);
+    return lines;
+}
+
 CRoom::CRoom()
     : _network(nullptr)
     , _inRoom(false)
     , _roomId(-1)
     , _maxPlayers(0)
-    , _pendingMaxPlayers(0)
+    , _playing(false)
+    , _mySlot(0)
+    , _gamePlayerCount(0)
+    , _lastWinner(-1)
+    , _confirmedFrames(0)
+    , _nextInputFrame(0)
+    , _inputBatch()
+    , _inputBatchCount(0)
+    , _targetMode(GarbageTargetMode::RANDOM)
 {
 }
 
@@ -25,9 +85,6 @@ void CRoom::RequestCreateRoom(const std::string& title, int32_t maxPlayers)
         return;
     }
 
-    _pendingTitle = title;
-    _pendingMaxPlayers = maxPlayers;
-
     _network->RequestCreateRoom(title, maxPlayers);
 }
 
@@ -51,13 +108,33 @@ void CRoom::RequestLeaveRoom()
     _network->RequestLeaveRoom();
 }
 
-void CRoom::OnRoomCreated(int32_t roomId)
+void CRoom::RequestQuickJoin(uint8_t maxPlayers)
+{
+    if (!_network)
+    {
+        return;
+    }
+
+    _network->RequestQuickJoin(maxPlayers);
+}
+
+void CRoom::RequestGameStart()
+{
+    if (!_network)
+    {
+        return;
+    }
+
+    _network->RequestGameStart();
+}
+
+void CRoom::OnRoomCreated(int32_t roomId, const std::string& title, int32_t maxPlayers)
 {
     std::lock_guard<std::mutex> lock(_mutex);
     _inRoom = true;
     _roomId = roomId;
-    _title = _pendingTitle;
-    _maxPlayers = _pendingMaxPlayers;
+    _title = title;
+    _maxPlayers = maxPlayers;
     InitPlayers();
 }
 
@@ -66,7 +143,17 @@ void CRoom::OnRoomJoined(int32_t roomId)
     std::lock_guard<std::mutex> lock(_mutex);
     _inRoom = true;
     _roomId = roomId;
-    // TODO:    ޾ƿ _title, _maxPlayers Ʈ
+    // TODO: 서버에서 방 정보를 받아와 _title, _maxPlayers 업데이트
+    InitPlayers();
+}
+
+void CRoom::OnRoomJoined(int32_t roomId, const std::string& title, int32_t maxPlayers)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inRoom = true;
+    _roomId = roomId;
+    _title = title;
+    _maxPlayers = maxPlayers;
     InitPlayers();
 }
 
@@ -78,6 +165,106 @@ void CRoom::OnRoomLeft()
     _title.clear();
     _maxPlayers = 0;
     _players.clear();
+    _playing = false;
+    _gamePlayerCount = 0;
+}
+
+void CRoom::OnGameStarted(const MSG_S2C_GAME_STARTED& msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _mySlot = msg.yourSlot;
+    _gamePlayerCount = msg.playerCount;
+    _lastWinner = -1;
+    _confirmedFrames = 0;
+    _nextInputFrame = 0;
+    _inputBatchCount = 0;
+    _targetMode = GarbageTargetMode::RANDOM;
+
+    // 서버와 같은 seed, 같은 슬롯 순서
+    for (int32_t slot = 0; slot < _gamePlayerCount; ++slot)
+    {
+        _boards[slot].Start(msg.seed);
+    }
+    _playing = true;
+}
+
+void CRoom::OnGameFrames(const MSG_S2C_GAME_FRAMES& msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_playing || msg.playerCount != _gamePlayerCount)
+    {
+        return;
+    }
+
+    // TCP 순서대로 오므로 정상적으로는 항상 이어짐 (어긋나면 보드가 서버와 달라지므로 버림)
+    if (msg.firstFrame != _confirmedFrames)
+    {
+        std::wcerr << L"Game frame out of order: " << msg.firstFrame << L" (expected " << _confirmedFrames << L")" << std::endl;
+        return;
+    }
+
+    // 방해 줄은 서버가 공격을 계산해서 정한 것. 그 프레임을 진행한 직후 실린 순서대로 넣음 (서버 보드와 같은 순서)
+    const uint8_t* inputs = msg.inputs;
+    const GarbageEvent* garbage = msg.garbage;
+    const GarbageEvent* garbageEnd = msg.garbage + msg.garbageCount;
+    for (uint8_t frame = 0; frame < msg.frameCount; ++frame)
+    {
+        for (int32_t slot = 0; slot < _gamePlayerCount; ++slot)
+        {
+            _boards[slot].Step(*inputs++);
+        }
+
+        for (; garbage != garbageEnd && garbage->frameOffset == frame; ++garbage)
+        {
+            _boards[garbage->slot].InsertGarbage(garbage->GetLines(), garbage->GetHole());
+        }
+    }
+    _confirmedFrames += msg.frameCount;
+}
+
+void CRoom::OnGameOver(const MSG_S2C_GAME_OVER& msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lastWinner = (msg.winnerSlot == LOCKSTEP_SLOT_NONE) ? -1 : msg.winnerSlot;
+    _playing = false;
+}
+
+void CRoom::UpdateGame()
+{
+    uint8_t input = _tetris.TakeInput();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_playing || !_network || _boards[_mySlot].IsGameOver())
+    {
+        return; // 탈락한 뒤에는 서버도 입력을 기다리지 않음
+    }
+
+    // 서버 입력 창을 넘게 앞서가면 이번 프레임은 만들지 않음 (확정이 따라올 때까지 대기)
+    uint32_t frame = _nextInputFrame + _inputBatchCount;
+    if (frame + LOCKSTEP_MAX_INPUTS_PER_MSG >= _confirmedFrames + LOCKSTEP_INPUT_WINDOW)
+    {
+        return;
+    }
+
+    _inputBatch[_inputBatchCount++] = input;
+    if (_inputBatchCount >= LOCKSTEP_CLIENT_BATCH_FRAMES)
+    {
+        _network->SendGameInput(_nextInputFrame, _inputBatch, _inputBatchCount);
+        _nextInputFrame += _inputBatchCount;
+        _inputBatchCount = 0;
+    }
+}
+
+void CRoom::CycleTargetMode()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_playing || !_network)
+    {
+        return;
+    }
+
+    _targetMode = static_cast<GarbageTargetMode>((static_cast<uint8_t>(_targetMode) + 1) % static_cast<uint8_t>(GarbageTargetMode::COUNT));
+    _network->SendGameTarget(_targetMode);
 }
 
 void CRoom::InitPlayers()
@@ -133,11 +320,7 @@ void CRoom::DisplayRoomInfo()
         }
     }
 
-    std::wstring statusStr = L"WAITING";
-    if (_maxPlayers > 0 && currentPlayers == _maxPlayers)
-    {
-        statusStr = L"PLAYING";
-    }
+    std::wstring statusStr = _playing ? L"PLAYING" : L"WAITING";
 
     std::wcout << L"\n";
     std::wcout << L"+----+--------------------------+--------+----------+" << std::endl;
@@ -156,30 +339,56 @@ void CRoom::DisplayRoomView()
 {
     DisplayRoomInfo();
 
-    std::vector<std::wstring> myScreen = {
-        L"+---------------------+",
-        L"|                     |",
-        L"+---------------------+",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|        WAIT         |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"|                     |",
-        L"+---------------------+"
-    };
+    // 게임을 한 번이라도 했으면 내 보드 (끝난 뒤에는 마지막 상태)
+    std::vector<std::wstring> myScreen;
+    std::vector<int32_t> opponentSlots;
+    GarbageTargetMode targetMode;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        targetMode = _targetMode;
+        if (_gamePlayerCount > 0)
+        {
+            const CTetrisEngine& board = _boards[_mySlot];
+            std::wstring status = _playing ? (board.IsGameOver() ? L"OUT" : L"PLAY") : (_lastWinner == _mySlot ? L"WIN" : L"END");
+            myScreen = BuildBoardScreen(board, status);
+
+            for (int32_t slot = 0; slot < _gamePlayerCount; ++slot)
+            {
+                if (slot != _mySlot)
+                {
+                    opponentSlots.push_back(slot);
+                }
+            }
+        }
+    }
+
+    if (myScreen.empty())
+    {
+        myScreen = {
+            L"+---------------------+",
+            L"|                     |",
+            L"+---------------------+",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|        WAIT         |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"|                     |",
+            L"+---------------------+"
+        };
+    }
 
     std::vector<std::vector<std::wstring>> smallScreens;
     {
@@ -201,7 +410,16 @@ void CRoom::DisplayRoomView()
         for (int i = 1; i <= 9; ++i)
         {
             std::wstring label;
-            if (_players.size() > static_cast<size_t>(i) && _players[i].isPresent)
+            std::wstring detail;
+            if (static_cast<size_t>(i) <= opponentSlots.size())
+            {
+                // 게임 참가자 (상대 슬롯 순서대로)
+                int32_t slot = opponentSlots[i - 1];
+                const CTetrisEngine& board = _boards[slot];
+                label = !board.IsGameOver() ? L"[PLAY]" : (slot == _lastWinner ? L"[WIN]" : L"[OUT]");
+                detail = L"L:" + std::to_wstring(board.GetLines());
+            }
+            else if (_players.size() > static_cast<size_t>(i) && _players[i].isPresent)
             {
                 label = L"[WAIT]";
             }
@@ -209,6 +427,7 @@ void CRoom::DisplayRoomView()
             {
                 label = L"[NONE]";
             }
+            detail.resize(9, L' ');
 
             std::vector<std::wstring> box = {
                 L"+-------------+",
@@ -217,7 +436,7 @@ void CRoom::DisplayRoomView()
                 L"|             |",
                 L"|             |",
                 L"|   " + std::to_wstring(i) + L"  " + label + std::wstring(7 - label.size(), L' ') + L"|",
-                L"|             |",
+                L"|    " + detail + L"|",
                 L"|             |",
                 L"|             |",
                 L"|             |",
@@ -275,7 +494,15 @@ void CRoom::DisplayRoomView()
         std::wcout << std::endl;
     }
 
+    if (_playing)
+    {
+        std::wcout << L"\nArrows: move / rotate / soft drop, Space: hard drop, Z: rotate CCW, C: hold, ESC: leave room" << std::endl;
+        std::wcout << L"T: attack target (" << GetTargetModeName(targetMode) << L")          " << std::endl;
+        return;
+    }
+
     std::wcout << L"\n[1] Leave Room" << std::endl;
+    std::wcout << L"[2] Start Game (owner)" << std::endl;
     std::wcout << L"[0] Disconnect" << std::endl;
     std::wcout << L"Select: ";
 }
@@ -293,7 +520,7 @@ void CRoom::DisplayRoomList(const std::vector<RoomInfo>& rooms)
 
         wprintf(L"| %-4d | %-22s | %2d / %-4d | %-8s |\n",
             room.roomId,
-            std::wstring(room.title, room.title + strlen(room.title)).c_str(),
+            std::wstring(room.title.begin(), room.title.end()).c_str(),
             room.currentPlayers,
             room.maxPlayers,
             statusStr.c_str());
@@ -5,9 +5,10 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <iostream>
 
-class CClientNetwork; //  
+class CClientNetwork; // 전방 선언
 
 struct RoomPlayer
 {
@@ -22,34 +23,51 @@ public:
     CRoom();
     ~CRoom();
 
-    // Ʈũ 
+    // 네트워크 설정
     void SetNetwork(CClientNetwork* network) { _network = network; }
 
-    //  û (Ʈũ  )
+    // 방 요청 (네트워크를 통해 전송)
     void RequestCreateRoom(const std::string& title, int32_t maxPlayers);
     void RequestJoinRoom(int32_t roomId);
     void RequestLeaveRoom();
+    void RequestQuickJoin(uint8_t maxPlayers);
+    void RequestGameStart();
 
-    //   ó
-    void OnRoomCreated(int32_t roomId);
+    // 서버 응답 처리
+    void OnRoomCreated(int32_t roomId, const std::string& title, int32_t maxPlayers);
     void OnRoomJoined(int32_t roomId);
+    void OnRoomJoined(int32_t roomId, const std::string& title, int32_t maxPlayers); // 방 정보를 같이 받은 경우
     void OnRoomLeft();
 
-    //  
+    // 락스텝 게임 (수신 스레드). 보드는 서버가 확정한 프레임 입력으로만 진행
+    void OnGameStarted(const MSG_S2C_GAME_STARTED& msg);
+    void OnGameFrames(const MSG_S2C_GAME_FRAMES& msg);
+    void OnGameOver(const MSG_S2C_GAME_OVER& msg);
+
+    // 게임 중 프레임마다 (메인 스레드, TETRIS_FRAME_RATE). 모아둔 키 입력을 이번 프레임 입력으로 묶어 전송
+    void UpdateGame();
+
+    // 공격 대상 고르기 방식을 다음 것으로 바꿔 서버에 알림 (메인 스레드)
+    void CycleTargetMode();
+
+    // 방 상태
     bool IsInRoom() const { return _inRoom; }
     int32_t GetRoomId() const { return _roomId; }
+    bool IsPlaying() const { return _playing; }
+    int32_t GetMySlot() const { return _mySlot; }
+    int32_t GetLastWinner() const { return _lastWinner; } // 마지막 게임 승자 슬롯 (-1: 없음 / 무승부)
 
-    // ÷̾ 
+    // 플레이어 관리
     void InitPlayers();
     void AddPlayer(int index, const std::string& name);
     void RemovePlayer(int index);
 
-    // 
+    // 렌더링
     void DisplayRoomInfo();
     void DisplayRoomView();
     void DisplayRoomList(const std::vector<RoomInfo>& rooms);
 
-    // Tetris 
+    // Tetris 접근
     CTetris& GetTetris() { return _tetris; }
 
 private:
@@ -64,7 +82,15 @@ private:
     std::vector<RoomPlayer> _players;
     std::mutex _mutex;
 
-    //    ӽ 
-    std::string _pendingTitle;
-    int32_t _pendingMaxPlayers;
+    // 락스텝 게임 (_mutex로 보호, _playing은 메인 스레드가 락 없이 확인)
+    std::atomic<bool> _playing;
+    int32_t _mySlot;
+    int32_t _gamePlayerCount;        // 0: 아직 게임을 한 적 없음 (끝난 뒤에도 마지막 보드를 보여줌)
+    int32_t _lastWinner;
+    uint32_t _confirmedFrames;       // 진행한 확정 프레임 수
+    uint32_t _nextInputFrame;        // 다음에 보낼 묶음의 첫 프레임
+    uint8_t _inputBatch[LOCKSTEP_MAX_INPUTS_PER_MSG];
+    uint8_t _inputBatchCount;
+    GarbageTargetMode _targetMode;   // 서버도 게임 시작 때 RANDOM으로 시작
+    CTetrisEngine _boards[ROOM_MAX_PLAYERS];
 };
\ No newline at end of file
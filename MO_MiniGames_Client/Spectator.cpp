@@ -0,0 +1,202 @@
+﻿#include "Spectator.h"
+#include "ClientNetwork.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 관전 화면 보드 하나의 안쪽 폭 (칸 하나 = 한 글자, 10명이 한 줄에 들어가도록)
+constexpr size_t SPECTATOR_VIEW_BOARD_WIDTH = TETRIS_BOARD_WIDTH;
+
+CSpectator::CSpectator()
+    : _network(nullptr)
+    , _watching(false)
+    , _roomId(-1)
+    , _views()
+    , _boardCount(0)
+    , _frame(0)
+    , _synced(false)
+    , _gameOver(false)
+    , _lastWinner(-1)
+{
+}
+
+void CSpectator::RequestSpectateRoom(int32_t roomId)
+{
+    if (!_network)
+    {
+        return;
+    }
+
+    _network->RequestSpectateRoom(roomId);
+}
+
+void CSpectator::RequestStopSpectate()
+{
+    if (!_network)
+    {
+        return;
+    }
+
+    _network->RequestStopSpectate();
+}
+
+void CSpectator::OnSpectateState(const MSG_S2C_SPECTATE_STATE* msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // 다른 방으로 옮겼거나 새로 시작 -> 이전 화면은 버리고 키프레임부터
+    if (!msg->watching || msg->roomId != _roomId)
+    {
+        ResetViews();
+    }
+
+    _roomId = msg->watching ? msg->roomId : -1;
+    _watching = (msg->watching != 0);
+
+    if (!_watching && msg->requestId == REQUEST_ID_NONE)
+    {
+        std::wcout << L"\nSpectating ended by server." << std::endl;
+    }
+}
+
+void CSpectator::OnBoardStream(const MSG_S2C_BOARD_STREAM& msg)
+{
+    if (!_watching)
+    {
+        return; // 그만두기 응답보다 먼저 출발한 화면
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // 키프레임 메시지는 모든 보드가 키프레임 델타 (첫 델타만 보면 됨)
+    bool keyframe = msg.updateCount > 0 && msg.updatesSize >= 2 && (msg.updates[1] & BOARD_DELTA_KEYFRAME) != 0;
+    if (!_synced && !keyframe)
+    {
+        return; // 기준 화면이 없는 델타
+    }
+
+    if (keyframe)
+    {
+        // 새 게임이거나 주기적인 키프레임. 게임 종료 표시는 다음 게임이 시작될 때 지움
+        if (msg.frame < _frame || msg.boardCount != _boardCount)
+        {
+            _gameOver = false;
+        }
+        _boardCount = msg.boardCount;
+        _synced = true;
+    }
+
+    CMsgReader reader(reinterpret_cast<const char*>(msg.updates), msg.updatesSize, 0);
+    for (uint8_t i = 0; i < msg.updateCount; ++i)
+    {
+        uint8_t slot;
+        if (!reader.ReadUInt8(slot) || slot >= _boardCount || !DecodeBoardDelta(reader, _views[slot]))
+        {
+            // 일부만 적용됐을 수 있음 -> 다음 키프레임까지 기다림
+            std::wcerr << L"Invalid board stream" << std::endl;
+            _synced = false;
+            return;
+        }
+    }
+    _frame = msg.frame;
+}
+
+void CSpectator::OnGameOver(const MSG_S2C_GAME_OVER& msg)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _gameOver = true;
+    _lastWinner = (msg.winnerSlot == LOCKSTEP_SLOT_NONE) ? -1 : static_cast<int32_t>(msg.winnerSlot);
+}
+
+void CSpectator::ResetViews()
+{
+    for (BoardView& view : _views)
+    {
+        view.Clear();
+    }
+    _boardCount = 0;
+    _frame = 0;
+    _synced = false;
+    _gameOver = false;
+    _lastWinner = -1;
+}
+
+void CSpectator::DisplaySpectatorView()
+{
+    std::vector<std::wstring> lines;
+    int32_t roomId = _roomId;
+    uint32_t seconds = 0;
+    bool gameOver = false;
+    int32_t winner = -1;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        seconds = _frame / TETRIS_FRAME_RATE;
+        gameOver = _gameOver;
+        winner = _lastWinner;
+
+        if (_synced && _boardCount > 0)
+        {
+            // 보드를 한 줄로 나란히 (맨 위 줄이 보이는 가장 높은 행)
+            std::wstring border;
+            std::wstring header;
+            std::wstring status;
+            for (int32_t slot = 0; slot < _boardCount; ++slot)
+            {
+                const BoardView& view = _views[slot];
+                std::wstring label = std::to_wstring(slot + 1) + L" "
+                    + (!view.gameOver ? (gameOver ? L"END" : L"PLAY") : (slot == winner ? L"WIN" : L"OUT"));
+                std::wstring detail = L"L:" + std::to_wstring(view.lines);
+                label.resize(SPECTATOR_VIEW_BOARD_WIDTH, L' ');
+                detail.resize(SPECTATOR_VIEW_BOARD_WIDTH, L' ');
+
+                border += L"+" + std::wstring(SPECTATOR_VIEW_BOARD_WIDTH, L'-') + L"+ ";
+                header += L"|" + label + L"| ";
+                status += L"|" + detail + L"| ";
+            }
+
+            lines.push_back(border);
+            lines.push_back(header);
+            lines.push_back(status);
+            lines.push_back(border);
+
+            for (int32_t y = TETRIS_VISIBLE_HEIGHT - 1; y >= 0; --y)
+            {
+                std::wstring line;
+                for (int32_t slot = 0; slot < _boardCount; ++slot)
+                {
+                    uint16_t row = _views[slot].rows[y];
+                    line += L"|";
+                    for (int32_t x = 0; x < TETRIS_BOARD_WIDTH; ++x)
+                    {
+                        line += ((row >> x) & 1) ? L'#' : L'.';
+                    }
+                    line += L"| ";
+                }
+                lines.push_back(line);
+            }
+
+            lines.push_back(border);
+        }
+    }
+
+    std::wcout << L"\n==================================" << std::endl;
+    std::wcout << L"SPECTATING ROOM " << roomId << L"  " << (seconds / 60) << L":"
+        << (seconds % 60 < 10 ? L"0" : L"") << (seconds % 60) << L"          " << std::endl;
+    std::wcout << L"==================================" << std::endl;
+
+    if (lines.empty())
+    {
+        std::wcout << L"Waiting for the game to start..." << std::endl;
+    }
+    for (const std::wstring& line : lines)
+    {
+        std::wcout << line << std::endl;
+    }
+
+    if (gameOver)
+    {
+        std::wcout << L"\nGAME OVER - " << ((winner < 0) ? std::wstring(L"Draw") : L"Player " + std::to_wstring(winner + 1) + L" wins")
+            << L"          " << std::endl;
+    }
+    std::wcout << L"\nESC: stop watching" << std::endl;
+}
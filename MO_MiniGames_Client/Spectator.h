@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include "Protocol.h"
+#include "BoardDelta.h"
+#include <atomic>
+#include <mutex>
+
+class CClientNetwork; // 전방 선언
+
+// 방 밖에서 다른 방 게임 보기 (방 인원에 세지 않음)
+// 서버가 보낸 보드 화면 스트림(S2C_BOARD_STREAM)을 그대로 적용해서 그림. 시뮬레이션은 돌리지 않음
+// 수신 스레드가 적용하고 메인 스레드가 그리므로 화면 상태는 _mutex로 보호
+class CSpectator
+{
+public:
+    CSpectator();
+
+    void SetNetwork(CClientNetwork* network) { _network = network; }
+
+    // 관전 요청 (네트워크를 통해 전송)
+    void RequestSpectateRoom(int32_t roomId);
+    void RequestStopSpectate();
+
+    // 서버 응답 처리 (수신 스레드)
+    void OnSpectateState(const MSG_S2C_SPECTATE_STATE* msg);
+    void OnBoardStream(const MSG_S2C_BOARD_STREAM& msg);
+    void OnGameOver(const MSG_S2C_GAME_OVER& msg);
+
+    bool IsWatching() const { return _watching; }
+    int32_t GetRoomId() const { return _roomId; }
+
+    // 렌더링 (메인 스레드)
+    void DisplaySpectatorView();
+
+private:
+    void ResetViews();
+
+private:
+    CClientNetwork* _network;
+
+    std::atomic<bool> _watching;
+    std::atomic<int32_t> _roomId;
+
+    // 화면 상태 (_mutex로 보호)
+    std::mutex _mutex;
+    BoardView _views[ROOM_MAX_PLAYERS];
+    int32_t _boardCount;  // 0: 아직 키프레임을 받지 못함 (다음 게임을 기다리는 중)
+    uint32_t _frame;      // 마지막으로 받은 화면의 프레임
+    bool _synced;         // 키프레임을 받은 뒤 델타가 모두 맞게 적용됨
+    bool _gameOver;
+    int32_t _lastWinner;  // -1: 무승부
+};
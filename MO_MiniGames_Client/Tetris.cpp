@@ -2,9 +2,30 @@
 #include "Tetris.h"
 
 CTetris::CTetris()
+    : _input(TETRIS_INPUT_NONE)
 {
 }
 
 CTetris::~CTetris()
 {
+}
+
+void CTetris::Start(uint32_t seed)
+{
+    _engine.Start(seed);
+    _input = TETRIS_INPUT_NONE;
+}
+
+TetrisStepResult CTetris::Update()
+{
+    TetrisStepResult result = _engine.Step(_input);
+    _input = TETRIS_INPUT_NONE;
+    return result;
+}
+
+uint8_t CTetris::TakeInput()
+{
+    uint8_t input = _input;
+    _input = TETRIS_INPUT_NONE;
+    return input;
 }
\ No newline at end of file
@@ -1,22 +1,37 @@
 #pragma once
 
+#include "TetrisEngine.h"
+
+// 클라이언트 쪽 보드 하나 (시뮬레이션은 서버와 같은 CTetrisEngine)
+// 키 입력은 프레임 입력 비트로 모아뒀다가 Update에서 한 프레임 진행
 class CTetris
 {
 public:
     CTetris();
     ~CTetris();
 
-    // TODO:   ߰ 
-    // void Update();
+    void Start(uint32_t seed);
+
+    // 한 프레임 진행 (TETRIS_FRAME_RATE마다 호출). 모아둔 입력은 비움
+    TetrisStepResult Update();
+
+    // TODO: 렌더링 추가 예정 (지금은 CRoom::DisplayRoomView에서 엔진 상태를 직접 읽음)
     // void Render();
-    // void MoveLeft();
-    // void MoveRight();
-    // void Rotate();
-    // void Drop();
+
+    void MoveLeft() { _input |= TETRIS_INPUT_LEFT; }
+    void MoveRight() { _input |= TETRIS_INPUT_RIGHT; }
+    void Rotate() { _input |= TETRIS_INPUT_ROTATE_CW; }
+    void RotateCcw() { _input |= TETRIS_INPUT_ROTATE_CCW; }
+    void Drop() { _input |= TETRIS_INPUT_HARD_DROP; }
+    void SoftDrop() { _input |= TETRIS_INPUT_SOFT_DROP; }
+    void Hold() { _input |= TETRIS_INPUT_HOLD; }
+
+    // 멀티 플레이 (락스텝): 모아둔 입력을 꺼내서 서버로 보냄. 보드 진행은 서버가 확정한 프레임으로
+    uint8_t TakeInput();
+
+    const CTetrisEngine& GetEngine() const { return _engine; }
 
 private:
-    // TODO:   
-    // int _board[20][10];
-    // int _score;
-    // int _level;
+    CTetrisEngine _engine;
+    uint8_t _input; // 이번 프레임에 누른 키 (TetrisInput 비트)
 };
\ No newline at end of file
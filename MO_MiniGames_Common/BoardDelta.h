@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "MsgCodec.h"
+#include "Protocol.h"
+#include "TetrisEngine.h"
+
+// __________________________________________________________________
+//
+// 보드 화면 델타 인코딩 (보드 상태 스트림, 시뮬레이션을 돌리지 않는 쪽이 보는 화면)
+// 보드 한 장 = 보이는 20행 x 10칸 비트 + 지운 줄 수 + 게임 오버
+// 기준 상태(마지막으로 보낸 상태)와 비교해 바뀐 행만 보냄
+//  [uint8 flags | lowRow << 3]                    flags: BoardDeltaFlags, lowRow: 바뀐 가장 낮은 행 (없으면 BOARD_DELTA_NO_ROWS)
+//  [varuint 바뀐 행 마스크 >> lowRow]             행이 있을 때만 (bit 0 = lowRow. 블록 하나 움직임이면 1바이트)
+//  [바뀐 행 값 10비트씩 이어 붙임 (아래 행부터)]  ceil(행 수 * 10 / 8) 바이트
+//  [varuint lines]                               BOARD_DELTA_LINES일 때만
+// 키프레임은 빈 보드 기준 델타 (받는 쪽은 지우고 적용) -> 빈 행이 많을수록 짧음
+// __________________________________________________________________
+
+constexpr uint16_t BOARD_VIEW_ROW_MASK = (1u << TETRIS_BOARD_WIDTH) - 1;
+constexpr uint8_t BOARD_DELTA_NO_ROWS = 0x1F;
+static_assert(TETRIS_VISIBLE_HEIGHT < BOARD_DELTA_NO_ROWS, "lowRow must fit 5 bits");
+
+// 델타 하나의 최대 크기 (전 행 + 줄 수)
+constexpr size_t BOARD_DELTA_MAX_SIZE = 1 + MAX_VARINT32_SIZE + (TETRIS_VISIBLE_HEIGHT * TETRIS_BOARD_WIDTH + 7) / 8 + MAX_VARINT32_SIZE;
+
+// S2C_BOARD_STREAM 최대 크기 (헤더 포함, 방 전원 키프레임)
+constexpr size_t BOARD_STREAM_UPDATES_MAX_SIZE = ROOM_MAX_PLAYERS * (1 + BOARD_DELTA_MAX_SIZE);
+constexpr size_t BOARD_STREAM_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE + 2 + BOARD_STREAM_UPDATES_MAX_SIZE;
+
+enum BoardDeltaFlags : uint8_t
+{
+    BOARD_DELTA_KEYFRAME  = 1 << 0, // 빈 보드 기준 (받는 쪽은 먼저 지움)
+    BOARD_DELTA_GAME_OVER = 1 << 1, // 현재 게임 오버 (매번 실림)
+    BOARD_DELTA_LINES     = 1 << 2  // lines가 뒤에 옴
+};
+
+// 보드 한 장의 화면 상태
+struct BoardView
+{
+    uint16_t rows[TETRIS_VISIBLE_HEIGHT]; // bit x = 열 x (벽 비트 없음), rows[0]이 맨 아래
+    uint32_t lines;
+    bool gameOver;
+
+    void Clear()
+    {
+        for (uint16_t& row : rows)
+        {
+            row = 0;
+        }
+        lines = 0;
+        gameOver = false;
+    }
+
+    // withPiece: 떨어지는 블록까지 (false면 고정된 칸만 -> 블록이 고정될 때만 바뀜)
+    void Capture(const CTetrisEngine& engine, bool withPiece)
+    {
+        bool showPiece = withPiece && !engine.IsGameOver();
+        for (int32_t y = 0; y < TETRIS_VISIBLE_HEIGHT; ++y)
+        {
+            uint16_t row = engine.GetRow(y);
+            if (showPiece)
+            {
+                row |= engine.GetPieceRowMask(y);
+            }
+            rows[y] = static_cast<uint16_t>((row >> TETRIS_WALL_BITS) & BOARD_VIEW_ROW_MASK);
+        }
+        lines = static_cast<uint32_t>(engine.GetLines());
+        gameOver = engine.IsGameOver();
+    }
+};
+
+// base -> current 델타를 씀. keyframe이면 base 대신 빈 보드 기준
+// 키프레임이 아니고 바뀐 것이 없으면 아무것도 쓰지 않고 false
+inline bool EncodeBoardDelta(CMsgWriter& writer, const BoardView& base, const BoardView& current, bool keyframe)
+{
+    uint32_t mask = 0;
+    for (int32_t y = 0; y < TETRIS_VISIBLE_HEIGHT; ++y)
+    {
+        uint16_t before = keyframe ? 0 : base.rows[y];
+        if (current.rows[y] != before)
+        {
+            mask |= 1u << y;
+        }
+    }
+
+    bool linesChanged = keyframe ? (current.lines != 0) : (current.lines != base.lines);
+    if (!keyframe && mask == 0 && !linesChanged && current.gameOver == base.gameOver)
+    {
+        return false;
+    }
+
+    uint8_t lowRow = BOARD_DELTA_NO_ROWS;
+    if (mask != 0)
+    {
+        lowRow = 0;
+        while (((mask >> lowRow) & 1) == 0)
+        {
+            ++lowRow;
+        }
+    }
+
+    uint8_t flags = static_cast<uint8_t>((keyframe ? BOARD_DELTA_KEYFRAME : 0) | (current.gameOver ? BOARD_DELTA_GAME_OVER : 0)
+        | (linesChanged ? BOARD_DELTA_LINES : 0));
+    writer.WriteUInt8(static_cast<uint8_t>(flags | (lowRow << 3)));
+
+    if (mask != 0)
+    {
+        writer.WriteVarUInt(mask >> lowRow);
+
+        // 10비트 행을 이어 붙임 (바이트가 찰 때마다 내보냄)
+        uint32_t bits = 0;
+        int32_t bitCount = 0;
+        for (int32_t y = lowRow; y < TETRIS_VISIBLE_HEIGHT; ++y)
+        {
+            if ((mask >> y) & 1)
+            {
+                bits |= static_cast<uint32_t>(current.rows[y]) << bitCount;
+                bitCount += TETRIS_BOARD_WIDTH;
+                while (bitCount >= 8)
+                {
+                    writer.WriteUInt8(static_cast<uint8_t>(bits));
+                    bits >>= 8;
+                    bitCount -= 8;
+                }
+            }
+        }
+        if (bitCount > 0)
+        {
+            writer.WriteUInt8(static_cast<uint8_t>(bits));
+        }
+    }
+
+    if (linesChanged)
+    {
+        writer.WriteVarUInt(current.lines);
+    }
+    return true;
+}
+
+// view에 델타 하나를 적용. 형식이 틀리면 false (view는 일부만 바뀌었을 수 있으므로 다음 키프레임까지 버려야 함)
+inline bool DecodeBoardDelta(CMsgReader& reader, BoardView& view)
+{
+    uint8_t header;
+    if (!reader.ReadUInt8(header))
+    {
+        return false;
+    }
+
+    uint8_t flags = static_cast<uint8_t>(header & 0x07);
+    uint8_t lowRow = static_cast<uint8_t>(header >> 3);
+    if (flags & BOARD_DELTA_KEYFRAME)
+    {
+        view.Clear();
+    }
+    view.gameOver = (flags & BOARD_DELTA_GAME_OVER) != 0;
+
+    if (lowRow != BOARD_DELTA_NO_ROWS)
+    {
+        uint32_t shifted;
+        if (lowRow >= TETRIS_VISIBLE_HEIGHT || !reader.ReadVarUInt(shifted) || (shifted & 1) == 0
+            || (shifted >> (TETRIS_VISIBLE_HEIGHT - lowRow)) != 0)
+        {
+            return false;
+        }
+
+        uint32_t mask = shifted << lowRow;
+        uint32_t bits = 0;
+        int32_t bitCount = 0;
+        for (int32_t y = lowRow; y < TETRIS_VISIBLE_HEIGHT; ++y)
+        {
+            if (((mask >> y) & 1) == 0)
+            {
+                continue;
+            }
+
+            while (bitCount < TETRIS_BOARD_WIDTH)
+            {
+                uint8_t byte;
+                if (!reader.ReadUInt8(byte))
+                {
+                    return false;
+                }
+                bits |= static_cast<uint32_t>(byte) << bitCount;
+                bitCount += 8;
+            }
+
+            view.rows[y] = static_cast<uint16_t>(bits & BOARD_VIEW_ROW_MASK);
+            bits >>= TETRIS_BOARD_WIDTH;
+            bitCount -= TETRIS_BOARD_WIDTH;
+        }
+    }
+
+    if (flags & BOARD_DELTA_LINES)
+    {
+        return reader.ReadVarUInt(view.lines);
+    }
+    return true;
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// __________________________________________________________________
+//
+// 가변 길이 필드 인코딩 (LEB128 varint)
+// - 정수/개수: 7비트 단위 varint (작은 값일수록 짧음, 127 이하 1바이트)
+// - 부호 있는 정수: zigzag 변환 후 varint (-1 -> 1, 1 -> 2)
+// - 문자열: varint 길이 + 바이트 (널 종료 없음)
+// 헤더(MsgHeader)는 고정 크기 그대로 두고 그 뒤 본문만 인코딩한다.
+// __________________________________________________________________
+
+constexpr size_t MAX_VARINT32_SIZE = 5;
+
+class CMsgWriter
+{
+public:
+    // headerSize 만큼 비워두고 본문을 쓴다. 헤더는 호출 측에서 마지막에 채운다.
+    CMsgWriter(char* buffer, size_t capacity, size_t headerSize)
+        : _buffer(buffer)
+        , _capacity(capacity)
+        , _pos(headerSize)
+        , _overflow(headerSize > capacity)
+    {
+    }
+
+    void WriteUInt8(uint8_t value)
+    {
+        if (!Ensure(1))
+            return;
+
+        _buffer[_pos++] = static_cast<char>(value);
+    }
+
+    void WriteVarUInt(uint32_t value)
+    {
+        if (!Ensure(VarUIntSize(value)))
+            return;
+
+        while (value >= 0x80)
+        {
+            _buffer[_pos++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        _buffer[_pos++] = static_cast<char>(value);
+    }
+
+    void WriteVarInt(int32_t value)
+    {
+        WriteVarUInt(ZigZagEncode(value));
+    }
+
+    // maxLength를 넘는 부분은 잘라서 기록
+    void WriteString(std::string_view value, size_t maxLength)
+    {
+        if (value.size() > maxLength)
+        {
+            value = value.substr(0, maxLength);
+        }
+
+        WriteVarUInt(static_cast<uint32_t>(value.size()));
+        if (value.empty() || !Ensure(value.size()))
+            return;
+
+        std::memcpy(_buffer + _pos, value.data(), value.size());
+        _pos += value.size();
+    }
+
+    // 길이 없이 바이트만 기록 (길이는 앞선 필드로 알 수 있는 경우)
+    void WriteBytes(const void* data, size_t size)
+    {
+        if (size == 0 || !Ensure(size))
+            return;
+
+        std::memcpy(_buffer + _pos, data, size);
+        _pos += size;
+    }
+
+    size_t GetSize() const { return _pos; }
+    bool IsOverflow() const { return _overflow; }
+
+    static size_t VarUIntSize(uint32_t value)
+    {
+        size_t size = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static uint32_t ZigZagEncode(int32_t value)
+    {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+private:
+    bool Ensure(size_t size)
+    {
+        if (_overflow || _capacity - _pos < size)
+        {
+            _overflow = true;
+            return false;
+        }
+        return true;
+    }
+
+    char* _buffer;
+    size_t _capacity;
+    size_t _pos;
+    bool _overflow;
+};
+
+// 수신 버퍼를 복사하지 않고 읽는다.
+// ReadString이 돌려주는 string_view는 수신 버퍼를 가리키므로 버퍼 수명 안에서만 유효.
+class CMsgReader
+{
+public:
+    // headerSize 이후부터 본문으로 읽는다.
+    CMsgReader(const char* data, size_t length, size_t headerSize)
+        : _data(data)
+        , _length(length)
+        , _pos(headerSize)
+        , _failed(headerSize > length)
+    {
+    }
+
+    bool ReadUInt8(uint8_t& value)
+    {
+        if (!Ensure(1))
+            return false;
+
+        value = static_cast<uint8_t>(_data[_pos++]);
+        return true;
+    }
+
+    bool ReadVarUInt(uint32_t& value)
+    {
+        value = 0;
+        for (size_t i = 0; i < MAX_VARINT32_SIZE; ++i)
+        {
+            if (!Ensure(1))
+                return false;
+
+            uint8_t byte = static_cast<uint8_t>(_data[_pos++]);
+            value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        // 5바이트를 넘는 varint는 잘못된 패킷
+        _failed = true;
+        return false;
+    }
+
+    bool ReadVarInt(int32_t& value)
+    {
+        uint32_t raw = 0;
+        if (!ReadVarUInt(raw))
+            return false;
+
+        value = ZigZagDecode(raw);
+        return true;
+    }
+
+    bool ReadString(std::string_view& value, size_t maxLength)
+    {
+        uint32_t length = 0;
+        if (!ReadVarUInt(length))
+            return false;
+
+        if (length > maxLength || !Ensure(length))
+        {
+            _failed = true;
+            return false;
+        }
+
+        value = std::string_view(_data + _pos, length);
+        _pos += length;
+        return true;
+    }
+
+    // size 바이트를 복사 없이 읽음 (value는 수신 버퍼를 가리킴)
+    bool ReadBytes(const uint8_t*& value, size_t size)
+    {
+        if (!Ensure(size))
+            return false;
+
+        value = reinterpret_cast<const uint8_t*>(_data + _pos);
+        _pos += size;
+        return true;
+    }
+
+    bool IsFailed() const { return _failed; }
+    size_t GetRemainSize() const { return _failed ? 0 : _length - _pos; }
+
+    static int32_t ZigZagDecode(uint32_t value)
+    {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+private:
+    bool Ensure(size_t size)
+    {
+        if (_failed || _length - _pos < size)
+        {
+            _failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    const char* _data;
+    size_t _length;
+    size_t _pos;
+    bool _failed;
+};
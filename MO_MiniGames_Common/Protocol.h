@@ -0,0 +1,656 @@
+#pragma once
+
+// __________________________________________________________________
+//
+// 클라/서버 공용 프로토콜 (헤더 전용)
+// 두 프로젝트 모두 이 파일 하나만 include 한다. 복사본을 만들지 말 것.
+// 와이어 포맷을 바꾸면 MO_MiniGames_Bench로 인코딩/디코딩 수치를 같이 확인.
+// __________________________________________________________________
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include "MsgCodec.h"
+
+// 패킷 타입 (혼용 방지를 위해 L7 Msg로 표기)
+enum class MsgType : uint16_t
+{
+    // C2S: Client to Server
+    // S2C: Server to Client
+
+    C2S_REQUEST_ROOM_LIST = 1000,
+    S2C_ROOM_LIST,
+
+    C2S_CREATE_ROOM,
+    S2C_ROOM_CREATED,
+
+    C2S_JOIN_ROOM,
+    S2C_ROOM_JOINED,
+
+    C2S_LEAVE_ROOM,
+    S2C_ROOM_LEFT,
+
+    S2C_ERROR,
+
+    C2S_REQUEST_ROOM_PAGE,
+    S2C_ROOM_PAGE,
+
+    C2S_QUICK_JOIN,
+    S2C_QUICK_JOINED,
+
+    // 방 안 게임 (락스텝). 방 액터가 처리
+    C2S_GAME_START,
+    S2C_GAME_STARTED,
+
+    C2S_GAME_INPUT,
+    S2C_GAME_FRAMES,
+
+    S2C_GAME_OVER,
+
+    C2S_GAME_TARGET,
+
+    S2C_BOARD_STREAM,
+
+    // 관전 (방 인원에 세지 않음). 로비가 처리
+    C2S_SPECTATE_ROOM,
+    C2S_STOP_SPECTATE,
+    S2C_SPECTATE_STATE
+};
+
+// 에러 코드 (S2C_ERROR). 사람이 읽는 문구는 클라 쪽 카탈로그에서 관리
+// 값은 와이어에 그대로 실리므로 중간 삽입 금지, 항상 끝에 추가
+enum class ErrorCode : uint16_t
+{
+    NONE = 0,
+    INVALID_ROOM_PARAMS,      // args: -
+    ROOM_TITLE_EXISTS,        // args: -
+    CREATED_ROOM_JOIN_FAILED, // args: roomId
+    ROOM_NOT_FOUND,           // args: roomId
+    ROOM_FULL,                // args: roomId, maxPlayers
+    ALREADY_IN_ROOM,          // args: 현재 roomId
+    NOT_IN_ROOM,              // args: -
+    ROOM_JOIN_FAILED,         // args: roomId
+    ROOM_LIMIT_REACHED,       // args: 최대 방 개수
+    SERVER_BUSY,              // args: - (요청 대기열이 가득 참, 잠시 후 다시 시도)
+    AFK_KICKED,               // args: roomId, 요청 없이 지난 시간(초) (서버가 방에서 내보냄, S2C_ROOM_LEFT가 같이 옴)
+    NOT_ROOM_OWNER,           // args: - (방장만 게임을 시작할 수 있음)
+    NOT_ENOUGH_PLAYERS,       // args: 현재 인원, 최소 인원
+    GAME_IN_PROGRESS,         // args: roomId (게임 중인 방에는 입장 / 시작 불가)
+    SPECTATOR_LIMIT,          // args: roomId (관전 릴레이가 모두 사용 중)
+
+    COUNT
+};
+
+constexpr uint8_t ERROR_MAX_ARGS = 2;
+
+// 요청 식별자 (C2S 요청마다 클라가 발급, S2C 응답에 그대로 돌려줌)
+// 요청 없이 서버가 먼저 보내는 메시지는 REQUEST_ID_NONE
+constexpr uint32_t REQUEST_ID_NONE = 0;
+
+// 가변 길이 문자열 필드 최대 길이 (바이트)
+constexpr size_t ROOM_TITLE_MAX_LEN = 63;
+
+// 방 인원 제한 (서버는 CRoom 안에 이 크기의 고정 배열을 둠)
+constexpr int32_t ROOM_MIN_PLAYERS = 2;
+constexpr int32_t ROOM_MAX_PLAYERS = 10;
+
+// 빠른 입장에서 인원 조건 없이 요청했는데 들어갈 방이 없어 새로 만들 때의 최대 인원
+constexpr int32_t QUICK_JOIN_DEFAULT_MAX_PLAYERS = 4;
+
+// 방 목록 페이지 크기 (uint16_t size 헤더 안에 들어가도록 제한)
+constexpr uint16_t ROOM_PAGE_DEFAULT_SIZE = 16;
+constexpr uint16_t ROOM_PAGE_MAX_SIZE = 32;
+
+// 락스텝 게임 (방 안)
+// 클라는 프레임(60Hz)마다 입력 비트(TetrisInput) 하나를 만들어 몇 프레임씩 묶어 보내고,
+// 서버는 방 전원의 입력이 모인 프레임부터 확정해서 방 전체에 한 번에 보냄. 모두 확정 프레임으로만 시뮬레이션을 진행
+constexpr size_t LOCKSTEP_INPUT_WINDOW = 128;        // 서버가 확정 프레임보다 앞서 받아두는 프레임 수 (넘으면 버림)
+constexpr size_t LOCKSTEP_MAX_INPUTS_PER_MSG = 16;   // C2S_GAME_INPUT 한 번에 보낼 수 있는 프레임 수
+constexpr size_t LOCKSTEP_MAX_FRAMES_PER_MSG = 16;   // S2C_GAME_FRAMES 한 번에 담는 프레임 수
+constexpr uint8_t LOCKSTEP_SLOT_NONE = 0xFF;         // S2C_GAME_OVER 승자 없음 (무승부)
+constexpr size_t LOCKSTEP_MAX_GARBAGE_PER_MSG = 64;  // S2C_GAME_FRAMES 한 번에 담는 방해 줄 삽입 수
+
+// 방해 줄 공격 대상 고르기 (C2S_GAME_TARGET). 공격은 서버가 확정 프레임에서 계산해서 보냄
+enum class GarbageTargetMode : uint8_t
+{
+    RANDOM,    // 공격마다 살아 있는 상대 중 무작위
+    EVEN,      // 살아 있는 상대를 슬롯 순서대로 돌아가며
+    KO,        // 스택이 가장 높은 상대 (탈락 직전을 노림)
+    ATTACKERS, // 나를 마지막으로 공격 대상으로 고른 상대 (없으면 RANDOM)
+
+    COUNT
+};
+
+// 방 목록 페이지 필터 (비트 플래그 조합)
+enum RoomFilterFlags : uint8_t
+{
+    ROOM_FILTER_NONE         = 0,
+    ROOM_FILTER_JOINABLE     = 1 << 0, // 입장 가능한 방만 (WAITING && 빈 자리 있음)
+    ROOM_FILTER_STATUS       = 1 << 1, // status 일치
+    ROOM_FILTER_MIN_FREE     = 1 << 2, // 빈 자리 minFreeSlots 이상
+    ROOM_FILTER_TITLE_PREFIX = 1 << 3  // 제목이 titlePrefix로 시작
+};
+
+// 패킷 헤더 (모든 패킷 공통)
+#pragma pack(push, 1)
+struct MsgHeader
+{
+    uint16_t size;        // 패킷 전체 크기 (헤더 포함)
+    MsgType type;         // 패킷 타입
+};
+
+// C2S: 방 목록 요청
+struct MSG_C2S_REQUEST_ROOM_LIST
+{
+    MsgHeader header;
+    uint32_t requestId;
+};
+
+// S2C: 방 생성 응답
+struct MSG_S2C_ROOM_CREATED
+{
+    MsgHeader header;
+    uint32_t requestId;
+    int32_t roomId;
+    uint8_t success; // 0: 실패, 1: 성공
+};
+
+// C2S: 방 입장 요청
+struct MSG_C2S_JOIN_ROOM
+{
+    MsgHeader header;
+    uint32_t requestId;
+    int32_t roomId;
+};
+
+// S2C: 방 입장 응답
+struct MSG_S2C_ROOM_JOINED
+{
+    MsgHeader header;
+    uint32_t requestId;
+    int32_t roomId;
+    uint8_t success;
+};
+
+// C2S: 방 퇴장 요청
+struct MSG_C2S_LEAVE_ROOM
+{
+    MsgHeader header;
+    uint32_t requestId;
+};
+
+// S2C: 방 퇴장 응답
+struct MSG_S2C_ROOM_LEFT
+{
+    MsgHeader header;
+    uint32_t requestId;
+    uint8_t success;
+};
+
+// C2S: 빠른 입장 요청 (서버가 입장할 방을 고르고, 없으면 새로 만들어서 입장)
+struct MSG_C2S_QUICK_JOIN
+{
+    MsgHeader header;
+    uint32_t requestId;
+    uint8_t maxPlayers;    // 원하는 방 최대 인원 (0: 상관없음)
+};
+
+// C2S: 게임 시작 요청 (방장만, 응답은 방 전원에게 S2C_GAME_STARTED)
+struct MSG_C2S_GAME_START
+{
+    MsgHeader header;
+    uint32_t requestId;
+};
+
+// C2S: 공격 대상 고르기 방식 변경 (게임 중, 응답 없음). 다음 공격부터 적용
+struct MSG_C2S_GAME_TARGET
+{
+    MsgHeader header;
+    uint8_t mode; // GarbageTargetMode
+};
+
+// C2S: 관전 시작 (방 밖의 세션만, 응답은 S2C_SPECTATE_STATE). 다른 방을 관전 중이면 옮김
+// 관전자는 S2C_BOARD_STREAM / S2C_GAME_OVER를 받음 (첫 메시지는 키프레임)
+struct MSG_C2S_SPECTATE_ROOM
+{
+    MsgHeader header;
+    uint32_t requestId;
+    int32_t roomId;
+};
+
+// C2S: 관전 그만두기 (응답은 S2C_SPECTATE_STATE watching = 0)
+struct MSG_C2S_STOP_SPECTATE
+{
+    MsgHeader header;
+    uint32_t requestId;
+};
+
+// S2C: 관전 상태. 요청 응답이거나, 방이 없어져서 / 방에 입장해서 서버가 관전을 끝낸 경우 (REQUEST_ID_NONE)
+struct MSG_S2C_SPECTATE_STATE
+{
+    MsgHeader header;
+    uint32_t requestId;
+    int32_t roomId;
+    uint8_t watching; // 0: 관전 중 아님, 1: roomId 관전 중
+};
+
+// S2C_GAME_FRAMES 안의 방해 줄 삽입 하나
+// frameOffset 프레임을 모든 보드가 진행한 직후 slot 보드 아래에 lines줄 (구멍 열 hole) 삽입
+// 같은 프레임 안에서는 메시지에 실린 순서대로
+struct GarbageEvent
+{
+    uint8_t frameOffset;  // firstFrame 기준
+    uint8_t slot;
+    uint8_t linesAndHole; // 상위 4비트 lines (1 ~ 15), 하위 4비트 hole (보드 밖이면 엔진이 0열로)
+
+    uint8_t GetLines() const { return static_cast<uint8_t>(linesAndHole >> 4); }
+    uint8_t GetHole() const { return static_cast<uint8_t>(linesAndHole & 0x0F); }
+    void Set(uint8_t lines, uint8_t hole) { linesAndHole = static_cast<uint8_t>((lines << 4) | (hole & 0x0F)); }
+};
+
+#pragma pack(pop)
+
+// 고정 크기 패킷 레이아웃 검사 (컴파일러/패킹 설정이 달라도 양쪽이 같은 크기를 쓰도록)
+static_assert(sizeof(MsgHeader) == 4, "MsgHeader layout changed");
+static_assert(sizeof(MSG_C2S_REQUEST_ROOM_LIST) == 8, "MSG_C2S_REQUEST_ROOM_LIST layout changed");
+static_assert(sizeof(MSG_S2C_ROOM_CREATED) == 13, "MSG_S2C_ROOM_CREATED layout changed");
+static_assert(sizeof(MSG_C2S_JOIN_ROOM) == 12, "MSG_C2S_JOIN_ROOM layout changed");
+static_assert(sizeof(MSG_S2C_ROOM_JOINED) == 13, "MSG_S2C_ROOM_JOINED layout changed");
+static_assert(sizeof(MSG_C2S_LEAVE_ROOM) == 8, "MSG_C2S_LEAVE_ROOM layout changed");
+static_assert(sizeof(MSG_S2C_ROOM_LEFT) == 9, "MSG_S2C_ROOM_LEFT layout changed");
+static_assert(sizeof(MSG_C2S_QUICK_JOIN) == 9, "MSG_C2S_QUICK_JOIN layout changed");
+static_assert(sizeof(MSG_C2S_GAME_START) == 8, "MSG_C2S_GAME_START layout changed");
+static_assert(sizeof(MSG_C2S_GAME_TARGET) == 5, "MSG_C2S_GAME_TARGET layout changed");
+static_assert(sizeof(MSG_C2S_SPECTATE_ROOM) == 12, "MSG_C2S_SPECTATE_ROOM layout changed");
+static_assert(sizeof(MSG_C2S_STOP_SPECTATE) == 8, "MSG_C2S_STOP_SPECTATE layout changed");
+static_assert(sizeof(MSG_S2C_SPECTATE_STATE) == 13, "MSG_S2C_SPECTATE_STATE layout changed");
+static_assert(sizeof(GarbageEvent) == 3, "GarbageEvent layout changed");
+
+// __________________________________________________________________
+//
+// 가변 길이 메시지 (MsgHeader 뒤 본문을 MsgCodec으로 인코딩)
+// 디코딩된 string_view는 수신 버퍼를 가리키므로 핸들러 안에서만 사용
+// __________________________________________________________________
+
+// 방 정보 (목록용)
+// [varuint roomId][string title][varuint currentPlayers][varuint maxPlayers][uint8 status]
+struct RoomInfo
+{
+    int32_t roomId;
+    std::string_view title;
+    int32_t currentPlayers;
+    int32_t maxPlayers;
+    uint8_t status; // 0: WAITING, 1: PLAYING
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(static_cast<uint32_t>(roomId));
+        writer.WriteString(title, ROOM_TITLE_MAX_LEN);
+        writer.WriteVarUInt(static_cast<uint32_t>(currentPlayers));
+        writer.WriteVarUInt(static_cast<uint32_t>(maxPlayers));
+        writer.WriteUInt8(status);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        uint32_t id = 0, current = 0, max = 0;
+        if (!reader.ReadVarUInt(id) || !reader.ReadString(title, ROOM_TITLE_MAX_LEN)
+            || !reader.ReadVarUInt(current) || !reader.ReadVarUInt(max) || !reader.ReadUInt8(status))
+            return false;
+
+        roomId = static_cast<int32_t>(id);
+        currentPlayers = static_cast<int32_t>(current);
+        maxPlayers = static_cast<int32_t>(max);
+        return true;
+    }
+};
+
+// RoomInfo 1개의 최대 인코딩 크기 (버퍼 크기 계산용)
+// varint 4개(roomId, 제목 길이, currentPlayers, maxPlayers) + 제목 + status
+constexpr size_t ROOM_INFO_MAX_ENCODED_SIZE = MAX_VARINT32_SIZE * 4 + ROOM_TITLE_MAX_LEN + 1;
+
+// S2C: 방 목록 응답
+// [varuint requestId][varuint roomCount][RoomInfo * roomCount]
+struct MSG_S2C_ROOM_LIST
+{
+    uint32_t requestId;
+    uint32_t roomCount;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteVarUInt(roomCount);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        return reader.ReadVarUInt(requestId) && reader.ReadVarUInt(roomCount);
+    }
+};
+
+// S2C: 방 목록 페이지 응답
+// [varuint requestId][varint nextCursor][varuint roomCount][RoomInfo * roomCount]
+struct MSG_S2C_ROOM_PAGE
+{
+    uint32_t requestId;
+    int32_t nextCursor;    // 다음 페이지 요청에 그대로 전달 (0: 마지막 페이지)
+    uint32_t roomCount;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteVarInt(nextCursor);
+        writer.WriteVarUInt(roomCount);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        return reader.ReadVarUInt(requestId) && reader.ReadVarInt(nextCursor) && reader.ReadVarUInt(roomCount);
+    }
+};
+
+// C2S: 방 목록 페이지 요청 (커서 기반)
+// [varuint requestId][varint cursor][varuint pageSize][uint8 filterFlags][uint8 status][uint8 minFreeSlots][string titlePrefix]
+// titlePrefix는 ROOM_FILTER_TITLE_PREFIX가 없으면 빈 문자열 (길이 1바이트만)
+struct MSG_C2S_REQUEST_ROOM_PAGE
+{
+    uint32_t requestId;
+    int32_t cursor;               // 이전 응답의 nextCursor (0: 처음부터)
+    uint16_t pageSize;            // 1 ~ ROOM_PAGE_MAX_SIZE
+    uint8_t filterFlags;          // RoomFilterFlags 조합
+    uint8_t status;               // ROOM_FILTER_STATUS 일때 사용
+    uint8_t minFreeSlots;         // ROOM_FILTER_MIN_FREE 일때 사용
+    std::string_view titlePrefix; // ROOM_FILTER_TITLE_PREFIX 일때 사용 (제목보다 길면 맞는 방이 없으므로 ROOM_TITLE_MAX_LEN까지)
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteVarInt(cursor);
+        writer.WriteVarUInt(pageSize);
+        writer.WriteUInt8(filterFlags);
+        writer.WriteUInt8(status);
+        writer.WriteUInt8(minFreeSlots);
+        writer.WriteString((filterFlags & ROOM_FILTER_TITLE_PREFIX) ? titlePrefix : std::string_view(), ROOM_TITLE_MAX_LEN);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        uint32_t size = 0;
+        if (!reader.ReadVarUInt(requestId) || !reader.ReadVarInt(cursor) || !reader.ReadVarUInt(size)
+            || !reader.ReadUInt8(filterFlags) || !reader.ReadUInt8(status) || !reader.ReadUInt8(minFreeSlots)
+            || !reader.ReadString(titlePrefix, ROOM_TITLE_MAX_LEN))
+            return false;
+
+        pageSize = static_cast<uint16_t>((std::min)(size, static_cast<uint32_t>(UINT16_MAX)));
+        return true;
+    }
+};
+
+// MSG_C2S_REQUEST_ROOM_PAGE 최대 인코딩 크기 (헤더 포함)
+constexpr size_t ROOM_PAGE_REQUEST_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE * 4 + 3 + ROOM_TITLE_MAX_LEN;
+
+// 빠른 입장 결과
+enum class QuickJoinResult : uint8_t
+{
+    FAILED = 0,  // 실패 (사유는 S2C_ERROR로 따로 옴)
+    JOINED,      // 기존 방에 입장
+    CREATED      // 맞는 방이 없어서 새로 만들고 입장
+};
+
+// S2C: 빠른 입장 응답 (클라가 목록 없이도 방 화면을 그릴 수 있도록 방 정보를 같이 보냄)
+// [varuint requestId][uint8 result][RoomInfo room (result != FAILED 일때만)]
+struct MSG_S2C_QUICK_JOINED
+{
+    uint32_t requestId;
+    QuickJoinResult result;
+    RoomInfo room;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteUInt8(static_cast<uint8_t>(result));
+        if (result != QuickJoinResult::FAILED)
+        {
+            room.Encode(writer);
+        }
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        uint8_t rawResult = 0;
+        if (!reader.ReadVarUInt(requestId) || !reader.ReadUInt8(rawResult))
+            return false;
+
+        result = static_cast<QuickJoinResult>(rawResult);
+        return result == QuickJoinResult::FAILED || room.Decode(reader);
+    }
+};
+
+// MSG_S2C_QUICK_JOINED 최대 인코딩 크기 (헤더 포함)
+constexpr size_t QUICK_JOINED_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE + 1 + ROOM_INFO_MAX_ENCODED_SIZE;
+
+// C2S: 방 생성 요청
+// [varuint requestId][string title][varuint maxPlayers]
+struct MSG_C2S_CREATE_ROOM
+{
+    uint32_t requestId;
+    std::string_view title;
+    int32_t maxPlayers;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteString(title, ROOM_TITLE_MAX_LEN);
+        writer.WriteVarUInt(static_cast<uint32_t>(maxPlayers));
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        uint32_t max = 0;
+        if (!reader.ReadVarUInt(requestId) || !reader.ReadString(title, ROOM_TITLE_MAX_LEN) || !reader.ReadVarUInt(max))
+            return false;
+
+        maxPlayers = static_cast<int32_t>(max);
+        return true;
+    }
+};
+
+// S2C: 에러 응답 (문자열 없이 코드 + 작은 인자만 전송)
+// [varuint requestId][varuint code][uint8 argCount][varint args * argCount]
+struct MSG_S2C_ERROR
+{
+    uint32_t requestId;
+    ErrorCode code;
+    uint8_t argCount;
+    int32_t args[ERROR_MAX_ARGS];
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteVarUInt(static_cast<uint32_t>(code));
+        uint8_t n = (std::min<uint8_t>)(argCount, ERROR_MAX_ARGS); // Decode가 거부하는 개수를 보내지 않음
+        writer.WriteUInt8(n);
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            writer.WriteVarInt(args[i]);
+        }
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        uint32_t rawCode = 0;
+        if (!reader.ReadVarUInt(requestId) || !reader.ReadVarUInt(rawCode)
+            || !reader.ReadUInt8(argCount) || argCount > ERROR_MAX_ARGS)
+            return false;
+
+        code = static_cast<ErrorCode>(rawCode);
+        for (uint8_t i = 0; i < argCount; ++i)
+        {
+            if (!reader.ReadVarInt(args[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+// MSG_S2C_ERROR 최대 인코딩 크기 (헤더 포함)
+constexpr size_t ERROR_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE * 2 + 1 + MAX_VARINT32_SIZE * ERROR_MAX_ARGS;
+
+// S2C: 게임 시작 (방 전원에게. requestId는 시작을 요청한 방장에게만, 나머지는 REQUEST_ID_NONE)
+// 모든 보드는 같은 seed로 시작하고, 슬롯 순서 = 시작할 때의 입장 순서
+// [varuint requestId][varuint seed][uint8 playerCount][uint8 yourSlot]
+struct MSG_S2C_GAME_STARTED
+{
+    uint32_t requestId;
+    uint32_t seed;
+    uint8_t playerCount;
+    uint8_t yourSlot;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(requestId);
+        writer.WriteVarUInt(seed);
+        writer.WriteUInt8(playerCount);
+        writer.WriteUInt8(yourSlot);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        return reader.ReadVarUInt(requestId) && reader.ReadVarUInt(seed)
+            && reader.ReadUInt8(playerCount) && reader.ReadUInt8(yourSlot)
+            && playerCount <= ROOM_MAX_PLAYERS && yourSlot < playerCount;
+    }
+};
+
+constexpr size_t GAME_STARTED_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE * 2 + 2;
+
+// C2S: 프레임 입력 (firstFrame부터 연속 count프레임, 프레임 번호는 0부터)
+// 이미 보낸 프레임을 다시 보내면 무시되고, 중간 프레임을 건너뛰면 버려짐
+// [varuint firstFrame][uint8 count][uint8 inputs * count]
+struct MSG_C2S_GAME_INPUT
+{
+    uint32_t firstFrame;
+    uint8_t count;
+    const uint8_t* inputs; // 수신 버퍼를 가리킴
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(firstFrame);
+        writer.WriteUInt8(count);
+        writer.WriteBytes(inputs, count);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        return reader.ReadVarUInt(firstFrame) && reader.ReadUInt8(count)
+            && count > 0 && count <= LOCKSTEP_MAX_INPUTS_PER_MSG && reader.ReadBytes(inputs, count);
+    }
+};
+
+constexpr size_t GAME_INPUT_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE + 1 + LOCKSTEP_MAX_INPUTS_PER_MSG;
+
+// S2C: 확정 프레임 입력 + 그 사이의 방해 줄 삽입 (방 전원 같은 바이트). inputs[frame * playerCount + slot]
+// 공격은 서버가 모아서 계산하므로 받는 사람마다 따로 보내지 않고, 이 메시지 하나로 방 전원이 같은 결과를 적용
+// [varuint firstFrame][uint8 frameCount][uint8 playerCount][uint8 inputs * frameCount * playerCount]
+// [uint8 garbageCount][GarbageEvent * garbageCount (frameOffset 순)]
+struct MSG_S2C_GAME_FRAMES
+{
+    uint32_t firstFrame;
+    uint8_t frameCount;
+    uint8_t playerCount;
+    const uint8_t* inputs; // 수신 버퍼를 가리킴
+    uint8_t garbageCount;
+    const GarbageEvent* garbage; // 수신 버퍼를 가리킴
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(firstFrame);
+        writer.WriteUInt8(frameCount);
+        writer.WriteUInt8(playerCount);
+        writer.WriteBytes(inputs, static_cast<size_t>(frameCount) * playerCount);
+        writer.WriteUInt8(garbageCount);
+        writer.WriteBytes(garbage, sizeof(GarbageEvent) * garbageCount);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        const uint8_t* garbageBytes = nullptr;
+        if (!(reader.ReadVarUInt(firstFrame) && reader.ReadUInt8(frameCount) && reader.ReadUInt8(playerCount)
+            && frameCount <= LOCKSTEP_MAX_FRAMES_PER_MSG && playerCount <= ROOM_MAX_PLAYERS
+            && reader.ReadBytes(inputs, static_cast<size_t>(frameCount) * playerCount)
+            && reader.ReadUInt8(garbageCount) && garbageCount <= LOCKSTEP_MAX_GARBAGE_PER_MSG
+            && reader.ReadBytes(garbageBytes, sizeof(GarbageEvent) * garbageCount)))
+        {
+            return false;
+        }
+
+        // GarbageEvent는 1바이트 필드만 있어서 수신 버퍼를 그대로 가리켜도 됨
+        garbage = reinterpret_cast<const GarbageEvent*>(garbageBytes);
+        for (uint8_t i = 0; i < garbageCount; ++i)
+        {
+            if (garbage[i].frameOffset >= frameCount || garbage[i].slot >= playerCount || garbage[i].GetLines() == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+constexpr size_t GAME_FRAMES_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE + 2 + LOCKSTEP_MAX_FRAMES_PER_MSG * ROOM_MAX_PLAYERS
+    + 1 + sizeof(GarbageEvent) * LOCKSTEP_MAX_GARBAGE_PER_MSG;
+static_assert(GAME_FRAMES_MSG_MAX_SIZE <= UINT16_MAX, "S2C_GAME_FRAMES must fit MsgHeader::size");
+
+// S2C: 보드 화면 스트림 (시뮬레이션을 돌리지 않고 보드 상태를 그대로 받는 쪽)
+// 받는 쪽마다 따로 만들지 않고 한 번 인코딩한 바이트를 같이 보냄. 델타 형식과 최대 크기는 BoardDelta.h
+// [varuint frame][uint8 boardCount][uint8 updateCount][(uint8 slot, 보드 델타) * updateCount]
+// 바뀐 보드만 실림. 키프레임 메시지는 모든 보드가 BOARD_DELTA_KEYFRAME 델타
+struct MSG_S2C_BOARD_STREAM
+{
+    uint32_t frame;
+    uint8_t boardCount;
+    uint8_t updateCount;
+    const uint8_t* updates; // 수신 버퍼를 가리킴 (메시지 끝까지)
+    size_t updatesSize;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(frame);
+        writer.WriteUInt8(boardCount);
+        writer.WriteUInt8(updateCount);
+        writer.WriteBytes(updates, updatesSize);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        if (!(reader.ReadVarUInt(frame) && reader.ReadUInt8(boardCount) && reader.ReadUInt8(updateCount)
+            && boardCount <= ROOM_MAX_PLAYERS && updateCount <= boardCount))
+        {
+            return false;
+        }
+        updatesSize = reader.GetRemainSize();
+        return reader.ReadBytes(updates, updatesSize);
+    }
+};
+
+// S2C: 게임 종료 (마지막 S2C_GAME_FRAMES 뒤에 옴). 방은 다시 WAITING
+// [varuint frameCount (확정된 전체 프레임 수)][uint8 winnerSlot (LOCKSTEP_SLOT_NONE: 무승부)]
+struct MSG_S2C_GAME_OVER
+{
+    uint32_t frameCount;
+    uint8_t winnerSlot;
+
+    void Encode(CMsgWriter& writer) const
+    {
+        writer.WriteVarUInt(frameCount);
+        writer.WriteUInt8(winnerSlot);
+    }
+
+    bool Decode(CMsgReader& reader)
+    {
+        return reader.ReadVarUInt(frameCount) && reader.ReadUInt8(winnerSlot);
+    }
+};
+
+constexpr size_t GAME_OVER_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE + 1;
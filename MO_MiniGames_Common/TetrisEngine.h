@@ -0,0 +1,797 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// __________________________________________________________________
+//
+// 테트리스 시뮬레이션 엔진 (클라이언트 / 서버 공용)
+// - 결정적: 정수 연산만 사용. 같은 시드 + 같은 프레임별 입력열이면 어느 쪽에서 돌려도 같은 보드
+// - 할당 없음: 상태는 전부 고정 크기 멤버. 복사로 스냅샷을 뜰 수 있음
+// - 시간 단위는 프레임 (TETRIS_FRAME_RATE). 한 프레임 = Step 한 번
+//
+// 보드: 행 하나를 uint16_t 하나로 (비트보드), rows[0]이 맨 아래
+//   bit 0~2 : 왼쪽 벽 (항상 1)
+//   bit 3~12: 칸 0~9
+//   bit 13~15: 오른쪽 벽 (항상 1)
+//   -> 빈 행 = TETRIS_EMPTY_ROW, 꽉 찬 행 = 0xFFFF. 충돌 검사는 블록 마스크 AND 한 번, 줄 완성 검사는 비교 한 번
+//
+// 블록: 4x4 상자 안의 행 마스크 4개 (bit c = 상자의 c번째 칸), 위치는 상자 왼쪽 칸 x / 맨 윗행 y
+//   상자 r번째 행은 보드 y - r 행에 놓임
+// 회전과 벽 차기는 SRS (Super Rotation System) 표를 컴파일 타임에 만들어 둠
+// __________________________________________________________________
+
+constexpr int32_t TETRIS_FRAME_RATE = 60;
+
+constexpr int32_t TETRIS_BOARD_WIDTH = 10;
+constexpr int32_t TETRIS_VISIBLE_HEIGHT = 20;
+constexpr int32_t TETRIS_BOARD_HEIGHT = 32; // 보이는 20행 + 생성/회전용 숨은 행 (행 32개 = 64바이트)
+
+constexpr int32_t TETRIS_WALL_BITS = 3;
+constexpr uint16_t TETRIS_EMPTY_ROW = 0xE007;
+constexpr uint16_t TETRIS_FULL_ROW = 0xFFFF;
+
+constexpr int32_t TETRIS_PREVIEW_COUNT = 5;
+constexpr int32_t TETRIS_MAX_LEVEL = 20;
+
+// 블록 생성 위치 (상자 기준). 보이는 영역 바로 위 두 행에 걸침
+constexpr int32_t TETRIS_SPAWN_X = 3;
+constexpr int32_t TETRIS_SPAWN_Y = TETRIS_VISIBLE_HEIGHT + 1;
+
+// 바닥에 닿은 뒤 고정까지 유예 (프레임). 이동/회전에 성공하면 다시 셈, 최대 TETRIS_LOCK_RESET_LIMIT번
+constexpr int32_t TETRIS_LOCK_DELAY = 30;
+constexpr int32_t TETRIS_LOCK_RESET_LIMIT = 15;
+
+// 좌우 키를 누르고 있을 때 자동 반복 (프레임): 첫 이동 후 DAS만큼 기다렸다가 ARR마다 한 칸
+constexpr int32_t TETRIS_DAS = 10;
+constexpr int32_t TETRIS_ARR = 2;
+
+// 중력: 프레임당 내려가는 칸 수를 1/65536 단위로 누적
+constexpr uint32_t TETRIS_GRAVITY_ONE = 1u << 16;
+constexpr uint32_t TETRIS_SOFT_DROP_FACTOR = 20;
+constexpr uint32_t TETRIS_MAX_GRAVITY = TETRIS_GRAVITY_ONE * TETRIS_VISIBLE_HEIGHT;
+
+// 레벨별 중력 (가이드라인 곡선 (0.8 - (level - 1) * 0.007)^(level - 1) 초/칸을 60Hz 기준으로 환산)
+constexpr uint32_t TETRIS_LEVEL_GRAVITY[TETRIS_MAX_LEVEL] = {
+    1092, 1377, 1768, 2311, 3075, 4169, 5759, 8107, 11634, 17026,
+    25416, 38709, 60169, 95483, 154742, 256187, 433425, 749597, 1310720, 1310720
+};
+
+enum class TetrisPiece : uint8_t
+{
+    I, J, L, O, S, T, Z,
+    COUNT,
+    NONE = COUNT
+};
+
+constexpr int32_t TETRIS_PIECE_COUNT = static_cast<int32_t>(TetrisPiece::COUNT);
+
+// 프레임 입력 (누르고 있는 키의 비트 조합). 회전 / 하드 드롭 / 홀드는 누른 프레임에만 동작
+enum TetrisInput : uint8_t
+{
+    TETRIS_INPUT_NONE       = 0,
+    TETRIS_INPUT_LEFT       = 1 << 0,
+    TETRIS_INPUT_RIGHT      = 1 << 1,
+    TETRIS_INPUT_SOFT_DROP  = 1 << 2,
+    TETRIS_INPUT_HARD_DROP  = 1 << 3,
+    TETRIS_INPUT_ROTATE_CW  = 1 << 4,
+    TETRIS_INPUT_ROTATE_CCW = 1 << 5,
+    TETRIS_INPUT_HOLD       = 1 << 6,
+    TETRIS_INPUT_RESIGN     = 1 << 7  // 기권 (서버 릴레이가 퇴장한 플레이어 자리에 넣음, 그 프레임에 게임 오버)
+};
+
+// 클라가 보낼 수 있는 입력 비트 (나머지는 서버가 걸러냄)
+constexpr uint8_t TETRIS_INPUT_PLAYER_MASK = 0x7F;
+
+// 블록 모양 표 ///////////////////////////////////////////////////////////////////
+struct TetrisShapeTable
+{
+    uint8_t rows[TETRIS_PIECE_COUNT][4][4]; // [블록][회전 0/R/2/L][상자 행]
+};
+
+constexpr TetrisShapeTable MakeTetrisShapeTable()
+{
+    // 생성 방향 모양과 회전 상자 크기 (O는 회전해도 그대로)
+    constexpr uint8_t spawn[TETRIS_PIECE_COUNT][4] = {
+        { 0x0, 0xF, 0x0, 0x0 }, // I  ....  ####
+        { 0x1, 0x7, 0x0, 0x0 }, // J  #..   ###
+        { 0x4, 0x7, 0x0, 0x0 }, // L  ..#   ###
+        { 0x6, 0x6, 0x0, 0x0 }, // O  .##.  .##.
+        { 0x6, 0x3, 0x0, 0x0 }, // S  .##   ##.
+        { 0x2, 0x7, 0x0, 0x0 }, // T  .#.   ###
+        { 0x3, 0x6, 0x0, 0x0 }, // Z  ##.   .##
+    };
+    constexpr int32_t boxSize[TETRIS_PIECE_COUNT] = { 4, 3, 3, 0, 3, 3, 3 };
+
+    TetrisShapeTable table{};
+    for (int32_t piece = 0; piece < TETRIS_PIECE_COUNT; ++piece)
+    {
+        for (int32_t r = 0; r < 4; ++r)
+        {
+            table.rows[piece][0][r] = spawn[piece][r];
+        }
+
+        int32_t n = boxSize[piece];
+        for (int32_t rotation = 1; rotation < 4; ++rotation)
+        {
+            for (int32_t r = 0; r < 4; ++r)
+            {
+                if (n == 0)
+                {
+                    table.rows[piece][rotation][r] = spawn[piece][r];
+                    continue;
+                }
+
+                // 시계 방향: 새 (r, c) = 이전 (n - 1 - c, r)
+                uint8_t bits = 0;
+                for (int32_t c = 0; c < n && r < n; ++c)
+                {
+                    if (table.rows[piece][rotation - 1][n - 1 - c] & (1 << r))
+                    {
+                        bits = static_cast<uint8_t>(bits | (1 << c));
+                    }
+                }
+                table.rows[piece][rotation][r] = bits;
+            }
+        }
+    }
+    return table;
+}
+
+constexpr TetrisShapeTable TETRIS_SHAPES = MakeTetrisShapeTable();
+
+// SRS 벽 차기 표 [I 여부][현재 회전][0: 시계, 1: 반시계][시도 순서][dx, dy] (dy는 위쪽이 +)
+constexpr int8_t TETRIS_KICKS[2][4][2][5][2] = {
+    { // J, L, S, T, Z
+        { { { 0, 0 }, { -1, 0 }, { -1,  1 }, { 0, -2 }, { -1, -2 } },   // 0 -> R
+          { { 0, 0 }, {  1, 0 }, {  1,  1 }, { 0, -2 }, {  1, -2 } } }, // 0 -> L
+        { { { 0, 0 }, {  1, 0 }, {  1, -1 }, { 0,  2 }, {  1,  2 } },   // R -> 2
+          { { 0, 0 }, {  1, 0 }, {  1, -1 }, { 0,  2 }, {  1,  2 } } }, // R -> 0
+        { { { 0, 0 }, {  1, 0 }, {  1,  1 }, { 0, -2 }, {  1, -2 } },   // 2 -> L
+          { { 0, 0 }, { -1, 0 }, { -1,  1 }, { 0, -2 }, { -1, -2 } } }, // 2 -> R
+        { { { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0,  2 }, { -1,  2 } },   // L -> 0
+          { { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0,  2 }, { -1,  2 } } }, // L -> 2
+    },
+    { // I
+        { { { 0, 0 }, { -2, 0 }, {  1, 0 }, { -2, -1 }, {  1,  2 } },   // 0 -> R
+          { { 0, 0 }, { -1, 0 }, {  2, 0 }, { -1,  2 }, {  2, -1 } } }, // 0 -> L
+        { { { 0, 0 }, { -1, 0 }, {  2, 0 }, { -1,  2 }, {  2, -1 } },   // R -> 2
+          { { 0, 0 }, {  2, 0 }, { -1, 0 }, {  2,  1 }, { -1, -2 } } }, // R -> 0
+        { { { 0, 0 }, {  2, 0 }, { -1, 0 }, {  2,  1 }, { -1, -2 } },   // 2 -> L
+          { { 0, 0 }, {  1, 0 }, { -2, 0 }, {  1, -2 }, { -2,  1 } } }, // 2 -> R
+        { { { 0, 0 }, {  1, 0 }, { -2, 0 }, {  1, -2 }, { -2,  1 } },   // L -> 0
+          { { 0, 0 }, { -2, 0 }, {  1, 0 }, { -2, -1 }, {  1,  2 } } }, // L -> 2
+    },
+};
+
+// 줄 삭제 점수 (x 레벨)
+constexpr uint32_t TETRIS_LINE_SCORE[5] = { 0, 100, 300, 500, 800 };
+
+// __________________________________________________________________
+//
+// 7-bag 블록 생성기
+// 7종을 한 번씩 섞어서 내보내고 다 쓰면 다시 섞음 (같은 블록이 길게 안 나오거나 몰리지 않음)
+// 난수는 xorshift32. 플랫폼 rand()에 의존하지 않으므로 시드만 같으면 순서도 같음
+// __________________________________________________________________
+
+class CTetrisBag
+{
+public:
+    explicit CTetrisBag(uint32_t seed = 0)
+    {
+        Reset(seed);
+    }
+
+    void Reset(uint32_t seed)
+    {
+        // xorshift는 상태 0이면 계속 0
+        _state = (seed != 0) ? seed : 0x9E3779B9u;
+        _index = TETRIS_PIECE_COUNT;
+    }
+
+    TetrisPiece Next()
+    {
+        if (_index == TETRIS_PIECE_COUNT)
+        {
+            Refill();
+        }
+        return static_cast<TetrisPiece>(_pieces[_index++]);
+    }
+
+private:
+    uint32_t NextRandom()
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 17;
+        _state ^= _state << 5;
+        return _state;
+    }
+
+    void Refill()
+    {
+        for (int32_t i = 0; i < TETRIS_PIECE_COUNT; ++i)
+        {
+            _pieces[i] = static_cast<uint8_t>(i);
+        }
+
+        // Fisher-Yates. [0, i] 범위는 나눗셈 대신 곱셈 후 상위 32비트
+        for (int32_t i = TETRIS_PIECE_COUNT - 1; i > 0; --i)
+        {
+            int32_t j = static_cast<int32_t>((static_cast<uint64_t>(NextRandom()) * static_cast<uint32_t>(i + 1)) >> 32);
+            uint8_t temp = _pieces[i];
+            _pieces[i] = _pieces[j];
+            _pieces[j] = temp;
+        }
+        _index = 0;
+    }
+
+private:
+    uint32_t _state;
+    int32_t _index;
+    uint8_t _pieces[TETRIS_PIECE_COUNT];
+};
+
+// 한 프레임 결과 (고정된 블록이 있을 때만 locked = true)
+struct TetrisStepResult
+{
+    bool locked = false;
+    uint8_t linesCleared = 0;
+    uint8_t combo = 0;       // 연속으로 줄을 지운 고정 횟수 - 1 (이번에 안 지웠으면 0)
+    bool backToBack = false; // 직전 삭제도 4줄이었던 4줄 삭제
+    bool gameOver = false;   // 이번 프레임에 게임 오버
+};
+
+// __________________________________________________________________
+//
+// 보드 하나의 시뮬레이션
+// Start(seed)로 시작하고 프레임마다 Step(입력)을 호출한다. 렌더링은 GetRow / GetCell / 현재 블록 조회로
+// 서버는 방의 보드를 전부 60Hz로 돌리므로 Step 경로에는 할당도 가상 호출도 없음
+// 보드 행은 기본적으로 객체 안에 두지만 BindRows로 바깥 저장소(서버의 보드 묶음)에 둘 수 있음
+//  - 자체 행을 쓰는 엔진의 복사본은 행까지 복사됨 (스냅샷)
+//  - 바깥 행을 쓰는 엔진의 복사본은 같은 행을 가리킴 -> 스냅샷이 필요하면 행을 따로 복사할 것
+// __________________________________________________________________
+
+class CTetrisEngine
+{
+public:
+    CTetrisEngine()
+        : _externalRows(nullptr)
+    {
+        Start(0);
+    }
+
+    // 이후 보드 행을 rows(TETRIS_BOARD_HEIGHT개)에 둠. 지금 보드 내용을 옮겨 씀 (nullptr이면 자체 행으로 복귀)
+    void BindRows(uint16_t* rows)
+    {
+        uint16_t* current = Rows();
+        uint16_t* target = (rows != nullptr) ? rows : _ownRows;
+        if (target != current)
+        {
+            std::memcpy(target, current, sizeof(_ownRows));
+        }
+        _externalRows = rows;
+    }
+
+    void Start(uint32_t seed, int32_t startLevel = 1)
+    {
+        uint16_t* rows = Rows();
+        for (int32_t y = 0; y < TETRIS_BOARD_HEIGHT; ++y)
+        {
+            rows[y] = TETRIS_EMPTY_ROW;
+        }
+
+        _bag.Reset(seed);
+        for (int32_t i = 0; i < TETRIS_PREVIEW_COUNT; ++i)
+        {
+            _queue[i] = _bag.Next();
+        }
+        _queueHead = 0;
+
+        _hold = TetrisPiece::NONE;
+        _holdUsed = false;
+
+        _score = 0;
+        _lines = 0;
+        _startLevel = (startLevel < 1) ? 1 : ((startLevel > TETRIS_MAX_LEVEL) ? TETRIS_MAX_LEVEL : startLevel);
+        _level = _startLevel;
+        _combo = -1;
+        _lastClearWasTetris = false;
+
+        _prevInput = TETRIS_INPUT_NONE;
+        _shiftDir = 0;
+        _shiftFrames = 0;
+        _frame = 0;
+        _gameOver = false;
+
+        Spawn(PopQueue());
+    }
+
+    // 한 프레임 진행 (input: TetrisInput 비트 조합, 이번 프레임에 누르고 있는 키)
+    TetrisStepResult Step(uint8_t input)
+    {
+        TetrisStepResult result;
+        if (_gameOver)
+        {
+            return result;
+        }
+
+        ++_frame;
+        if (input & TETRIS_INPUT_RESIGN)
+        {
+            _gameOver = true;
+            result.gameOver = true;
+            return result;
+        }
+
+        uint8_t pressed = static_cast<uint8_t>(input & ~_prevInput);
+        _prevInput = input;
+
+        if (pressed & TETRIS_INPUT_HOLD)
+        {
+            if (!Hold())
+            {
+                result.gameOver = true;
+                return result;
+            }
+        }
+
+        if (pressed & TETRIS_INPUT_ROTATE_CW)
+        {
+            Rotate(0);
+        }
+        if (pressed & TETRIS_INPUT_ROTATE_CCW)
+        {
+            Rotate(1);
+        }
+
+        ApplyShift(input, pressed);
+
+        if (pressed & TETRIS_INPUT_HARD_DROP)
+        {
+            int32_t distance = _pieceY - GetGhostY();
+            _pieceY -= distance;
+            _score += static_cast<uint32_t>(distance) * 2;
+            Lock(result);
+            return result;
+        }
+
+        ApplyGravity((input & TETRIS_INPUT_SOFT_DROP) != 0);
+
+        if (Collides(_piece, _rotation, _pieceX, _pieceY - 1))
+        {
+            if (++_lockTimer >= TETRIS_LOCK_DELAY)
+            {
+                Lock(result);
+            }
+        }
+        else
+        {
+            _lockTimer = 0;
+        }
+        return result;
+    }
+
+    // 방해 줄 (다른 플레이어의 공격) ///////////////////////////////////////////////
+    // 보드 맨 아래에 lines줄을 밀어 넣음 (holeColumn 칸만 비어 있는 줄). 게임 오버가 되면 false
+    // 서버의 보드 묶음은 같은 동작을 SIMD로 한꺼번에 하고 OnRowsInserted만 호출
+    bool InsertGarbage(int32_t lines, int32_t holeColumn)
+    {
+        if (lines <= 0 || _gameOver)
+        {
+            return !_gameOver;
+        }
+        if (lines > TETRIS_BOARD_HEIGHT)
+        {
+            lines = TETRIS_BOARD_HEIGHT;
+        }
+
+        uint16_t* rows = Rows();
+        bool toppedOut = false;
+        for (int32_t y = TETRIS_BOARD_HEIGHT - lines; y < TETRIS_BOARD_HEIGHT; ++y)
+        {
+            toppedOut = toppedOut || (rows[y] != TETRIS_EMPTY_ROW);
+        }
+
+        uint16_t garbage = MakeGarbageRow(holeColumn);
+        std::memmove(rows + lines, rows, sizeof(uint16_t) * (TETRIS_BOARD_HEIGHT - lines));
+        for (int32_t y = 0; y < lines; ++y)
+        {
+            rows[y] = garbage;
+        }
+        return OnRowsInserted(lines, toppedOut);
+    }
+
+    // 보드 행이 바깥에서 lines줄 올라간 뒤 호출. 떨어지는 블록도 같이 올림
+    // toppedOut: 밀려서 버려진 행에 블록이 있었음. 게임 오버면 false
+    bool OnRowsInserted(int32_t lines, bool toppedOut)
+    {
+        _pieceY += lines;
+        _lowestY += lines;
+        if (toppedOut || Collides(_piece, _rotation, _pieceX, _pieceY))
+        {
+            _gameOver = true;
+        }
+        return !_gameOver;
+    }
+
+    static uint16_t MakeGarbageRow(int32_t holeColumn)
+    {
+        if (holeColumn < 0 || holeColumn >= TETRIS_BOARD_WIDTH)
+        {
+            holeColumn = 0;
+        }
+        return static_cast<uint16_t>(TETRIS_FULL_ROW & ~(1u << (holeColumn + TETRIS_WALL_BITS)));
+    }
+
+    // 보드 조회 ////////////////////////////////////////////////////////////////////
+    // 벽 비트 포함 행 (rows[0]이 맨 아래)
+    uint16_t GetRow(int32_t y) const { return Rows()[y]; }
+    const uint16_t* GetRows() const { return Rows(); }
+
+    // 고정된 칸만 (현재 떨어지는 블록은 제외)
+    bool GetCell(int32_t x, int32_t y) const
+    {
+        return (Rows()[y] >> (x + TETRIS_WALL_BITS)) & 1;
+    }
+
+    // 현재 블록의 보드 행 마스크 (벽 비트 위치 기준, 0이면 그 행에 없음)
+    uint16_t GetPieceRowMask(int32_t y) const
+    {
+        int32_t r = _pieceY - y;
+        if (r < 0 || r >= 4)
+        {
+            return 0;
+        }
+        return static_cast<uint16_t>(static_cast<uint32_t>(TETRIS_SHAPES.rows[static_cast<int32_t>(_piece)][_rotation][r]) << (_pieceX + TETRIS_WALL_BITS));
+    }
+
+    // 하드 드롭하면 놓일 상자 y
+    int32_t GetGhostY() const
+    {
+        int32_t y = _pieceY;
+        while (!Collides(_piece, _rotation, _pieceX, y - 1))
+        {
+            --y;
+        }
+        return y;
+    }
+
+    TetrisPiece GetPiece() const { return _piece; }
+    int32_t GetRotation() const { return _rotation; }
+    int32_t GetPieceX() const { return _pieceX; }
+    int32_t GetPieceY() const { return _pieceY; }
+    TetrisPiece GetHold() const { return _hold; }
+    TetrisPiece GetPreview(int32_t index) const { return _queue[(_queueHead + index) % TETRIS_PREVIEW_COUNT]; }
+
+    uint32_t GetScore() const { return _score; }
+    uint32_t GetLines() const { return _lines; }
+    int32_t GetLevel() const { return _level; }
+    uint32_t GetFrame() const { return _frame; }
+    bool IsGameOver() const { return _gameOver; }
+
+    // 블록(piece, rotation)을 상자 위치 (x, y)에 놓으면 벽/바닥/고정된 칸과 겹치는지
+    bool Collides(TetrisPiece piece, int32_t rotation, int32_t x, int32_t y) const
+    {
+        // 상자 왼쪽이 벽 비트보다 더 왼쪽이면 어떤 모양이든 벽에 걸림
+        if (x < -TETRIS_WALL_BITS)
+        {
+            return true;
+        }
+
+        const uint8_t* shape = TETRIS_SHAPES.rows[static_cast<int32_t>(piece)][rotation];
+        const uint16_t* rows = Rows();
+        for (int32_t r = 0; r < 4; ++r)
+        {
+            if (shape[r] == 0)
+            {
+                continue;
+            }
+
+            int32_t row = y - r;
+            if (row < 0 || row >= TETRIS_BOARD_HEIGHT)
+            {
+                return true;
+            }
+
+            // 오른쪽 벽 비트를 넘어가면 16비트 밖으로 나감
+            uint32_t mask = static_cast<uint32_t>(shape[r]) << (x + TETRIS_WALL_BITS);
+            if (mask > 0xFFFF || (mask & rows[row]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    uint16_t* Rows() { return (_externalRows != nullptr) ? _externalRows : _ownRows; }
+    const uint16_t* Rows() const { return (_externalRows != nullptr) ? _externalRows : _ownRows; }
+
+    TetrisPiece PopQueue()
+    {
+        TetrisPiece piece = _queue[_queueHead];
+        _queue[_queueHead] = _bag.Next();
+        _queueHead = (_queueHead + 1) % TETRIS_PREVIEW_COUNT;
+        return piece;
+    }
+
+    // 생성 위치에 놓을 수 없으면 게임 오버 (false)
+    bool Spawn(TetrisPiece piece)
+    {
+        _piece = piece;
+        _rotation = 0;
+        _pieceX = TETRIS_SPAWN_X;
+        _pieceY = TETRIS_SPAWN_Y;
+        _lowestY = _pieceY;
+        _gravityAcc = 0;
+        _lockTimer = 0;
+        _lockResets = 0;
+
+        if (Collides(_piece, _rotation, _pieceX, _pieceY))
+        {
+            _gameOver = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool Hold()
+    {
+        if (_holdUsed)
+        {
+            return true;
+        }
+
+        TetrisPiece current = _piece;
+        TetrisPiece next = (_hold == TetrisPiece::NONE) ? PopQueue() : _hold;
+        _hold = current;
+        _holdUsed = true;
+        return Spawn(next);
+    }
+
+    // 이동/회전 성공 후 호출. 바닥에 닿은 상태면 고정 유예를 다시 셈 (횟수 제한)
+    void OnMoved()
+    {
+        if (_pieceY < _lowestY)
+        {
+            _lowestY = _pieceY;
+            _lockResets = 0;
+        }
+
+        if (_lockResets < TETRIS_LOCK_RESET_LIMIT)
+        {
+            _lockTimer = 0;
+            ++_lockResets;
+        }
+    }
+
+    bool TryMove(int32_t dx, int32_t dy)
+    {
+        if (Collides(_piece, _rotation, _pieceX + dx, _pieceY + dy))
+        {
+            return false;
+        }
+
+        _pieceX += dx;
+        _pieceY += dy;
+        return true;
+    }
+
+    // direction 0: 시계, 1: 반시계. 기본 위치에서 안 되면 SRS 표 순서대로 밀어봄
+    void Rotate(int32_t direction)
+    {
+        int32_t next = (direction == 0) ? ((_rotation + 1) & 3) : ((_rotation + 3) & 3);
+        if (_piece == TetrisPiece::O)
+        {
+            _rotation = next;
+            return;
+        }
+
+        const int8_t (*kicks)[2] = TETRIS_KICKS[_piece == TetrisPiece::I ? 1 : 0][_rotation][direction];
+        for (int32_t i = 0; i < 5; ++i)
+        {
+            int32_t x = _pieceX + kicks[i][0];
+            int32_t y = _pieceY + kicks[i][1];
+            if (!Collides(_piece, next, x, y))
+            {
+                _rotation = next;
+                _pieceX = x;
+                _pieceY = y;
+                OnMoved();
+                return;
+            }
+        }
+    }
+
+    // 좌우 이동 + 자동 반복. 양쪽을 같이 누르면 움직이지 않음
+    void ApplyShift(uint8_t input, uint8_t pressed)
+    {
+        bool left = (input & TETRIS_INPUT_LEFT) != 0;
+        bool right = (input & TETRIS_INPUT_RIGHT) != 0;
+        int32_t dir = (left == right) ? 0 : (left ? -1 : 1);
+
+        if (dir == 0)
+        {
+            _shiftDir = 0;
+            _shiftFrames = 0;
+            return;
+        }
+
+        bool fresh = (dir != _shiftDir) || (pressed & (TETRIS_INPUT_LEFT | TETRIS_INPUT_RIGHT)) != 0;
+        if (fresh)
+        {
+            _shiftDir = dir;
+            _shiftFrames = 0;
+        }
+        else
+        {
+            ++_shiftFrames;
+            if (_shiftFrames < TETRIS_DAS || (_shiftFrames - TETRIS_DAS) % TETRIS_ARR != 0)
+            {
+                return;
+            }
+        }
+
+        if (TryMove(dir, 0))
+        {
+            OnMoved();
+        }
+    }
+
+    void ApplyGravity(bool softDrop)
+    {
+        uint32_t gravity = TETRIS_LEVEL_GRAVITY[_level - 1];
+        if (softDrop)
+        {
+            gravity *= TETRIS_SOFT_DROP_FACTOR;
+        }
+        if (gravity > TETRIS_MAX_GRAVITY)
+        {
+            gravity = TETRIS_MAX_GRAVITY;
+        }
+
+        _gravityAcc += gravity;
+        while (_gravityAcc >= TETRIS_GRAVITY_ONE)
+        {
+            _gravityAcc -= TETRIS_GRAVITY_ONE;
+            if (!TryMove(0, -1))
+            {
+                _gravityAcc = 0;
+                break;
+            }
+
+            if (softDrop)
+            {
+                ++_score;
+            }
+            if (_pieceY < _lowestY)
+            {
+                _lowestY = _pieceY;
+                _lockResets = 0;
+            }
+        }
+    }
+
+    // 블록을 보드에 새기고 줄 삭제, 점수 반영 후 다음 블록 생성
+    void Lock(TetrisStepResult& result)
+    {
+        result.locked = true;
+
+        const uint8_t* shape = TETRIS_SHAPES.rows[static_cast<int32_t>(_piece)][_rotation];
+        uint16_t* rows = Rows();
+        bool belowTop = false;
+        for (int32_t r = 0; r < 4; ++r)
+        {
+            if (shape[r] == 0)
+            {
+                continue;
+            }
+
+            int32_t row = _pieceY - r;
+            rows[row] = static_cast<uint16_t>(rows[row] | (static_cast<uint32_t>(shape[r]) << (_pieceX + TETRIS_WALL_BITS)));
+            if (row < TETRIS_VISIBLE_HEIGHT)
+            {
+                belowTop = true;
+            }
+        }
+
+        int32_t cleared = ClearLines(_pieceY - 3, _pieceY);
+        if (cleared > 0)
+        {
+            bool tetris = (cleared == 4);
+            result.backToBack = tetris && _lastClearWasTetris;
+            _lastClearWasTetris = tetris;
+            ++_combo;
+
+            uint32_t points = TETRIS_LINE_SCORE[cleared] * static_cast<uint32_t>(_level);
+            if (result.backToBack)
+            {
+                points += points / 2;
+            }
+            _score += points + 50u * static_cast<uint32_t>(_combo) * static_cast<uint32_t>(_level);
+
+            _lines += static_cast<uint32_t>(cleared);
+            int32_t level = _startLevel + static_cast<int32_t>(_lines / 10);
+            _level = (level > TETRIS_MAX_LEVEL) ? TETRIS_MAX_LEVEL : level;
+        }
+        else
+        {
+            _combo = -1;
+        }
+
+        result.linesCleared = static_cast<uint8_t>(cleared);
+        result.combo = static_cast<uint8_t>(_combo > 0 ? _combo : 0);
+
+        // 전부 보이는 영역 위에서 고정되면 게임 오버 (lock out)
+        _holdUsed = false;
+        if (!belowTop || !Spawn(PopQueue()))
+        {
+            _gameOver = true;
+            result.gameOver = true;
+        }
+    }
+
+    // [fromRow, toRow] 범위에서 꽉 찬 행을 지우고 위쪽 행을 내림. 지운 행 수 리턴
+    int32_t ClearLines(int32_t fromRow, int32_t toRow)
+    {
+        if (fromRow < 0)
+        {
+            fromRow = 0;
+        }
+
+        uint16_t* rows = Rows();
+        int32_t write = fromRow;
+        for (int32_t read = fromRow; read < TETRIS_BOARD_HEIGHT; ++read)
+        {
+            if (read <= toRow && rows[read] == TETRIS_FULL_ROW)
+            {
+                continue;
+            }
+            rows[write++] = rows[read];
+        }
+
+        int32_t cleared = TETRIS_BOARD_HEIGHT - write;
+        while (write < TETRIS_BOARD_HEIGHT)
+        {
+            rows[write++] = TETRIS_EMPTY_ROW;
+        }
+        return cleared;
+    }
+
+private:
+    uint16_t _ownRows[TETRIS_BOARD_HEIGHT];
+    uint16_t* _externalRows; // BindRows로 받은 바깥 행 (nullptr이면 _ownRows)
+
+    CTetrisBag _bag;
+    TetrisPiece _queue[TETRIS_PREVIEW_COUNT]; // 미리보기 (원형, _queueHead가 다음 블록)
+    int32_t _queueHead;
+
+    // 떨어지는 블록
+    TetrisPiece _piece;
+    int32_t _rotation;
+    int32_t _pieceX;
+    int32_t _pieceY;
+    int32_t _lowestY;     // 이 블록이 내려간 가장 낮은 y (더 내려가면 고정 유예 횟수 초기화)
+    uint32_t _gravityAcc; // 1/65536칸 단위 누적
+    int32_t _lockTimer;
+    int32_t _lockResets;
+
+    TetrisPiece _hold;
+    bool _holdUsed; // 블록 하나당 홀드 한 번
+
+    uint32_t _score;
+    uint32_t _lines;
+    int32_t _startLevel;
+    int32_t _level;
+    int32_t _combo; // -1: 직전 고정에서 줄을 못 지움
+    bool _lastClearWasTetris;
+
+    // 입력 상태 (누른 프레임 판별, 좌우 자동 반복)
+    uint8_t _prevInput;
+    int32_t _shiftDir;
+    int32_t _shiftFrames;
+
+    uint32_t _frame;
+    bool _gameOver;
+};
@@ -0,0 +1,142 @@
+#include "ActorScheduler.h"
+#include "AsyncLogger.h"
+#include <algorithm>
+
+CActor::CActor(CActorWorkerPool& pool)
+    : _pool(pool)
+    , _scheduled(false)
+{
+}
+
+CActor::~CActor()
+{
+}
+
+void CActor::Notify()
+{
+    // 메시지 공개(메일박스 순번 store)와 플래그 확인 사이 순서 보장. Run 쪽 fence와 짝
+    // -> 워커가 플래그를 내린 뒤 메시지를 못 봤다면, 여기서는 반드시 내려간 플래그를 봄
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!_scheduled.exchange(true))
+    {
+        _pool.Schedule(this);
+    }
+}
+
+void CActor::Run(size_t budget)
+{
+    ProcessMessages(budget);
+
+    // 플래그를 내린 뒤에 남은 메시지를 확인 (반대 순서면 그 사이 들어온 메시지를 아무도 안 올림)
+    _scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasPendingMessages() && !_scheduled.exchange(true))
+    {
+        _pool.Schedule(this);
+    }
+}
+
+CActorWorkerPool::CActorWorkerPool(int32_t threadCount, size_t maxActors, size_t messageBudget)
+    : _threadCount((threadCount > 0) ? threadCount : static_cast<int32_t>((std::max)(1u, std::thread::hardware_concurrency())))
+    , _messageBudget((messageBudget > 0) ? messageBudget : ACTOR_DEFAULT_MESSAGE_BUDGET)
+    , _threads()
+    , _mutex()
+    , _cv()
+    , _ready((std::max)(maxActors, static_cast<size_t>(1)), nullptr)
+    , _readyHead(0)
+    , _readyCount(0)
+    , _running(false)
+{
+}
+
+CActorWorkerPool::~CActorWorkerPool()
+{
+    Stop();
+}
+
+void CActorWorkerPool::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_running)
+        {
+            return;
+        }
+        _running = true;
+    }
+
+    _threads.reserve(_threadCount);
+    for (int32_t i = 0; i < _threadCount; ++i)
+    {
+        _threads.emplace_back(&CActorWorkerPool::WorkerThread, this);
+    }
+}
+
+void CActorWorkerPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+
+    _cv.notify_all();
+    for (std::thread& thread : _threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    _threads.clear();
+}
+
+void CActorWorkerPool::Schedule(CActor* actor)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_readyCount == _ready.size())
+        {
+            // 선언한 것보다 많은 액터가 대기열에 올라옴. 버리면 그 액터가 영영 실행되지 않으므로 늘림
+            LOG_WARNING("[ActorWorkerPool] Ready queue full ({}), growing", _ready.size());
+
+            std::vector<CActor*> grown(_ready.size() * 2, nullptr);
+            for (size_t i = 0; i < _readyCount; ++i)
+            {
+                grown[i] = _ready[(_readyHead + i) % _ready.size()];
+            }
+            _ready.swap(grown);
+            _readyHead = 0;
+        }
+
+        _ready[(_readyHead + _readyCount) % _ready.size()] = actor;
+        ++_readyCount;
+    }
+
+    _cv.notify_one();
+}
+
+void CActorWorkerPool::WorkerThread()
+{
+    while (true)
+    {
+        CActor* actor = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return !_running || _readyCount > 0; });
+            if (!_running)
+            {
+                return;
+            }
+
+            actor = _ready[_readyHead];
+            _readyHead = (_readyHead + 1) % _ready.size();
+            --_readyCount;
+        }
+
+        actor->Run(_messageBudget);
+    }
+}
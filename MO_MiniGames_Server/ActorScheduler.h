@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 워커가 액터 하나를 한 번 잡았을 때 처리하는 최대 메시지 수 (한 방이 워커를 오래 붙잡지 않도록)
+constexpr size_t ACTOR_DEFAULT_MESSAGE_BUDGET = 64;
+
+class CActorWorkerPool;
+
+// __________________________________________________________________
+//
+// 액터 기반 클래스
+// 메일박스에 메시지가 들어오면 공용 워커 풀의 실행 대기열에 한 번만 올라가고,
+// 워커 하나가 꺼내서 처리 -> 같은 액터를 두 워커가 동시에 실행하는 일이 없으므로 액터 상태에는 락이 필요 없음
+// (_scheduled 플래그: 대기열에 있거나 실행 중이면 true. 다시 올리는 것은 false -> true로 바꾼 쪽만)
+// 메일박스 종류와 메시지 처리는 하위 클래스가 정함
+// __________________________________________________________________
+
+class CActor
+{
+public:
+    explicit CActor(CActorWorkerPool& pool);
+    virtual ~CActor();
+
+    CActor(const CActor&) = delete;
+    CActor& operator=(const CActor&) = delete;
+
+protected:
+    // 메일박스에 메시지를 넣은 뒤 호출 (아무 스레드). 이미 대기열에 있거나 실행 중이면 아무것도 안 함
+    void Notify();
+
+    // 워커 스레드에서 호출. 한 번에 한 워커만 들어오며 메시지를 최대 budget개 처리
+    virtual void ProcessMessages(size_t budget) = 0;
+
+    // 처리할 메시지가 남았는지 (ProcessMessages를 마친 워커가 다시 대기열에 올릴지 판단)
+    virtual bool HasPendingMessages() const = 0;
+
+private:
+    friend class CActorWorkerPool;
+
+    void Run(size_t budget);
+
+    CActorWorkerPool& _pool;
+    std::atomic<bool> _scheduled;
+};
+
+// __________________________________________________________________
+//
+// 액터 공용 워커 풀
+// 실행할 메시지가 있는 액터만 대기열(FIFO)에 올라옴. 처리 예산을 다 쓰고도 남은 액터는 맨 뒤로 돌아가므로
+// 메시지가 몰린 방이 있어도 다른 방들이 같이 진행됨
+// 대기열은 액터 수만큼 미리 잡아둠 (액터는 대기열에 최대 한 번만 있으므로 보통 넘치지 않음)
+// __________________________________________________________________
+
+class CActorWorkerPool
+{
+public:
+    // threadCount가 0 이하면 하드웨어 스레드 수
+    CActorWorkerPool(int32_t threadCount, size_t maxActors, size_t messageBudget = ACTOR_DEFAULT_MESSAGE_BUDGET);
+    ~CActorWorkerPool();
+
+    CActorWorkerPool(const CActorWorkerPool&) = delete;
+    CActorWorkerPool& operator=(const CActorWorkerPool&) = delete;
+
+    void Start();
+    void Stop(); // 대기열에 남은 액터는 처리하지 않음
+
+    int32_t GetThreadCount() const { return _threadCount; }
+
+private:
+    friend class CActor;
+
+    void Schedule(CActor* actor); // 아무 스레드
+    void WorkerThread();
+
+    int32_t _threadCount;
+    size_t _messageBudget;
+    std::vector<std::thread> _threads;
+
+    // 실행 대기열 (원형 버퍼)
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<CActor*> _ready;
+    size_t _readyHead;
+    size_t _readyCount;
+    bool _running;
+};
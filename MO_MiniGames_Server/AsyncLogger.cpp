@@ -0,0 +1,284 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+bool LogSite::Admit(uint32_t& outSuppressed)
+{
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t window = std::chrono::duration_cast<std::chrono::milliseconds>(LOG_RATE_WINDOW).count();
+
+    // 창이 지났으면 처음 본 스레드 하나만 새 창을 엶 (경계에서 몇 개 더 나가는 정도의 오차는 허용)
+    int64_t start = windowStart.load(std::memory_order_relaxed);
+    if (now - start >= window && windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    if (count.fetch_add(1, std::memory_order_relaxed) >= LOG_RATE_LIMIT_PER_SITE)
+    {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    outSuppressed = suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+CAsyncLogger& CAsyncLogger::Get()
+{
+    static CAsyncLogger logger;
+    return logger;
+}
+
+CAsyncLogger::CAsyncLogger()
+    : _minLevel(LogLevel::Info)
+    , _ringsMutex()
+    , _rings()
+    , _draining()
+    , _threadMutex()
+    , _cv()
+    , _thread()
+    , _running(false)
+    , _line()
+{
+}
+
+CAsyncLogger::~CAsyncLogger()
+{
+    Stop();
+}
+
+void CAsyncLogger::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        if (_running)
+        {
+            return;
+        }
+        _running = true;
+    }
+
+    _thread = std::thread(&CAsyncLogger::LoggerThread, this);
+}
+
+void CAsyncLogger::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+
+    _cv.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+CAsyncLogger::CRing::CRing()
+    : records(LOG_RING_CAPACITY)
+    , head(0)
+    , tail(0)
+    , dropped(0)
+    , retired(false)
+{
+}
+
+LogRecord* CAsyncLogger::CRing::BeginPush()
+{
+    uint32_t currentTail = tail.load(std::memory_order_relaxed);
+    if (currentTail - head.load(std::memory_order_acquire) >= LOG_RING_CAPACITY)
+    {
+        return nullptr;
+    }
+    return &records[currentTail & (LOG_RING_CAPACITY - 1)];
+}
+
+void CAsyncLogger::CRing::EndPush()
+{
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+CAsyncLogger::CThreadRingHolder::~CThreadRingHolder()
+{
+    if (ring)
+    {
+        ring->retired.store(true, std::memory_order_release);
+    }
+}
+
+CAsyncLogger::CRing& CAsyncLogger::GetThreadRing()
+{
+    // 스레드마다 처음 한 번만 할당 + 등록
+    thread_local CThreadRingHolder holder;
+    if (!holder.ring)
+    {
+        holder.ring = std::make_shared<CRing>();
+
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        _rings.push_back(holder.ring);
+    }
+    return *holder.ring;
+}
+
+void CAsyncLogger::CaptureText(LogRecord& record, LogArg& arg, std::string_view value)
+{
+    size_t length = (std::min)(value.size(), LOG_TEXT_CAPACITY - record.textSize);
+    std::memcpy(record.text + record.textSize, value.data(), length);
+
+    arg.type = LogArg::Type::Text;
+    arg.text.offset = record.textSize;
+    arg.text.length = static_cast<uint16_t>(length);
+    record.textSize = static_cast<uint16_t>(record.textSize + length);
+}
+
+void CAsyncLogger::LoggerThread()
+{
+    while (true)
+    {
+        bool running = false;
+        {
+            std::unique_lock<std::mutex> lock(_threadMutex);
+            _cv.wait_for(lock, LOG_FLUSH_INTERVAL, [this] { return !_running; });
+            running = _running;
+        }
+
+        // 밀린 만큼 다 비움 (종료할 때도 남은 로그를 모두 출력)
+        while (DrainRings())
+        {
+        }
+
+        if (!running)
+        {
+            return;
+        }
+    }
+}
+
+bool CAsyncLogger::DrainRings()
+{
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+
+        // 끝난 스레드의 링은 다 비운 뒤에 목록에서 뺌
+        _rings.erase(std::remove_if(_rings.begin(), _rings.end(), [](const std::shared_ptr<CRing>& ring)
+        {
+            return ring->retired.load(std::memory_order_acquire)
+                && ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_acquire)
+                && ring->dropped.load(std::memory_order_relaxed) == 0;
+        }), _rings.end());
+
+        _draining.assign(_rings.begin(), _rings.end());
+    }
+
+    bool wrote = false;
+    bool wroteError = false;
+    for (const std::shared_ptr<CRing>& ring : _draining)
+    {
+        uint32_t head = ring->head.load(std::memory_order_relaxed);
+        uint32_t tail = ring->tail.load(std::memory_order_acquire);
+        wrote = wrote || head != tail;
+
+        for (; head != tail; ++head)
+        {
+            const LogRecord& record = ring->records[head & (LOG_RING_CAPACITY - 1)];
+            FormatRecord(record, _line);
+
+            if (record.level >= LogLevel::Warning)
+            {
+                std::cerr << _line << '\n';
+                wroteError = true;
+            }
+            else
+            {
+                std::cout << _line << '\n';
+            }
+        }
+        ring->head.store(head, std::memory_order_release);
+
+        uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            std::cerr << "[Logger] " << dropped << " records dropped (log ring full)" << '\n';
+            wrote = true;
+            wroteError = true;
+        }
+    }
+
+    if (wrote)
+    {
+        std::cout.flush();
+        if (wroteError)
+        {
+            std::cerr.flush();
+        }
+    }
+
+    _draining.clear();
+    return wrote;
+}
+
+void CAsyncLogger::FormatRecord(const LogRecord& record, std::string& outLine) const
+{
+    static const char* const LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+
+    std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+    int32_t millis = static_cast<int32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.time.time_since_epoch()).count() % 1000);
+
+    std::tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%03d %-5s ",
+        local.tm_hour, local.tm_min, local.tm_sec, millis, LEVEL_NAMES[static_cast<int32_t>(record.level)]);
+
+    outLine.assign(prefix);
+
+    // {} 자리에 인자를 순서대로 (남는 {}는 그대로 둠)
+    uint8_t argIndex = 0;
+    for (const char* p = record.format; *p; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && argIndex < record.argCount)
+        {
+            const LogArg& arg = record.args[argIndex++];
+            switch (arg.type)
+            {
+            case LogArg::Type::Int:
+                outLine += std::to_string(arg.i);
+                break;
+            case LogArg::Type::UInt:
+                outLine += std::to_string(arg.u);
+                break;
+            case LogArg::Type::Double:
+                outLine += std::to_string(arg.d);
+                break;
+            case LogArg::Type::Text:
+                outLine.append(record.text + arg.text.offset, arg.text.length);
+                break;
+            }
+            ++p;
+            continue;
+        }
+        outLine += *p;
+    }
+
+    if (record.suppressed > 0)
+    {
+        outLine += " (+";
+        outLine += std::to_string(record.suppressed);
+        outLine += " similar suppressed)";
+    }
+}
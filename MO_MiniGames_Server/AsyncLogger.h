@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// __________________________________________________________________
+//
+// 비동기 로거
+// 로그를 남기는 스레드(로직 스레드, IOCP 워커)는 포맷 문자열 포인터와 인자 값만 자기 스레드 링에 복사하고 바로 리턴
+// 문자열 만들기와 콘솔 출력은 로거 스레드가 나중에 함 -> 콘솔이 느려도 호출한 스레드는 기다리지 않음
+//  - 스레드마다 SPSC 링 하나 (처음 로그를 남길 때 등록, 이후 락 없음)
+//  - 링이 가득 차면 기다리지 않고 버림 (버린 개수는 로거 스레드가 따로 출력)
+//  - 레벨 필터: SetMinLevel 미만은 인자 평가도 하지 않음
+//  - 같은 위치의 로그는 LOG_RATE_WINDOW 동안 LOG_RATE_LIMIT_PER_SITE개까지만, 나머지는 개수만 세서 다음 줄에 붙임
+// 사용법: LOG_ERROR("[IOCPServer] WSASend failed: {} - SessionId: {}", error, sessionId);
+// 포맷 문자열은 반드시 문자열 리터럴 (포인터만 저장하고 나중에 읽음). {} 자리에 인자가 순서대로 들어감
+// __________________________________________________________________
+
+enum class LogLevel : uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+constexpr size_t LOG_MAX_ARGS = 12;
+constexpr size_t LOG_TEXT_CAPACITY = 128;        // 레코드 하나의 문자열 인자 복사 공간 (넘으면 잘림)
+constexpr size_t LOG_RING_CAPACITY = 1024;       // 스레드당 레코드 수 (2의 거듭제곱)
+constexpr uint32_t LOG_RATE_LIMIT_PER_SITE = 20;
+constexpr auto LOG_RATE_WINDOW = std::chrono::seconds(1);
+constexpr auto LOG_FLUSH_INTERVAL = std::chrono::milliseconds(10); // 로거 스레드가 링을 비우는 주기
+
+static_assert((LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "log ring capacity must be a power of two");
+
+// 로그 인자 하나 (문자열은 레코드의 text 영역에 복사하고 위치만 가짐)
+struct LogArg
+{
+    enum class Type : uint8_t
+    {
+        Int,
+        UInt,
+        Double,
+        Text
+    };
+
+    Type type;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        struct
+        {
+            uint16_t offset;
+            uint16_t length;
+        } text;
+    };
+};
+
+// 링에 들어가는 바이너리 레코드 (포맷 전)
+struct LogRecord
+{
+    const char* format;
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    uint8_t argCount;
+    uint16_t textSize;
+    uint32_t suppressed; // 이 레코드 직전까지 속도 제한으로 버려진 같은 위치 로그 수
+    LogArg args[LOG_MAX_ARGS];
+    char text[LOG_TEXT_CAPACITY];
+};
+
+// 로그 호출 위치 하나의 속도 제한 상태 (LOG_* 매크로가 위치마다 static으로 하나씩 만듦)
+struct LogSite
+{
+    std::atomic<int64_t> windowStart{ 0 }; // steady_clock ms
+    std::atomic<uint32_t> count{ 0 };
+    std::atomic<uint32_t> suppressed{ 0 };
+
+    // 이번 창에서 더 남길 수 있으면 true + 그동안 버린 개수
+    bool Admit(uint32_t& outSuppressed);
+};
+
+class CAsyncLogger
+{
+public:
+    static CAsyncLogger& Get();
+
+    // 로거 스레드 시작 / 종료 (종료 시 남은 로그를 모두 출력). 시작 전에 남긴 로그는 링에 쌓였다가 시작 후 출력
+    void Start();
+    void Stop();
+
+    void SetMinLevel(LogLevel level) { _minLevel.store(level, std::memory_order_relaxed); }
+    bool IsEnabled(LogLevel level) const { return level >= _minLevel.load(std::memory_order_relaxed); }
+
+    template <typename... Args>
+    void Write(LogLevel level, LogSite& site, const char* format, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+
+        uint32_t suppressed = 0;
+        if (!site.Admit(suppressed))
+        {
+            return;
+        }
+
+        CRing& ring = GetThreadRing();
+        LogRecord* record = ring.BeginPush();
+        if (!record)
+        {
+            ring.dropped.fetch_add(1 + suppressed, std::memory_order_relaxed);
+            return;
+        }
+
+        record->format = format;
+        record->time = std::chrono::system_clock::now();
+        record->level = level;
+        record->argCount = 0;
+        record->textSize = 0;
+        record->suppressed = suppressed;
+        (Capture(*record, args), ...);
+
+        ring.EndPush();
+    }
+
+private:
+    // 단일 생산자(소유 스레드) / 단일 소비자(로거 스레드) 링
+    struct CRing
+    {
+        CRing();
+
+        LogRecord* BeginPush();
+        void EndPush();
+
+        std::vector<LogRecord> records;
+        alignas(64) std::atomic<uint32_t> head; // 로거 스레드가 다음에 읽을 위치
+        alignas(64) std::atomic<uint32_t> tail; // 소유 스레드가 다음에 쓸 위치
+        std::atomic<uint64_t> dropped;          // 링이 가득 차서 버린 개수
+        std::atomic<bool> retired;              // 소유 스레드 종료 (비우고 나면 목록에서 뺌)
+    };
+
+    // 스레드 종료 시 링을 retired로 표시
+    struct CThreadRingHolder
+    {
+        ~CThreadRingHolder();
+        std::shared_ptr<CRing> ring;
+    };
+
+    CAsyncLogger();
+    ~CAsyncLogger();
+
+    CAsyncLogger(const CAsyncLogger&) = delete;
+    CAsyncLogger& operator=(const CAsyncLogger&) = delete;
+
+    CRing& GetThreadRing();
+
+    template <typename T>
+    static void Capture(LogRecord& record, const T& value)
+    {
+        LogArg& arg = record.args[record.argCount++];
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            arg.type = LogArg::Type::UInt;
+            arg.u = value ? 1 : 0;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            arg.type = LogArg::Type::Int;
+            arg.i = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        {
+            arg.type = LogArg::Type::Int;
+            arg.i = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            arg.type = LogArg::Type::UInt;
+            arg.u = static_cast<uint64_t>(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            arg.type = LogArg::Type::Double;
+            arg.d = static_cast<double>(value);
+        }
+        else
+        {
+            static_assert(std::is_convertible_v<const T&, std::string_view>, "unsupported log argument type");
+            CaptureText(record, arg, std::string_view(value));
+        }
+    }
+
+    static void CaptureText(LogRecord& record, LogArg& arg, std::string_view value);
+
+    void LoggerThread();
+    bool DrainRings(); // 하나라도 출력했으면 true
+    void FormatRecord(const LogRecord& record, std::string& outLine) const;
+
+private:
+    std::atomic<LogLevel> _minLevel;
+
+    std::mutex _ringsMutex;
+    std::vector<std::shared_ptr<CRing>> _rings;   // _ringsMutex
+    std::vector<std::shared_ptr<CRing>> _draining; // 로거 스레드 전용 (_rings 복사본)
+
+    std::mutex _threadMutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+    bool _running; // _threadMutex
+
+    std::string _line; // 로거 스레드 전용 (한 줄 포맷 버퍼)
+};
+
+#define LOG_WRITE(level, format, ...)                                                   \
+    do                                                                                  \
+    {                                                                                   \
+        if (CAsyncLogger::Get().IsEnabled(level))                                       \
+        {                                                                               \
+            static LogSite logSite_;                                                    \
+            CAsyncLogger::Get().Write(level, logSite_, format, ##__VA_ARGS__);          \
+        }                                                                               \
+    } while (0)
+
+#define LOG_DEBUG(format, ...) LOG_WRITE(LogLevel::Debug, format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_WRITE(LogLevel::Info, format, ##__VA_ARGS__)
+#define LOG_WARNING(format, ...) LOG_WRITE(LogLevel::Warning, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG_WRITE(LogLevel::Error, format, ##__VA_ARGS__)
@@ -0,0 +1,285 @@
+#include "AttackRouter.h"
+#include <algorithm>
+
+CAttackRouter::CAttackRouter()
+    : _queues()
+    , _modes()
+    , _lastTarget()
+    , _playerCount(0)
+    , _random(1)
+    , _usedRows()
+    , _usedRowsValid(false)
+    , _sentLines(0)
+    , _cancelledLines(0)
+    , _insertedLines(0)
+{
+}
+
+void CAttackRouter::Start(uint32_t seed, int32_t playerCount)
+{
+    _playerCount = (std::max)(0, (std::min)(playerCount, ROOM_MAX_PLAYERS));
+    _random = (seed ^ 0x9E3779B9u) | 1; // 블록 순서와 다른 수열 (0이면 멈춤)
+    _sentLines = 0;
+    _cancelledLines = 0;
+    _insertedLines = 0;
+
+    for (int32_t slot = 0; slot < ROOM_MAX_PLAYERS; ++slot)
+    {
+        _queues[slot].head = 0;
+        _queues[slot].count = 0;
+        _queues[slot].totalLines = 0;
+        _modes[slot] = GarbageTargetMode::RANDOM;
+        _lastTarget[slot] = -1;
+    }
+}
+
+void CAttackRouter::SetTargetMode(int32_t slot, GarbageTargetMode mode)
+{
+    if (slot >= 0 && slot < _playerCount && mode < GarbageTargetMode::COUNT)
+    {
+        _modes[slot] = mode;
+    }
+}
+
+uint8_t CAttackRouter::GetAttackLines(const TetrisStepResult& result)
+{
+    if (!result.locked || result.linesCleared == 0)
+    {
+        return 0;
+    }
+
+    constexpr size_t comboCount = sizeof(GARBAGE_COMBO_BONUS) / sizeof(GARBAGE_COMBO_BONUS[0]);
+    int32_t lines = GARBAGE_ATTACK_BY_LINES[(std::min)(static_cast<size_t>(result.linesCleared), size_t(4))]
+        + GARBAGE_COMBO_BONUS[(std::min)(static_cast<size_t>(result.combo), comboCount - 1)]
+        + (result.backToBack ? GARBAGE_BACK_TO_BACK_BONUS : 0);
+    return static_cast<uint8_t>((std::min)(lines, static_cast<int32_t>(GARBAGE_MAX_CHUNK_LINES)));
+}
+
+size_t CAttackRouter::ResolveFrame(uint32_t frame, const TetrisStepResult* results, const bool* alive,
+    const CTetrisBoardBatch& boards, GarbageInsertion* outInsertions)
+{
+    // 1. 이번 프레임 공격을 전부 모음
+    uint8_t attacks[ROOM_MAX_PLAYERS];
+    bool anyAttack = false;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        attacks[slot] = alive[slot] ? GetAttackLines(results[slot]) : 0;
+        anyAttack = anyAttack || (attacks[slot] > 0);
+    }
+
+    if (anyAttack)
+    {
+        // 2. 상쇄를 먼저 모두 끝냄 (같은 프레임에 서로 보낸 공격으로 상쇄하지 않도록, 슬롯 순서와 무관)
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (attacks[slot] > 0)
+            {
+                uint8_t cancelled = Cancel(slot, attacks[slot]);
+                attacks[slot] = static_cast<uint8_t>(attacks[slot] - cancelled);
+                _cancelledLines += cancelled;
+            }
+        }
+
+        // 3. 남은 공격을 대상에게 (대기열에 넣기만 하고 이번 프레임에는 올라오지 않음)
+        _usedRowsValid = false;
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (attacks[slot] == 0)
+            {
+                continue;
+            }
+
+            int32_t target = PickTarget(slot, alive, boards);
+            if (target < 0)
+            {
+                continue; // 상대가 없음 (같은 프레임에 모두 탈락)
+            }
+
+            _lastTarget[slot] = static_cast<int8_t>(target);
+            Push(target, frame + GARBAGE_DELAY_FRAMES, attacks[slot]);
+            _sentLines += attacks[slot];
+        }
+    }
+
+    // 4. 줄을 지우지 않고 고정한 슬롯에 대기가 끝난 묶음을 올림
+    size_t insertionCount = 0;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        GarbageQueue& queue = _queues[slot];
+        if (!alive[slot] || queue.count == 0 || !results[slot].locked || results[slot].linesCleared > 0)
+        {
+            continue;
+        }
+
+        uint8_t budget = GARBAGE_MAX_LINES_PER_LOCK;
+        for (size_t chunkCount = 0; chunkCount < GARBAGE_MAX_CHUNKS_PER_LOCK && queue.count > 0 && budget > 0; ++chunkCount)
+        {
+            GarbageChunk& chunk = queue.chunks[queue.head];
+            if (chunk.readyFrame > frame)
+            {
+                break; // 뒤 묶음은 더 늦게 들어왔으므로 모두 대기 중
+            }
+
+            // 한도를 넘는 묶음은 나눠서 나머지는 같은 구멍으로 다음 고정 때
+            uint8_t lines = (std::min)(chunk.lines, budget);
+            GarbageInsertion& insertion = outInsertions[insertionCount++];
+            insertion.slot = static_cast<uint8_t>(slot);
+            insertion.lines = lines;
+            insertion.hole = chunk.hole;
+
+            budget = static_cast<uint8_t>(budget - lines);
+            chunk.lines = static_cast<uint8_t>(chunk.lines - lines);
+            queue.totalLines -= lines;
+            _insertedLines += lines;
+
+            if (chunk.lines == 0)
+            {
+                queue.head = static_cast<uint8_t>((queue.head + 1) % GARBAGE_QUEUE_CAPACITY);
+                --queue.count;
+            }
+        }
+    }
+
+    return insertionCount;
+}
+
+int32_t CAttackRouter::PickTarget(int32_t attacker, const bool* alive, const CTetrisBoardBatch& boards)
+{
+    switch (_modes[attacker])
+    {
+    case GarbageTargetMode::EVEN:
+        // 마지막 대상 다음 슬롯부터 살아 있는 상대
+        for (int32_t step = 1; step <= _playerCount; ++step)
+        {
+            int32_t slot = (_lastTarget[attacker] + _playerCount + step) % _playerCount;
+            if (slot != attacker && alive[slot])
+            {
+                return slot;
+            }
+        }
+        return -1;
+
+    case GarbageTargetMode::KO:
+    {
+        if (!_usedRowsValid)
+        {
+            boards.FindUsedRows(static_cast<size_t>(_playerCount), _usedRows);
+            _usedRowsValid = true;
+        }
+
+        // 스택이 가장 높은 상대 (같으면 앞 슬롯). 이번 프레임 공격 전 높이 기준
+        int32_t best = -1;
+        uint32_t bestMask = 0;
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (slot == attacker || !alive[slot])
+            {
+                continue;
+            }
+
+            // 마스크를 정수로 비교하면 가장 높은 쌓인 행부터 비교됨
+            if (best < 0 || _usedRows[slot] > bestMask)
+            {
+                best = slot;
+                bestMask = _usedRows[slot];
+            }
+        }
+        return best;
+    }
+
+    case GarbageTargetMode::ATTACKERS:
+    {
+        // 나를 마지막으로 공격한 상대 중 하나
+        int32_t attackers[ROOM_MAX_PLAYERS];
+        int32_t count = 0;
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (slot != attacker && alive[slot] && _lastTarget[slot] == attacker)
+            {
+                attackers[count++] = slot;
+            }
+        }
+
+        if (count > 0)
+        {
+            return attackers[NextRandom() % static_cast<uint32_t>(count)];
+        }
+        return PickRandom(attacker, alive);
+    }
+
+    case GarbageTargetMode::RANDOM:
+    default:
+        return PickRandom(attacker, alive);
+    }
+}
+
+int32_t CAttackRouter::PickRandom(int32_t attacker, const bool* alive)
+{
+    int32_t candidates[ROOM_MAX_PLAYERS];
+    int32_t count = 0;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        if (slot != attacker && alive[slot])
+        {
+            candidates[count++] = slot;
+        }
+    }
+
+    if (count == 0)
+    {
+        return -1;
+    }
+    return candidates[NextRandom() % static_cast<uint32_t>(count)];
+}
+
+uint8_t CAttackRouter::Cancel(int32_t slot, uint8_t lines)
+{
+    GarbageQueue& queue = _queues[slot];
+    uint8_t cancelled = 0;
+    while (queue.count > 0 && cancelled < lines)
+    {
+        GarbageChunk& chunk = queue.chunks[queue.head];
+        uint8_t take = (std::min)(chunk.lines, static_cast<uint8_t>(lines - cancelled));
+        chunk.lines = static_cast<uint8_t>(chunk.lines - take);
+        cancelled = static_cast<uint8_t>(cancelled + take);
+
+        if (chunk.lines == 0)
+        {
+            queue.head = static_cast<uint8_t>((queue.head + 1) % GARBAGE_QUEUE_CAPACITY);
+            --queue.count;
+        }
+    }
+
+    queue.totalLines -= cancelled;
+    return cancelled;
+}
+
+void CAttackRouter::Push(int32_t slot, uint32_t readyFrame, uint8_t lines)
+{
+    GarbageQueue& queue = _queues[slot];
+    if (queue.count == GARBAGE_QUEUE_CAPACITY)
+    {
+        // 가득 참: 마지막 묶음에 합침 (그 묶음의 구멍과 대기 시간을 따름, 넘치는 줄은 버림)
+        GarbageChunk& last = queue.chunks[(queue.head + queue.count - 1) % GARBAGE_QUEUE_CAPACITY];
+        uint8_t added = (std::min)(lines, static_cast<uint8_t>(GARBAGE_MAX_CHUNK_LINES - last.lines));
+        last.lines = static_cast<uint8_t>(last.lines + added);
+        queue.totalLines += added;
+        return;
+    }
+
+    GarbageChunk& chunk = queue.chunks[(queue.head + queue.count) % GARBAGE_QUEUE_CAPACITY];
+    chunk.readyFrame = readyFrame;
+    chunk.lines = lines;
+    chunk.hole = static_cast<uint8_t>(NextRandom() % TETRIS_BOARD_WIDTH);
+    ++queue.count;
+    queue.totalLines += lines;
+}
+
+uint32_t CAttackRouter::NextRandom()
+{
+    // xorshift32
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    return _random;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Protocol.h"
+#include "TetrisBoardBatch.h"
+
+// 공격 규칙 ////////////////////////////////////////////////////////////////////////
+// 보내는 줄 = 지운 줄 수별 기본값 + 연속 삭제(콤보) 보너스 + 연속 4줄(back-to-back) 보너스
+constexpr uint8_t GARBAGE_ATTACK_BY_LINES[5] = { 0, 0, 1, 2, 4 };
+constexpr uint8_t GARBAGE_COMBO_BONUS[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5 }; // [combo], 끝을 넘으면 마지막 값
+constexpr uint8_t GARBAGE_BACK_TO_BACK_BONUS = 1;
+
+// 받은 공격은 이 프레임 수 동안 대기열에만 있음 (그 사이 줄을 지우면 상쇄, 1/3초)
+constexpr uint32_t GARBAGE_DELAY_FRAMES = 20;
+
+// 한 번 고정할 때 올라오는 최대 줄 수 / 공격 묶음 수 (나머지는 다음 고정 때)
+constexpr uint8_t GARBAGE_MAX_LINES_PER_LOCK = 8;
+constexpr size_t GARBAGE_MAX_CHUNKS_PER_LOCK = 4;
+
+// 슬롯마다 대기 중인 공격 묶음 수 (가득 차면 마지막 묶음에 합침)
+constexpr size_t GARBAGE_QUEUE_CAPACITY = 8;
+
+// 묶음 하나의 최대 줄 수 (GarbageEvent 4비트)
+constexpr uint8_t GARBAGE_MAX_CHUNK_LINES = 15;
+
+// 방해 줄 삽입 하나 (ResolveFrame 결과. 슬롯 순, 같은 슬롯은 넣을 순서대로)
+struct GarbageInsertion
+{
+    uint8_t slot;
+    uint8_t lines;
+    uint8_t hole;
+};
+
+// __________________________________________________________________
+//
+// 공격 라우터 (방 하나, 락스텝 릴레이 안에서 확정 프레임마다 호출)
+// 슬롯 = 게임 시작 시 CRoom::GetPlayers() 순서 (방 액터가 정함)
+// 확정 프레임 하나를 틱 하나로 보고, 그 프레임의 공격을 전부 모은 뒤 한꺼번에 처리
+//  1. 줄을 지운 슬롯마다 공격 줄 수 계산
+//  2. 상쇄: 자기 대기열의 오래된 묶음부터 공격으로 지움
+//  3. 남은 공격은 대상 규칙(GarbageTargetMode)으로 고른 상대 하나의 대기열 끝에 묶음 하나로 (구멍 열은 묶음마다)
+//  4. 줄을 지우지 않고 고정한 슬롯은 대기가 끝난 묶음을 꺼내 삽입 목록에 씀
+// 결과는 서버 보드에 바로 적용하고 S2C_GAME_FRAMES에 그대로 실어 보냄 (방 전원 한 메시지)
+// -> 공격자 x 대상마다 작은 패킷을 따로 보내지 않음. 클라는 라우팅을 하지 않고 삽입만 같은 순서로 적용
+// 무작위 요소(대상, 구멍)는 게임 seed로 시작한 내부 난수라 같은 입력이면 같은 결과
+// __________________________________________________________________
+
+class CAttackRouter
+{
+public:
+    CAttackRouter();
+
+    void Start(uint32_t seed, int32_t playerCount);
+
+    void SetTargetMode(int32_t slot, GarbageTargetMode mode);
+    GarbageTargetMode GetTargetMode(int32_t slot) const { return _modes[slot]; }
+
+    // frame을 모든 보드가 진행한 결과(results, alive: 진행 뒤 살아 있음)로 이번 프레임 공격을 처리
+    // outInsertions(최대 playerCount * GARBAGE_MAX_CHUNKS_PER_LOCK개)에 넣을 방해 줄을 쓰고 개수를 리턴
+    size_t ResolveFrame(uint32_t frame, const TetrisStepResult* results, const bool* alive,
+        const CTetrisBoardBatch& boards, GarbageInsertion* outInsertions);
+
+    // 대기열에 있는 줄 수 (대기 중 + 대기가 끝나 다음 고정을 기다리는 줄)
+    int32_t GetPendingLines(int32_t slot) const { return _queues[slot].totalLines; }
+
+    static uint8_t GetAttackLines(const TetrisStepResult& result);
+
+    // 통계 (게임 시작 시 초기화)
+    uint64_t GetSentLines() const { return _sentLines; }
+    uint64_t GetCancelledLines() const { return _cancelledLines; }
+    uint64_t GetInsertedLines() const { return _insertedLines; }
+
+private:
+    struct GarbageChunk
+    {
+        uint32_t readyFrame; // 이 프레임부터 삽입 가능
+        uint8_t lines;
+        uint8_t hole;
+    };
+
+    // 고정 크기 원형 대기열 (오래된 묶음이 head)
+    struct GarbageQueue
+    {
+        GarbageChunk chunks[GARBAGE_QUEUE_CAPACITY];
+        uint8_t head;
+        uint8_t count;
+        int32_t totalLines;
+    };
+
+    int32_t PickTarget(int32_t attacker, const bool* alive, const CTetrisBoardBatch& boards);
+    int32_t PickRandom(int32_t attacker, const bool* alive);
+
+    // 오래된 묶음부터 lines줄을 지우고 지운 줄 수를 리턴
+    uint8_t Cancel(int32_t slot, uint8_t lines);
+    void Push(int32_t slot, uint32_t readyFrame, uint8_t lines);
+
+    uint32_t NextRandom();
+
+    GarbageQueue _queues[ROOM_MAX_PLAYERS];
+    GarbageTargetMode _modes[ROOM_MAX_PLAYERS];
+    int8_t _lastTarget[ROOM_MAX_PLAYERS]; // 마지막으로 공격한 슬롯 (-1: 없음)
+    int32_t _playerCount;
+    uint32_t _random;
+
+    // KO 대상용 스택 높이 (공격이 있는 프레임에만 한 번 계산)
+    uint32_t _usedRows[ROOM_MAX_PLAYERS];
+    bool _usedRowsValid;
+
+    uint64_t _sentLines;
+    uint64_t _cancelledLines;
+    uint64_t _insertedLines;
+};
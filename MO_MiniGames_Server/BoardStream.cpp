@@ -0,0 +1,112 @@
+#include "BoardStream.h"
+#include <algorithm>
+
+CBoardStream::CBoardStream()
+    : _baseline()
+    , _detail()
+    , _boardCount(0)
+    , _nextKeyframe(0)
+    , _nextMiniFrame(0)
+    , _keyframePending(true)
+    , _lastWasKeyframe(false)
+    , _messages(0)
+    , _keyframes(0)
+    , _boardUpdates(0)
+    , _updateBytes(0)
+{
+}
+
+void CBoardStream::Reset(int32_t boardCount)
+{
+    _boardCount = (std::max)(0, (std::min)(boardCount, ROOM_MAX_PLAYERS));
+    _nextKeyframe = 0;
+    _nextMiniFrame = 0;
+    _keyframePending = true;
+    _lastWasKeyframe = false;
+    _messages = 0;
+    _keyframes = 0;
+    _boardUpdates = 0;
+    _updateBytes = 0;
+
+    for (int32_t board = 0; board < ROOM_MAX_PLAYERS; ++board)
+    {
+        _baseline[board].Clear();
+        _detail[board] = BoardStreamDetail::MINI;
+    }
+}
+
+void CBoardStream::SetDetail(int32_t board, BoardStreamDetail detail)
+{
+    if (board >= 0 && board < _boardCount)
+    {
+        _detail[board] = detail;
+    }
+}
+
+bool CBoardStream::Encode(uint32_t frame, const CTetrisBoardBatch& boards, CMsgWriter& writer)
+{
+    bool keyframe = _keyframePending || frame >= _nextKeyframe;
+
+    // 간격 경계를 지난 첫 Encode (매 프레임 부르면 frame % 간격 == 0, 관전처럼 띄엄띄엄 불러도 건너뛰지 않음)
+    bool miniTick = keyframe || frame >= _nextMiniFrame;
+    if (miniTick)
+    {
+        _nextMiniFrame = (frame / BOARD_STREAM_MINI_INTERVAL + 1) * BOARD_STREAM_MINI_INTERVAL;
+    }
+
+    // 델타는 보드 수를 알기 전에 쓰므로 따로 모았다가 헤더 뒤에 붙임
+    char updates[BOARD_STREAM_UPDATES_MAX_SIZE];
+    CMsgWriter updateWriter(updates, sizeof(updates), 0);
+    uint8_t updateCount = 0;
+
+    for (int32_t board = 0; board < _boardCount; ++board)
+    {
+        bool full = (_detail[board] == BoardStreamDetail::FULL);
+        if (!full && !miniTick)
+        {
+            continue;
+        }
+
+        BoardView current;
+        current.Capture(boards.GetEngine(static_cast<size_t>(board)), full);
+
+        char delta[BOARD_DELTA_MAX_SIZE];
+        CMsgWriter deltaWriter(delta, sizeof(delta), 0);
+        if (!EncodeBoardDelta(deltaWriter, _baseline[board], current, keyframe))
+        {
+            continue; // 바뀐 것이 없음
+        }
+
+        updateWriter.WriteUInt8(static_cast<uint8_t>(board));
+        updateWriter.WriteBytes(delta, deltaWriter.GetSize());
+        _baseline[board] = current;
+        ++updateCount;
+    }
+
+    if (updateCount == 0)
+    {
+        _lastWasKeyframe = false;
+        return false;
+    }
+    _lastWasKeyframe = keyframe;
+
+    if (keyframe)
+    {
+        _keyframePending = false;
+        _nextKeyframe = frame + BOARD_STREAM_KEYFRAME_INTERVAL;
+        ++_keyframes;
+    }
+
+    MSG_S2C_BOARD_STREAM msg;
+    msg.frame = frame;
+    msg.boardCount = static_cast<uint8_t>(_boardCount);
+    msg.updateCount = updateCount;
+    msg.updates = reinterpret_cast<const uint8_t*>(updates);
+    msg.updatesSize = updateWriter.GetSize();
+    msg.Encode(writer);
+
+    ++_messages;
+    _boardUpdates += updateCount;
+    _updateBytes += updateWriter.GetSize();
+    return true;
+}
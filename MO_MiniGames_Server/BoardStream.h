@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "BoardDelta.h"
+#include "Protocol.h"
+#include "TetrisBoardBatch.h"
+
+// 보드별 화면 상세도
+enum class BoardStreamDetail : uint8_t
+{
+    MINI, // 작은 화면: BOARD_STREAM_MINI_INTERVAL 프레임마다, 고정된 칸만 (블록이 고정될 때만 바뀜)
+    FULL  // 큰 화면: 매번, 떨어지는 블록까지
+};
+
+// 작은 화면 갱신 간격 (프레임, 6 = 10Hz). 간격 경계를 지난 뒤 첫 Encode에서 갱신
+constexpr uint32_t BOARD_STREAM_MINI_INTERVAL = 6;
+
+// 키프레임 간격 (프레임, 2초). 중간에 들어온 쪽은 다음 키프레임부터 화면을 그림
+constexpr uint32_t BOARD_STREAM_KEYFRAME_INTERVAL = 120;
+
+// __________________________________________________________________
+//
+// 보드 화면 스트림 (방 하나, 방 액터 전용)
+// 서버 보드 묶음에서 보드마다 화면 상태(BoardView)를 떠서 마지막으로 내보낸 상태와의 델타만 S2C_BOARD_STREAM 본문으로 씀
+//  - 기준 상태 = 마지막으로 내보낸 상태. 받는 쪽은 TCP로 순서대로 모두 받으므로 곧 받는 쪽이 확인한 상태
+//    -> 받는 쪽마다 기준을 따로 두지 않고, 한 번 인코딩한 바이트를 모두에게 보냄
+//  - 키프레임: BOARD_STREAM_KEYFRAME_INTERVAL마다, 또는 RequestKeyframe 뒤 첫 Encode에서 전원을 빈 보드 기준으로
+//  - 상세도: 보드마다 MINI / FULL (BoardStreamDetail). 기본은 전원 MINI
+// 락스텝 참가자는 확정 입력으로 모든 보드를 직접 돌리므로 받지 않음 (보드당 프레임마다 1바이트)
+// 시뮬레이션 없이 화면만 보는 쪽(관전 등)이 대상
+// __________________________________________________________________
+
+class CBoardStream
+{
+public:
+    CBoardStream();
+
+    // 게임 시작 (boardCount장, 다음 Encode는 키프레임)
+    void Reset(int32_t boardCount);
+
+    void SetDetail(int32_t board, BoardStreamDetail detail);
+    BoardStreamDetail GetDetail(int32_t board) const { return _detail[board]; }
+
+    // 다음 Encode를 키프레임으로 (새 구독자가 바로 화면을 그릴 수 있도록)
+    void RequestKeyframe() { _keyframePending = true; }
+
+    // frame까지 진행한 boards로 보낼 것이 있으면 writer에 S2C_BOARD_STREAM 본문을 쓰고 true
+    // 바뀐 보드가 없거나 이번 프레임에 갱신할 보드가 없으면 false (아무것도 쓰지 않음)
+    bool Encode(uint32_t frame, const CTetrisBoardBatch& boards, CMsgWriter& writer);
+
+    bool WasKeyframe() const { return _lastWasKeyframe; }
+
+    // 통계 (Reset 시 초기화)
+    uint64_t GetMessageCount() const { return _messages; }
+    uint64_t GetKeyframeCount() const { return _keyframes; }
+    uint64_t GetBoardUpdateCount() const { return _boardUpdates; }
+    uint64_t GetUpdateBytes() const { return _updateBytes; } // 보드 델타 바이트 (slot 포함, 메시지 헤더 제외)
+
+private:
+    BoardView _baseline[ROOM_MAX_PLAYERS];
+    BoardStreamDetail _detail[ROOM_MAX_PLAYERS];
+    int32_t _boardCount;
+    uint32_t _nextKeyframe;
+    uint32_t _nextMiniFrame;
+    bool _keyframePending;
+    bool _lastWasKeyframe;
+
+    uint64_t _messages;
+    uint64_t _keyframes;
+    uint64_t _boardUpdates;
+    uint64_t _updateBytes;
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// __________________________________________________________________
+//
+// 고정 용량 lock-free 메일박스 (액터 메시지 큐)
+// 셀마다 순번(sequence)을 두는 링 버퍼: 생산자는 enqueue 위치를 CAS로 가져간 셀에 쓰고 순번을 올려 공개,
+// 소비자는 순번이 맞는 셀만 꺼냄 -> 락 없이 여러 생산자 / 여러 소비자 (액터는 소비자가 항상 하나)
+// 메시지는 셀 안에서 바로 쓰고 바로 처리하므로 복사 / 힙 할당 없음 (용량은 생성 시 2의 거듭제곱으로 올림)
+// 가득 차면 TryPush가 false -> 버릴지, 거절 응답을 보낼지, 다시 시도할지는 보내는 쪽이 결정
+// __________________________________________________________________
+
+template <typename T>
+class CBoundedMailbox
+{
+public:
+    explicit CBoundedMailbox(size_t capacity)
+        : _cells()
+        , _mask(0)
+        , _enqueuePos(0)
+        , _dequeuePos(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        _cells = std::make_unique<Cell[]>(size);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CBoundedMailbox(const CBoundedMailbox&) = delete;
+    CBoundedMailbox& operator=(const CBoundedMailbox&) = delete;
+
+    // fill(T&)로 셀을 채움 (아무 스레드). 가득 차면 fill을 호출하지 않고 false
+    template <typename Fill>
+    bool TryPush(Fill&& fill)
+    {
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = _cells[pos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                // 실패하면 pos가 현재 값으로 갱신되므로 다시 시도
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    fill(cell.value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 한 바퀴 전 메시지를 아직 안 꺼냄 = 가득 참
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 맨 앞 메시지를 func(T&)로 처리하고 셀을 돌려줌. 비어있으면 false
+    template <typename Func>
+    bool TryConsume(Func&& func)
+    {
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = _cells[pos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    func(cell.value);
+                    cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 비어있음 (또는 생산자가 자리만 잡고 아직 공개 전)
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 꺼낼 수 있는 메시지가 있는지 (소비자 쪽에서 확인용)
+    bool HasPending() const
+    {
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        return _cells[pos & _mask].sequence.load(std::memory_order_acquire) == pos + 1;
+    }
+
+    // 남은 자리 수. 생산자가 하나일 때 그 생산자가 보면 실제보다 작거나 같음 (소비자가 꺼내면 늘어나기만 함)
+    size_t GetFreeCount() const
+    {
+        size_t used = _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos.load(std::memory_order_acquire);
+        return (used < GetCapacity()) ? GetCapacity() - used : 0;
+    }
+
+    size_t GetCapacity() const { return _mask + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+
+    // 생산자 / 소비자가 서로 다른 캐시 라인을 쓰도록 분리
+    alignas(64) std::atomic<size_t> _enqueuePos;
+    alignas(64) std::atomic<size_t> _dequeuePos;
+};
@@ -1,15 +1,59 @@
 //
 #include "CentralizedServer.h"
 #include "RoomManager.h"
-#include <iostream>
-#include <cstring>
+#include "AsyncLogger.h"
 
+// 풀 점유율 로그 주기
+constexpr auto POOL_STATS_LOG_INTERVAL = std::chrono::seconds(60);
+
+// 방 안에서 이 시간 동안 요청이 없으면 방에서 내보냄
+constexpr auto ROOM_AFK_TIMEOUT = std::chrono::minutes(10);
+
+// 플레이어당 타이머 수 (잠수 검사 1개 + 방/게임 타이머 여유분)
+constexpr size_t TIMERS_PER_PLAYER = 4;
+
+// 방 목록 스냅샷 최소 게시 간격 (변경이 잦아도 목록 복사는 이 주기로 묶음)
+constexpr auto ROOM_LIST_PUBLISH_INTERVAL = std::chrono::milliseconds(50);
+
+// 로직 루프 단계별 시간 예산 (틱 간격 대비 %). 남는 시간은 틱이 밀렸을 때의 여유
+// 방 안 플레이어의 이벤트를 먼저 처리하고, 로비 요청(접속, 방 만들기 / 입장)은 따로 정한 예산 안에서 처리
+constexpr int64_t GAME_EVENT_BUDGET_PERCENT = 30;
+constexpr int64_t LOBBY_EVENT_BUDGET_PERCENT = 20;
+constexpr int64_t TIMER_BUDGET_PERCENT = 15;
+constexpr int64_t PUBLISH_BUDGET_PERCENT = 10;
+
+// 빈 방은 바로 삭제되므로 방 개수는 접속자 수를 넘지 않음 -> 방 풀도 maxClients 크기
 CCentralizedServer::CCentralizedServer(int port, int maxClients, int mainlogicTickMs)
     : _networkServer(std::make_shared<CIOCPServer>(port, maxClients, ServerArchitectureType::Centralized))
-    , _roomManager(std::make_shared<CRoomManager>())
+    , _roomManager(std::make_shared<CRoomManager>(static_cast<size_t>(maxClients)))
     , _running(false)
-    , _mainlogicTickMs(mainlogicTickMs)
+    , _tickScheduler(std::chrono::milliseconds(mainlogicTickMs))
+    , _gameEventBudget("GameEvents", _tickScheduler.GetInterval() * GAME_EVENT_BUDGET_PERCENT / 100)
+    , _lobbyEventBudget("LobbyEvents", _tickScheduler.GetInterval() * LOBBY_EVENT_BUDGET_PERCENT / 100)
+    , _timerBudget("Timers", _tickScheduler.GetInterval() * TIMER_BUDGET_PERCENT / 100)
+    , _publishBudget("RoomList", _tickScheduler.GetInterval() * PUBLISH_BUDGET_PERCENT / 100)
+    , _lobbyBacklog()
+    , _deferredEvents(static_cast<size_t>(maxClients), 0)
+    , _timers(static_cast<size_t>(maxClients) * TIMERS_PER_PLAYER)
+    , _afkTimeoutTicks(_tickScheduler.ToTicks(ROOM_AFK_TIMEOUT))
+    , _owedTimerTicks(0)
+    , _players(static_cast<size_t>(maxClients))
+    , _sessionToPlayer(static_cast<size_t>(maxClients))
+    , _roomListPublisher(static_cast<size_t>(maxClients))
+    , _nextRoomListPublish()
+    , _lastPoolStatsLog(std::chrono::steady_clock::now())
 {
+    // 방 목록 요청은 로직 스레드 큐를 거치지 않고 워커에서 스냅샷으로 응답
+    _networkServer->SetWorkerMsgHandler([this](int64_t sessionId, const char* data, size_t length)
+    {
+        return HandleWorkerMsg(sessionId, data, length);
+    });
+
+    // 로직 스레드는 이벤트가 없으면 다음 틱까지 잠들어 있으므로 큐에 넣을 때마다 깨움
+    _networkServer->SetNetworkEventNotifier([this]
+    {
+        _tickScheduler.Notify();
+    });
 }
 
 CCentralizedServer::~CCentralizedServer()
@@ -25,7 +69,8 @@ bool CCentralizedServer::Start()
         return false;
 
     _gameThread = std::thread(&CCentralizedServer::GameLogicThread, this);
-    std::cout << "[CentralizedServer] Game logic thread started" << std::endl;
+    LOG_INFO("[CentralizedServer] Game logic thread started");
+    return true;
 }
 
 void CCentralizedServer::Stop()
@@ -36,88 +81,162 @@ void CCentralizedServer::Stop()
     }
 
     _running = false;
+    _tickScheduler.Notify();
 
     if (_gameThread.joinable())
     {
         _gameThread.join();
     }
 
-    std::cout << "[CentralizedServer] Game logic thread stopped" << std::endl;
+    LOG_INFO("[CentralizedServer] Game logic thread stopped");
 }
 
 void CCentralizedServer::GameLogicThread()
 {
+    _tickScheduler.Start();
+
     while (_running)
     {
-        // 네트워크 이벤트 처리
-        NetworkEvent event(NetworkEvent::Type::CONNECTED, -1);
-        while (_networkServer->PopNetworkEvent(event))
+        // 네트워크 이벤트 / 밀린 타이머 처리 (단계마다 예산만큼)
+        bool backlog = ProcessNetworkEvents();
+        backlog |= ProcessTimers();
+
+        // 다음 틱 시각까지 대기 (이벤트가 들어오면 바로 깨어나서 위에서 처리), 틱이 되면 게임 로직 처리
+        // 예산을 넘겨 미룬 일이 있으면 잠들지 않고 틱 시각 전까지 이어서 처리
+        _tickScheduler.WaitAndRunTicks([this] { ProcessGameLogic(); }, !backlog);
+    }
+}
+
+bool CCentralizedServer::ProcessNetworkEvents()
+{
+    // 1. 공유 큐: 방 안 플레이어의 이벤트는 바로 처리하고 로비 이벤트는 대기열로 (게임 이벤트 예산)
+    //    로비 요청이 몰려도 게임 중인 플레이어의 요청이 그 뒤에서 기다리지 않음
+    uint64_t items = 0;
+    bool queueLeft = false;
+    _gameEventBudget.Begin();
+
+    NetworkEvent event(NetworkEvent::Type::CONNECTED, -1);
+    while (true)
+    {
+        if (items > 0 && _gameEventBudget.IsOver())
         {
-            switch (event.type)
-            {
-            case NetworkEvent::Type::CONNECTED:
-                DispatchClientConnected(event.sessionId);
-                break;
-            case NetworkEvent::Type::DISCONNECTED:
-                DispatchClientDisconnected(event.sessionId);
-                break;
-            case NetworkEvent::Type::RECEIVED:
-                DispatchDataReceived(event.sessionId, event.data.data(), event.data.size());
-                break;
-            }
+            queueLeft = true; // 남은 이벤트는 공유 큐에 둔 채로 다음 루프에서
+            break;
         }
+        if (!_networkServer->PopNetworkEvent(event))
+        {
+            break;
+        }
+        ++items;
 
-        // 게임 로직 처리
-        ProcessGameLogic();
-
-        // CPU 부하 방지
-        if (_mainlogicTickMs >= 0)
+        uint16_t index = CSession::ExtractIndex(event.sessionId);
+        if (IsGameEvent(event) || index >= _deferredEvents.size())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(_mainlogicTickMs));
+            DispatchNetworkEvent(event);
+            continue;
         }
+
+        ++_deferredEvents[index];
+        _lobbyBacklog.push(std::move(event));
+    }
+    _gameEventBudget.End(items, queueLeft);
+
+    // 2. 로비 대기열 (로비 이벤트 예산). 게임 이벤트가 예산을 다 써도 하나는 처리해서 굶지 않게
+    items = 0;
+    _lobbyEventBudget.Begin();
+    while (!_lobbyBacklog.empty() && (items == 0 || !_lobbyEventBudget.IsOver()))
+    {
+        const NetworkEvent& front = _lobbyBacklog.front();
+        --_deferredEvents[CSession::ExtractIndex(front.sessionId)];
+        DispatchNetworkEvent(front);
+        _lobbyBacklog.pop();
+        ++items;
+    }
+    _lobbyEventBudget.End(items, !_lobbyBacklog.empty());
+
+    return queueLeft || !_lobbyBacklog.empty();
+}
+
+bool CCentralizedServer::IsGameEvent(const NetworkEvent& event) const
+{
+    if (event.type == NetworkEvent::Type::CONNECTED)
+    {
+        return false;
+    }
+
+    // 이 세션의 앞선 이벤트가 대기열에 있으면 순서를 지키기 위해 뒤에 붙임
+    uint16_t index = CSession::ExtractIndex(event.sessionId);
+    if (index < _deferredEvents.size() && _deferredEvents[index] > 0)
+    {
+        return false;
+    }
+
+    const CPlayer* player = _sessionToPlayer.Find(index, CSession::ExtractUniqueId(event.sessionId));
+    return player && !player->GetRoomHandle().IsNull();
+}
+
+void CCentralizedServer::DispatchNetworkEvent(const NetworkEvent& event)
+{
+    switch (event.type)
+    {
+    case NetworkEvent::Type::CONNECTED:
+        DispatchClientConnected(event.sessionId);
+        break;
+    case NetworkEvent::Type::DISCONNECTED:
+        DispatchClientDisconnected(event.sessionId);
+        break;
+    case NetworkEvent::Type::RECEIVED:
+        DispatchDataReceived(event.sessionId, event.data.data(), event.data.size());
+        break;
     }
 }
 
 void CCentralizedServer::DispatchClientConnected(int64_t sessionId)
 {
     // 게임 컨텐츠 레이어의 플레이어 객체 생성
-    auto player = std::make_shared<CPlayer>(sessionId);
-    AddPlayer(player);
+    CPlayer* player = AddPlayer(sessionId);
+    if (!player)
+    {
+        // 네트워크 레이어도 maxClients로 제한하므로 정상적으로는 오지 않는 경로
+        LOG_ERROR("[CentralizedServer] Player pool exhausted, disconnecting SessionId: {}", sessionId);
+        _networkServer->RequestDisconnectSession(sessionId);
+        return;
+    }
 
     // 클라이언트가 접속하면 즉시 방 목록 전송
-    SendRoomList(player);
+    SendRoomList(*_networkServer, sessionId, REQUEST_ID_NONE, _roomListPublisher);
 }
 
 void CCentralizedServer::DispatchClientDisconnected(int64_t sessionId)
 {
     // 플레이어 객체 조회
-    auto player = GetPlayer(sessionId);
+    CPlayer* player = GetPlayer(sessionId);
     if (!player)
     {
-        std::cerr << "[CentralizedServer] Player not found for SessionId: " << sessionId << std::endl;
+        LOG_WARNING("[CentralizedServer] Player not found for SessionId: {}", sessionId);
         return;
     }
 
-    // 플레이어가 속한 방에서 퇴장 처리 (CPlayer 기반)
-    _roomManager->LeaveRoom(player);
+    // 플레이어가 속한 방에서 퇴장 처리
+    _roomManager->LeaveRoom(*player);
 
-    // <SessionId, _players> 맵에서 플레이어 제거
+    // 플레이어 테이블에서 제거 (이 플레이어의 핸들은 이후 모두 무효)
     RemovePlayer(sessionId);
 }
 
 void CCentralizedServer::DispatchDataReceived(int64_t sessionId, const char* data, size_t length)
 {
     // 플레이어 객체 조회
-    auto player = GetPlayer(sessionId);
+    CPlayer* player = GetPlayer(sessionId);
     if (!player)
     {
-        std::cerr << "[CentralizedServer] Player not found for SessionId: " << sessionId << std::endl;
+        LOG_WARNING("[CentralizedServer] Player not found for SessionId: {}", sessionId);
         return;
     }
 
     if (length < sizeof(MsgHeader))
     {
-        std::cerr << "[CentralizedServer] Invalid msg size from SessionId: " << sessionId << std::endl;
+        LOG_WARNING("[CentralizedServer] Invalid msg size from SessionId: {}", sessionId);
         return;
     }
 
@@ -126,203 +245,351 @@ void CCentralizedServer::DispatchDataReceived(int64_t sessionId, const char* dat
     // 패킷 크기 검증
     if (header->size != length)
     {
-        std::cerr << "[CentralizedServer] Msg size mismatch from SessionId: " << sessionId << std::endl;
+        LOG_WARNING("[CentralizedServer] Msg size mismatch from SessionId: {}", sessionId);
         return;
     }
 
+    // 요청이 올 때마다 타이머를 다시 걸지 않고 시각만 기록 (검사 타이머가 만료될 때 남은 시간만큼 다시 검)
+    player->SetLastActivityTick(_timers.GetCurrentTick());
+
     // 패킷 타입별 처리 (플레이어 기반)
     switch (header->type)
     {
-    case MsgType::C2S_REQUEST_ROOM_LIST:
-        if (length >= sizeof(MsgHeader))
-        {
-            HandleRequestRoomList(player);
-        }
-        break;
-
     case MsgType::C2S_CREATE_ROOM:
-        if (length >= sizeof(MSG_C2S_CREATE_ROOM))
+    {
+        // 가변 길이 메시지: 수신 버퍼에서 바로 디코딩 (title은 버퍼를 가리키는 view)
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_CREATE_ROOM msg;
+        if (msg.Decode(reader))
         {
-            HandleCreateRoom(player, reinterpret_cast<const MSG_C2S_CREATE_ROOM*>(data));
+            HandleCreateRoom(*player, msg);
         }
         break;
+    }
 
     case MsgType::C2S_JOIN_ROOM:
         if (length >= sizeof(MSG_C2S_JOIN_ROOM))
         {
-            HandleJoinRoom(player, reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data));
+            HandleJoinRoom(*player, reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data));
         }
         break;
 
     case MsgType::C2S_LEAVE_ROOM:
-        HandleLeaveRoom(player);
+        if (length >= sizeof(MSG_C2S_LEAVE_ROOM))
+        {
+            HandleLeaveRoom(*player, reinterpret_cast<const MSG_C2S_LEAVE_ROOM*>(data));
+        }
+        break;
+
+    case MsgType::C2S_QUICK_JOIN:
+        if (length >= sizeof(MSG_C2S_QUICK_JOIN))
+        {
+            HandleQuickJoin(*player, reinterpret_cast<const MSG_C2S_QUICK_JOIN*>(data));
+        }
         break;
 
     default:
-        std::cerr << "[CentralizedServer] Unknown msg type: " 
-                  << static_cast<int>(header->type) << std::endl;
+        LOG_WARNING("[CentralizedServer] Unknown msg type: {}", static_cast<int>(header->type));
         break;
     }
-}
 
-void CCentralizedServer::HandleRequestRoomList(std::shared_ptr<CPlayer> player)
-{
-    SendRoomList(player);
+    // 방에 들어갔으면 잠수 검사 시작
+    ArmAfkTimer(*player);
 }
 
-void CCentralizedServer::HandleCreateRoom(std::shared_ptr<CPlayer> player, const MSG_C2S_CREATE_ROOM* msg)
+bool CCentralizedServer::HandleWorkerMsg(int64_t sessionId, const char* data, size_t length)
 {
-    std::string title(msg->title);
-    int32_t maxPlayers = msg->maxPlayers;
-
-    // 유효성 검증
-    if (title.empty() || maxPlayers < 2 || maxPlayers > 10)
+    // IOCP 워커 스레드. 크기 검증은 DispatchDataReceived와 같게
+    if (length < sizeof(MsgHeader))
     {
-        SendRoomCreated(player, -1, false);
-        SendError(player, "Invalid room parameters");
-        return;
+        return false;
     }
 
-    // 방 이름 중복 체크
-    // 차후 스트링을 던질게 아니라 메시지로 빼는 방식으로 변경 하면 좋을 듯
-    if (_roomManager->FindRoomByTitle(title))
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+    if (header->size != length)
     {
-        SendRoomCreated(player, -1, false);
-        SendError(player, "Room title already exists");
-        return;
+        return false; // 로직 스레드에서 에러 로그
     }
 
-    auto room = _roomManager->CreateRoom(title, maxPlayers);
-    if (room)
+    switch (header->type)
     {
-        // 방 생성 성공 시, 즉시 입장 처리 (CPlayer 기반)
-        bool joinSuccess = _roomManager->JoinRoom(room->GetRoomId(), player);
-        SendRoomCreated(player, room->GetRoomId(), joinSuccess);
+    case MsgType::C2S_REQUEST_ROOM_LIST:
+        if (length >= sizeof(MSG_C2S_REQUEST_ROOM_LIST))
+        {
+            HandleRequestRoomList(sessionId, reinterpret_cast<const MSG_C2S_REQUEST_ROOM_LIST*>(data));
+        }
+        return true;
 
-        if (!joinSuccess)
+    case MsgType::C2S_REQUEST_ROOM_PAGE:
+    {
+        // 가변 길이 메시지 (titlePrefix는 수신 버퍼를 가리키는 view)
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_REQUEST_ROOM_PAGE msg;
+        if (msg.Decode(reader))
         {
-            SendError(player, "Failed to join created room");
+            HandleRequestRoomPage(sessionId, msg);
         }
+        return true;
     }
-    else // 방 생성 실패  
-    {
-        SendRoomCreated(player, -1, false);
+
+    default:
+        return false; // 나머지는 로직 스레드로
     }
 }
 
-void CCentralizedServer::HandleJoinRoom(std::shared_ptr<CPlayer> player, const MSG_C2S_JOIN_ROOM* msg)
+void CCentralizedServer::HandleRequestRoomList(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_LIST* msg)
 {
-    int32_t roomId = msg->roomId;
+    SendRoomList(*_networkServer, sessionId, msg->requestId, _roomListPublisher);
+}
 
-    // CPlayer 기반으로 RoomManager에 전달
-    bool success = _roomManager->JoinRoom(roomId, player);
-    SendRoomJoined(player, roomId, success);
+void CCentralizedServer::HandleCreateRoom(CPlayer& player, const MSG_C2S_CREATE_ROOM& msg)
+{
+    CRoomRequestHandler handler(*_roomManager);
+    RoomRequestResult result = handler.CreateRoom(msg, GetCurrentRoomId(player),
+        [&](CRoom& room, bool) { return SeatPlayer(player, room); });
 
-    if (!success)
-    {
-        SendError(player, "Failed to join room");
-    }
+    SendRoomRequestResult(*_networkServer, player.GetSessionId(), result);
 }
 
-void CCentralizedServer::HandleLeaveRoom(std::shared_ptr<CPlayer> player)
+void CCentralizedServer::HandleJoinRoom(CPlayer& player, const MSG_C2S_JOIN_ROOM* msg)
 {
-    // CPlayer 기반으로 RoomManager에 전달
-    bool success = _roomManager->LeaveRoom(player);
-    SendRoomLeft(player, success);
+    CRoomRequestHandler handler(*_roomManager);
+    RoomRequestResult result = handler.JoinRoom(*msg, GetCurrentRoomId(player),
+        [&](CRoom& room, bool) { return SeatPlayer(player, room); });
+
+    SendRoomRequestResult(*_networkServer, player.GetSessionId(), result);
+}
+
+void CCentralizedServer::HandleLeaveRoom(CPlayer& player, const MSG_C2S_LEAVE_ROOM* msg)
+{
+    bool left = _roomManager->LeaveRoom(player);
+    SendRoomRequestResult(*_networkServer, player.GetSessionId(), CRoomRequestHandler::LeaveRoom(msg->requestId, left));
+}
+
+void CCentralizedServer::HandleRequestRoomPage(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_PAGE& msg)
+{
+    SendRoomPage(*_networkServer, sessionId, msg.requestId, ParseRoomPageQuery(msg), _roomListPublisher);
+}
+
+void CCentralizedServer::HandleQuickJoin(CPlayer& player, const MSG_C2S_QUICK_JOIN* msg)
+{
+    // 방 선택과 입장이 로직 스레드 안에서 한 번에 처리되므로 목록 조회 후 입장 사이의 경합이 없음
+    CRoomRequestHandler handler(*_roomManager);
+    RoomRequestResult result = handler.QuickJoin(*msg, GetCurrentRoomId(player),
+        [&](CRoom& room, bool) { return SeatPlayer(player, room); });
+
+    SendRoomRequestResult(*_networkServer, player.GetSessionId(), result);
 }
 
-void CCentralizedServer::SendRoomList(std::shared_ptr<CPlayer> player)
+ErrorCode CCentralizedServer::SeatPlayer(CPlayer& player, CRoom& room)
 {
-    auto roomList = _roomManager->GetRoomList();
-    int32_t roomCount = static_cast<int32_t>(roomList.size());
+    // roomId 재조회 없이 방 객체로 바로 입장
+    return _roomManager->JoinRoom(room, player) ? ErrorCode::NONE : ErrorCode::ROOM_JOIN_FAILED;
+}
+
+int32_t CCentralizedServer::GetCurrentRoomId(const CPlayer& player)
+{
+    const CRoom* room = _roomManager->FindRoomByPlayer(player);
+    return room ? room->GetRoomId() : ROOM_ID_NONE;
+}
 
-    // 가변 길이 패킷 생성
-    size_t msgSize = sizeof(MSG_S2C_ROOM_LIST) + sizeof(RoomInfo) * roomCount;
-    std::vector<char> buffer(msgSize);
+void CCentralizedServer::ProcessGameLogic()
+{
+    // 주기적인 게임 로직 처리
+    // 예: 게임 타이머, 상태 업데이트 등
+    ++_owedTimerTicks;
+    ProcessTimers();
 
-    MSG_S2C_ROOM_LIST* msg = reinterpret_cast<MSG_S2C_ROOM_LIST*>(buffer.data());
-    msg->header.size = static_cast<uint16_t>(msgSize);
-    msg->header.type = MsgType::S2C_ROOM_LIST;
-    msg->roomCount = roomCount;
+    PublishRoomList();
 
-    // 방 정보 채우기
-    RoomInfo* roomInfoArray = reinterpret_cast<RoomInfo*>(buffer.data() + sizeof(MSG_S2C_ROOM_LIST));
-    int index = 0;
-    for (const auto& room : roomList)
+    auto now = std::chrono::steady_clock::now();
+    if (now - _lastPoolStatsLog >= POOL_STATS_LOG_INTERVAL)
     {
-        RoomInfo& info = roomInfoArray[index++];
-        info.roomId = room->GetRoomId();
-        strncpy_s(info.title, room->GetTitle().c_str(), sizeof(info.title) - 1);
-        info.title[sizeof(info.title) - 1] = '\0';
-        info.currentPlayers = room->GetCurrentPlayerCount();
-        info.maxPlayers = room->GetMaxPlayers();
-        info.status = static_cast<uint8_t>(room->GetStatus());
+        _lastPoolStatsLog = now;
+        LogPoolStats();
+        _tickScheduler.LogStats("CentralizedServer");
+        LogPhaseStats();
     }
-
-    _networkServer->RequestSendMsg(player->GetSessionId(), buffer.data(), static_cast<int>(msgSize));
 }
 
-void CCentralizedServer::SendRoomCreated(std::shared_ptr<CPlayer> player, int32_t roomId, bool success)
+bool CCentralizedServer::ProcessTimers()
 {
-    MSG_S2C_ROOM_CREATED msg;
-    msg.header.size = sizeof(MSG_S2C_ROOM_CREATED);
-    msg.header.type = MsgType::S2C_ROOM_CREATED;
-    msg.roomId = roomId;
-    msg.success = success ? 1 : 0;
+    if (_owedTimerTicks == 0)
+    {
+        return false;
+    }
 
-    _networkServer->RequestSendMsg(player->GetSessionId(), reinterpret_cast<const char*>(&msg), sizeof(msg));
+    // 만료가 몰린 틱은 예산까지만 처리하고 나머지는 다음 루프에서 이어서 (타이머 시각은 그만큼 늦게 감)
+    size_t expired = 0;
+    _timerBudget.Begin();
+    _owedTimerTicks -= _timers.AdvanceBudgeted(_owedTimerTicks,
+        [this](const TimerEvent& event) { DispatchTimer(event); },
+        [this] { return _timerBudget.IsOver(); },
+        expired);
+    _timerBudget.End(expired, _owedTimerTicks > 0);
+
+    return _owedTimerTicks > 0;
 }
 
-void CCentralizedServer::SendRoomJoined(std::shared_ptr<CPlayer> player, int32_t roomId, bool success)
+void CCentralizedServer::PublishRoomList()
 {
-    MSG_S2C_ROOM_JOINED msg;
-    msg.header.size = sizeof(MSG_S2C_ROOM_JOINED);
-    msg.header.type = MsgType::S2C_ROOM_JOINED;
-    msg.roomId = roomId;
-    msg.success = success ? 1 : 0;
+    if (_roomManager->GetVersion() == _roomListPublisher.GetPublishedVersion())
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < _nextRoomListPublish)
+    {
+        return;
+    }
+
+    // 모든 버퍼를 reader가 잡고 있으면 다음 틱에 다시 시도
+    RoomListSnapshot* snapshot = _roomListPublisher.BeginWrite();
+    if (!snapshot)
+    {
+        return;
+    }
 
-    _networkServer->RequestSendMsg(player->GetSessionId(), reinterpret_cast<const char*>(&msg), sizeof(msg));
+    // 방 전체를 복사하는 나눌 수 없는 작업이라 예산을 넘긴 만큼 다음 게시를 늦춤 (방이 많으면 목록 갱신이 느려짐)
+    _publishBudget.Begin();
+    _roomManager->FillSnapshot(*snapshot);
+    _roomListPublisher.Publish();
+    _publishBudget.End(snapshot->rooms.size(), false);
+    _nextRoomListPublish = now + (std::max)(std::chrono::steady_clock::duration(ROOM_LIST_PUBLISH_INTERVAL),
+        _publishBudget.GetAmortizedInterval(_tickScheduler.GetInterval()));
 }
 
-void CCentralizedServer::SendRoomLeft(std::shared_ptr<CPlayer> player, bool success)
+void CCentralizedServer::LogPoolStats()
 {
-    MSG_S2C_ROOM_LEFT msg;
-    msg.header.size = sizeof(MSG_S2C_ROOM_LEFT);
-    msg.header.type = MsgType::S2C_ROOM_LEFT;
-    msg.success = success ? 1 : 0;
+    PoolStats playerStats = _players.GetStats();
+    PoolStats roomStats = _roomManager->GetRoomPoolStats();
+    PoolStats timerStats = _timers.GetStats();
+
+    LOG_INFO("[CentralizedServer] Pool - Players: {}/{} (peak {}, fail {}), Rooms: {}/{} (peak {}, fail {}), Index nodes: {} KB",
+        playerStats.inUse, playerStats.capacity, playerStats.peak, playerStats.allocFailures,
+        roomStats.inUse, roomStats.capacity, roomStats.peak, roomStats.allocFailures,
+        _roomManager->GetIndexPoolBytes() / 1024);
+    LOG_INFO("[CentralizedServer] Pool - Timers: {}/{} (peak {}, fail {})",
+        timerStats.inUse, timerStats.capacity, timerStats.peak, timerStats.allocFailures);
+}
+
+void CCentralizedServer::LogPhaseStats()
+{
+    _gameEventBudget.LogStats("CentralizedServer");
+    _lobbyEventBudget.LogStats("CentralizedServer");
+    _timerBudget.LogStats("CentralizedServer");
+    _publishBudget.LogStats("CentralizedServer");
+
+    if (!_lobbyBacklog.empty() || _owedTimerTicks > 0)
+    {
+        LOG_WARNING("[CentralizedServer] Deferred work at report time: {} lobby events, {} timer ticks",
+            _lobbyBacklog.size(), _owedTimerTicks);
+    }
+}
 
-    _networkServer->RequestSendMsg(player->GetSessionId(), reinterpret_cast<const char*>(&msg), sizeof(msg));
+void CCentralizedServer::DispatchTimer(const TimerEvent& event)
+{
+    switch (event.type)
+    {
+    case TimerType::PLAYER_AFK_CHECK:
+        HandleAfkCheck(event);
+        break;
+    }
 }
 
-void CCentralizedServer::SendError(std::shared_ptr<CPlayer> player, const std::string& message)
+void CCentralizedServer::ArmAfkTimer(CPlayer& player)
 {
-    MSG_S2C_ERROR msg;
-    msg.header.size = sizeof(MSG_S2C_ERROR);
-    msg.header.type = MsgType::S2C_ERROR;
-    strncpy_s(msg.message, message.c_str(), sizeof(msg.message) - 1);
-    msg.message[sizeof(msg.message) - 1] = '\0';
+    if (player.GetRoomHandle().IsNull() || _timers.IsActive(player.GetAfkTimer()))
+    {
+        return;
+    }
 
-    _networkServer->RequestSendMsg(player->GetSessionId(), reinterpret_cast<const char*>(&msg), sizeof(msg));
+    TimerEvent event;
+    event.type = TimerType::PLAYER_AFK_CHECK;
+    event.player = player.GetHandle();
+    player.SetAfkTimer(_timers.Schedule(_afkTimeoutTicks, event)); // 가득 차서 실패하면 다음 요청 때 다시 시도
 }
 
-void CCentralizedServer::ProcessGameLogic()
+void CCentralizedServer::HandleAfkCheck(const TimerEvent& event)
 {
-    // 주기적인 게임 로직 처리
-    // 예: 게임 타이머, 상태 업데이트 등
+    // 그 사이 접속 종료(핸들 무효)나 방 퇴장이면 할 일 없음. 다시 입장하면 그때 새로 걸림
+    CPlayer* player = _players.Get(event.player);
+    if (!player || player->GetRoomHandle().IsNull())
+    {
+        return;
+    }
+
+    uint64_t idleTicks = _timers.GetCurrentTick() - player->GetLastActivityTick();
+    if (idleTicks < _afkTimeoutTicks)
+    {
+        // 그 사이 요청이 있었음: 마지막 요청 기준으로 남은 시간만큼 다시 검
+        TimerEvent next = event;
+        player->SetAfkTimer(_timers.Schedule(static_cast<uint32_t>(_afkTimeoutTicks - idleTicks), next));
+        return;
+    }
+
+    CRoom* room = _roomManager->GetRoom(player->GetRoomHandle());
+    int32_t roomId = room ? room->GetRoomId() : 0;
+    int32_t idleSeconds = static_cast<int32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        _tickScheduler.GetInterval() * static_cast<int64_t>(idleTicks)).count());
+
+    LOG_INFO("[CentralizedServer] AFK kick - SessionId: {}, RoomId: {}, idle {}s", player->GetSessionId(), roomId, idleSeconds);
+
+    _roomManager->LeaveRoom(*player);
+    SendRoomLeft(*_networkServer, player->GetSessionId(), REQUEST_ID_NONE, true);
+    SendError(*_networkServer, player->GetSessionId(), REQUEST_ID_NONE, ErrorCode::AFK_KICKED, { roomId, idleSeconds });
 }
 
-std::shared_ptr<CPlayer> CCentralizedServer::GetPlayer(int64_t sessionId)
+CPlayer* CCentralizedServer::GetPlayer(int64_t sessionId)
 {
-    auto it = _players.find(sessionId);
-    return (it != _players.end()) ? it->second : nullptr;
+    return _sessionToPlayer.Find(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
 }
 
-void CCentralizedServer::AddPlayer(std::shared_ptr<CPlayer> player)
+CPlayer* CCentralizedServer::AddPlayer(int64_t sessionId)
 {
-    _players[player->GetSessionId()] = player;
+    uint16_t index = CSession::ExtractIndex(sessionId);
+
+    // 같은 슬롯의 이전 세션이 아직 남아있으면 (종료 이벤트 누락) 먼저 정리
+    if (CPlayer* stalePlayer = _sessionToPlayer.Peek(index))
+    {
+        LOG_WARNING("[CentralizedServer] Stale player in session slot {} (SessionId: {}), removing",
+            index, stalePlayer->GetSessionId());
+        _roomManager->LeaveRoom(*stalePlayer);
+        RemovePlayer(stalePlayer->GetSessionId());
+    }
+
+    PlayerHandle handle = _players.Create(sessionId);
+    CPlayer* player = _players.Get(handle);
+    if (!player)
+    {
+        return nullptr;
+    }
+
+    player->SetHandle(handle);
+
+    if (!_sessionToPlayer.Insert(index, CSession::ExtractUniqueId(sessionId), player))
+    {
+        // 세션 index가 maxClients 범위를 벗어남
+        _players.Release(handle);
+        return nullptr;
+    }
+
+    return player;
 }
 
 void CCentralizedServer::RemovePlayer(int64_t sessionId)
 {
-    _players.erase(sessionId);
+    CPlayer* player = GetPlayer(sessionId);
+    if (!player)
+    {
+        return;
+    }
+
+    // 걸려있는 타이머 노드 반환 (남겨둬도 만료 시 핸들 검증에서 걸러지지만, 접속이 잦으면 노드가 쌓임)
+    _timers.Cancel(player->GetAfkTimer());
+
+    // 테이블 항목을 먼저 지우고 풀에 반환 (Release 이후 player 포인터는 무효)
+    _sessionToPlayer.Erase(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+    _players.Release(player->GetHandle());
 }
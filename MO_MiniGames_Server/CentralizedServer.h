@@ -4,16 +4,24 @@
 #include "RoomManager.h"
 #include "Protocol.h"
 #include "Player.h"
+#include "HandleTable.h"
+#include "SessionSlotTable.h"
+#include "RoomListSnapshot.h"
+#include "TickScheduler.h"
+#include "TimerWheel.h"
+#include "LobbyHandler.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <chrono>
-#include <unordered_map>
+#include <vector>
+#include <queue>
 
 // 중앙 집중형 게임 로직 레이어 - 별도 스레드에서 동작
 class CCentralizedServer
 {
 public:
+    // mainlogicTickMs: 게임 로직 틱 간격 (0 이하면 TICK_DEFAULT_INTERVAL). 네트워크 이벤트는 틱과 관계없이 바로 처리
     explicit CCentralizedServer(int port, int maxClients, int mainlogicTickMs = -1);
     virtual ~CCentralizedServer();
 
@@ -23,30 +31,47 @@ public:
 private:
     void GameLogicThread();
 
+    // 예산 안에서 네트워크 이벤트 처리. 다 못 하고 미룬 이벤트가 있으면 true
+    bool ProcessNetworkEvents();
+    bool IsGameEvent(const NetworkEvent& event) const; // 방 안 플레이어의 이벤트 (우선 처리)
+    void DispatchNetworkEvent(const NetworkEvent& event);
+
     // 네트워크 이벤트 처리 //////////////////////////////////////////////////////////
     void DispatchClientConnected(int64_t sessionId);
     void DispatchClientDisconnected(int64_t sessionId);
     void DispatchDataReceived(int64_t sessionId, const char* data, size_t length);
     ////////////////////////////////////////////////////////////////////////////////
 
-    // 패킷 핸들러 (CPlayer 기반)
-    void HandleRequestRoomList(std::shared_ptr<CPlayer> player);
-    void HandleCreateRoom(std::shared_ptr<CPlayer> player, const MSG_C2S_CREATE_ROOM* msg);
-    void HandleJoinRoom(std::shared_ptr<CPlayer> player, const MSG_C2S_JOIN_ROOM* msg);
-    void HandleLeaveRoom(std::shared_ptr<CPlayer> player);
+    // IOCP 워커 스레드에서 바로 처리하는 요청 (방 목록 조회). 처리했으면 true
+    // 게시된 방 목록 스냅샷만 읽고 로직 스레드 상태(플레이어, 방)는 건드리지 않음
+    bool HandleWorkerMsg(int64_t sessionId, const char* data, size_t length);
+    void HandleRequestRoomList(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_LIST* msg);
+    void HandleRequestRoomPage(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_PAGE& msg);
+
+    // 패킷 핸들러 (플레이어는 테이블 안의 객체를 참조로 전달, 참조 카운트 없음)
+    void HandleCreateRoom(CPlayer& player, const MSG_C2S_CREATE_ROOM& msg);
+    void HandleJoinRoom(CPlayer& player, const MSG_C2S_JOIN_ROOM* msg);
+    void HandleLeaveRoom(CPlayer& player, const MSG_C2S_LEAVE_ROOM* msg);
+    void HandleQuickJoin(CPlayer& player, const MSG_C2S_QUICK_JOIN* msg);
 
-    // 패킷 전송 헬퍼
-    void SendRoomList(std::shared_ptr<CPlayer> player);
-    void SendRoomCreated(std::shared_ptr<CPlayer> player, int32_t roomId, bool success);
-    void SendRoomJoined(std::shared_ptr<CPlayer> player, int32_t roomId, bool success);
-    void SendRoomLeft(std::shared_ptr<CPlayer> player, bool success);
-    void SendError(std::shared_ptr<CPlayer> player, const std::string& message);
+    // 공용 판정(CRoomRequestHandler)에 넘기는 좌석 처리: 방 디렉터리에 플레이어를 바로 넣음
+    ErrorCode SeatPlayer(CPlayer& player, CRoom& room);
+    int32_t GetCurrentRoomId(const CPlayer& player); // 방에 없으면 ROOM_ID_NONE
 
     void ProcessGameLogic();
+    bool ProcessTimers(); // 밀린 타이머 틱을 예산 안에서 진행. 남았으면 true
+    void LogPoolStats();
+    void LogPhaseStats();
+
+    // 타이머 (로직 스레드, 틱마다 만료분 처리)
+    void DispatchTimer(const TimerEvent& event);
+    void ArmAfkTimer(CPlayer& player); // 방 안에 있고 검사 타이머가 없으면 건다
+    void HandleAfkCheck(const TimerEvent& event);
+    void PublishRoomList();
 
     // 플레이어 관리
-    std::shared_ptr<CPlayer> GetPlayer(int64_t sessionId);
-    void AddPlayer(std::shared_ptr<CPlayer> player);
+    CPlayer* GetPlayer(int64_t sessionId);
+    CPlayer* AddPlayer(int64_t sessionId);
     void RemovePlayer(int64_t sessionId);
 
 private:
@@ -54,8 +79,37 @@ private:
     std::shared_ptr<CRoomManager> _roomManager;
     std::thread _gameThread;
     std::atomic<bool> _running;
-    int _mainlogicTickMs;
 
-    // 플레이어 관리 (sessionId -> Player)
-    std::unordered_map<int64_t, std::shared_ptr<CPlayer>> _players;
+    // 고정 간격 틱 + 이벤트가 들어오면 바로 깨어남 (IOCP 워커가 큐에 넣고 Notify)
+    CTickScheduler _tickScheduler;
+
+    // 로직 루프 단계별 시간 예산 (틱 간격의 일부). 넘으면 남은 일은 다음 루프로
+    CPhaseBudget _gameEventBudget;
+    CPhaseBudget _lobbyEventBudget;
+    CPhaseBudget _timerBudget;
+    CPhaseBudget _publishBudget; // 나눌 수 없는 작업이라 넘긴 만큼 다음 게시를 미룸
+
+    // 로비 이벤트 대기열 (방 밖 플레이어, 접속). 게임 이벤트 뒤에 로비 예산만큼 처리
+    // 세션 index마다 대기열에 있는 이벤트 수 -> 0이 아니면 그 세션의 이후 이벤트도 대기열로 (세션 안 순서 유지)
+    std::queue<NetworkEvent> _lobbyBacklog;
+    std::vector<uint32_t> _deferredEvents;
+
+    // 게임 로직 타이머 (방 카운트다운, 잠수 검사 등). 시간 단위는 로직 틱
+    CTimerWheel _timers;
+    uint32_t _afkTimeoutTicks;
+    uint32_t _owedTimerTicks; // 예산을 넘겨 아직 진행하지 못한 타이머 틱
+
+    // 플레이어 저장소 (세대 핸들 테이블, maxClients 크기 고정 풀)
+    CHandleTable<CPlayer> _players;
+
+    // sessionId -> 플레이어 (세션 슬롯 index로 바로 접근, uniqueId로 검증)
+    // 패킷마다 호출되는 GetPlayer 경로에 해싱 없음
+    CSessionSlotTable<CPlayer> _sessionToPlayer;
+
+    // 방 목록 스냅샷 (로직 스레드가 게시, 워커 스레드가 읽음)
+    CRoomListPublisher _roomListPublisher;
+    std::chrono::steady_clock::time_point _nextRoomListPublish; // 게시 간격 + 예산을 넘긴 만큼 미룸
+
+    // 풀 점유율 로그 주기
+    std::chrono::steady_clock::time_point _lastPoolStatsLog;
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// __________________________________________________________________
+//
+// 바뀐 슬롯 목록 (lock-free, 다중 생산자 / 단일 소비자)
+// 고정된 슬롯 번호 [0, slotCount)에 "확인할 것이 있음"을 표시하고, 소비자는 표시된 슬롯만 꺼내서 처리
+// -> 슬롯 전체를 주기적으로 훑지 않아도 되므로 비용이 바뀐 슬롯 수에 비례
+// 슬롯마다 다음 링크 하나를 두는 intrusive 스택: 생산자는 CAS로 머리에 넣고, 소비자는 머리를 통째로 떼어냄
+// (하나씩 꺼내지 않으므로 ABA 없음). 이미 목록에 있는 슬롯은 다시 넣지 않으므로 Push가 몇 번 와도 한 번만 나옴
+// 슬롯에 딸린 값(상태 등)은 호출 측이 Push 전에 써두고, 소비자는 Drain 콜백 안에서 읽음
+// __________________________________________________________________
+
+class CChangedSlotList
+{
+public:
+    static constexpr uint32_t SLOT_NONE = UINT32_MAX;
+
+    explicit CChangedSlotList(size_t slotCount)
+        : _head(SLOT_NONE)
+        , _next(std::make_unique<uint32_t[]>(slotCount))
+        , _queued(std::make_unique<std::atomic<bool>[]>(slotCount))
+    {
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            _next[i] = SLOT_NONE;
+            _queued[i].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    CChangedSlotList(const CChangedSlotList&) = delete;
+    CChangedSlotList& operator=(const CChangedSlotList&) = delete;
+
+    // 아무 스레드. 이미 목록에 있으면 아무것도 하지 않음
+    void Push(uint32_t slot)
+    {
+        if (_queued[slot].exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        // 링크는 이 슬롯을 넣은 생산자만 씀 (소비자가 꺼내서 _queued를 내리기 전까지 다시 들어오지 않음)
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        do
+        {
+            _next[slot] = head;
+        } while (!_head.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 소비자 스레드 하나 전용. 지금까지 표시된 슬롯을 모두 꺼내서 func(slot) (순서는 최근에 넣은 것부터)
+    // 콜백 안에서 같은 슬롯이 다시 표시되면 다음 Drain에 나옴
+    template <typename Func>
+    size_t Drain(Func&& func)
+    {
+        size_t count = 0;
+        uint32_t slot = _head.exchange(SLOT_NONE, std::memory_order_acquire);
+        while (slot != SLOT_NONE)
+        {
+            // _queued를 내린 뒤에는 생산자가 링크를 다시 쓸 수 있으므로 먼저 읽어둠
+            uint32_t next = _next[slot];
+            _queued[slot].store(false, std::memory_order_release);
+
+            func(slot);
+            ++count;
+            slot = next;
+        }
+        return count;
+    }
+
+private:
+    std::atomic<uint32_t> _head;
+    std::unique_ptr<uint32_t[]> _next;
+    std::unique_ptr<std::atomic<bool>[]> _queued;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// __________________________________________________________________
+//
+// 세대 핸들 테이블
+// 핸들 = 슬롯 index + generation. 슬롯이 해제될 때마다 generation이 올라가므로
+// 해제된 객체를 가리키던 핸들은 Get에서 nullptr (ABA 방지, 세션 ID의 index + uniqueId와 같은 방식)
+// 참조 카운트 없이 정수 비교만으로 유효성 검사 -> 핫 경로에 atomic 연산 / 포인터 해싱 없음
+//
+// 고정 용량 풀: 생성 시 슬롯 배열을 한 번만 할당하고 이후 Create/Release는 힙을 쓰지 않는다.
+// 슬롯 주소가 바뀌지 않으므로 Get으로 얻은 포인터는 해당 핸들을 Release 하기 전까지 유효.
+// 가득 차면 Create가 null 핸들을 반환 (allocFailures 증가)
+// 단일 스레드(게임 로직 스레드) 전용
+// __________________________________________________________________
+
+constexpr uint32_t HANDLE_INDEX_NONE = UINT32_MAX;
+
+template <typename T>
+struct THandle
+{
+    uint32_t index = HANDLE_INDEX_NONE;
+    uint32_t generation = 0; // 슬롯 generation은 1부터 시작하므로 0은 항상 무효
+
+    bool IsNull() const { return index == HANDLE_INDEX_NONE; }
+
+    bool operator==(const THandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const THandle& other) const { return !(*this == other); }
+};
+
+class CPlayer;
+class CRoom;
+
+using PlayerHandle = THandle<CPlayer>;
+using RoomHandle = THandle<CRoom>;
+
+// 풀 점유율 (모니터링용)
+struct PoolStats
+{
+    size_t capacity = 0;
+    size_t inUse = 0;
+    size_t peak = 0;            // 최대 동시 사용량
+    uint64_t allocFailures = 0; // 가득 차서 실패한 횟수
+};
+
+template <typename T>
+class CHandleTable
+{
+public:
+    using Handle = THandle<T>;
+
+    explicit CHandleTable(size_t capacity)
+        : _slots(std::make_unique<Slot[]>(capacity))
+        , _capacity(static_cast<uint32_t>(capacity))
+        , _highWater(0)
+        , _freeHead(HANDLE_INDEX_NONE)
+        , _count(0)
+        , _peak(0)
+        , _allocFailures(0)
+    {
+    }
+
+    CHandleTable(const CHandleTable&) = delete;
+    CHandleTable& operator=(const CHandleTable&) = delete;
+
+    // 해제된 슬롯이 있으면 재사용, 없으면 아직 안 쓴 슬롯 사용
+    template <typename... Args>
+    Handle Create(Args&&... args)
+    {
+        uint32_t index;
+        if (_freeHead != HANDLE_INDEX_NONE)
+        {
+            index = _freeHead;
+            _freeHead = _slots[index].nextFree;
+        }
+        else if (_highWater < _capacity)
+        {
+            index = _highWater++;
+        }
+        else
+        {
+            ++_allocFailures;
+            return Handle();
+        }
+
+        Slot& slot = _slots[index];
+        slot.value.emplace(std::forward<Args>(args)...);
+        slot.nextFree = HANDLE_INDEX_NONE;
+
+        if (++_count > _peak)
+        {
+            _peak = _count;
+        }
+
+        Handle handle;
+        handle.index = index;
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    T* Get(Handle handle)
+    {
+        if (handle.index >= _highWater)
+            return nullptr;
+
+        Slot& slot = _slots[handle.index];
+        return (slot.generation == handle.generation && slot.value) ? &*slot.value : nullptr;
+    }
+
+    const T* Get(Handle handle) const
+    {
+        return const_cast<CHandleTable*>(this)->Get(handle);
+    }
+
+    bool Release(Handle handle)
+    {
+        if (!Get(handle))
+            return false;
+
+        Slot& slot = _slots[handle.index];
+        slot.value.reset();
+
+        // 0은 무효 핸들용으로 남겨둠
+        if (++slot.generation == 0)
+        {
+            slot.generation = 1;
+        }
+
+        slot.nextFree = _freeHead;
+        _freeHead = handle.index;
+        --_count;
+        return true;
+    }
+
+    size_t GetCount() const { return _count; }
+    size_t GetCapacity() const { return _capacity; }
+
+    PoolStats GetStats() const
+    {
+        PoolStats stats;
+        stats.capacity = _capacity;
+        stats.inUse = _count;
+        stats.peak = _peak;
+        stats.allocFailures = _allocFailures;
+        return stats;
+    }
+
+    template <typename Func>
+    void ForEach(Func&& func)
+    {
+        for (uint32_t i = 0; i < _highWater; ++i)
+        {
+            if (_slots[i].value)
+            {
+                func(*_slots[i].value);
+            }
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::optional<T> value;
+        uint32_t generation = 1;
+        uint32_t nextFree = HANDLE_INDEX_NONE; // 빈 슬롯 리스트 (해제된 슬롯끼리 연결)
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    uint32_t _capacity;
+    uint32_t _highWater; // 한 번이라도 사용된 슬롯 수
+    uint32_t _freeHead;
+    size_t _count;
+    size_t _peak;
+    uint64_t _allocFailures;
+};
@@ -1,5 +1,5 @@
 #include "IOCPServer.h"
-#include <iostream>
+#include "AsyncLogger.h"
 
 extern void SignalProcessShutdown(); // main쪽에 정의된 함수
 
@@ -80,7 +80,7 @@ bool CIOCPServer::Start()
     WSADATA wsaData;
     if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
     {
-        std::cerr << "WSAStartup failed" << std::endl;
+        LOG_ERROR("[Network] WSAStartup failed");
         return false;
     }
 
@@ -112,19 +112,19 @@ bool CIOCPServer::Start()
     // Accept 스레드 생성
     _acceptThread = std::thread(&CIOCPServer::AcceptThread, this);
 
-    std::cout << "[Network] Server started with " << threadCount << " worker threads (Mode: ";
-
+    const char* modeName = "Unknown";
     switch (_architectureType)
     {
-    case ServerArchitectureType::EchoTest: std::cout << "EchoTest"; break;
-    case ServerArchitectureType::Centralized: std::cout << "Centralized"; break;
-    case ServerArchitectureType::Partitioned: std::cout << "Partitioned"; break;
-    case ServerArchitectureType::UnifiedStrand: std::cout << "UnifiedStrand"; break;
+    case ServerArchitectureType::EchoTest: modeName = "EchoTest"; break;
+    case ServerArchitectureType::Centralized: modeName = "Centralized"; break;
+    case ServerArchitectureType::Partitioned: modeName = "Partitioned"; break;
+    case ServerArchitectureType::UnifiedStrand: modeName = "UnifiedStrand"; break;
 
     default:
         break;
     }
-    std::cout << ")" << std::endl;
+
+    LOG_INFO("[Network] Server started with {} worker threads (Mode: {})", threadCount, modeName);
     return true;
 }
 
@@ -134,7 +134,7 @@ bool CIOCPServer::CreateListenSocket()
     _listenSocket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
     if (_listenSocket == INVALID_SOCKET)
     {
-        std::cerr << "WSASocket failed: " << WSAGetLastError() << std::endl;
+        LOG_ERROR("[Network] WSASocket failed: {}", WSAGetLastError());
         return false;
     }
 
@@ -146,14 +146,14 @@ bool CIOCPServer::CreateListenSocket()
 
     if (bind(_listenSocket, (SOCKADDR*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR)
     {
-        std::cerr << "bind failed: " << WSAGetLastError() << std::endl;
+        LOG_ERROR("[Network] bind failed: {}", WSAGetLastError());
         closesocket(_listenSocket);
         return false;
     }
 
     if (listen(_listenSocket, SOMAXCONN) == SOCKET_ERROR)
     {
-        std::cerr << "listen failed: " << WSAGetLastError() << std::endl;
+        LOG_ERROR("[Network] listen failed: {}", WSAGetLastError());
         closesocket(_listenSocket);
         return false;
     }
@@ -183,7 +183,7 @@ bool CIOCPServer::BindIOCP(SOCKET socket, ULONG_PTR completionKey)
     auto handle = CreateIoCompletionPort((HANDLE)socket, _iocpHandle, completionKey, 0);
     if (handle == NULL)
     {
-        std::cerr << "BindIOCP failed: " << GetLastError() << std::endl;
+        LOG_ERROR("[Network] BindIOCP failed: {}", GetLastError());
         return false;
     }
     return true;
@@ -300,7 +300,7 @@ void CIOCPServer::AcceptThread()
         {
             if (_running)
             {
-                std::cerr << "accept failed: " << WSAGetLastError() << std::endl;
+                LOG_ERROR("[Network] accept failed: {}", WSAGetLastError());
             }
             continue;
         }
@@ -315,7 +315,7 @@ void CIOCPServer::ProcessAccept(SOCKET clientSocket)
     // 빈 인덱스 확인 (여유가 없다면 동접 max)
     if (_availableIndices.empty())
     {
-        std::cerr << "[Error] No free session index available" << std::endl;
+        LOG_ERROR("[Network] No free session index available");
         closesocket(clientSocket);
         return;
     }
@@ -336,7 +336,7 @@ void CIOCPServer::ProcessAccept(SOCKET clientSocket)
     // IOCP의 CompletionKey는 단순 식별자 역할이므로, 세션 소유권을 갖지 않는다.
     if (!BindIOCP(clientSocket, (ULONG_PTR)_sessions[index].get()))
     {
-        std::cerr << "Failed to bind client socket to IOCP" << std::endl;
+        LOG_ERROR("[Network] Failed to bind client socket to IOCP");
         _sessions[index]->Close();
         _availableIndices.push(index);
         closesocket(clientSocket);
@@ -353,15 +353,19 @@ void CIOCPServer::ProcessAccept(SOCKET clientSocket)
         PushNetworkEvent(NetworkEvent(NetworkEvent::Type::CONNECTED, sessionId));
         break;
 
-    case ServerArchitectureType::UnifiedStrand: // 직접 처리 (하위 클래스에서 오버라이드된 메서드 호출)
-        //OnClientConnected(sessionId);
+    case ServerArchitectureType::Partitioned: // 라우터가 파티션 큐로 분배
+        RouteNetworkEvent(NetworkEvent::Type::CONNECTED, sessionId);
+        break;
+
+    case ServerArchitectureType::UnifiedStrand: // 라우터가 액터 메일박스로 분배
+        RouteNetworkEvent(NetworkEvent::Type::CONNECTED, sessionId);
         break;
 
     default:
         break;
     }
 
-    //std::cout << "Client connected - SessionId: " << sessionId << " (Index: " << index << ", UniqueID: " << uniqueId << ")" << std::endl;
+    LOG_DEBUG("[Network] Client connected - SessionId: {} (Index: {}, UniqueID: {})", sessionId, index, uniqueId);
 
     // 첫 Recv 요청
     PostRecv(_sessions[index].get());
@@ -401,7 +405,7 @@ void CIOCPServer::WorkerThread()
         //overlappedEx, session이 nullptr인 상황은 있을 수 없음
         if(overlappedEx == nullptr || session == nullptr)
         {
-            std::cerr << "[Error] Invalid overlappedEx or session pointer in WorkerThread" << std::endl;
+            LOG_ERROR("[Network] Invalid overlappedEx or session pointer in WorkerThread");
             continue;
         }
 
@@ -439,7 +443,7 @@ void CIOCPServer::ProcessRecv(CSession* session, DWORD bytesTransferred)
     // 방어 로직
     if (bytesTransferred == 0)
     {
-        std::cerr << "[Warning] ProcessRecv called with bytesTransferred == 0 - SessionId: " << session->_sessionId << std::endl;
+        LOG_WARNING("[Network] ProcessRecv called with bytesTransferred == 0 - SessionId: {}", session->_sessionId);
         DisconnectSessionInternal(session);
         return;
     }
@@ -448,8 +452,8 @@ void CIOCPServer::ProcessRecv(CSession* session, DWORD bytesTransferred)
     size_t movedSize = session->_recvQ.MoveWritePtr(bytesTransferred);
     if (movedSize != bytesTransferred)
     {
-        std::cerr << "[Error] Recv buffer overflow - SessionId: " << session->_sessionId 
-                  << ", Expected: " << bytesTransferred << ", Moved: " << movedSize << std::endl;
+        LOG_ERROR("[Network] Recv buffer overflow - SessionId: {}, Expected: {}, Moved: {}",
+            session->_sessionId, bytesTransferred, movedSize);
         DisconnectSessionInternal(session);
         return;
     }
@@ -504,7 +508,7 @@ void CIOCPServer::PostRecv(CSession* session)
     if (bufCount == 0)
     {
         // 링버퍼가 가득 찬 경우 - 연결 종료
-        std::cerr << "[Error] Recv buffer full - SessionId: " << session->_sessionId << std::endl;
+        LOG_ERROR("[Network] Recv buffer full - SessionId: {}", session->_sessionId);
         DisconnectSessionInternal(session);
         return;
     }
@@ -517,7 +521,7 @@ void CIOCPServer::PostRecv(CSession* session)
 
     if (result == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
     {
-        std::cerr << "[Error] WSARecv failed: " << WSAGetLastError() << " - SessionId: " << session->_sessionId << std::endl;
+        LOG_ERROR("[Network] WSARecv failed: {} - SessionId: {}", WSAGetLastError(), session->_sessionId);
         DisconnectSessionInternal(session);
     }
 }
@@ -552,8 +556,7 @@ void CIOCPServer::ParsePackets(CSession* session)
         // 3. 패킷 크기 검증
         if (header.size < MIN_PACKET_SIZE || header.size > MAX_PACKET_SIZE)
         {
-            std::cerr << "[Error] Invalid packet size: " << header.size 
-                      << " - SessionId: " << session->_sessionId << std::endl;
+            LOG_ERROR("[Network] Invalid packet size: {} - SessionId: {}", header.size, session->_sessionId);
             DisconnectSessionInternal(session);
             return;
         }
@@ -569,7 +572,7 @@ void CIOCPServer::ParsePackets(CSession* session)
         size_t dequeuedSize = session->_recvQ.Dequeue(packetBuffer.data(), header.size);
         if (dequeuedSize != header.size)
         {
-            std::cerr << "[Error] Packet dequeue failed - SessionId: " << session->_sessionId << std::endl;
+            LOG_ERROR("[Network] Packet dequeue failed - SessionId: {}", session->_sessionId);
             DisconnectSessionInternal(session);
             return;
         }
@@ -582,12 +585,21 @@ void CIOCPServer::ParsePackets(CSession* session)
                 // 따로 전달 없음
                 break;
         case ServerArchitectureType::Centralized: // 큐에 넣어서 별도 스레드로 전달
+            // 로직 스레드 상태가 필요 없는 요청은 여기서 바로 응답
+            if (_workerMsgHandler && _workerMsgHandler(session->_sessionId, packetBuffer.data(), packetBuffer.size()))
+            {
+                break;
+            }
             PushNetworkEvent(NetworkEvent(NetworkEvent::Type::RECEIVED, 
                 session->_sessionId, packetBuffer.data(), packetBuffer.size()));
             break;
 
-        case ServerArchitectureType::UnifiedStrand: // 직접 처리 (하위 클래스에서 오버라이드된 메서드 호출)
-            //OnDataReceived(session->_sessionId, packetBuffer.data(), packetBuffer.size());
+        case ServerArchitectureType::Partitioned: // 라우터가 파티션 큐로 분배
+            RouteNetworkEvent(NetworkEvent::Type::RECEIVED, session->_sessionId, packetBuffer.data(), packetBuffer.size());
+            break;
+
+        case ServerArchitectureType::UnifiedStrand: // 라우터가 액터 메일박스로 분배
+            RouteNetworkEvent(NetworkEvent::Type::RECEIVED, session->_sessionId, packetBuffer.data(), packetBuffer.size());
             break;
 
         default:
@@ -609,8 +621,8 @@ void CIOCPServer::ProcessSend(CSession* session, DWORD bytesTransferred)
     size_t consumed = session->_sendQ.Consume(bytesTransferred);
     if (consumed != bytesTransferred)
     {
-        std::cerr << "[Error] Send consume mismatch - SessionId: " << session->_sessionId
-                  << ", Expected: " << bytesTransferred << ", Consumed: " << consumed << std::endl;
+        LOG_ERROR("[Network] Send consume mismatch - SessionId: {}, Expected: {}, Consumed: {}",
+            session->_sessionId, bytesTransferred, consumed);
         DisconnectSessionInternal(session);
         return;
     }
@@ -651,8 +663,7 @@ void CIOCPServer::ProcessSend(CSession* session, DWORD bytesTransferred)
 
             if (result == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
             {
-                std::cerr << "[Error] WSASend failed: " << WSAGetLastError()
-                          << " - SessionId: " << session->_sessionId << std::endl;
+                LOG_ERROR("[Network] WSASend failed: {} - SessionId: {}", WSAGetLastError(), session->_sessionId);
                 session->_sending.store(false);
                 DisconnectSessionInternal(session);
             }
@@ -738,8 +749,7 @@ void CIOCPServer::PostSend(CSession* session)
 
     if (result == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
     {
-        std::cerr << "[Error] WSASend failed: " << WSAGetLastError() 
-                  << " - SessionId: " << session->_sessionId << std::endl;
+        LOG_ERROR("[Network] WSASend failed: {} - SessionId: {}", WSAGetLastError(), session->_sessionId);
         session->_sending.store(false);
         DisconnectSessionInternal(session);
     }
@@ -759,8 +769,8 @@ void CIOCPServer::RequestSendMsg(int64_t sessionId, const char* data, int length
     size_t enqueued = session->_sendQ.Enqueue(data, length);
     if (enqueued != length)
     {
-        std::cerr << "[Error] Send buffer overflow - SessionId: " << sessionId 
-                  << ", Requested: " << length << ", Enqueued: " << enqueued << std::endl;
+        LOG_ERROR("[Network] Send buffer overflow - SessionId: {}, Requested: {}, Enqueued: {}",
+            sessionId, length, enqueued);
         DisconnectSessionInternal(session);
         return;
     }
@@ -779,6 +789,19 @@ void CIOCPServer::EchoTestSend(CSession* session, const char* data, size_t lengt
 void CIOCPServer::PushNetworkEvent(NetworkEvent&& event)
 {
     _eventQueue.Push(std::move(event));
+    if (_networkEventNotifier)
+    {
+        _networkEventNotifier();
+    }
+}
+
+// 워커 스레드에서 호출. 라우터가 없으면 버림
+void CIOCPServer::RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)
+{
+    if (_networkEventRouter)
+    {
+        _networkEventRouter(type, sessionId, data, length);
+    }
 }
 
 // GameLogicThread 쪽에서 호출
@@ -792,6 +815,21 @@ ServerArchitectureType CIOCPServer::GetArchitectureType() const
     return _architectureType;
 }
 
+void CIOCPServer::SetWorkerMsgHandler(WorkerMsgHandler handler)
+{
+    _workerMsgHandler = std::move(handler);
+}
+
+void CIOCPServer::SetNetworkEventRouter(NetworkEventRouter router)
+{
+    _networkEventRouter = std::move(router);
+}
+
+void CIOCPServer::SetNetworkEventNotifier(NetworkEventNotifier notifier)
+{
+    _networkEventNotifier = std::move(notifier);
+}
+
 // 실제 할당, 해제는 acceptthread에서
 bool CIOCPServer::DisconnectSessionInternal(CSession* session)
 {
@@ -824,7 +862,11 @@ bool CIOCPServer::DisconnectSessionInternal(CSession* session)
     case ServerArchitectureType::Centralized:
             PushNetworkEvent(NetworkEvent(NetworkEvent::Type::DISCONNECTED, session->_sessionId));
         break;
+    case ServerArchitectureType::Partitioned:
+        RouteNetworkEvent(NetworkEvent::Type::DISCONNECTED, session->_sessionId);
+        break;
     case ServerArchitectureType::UnifiedStrand:
+        RouteNetworkEvent(NetworkEvent::Type::DISCONNECTED, session->_sessionId);
         break;
 
     default:
@@ -35,7 +35,7 @@ enum class ServerArchitectureType
     EchoTest,       // 에코 테스트용 (최소 기능)
     Centralized,    // 중앙 집중형 - 별도 스레드에서 이벤트 처리
     Partitioned,    // 분산형 - 여러 스레드/큐로 분리 처리
-    UnifiedStrand   // 통합 스트랜드 - IOCP 워커가 게임 로직까지 직접 처리
+    UnifiedStrand   // 통합 스트랜드 - IOCP 워커가 방(액터) 메일박스에 바로 넣고 공용 워커 풀이 방마다 하나씩 실행
 };
 
 class CSession
@@ -181,6 +181,16 @@ private:
 
 //TODO: 아키텍쳐별 설계..
 
+// 워커 스레드에서 바로 처리할 메시지 핸들러 (처리했으면 true, 아니면 게임 로직 큐로 전달)
+using WorkerMsgHandler = std::function<bool(int64_t sessionId, const char* data, size_t length)>;
+
+// 분산형(Partitioned) / 통합 스트랜드(UnifiedStrand) 모드에서 워커 스레드가 모든 이벤트를 바로 넘기는 라우터
+// 받는 쪽이 파티션(샤드)별 큐나 액터 메일박스로 나눠 담음. data는 RECEIVED일 때만 유효하고 호출이 끝나면 무효
+using NetworkEventRouter = std::function<void(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)>;
+
+// 이벤트 큐에 넣은 직후 워커 스레드에서 호출 (Centralized 모드: 잠든 로직 스레드 깨우기)
+using NetworkEventNotifier = std::function<void()>;
+
 // 네트워크 I/O 처리 레이어
 class CIOCPServer
 {
@@ -202,6 +212,11 @@ public:
     // 처리 방식 타입 가져오기
     ServerArchitectureType GetArchitectureType() const;
 
+    // Start 전에 설정. 여러 워커 스레드에서 동시에 호출되므로 thread-safe해야 함 (Centralized 모드)
+    void SetWorkerMsgHandler(WorkerMsgHandler handler);
+    void SetNetworkEventRouter(NetworkEventRouter router); // Partitioned / UnifiedStrand 모드
+    void SetNetworkEventNotifier(NetworkEventNotifier notifier); // Centralized 모드
+
     // 내부에서 사용할 함수
 private:
     bool DisconnectSessionInternal(CSession* session);
@@ -217,6 +232,7 @@ private:
     void EchoTestSend(CSession* session, const char* data, size_t length);
     // 게임 로직으로 이벤트 전달 (QUEUE_BASED 모드용)
     void PushNetworkEvent(NetworkEvent&& event);
+    void RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data = nullptr, size_t length = 0);
 
     void AcceptThread();
     void WorkerThread();
@@ -255,4 +271,7 @@ private:
 
     // 레이어 간 통신 큐 (QUEUE_BASED 모드용)
     ThreadSafeQueue<NetworkEvent> _eventQueue;    // 네트워크 -> 게임 로직
+    WorkerMsgHandler _workerMsgHandler;           // 큐를 거치지 않는 요청 (방 목록 조회 등)
+    NetworkEventRouter _networkEventRouter;       // 네트워크 -> 파티션별 큐 / 액터 메일박스 (Partitioned, UnifiedStrand 모드)
+    NetworkEventNotifier _networkEventNotifier;   // 큐에 이벤트가 들어왔음을 로직 스레드에 알림
 };
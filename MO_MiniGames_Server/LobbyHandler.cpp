@@ -0,0 +1,380 @@
+//
+#include "LobbyHandler.h"
+#include "IOCPServer.h"
+#include <cstring>
+#include <algorithm>
+
+// __________________________________________________________________
+//
+// 패킷 전송 헬퍼
+// __________________________________________________________________
+
+void SendRoomCreated(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool success)
+{
+    MSG_S2C_ROOM_CREATED msg;
+    msg.header.size = sizeof(MSG_S2C_ROOM_CREATED);
+    msg.header.type = MsgType::S2C_ROOM_CREATED;
+    msg.requestId = requestId;
+    msg.roomId = roomId;
+    msg.success = success ? 1 : 0;
+
+    network.RequestSendMsg(sessionId, reinterpret_cast<const char*>(&msg), sizeof(msg));
+}
+
+void SendRoomJoined(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool success)
+{
+    MSG_S2C_ROOM_JOINED msg;
+    msg.header.size = sizeof(MSG_S2C_ROOM_JOINED);
+    msg.header.type = MsgType::S2C_ROOM_JOINED;
+    msg.requestId = requestId;
+    msg.roomId = roomId;
+    msg.success = success ? 1 : 0;
+
+    network.RequestSendMsg(sessionId, reinterpret_cast<const char*>(&msg), sizeof(msg));
+}
+
+void SendRoomLeft(CIOCPServer& network, int64_t sessionId, uint32_t requestId, bool success)
+{
+    MSG_S2C_ROOM_LEFT msg;
+    msg.header.size = sizeof(MSG_S2C_ROOM_LEFT);
+    msg.header.type = MsgType::S2C_ROOM_LEFT;
+    msg.requestId = requestId;
+    msg.success = success ? 1 : 0;
+
+    network.RequestSendMsg(sessionId, reinterpret_cast<const char*>(&msg), sizeof(msg));
+}
+
+void SendQuickJoined(CIOCPServer& network, int64_t sessionId, uint32_t requestId, QuickJoinResult result, const CRoom* room)
+{
+    MSG_S2C_QUICK_JOINED msg;
+    msg.requestId = requestId;
+    msg.result = room ? result : QuickJoinResult::FAILED;
+    if (room)
+    {
+        msg.room = MakeRoomInfo(*room);
+    }
+
+    char buffer[QUICK_JOINED_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_QUICK_JOINED;
+
+    network.RequestSendMsg(sessionId, buffer, static_cast<int>(writer.GetSize()));
+}
+
+void SendSpectateState(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool watching)
+{
+    MSG_S2C_SPECTATE_STATE msg;
+    msg.header.size = sizeof(MSG_S2C_SPECTATE_STATE);
+    msg.header.type = MsgType::S2C_SPECTATE_STATE;
+    msg.requestId = requestId;
+    msg.roomId = roomId;
+    msg.watching = watching ? 1 : 0;
+
+    network.RequestSendMsg(sessionId, reinterpret_cast<const char*>(&msg), sizeof(msg));
+}
+
+void SendError(CIOCPServer& network, int64_t sessionId, uint32_t requestId, ErrorCode code, std::initializer_list<int32_t> args)
+{
+    SendError(network, sessionId, requestId, code, args.begin(), args.size());
+}
+
+void SendError(CIOCPServer& network, int64_t sessionId, uint32_t requestId, ErrorCode code, const int32_t* args, size_t argCount)
+{
+    MSG_S2C_ERROR msg;
+    msg.requestId = requestId;
+    msg.code = code;
+    msg.argCount = static_cast<uint8_t>((std::min)(argCount, static_cast<size_t>(ERROR_MAX_ARGS)));
+    std::copy(args, args + msg.argCount, msg.args);
+
+    // 문자열 처리 없이 스택 버퍼에 수 바이트만 인코딩
+    char buffer[ERROR_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_ERROR;
+
+    network.RequestSendMsg(sessionId, buffer, static_cast<int>(writer.GetSize()));
+}
+
+// 전체 목록 대신 최근 방 1페이지만 전송
+// (방이 많아지면 uint16_t size 헤더를 넘으므로 나머지는 C2S_REQUEST_ROOM_PAGE로 조회)
+void SendRoomList(CIOCPServer& network, int64_t sessionId, uint32_t requestId, const CRoomListPublisher& publisher)
+{
+    // 목록이 바뀌기 전까지 모든 요청이 같은 바이트를 공유
+    // 복사가 끝날 때까지 스냅샷을 잡고 있음 (그동안 게시하는 쪽은 다른 버퍼에 씀)
+    char buffer[ROOM_LIST_MSG_MAX_SIZE];
+    size_t size = publisher.Acquire()->WriteRoomListMsg(buffer, requestId);
+
+    network.RequestSendMsg(sessionId, buffer, static_cast<int>(size));
+}
+
+void SendRoomPage(CIOCPServer& network, int64_t sessionId, uint32_t requestId,
+    const RoomSummary* const* rooms, int32_t roomCount, int32_t nextCursor)
+{
+    // pageSize가 ROOM_PAGE_MAX_SIZE로 제한되므로 최대 크기도 uint16_t 범위 안
+    char buffer[ROOM_LIST_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+
+    MSG_S2C_ROOM_PAGE msg;
+    msg.requestId = requestId;
+    msg.nextCursor = nextCursor;
+    msg.roomCount = static_cast<uint32_t>(roomCount);
+    msg.Encode(writer);
+
+    for (int32_t i = 0; i < roomCount; ++i)
+    {
+        rooms[i]->Encode(writer);
+    }
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_ROOM_PAGE;
+
+    network.RequestSendMsg(sessionId, buffer, static_cast<int>(writer.GetSize()));
+}
+
+void SendRoomPage(CIOCPServer& network, int64_t sessionId, uint32_t requestId,
+    const RoomPageQuery& query, const CRoomListPublisher& publisher)
+{
+    // 인코딩이 끝날 때까지 스냅샷을 잡고 있음 (페이지는 스냅샷 안의 요약을 가리킴)
+    auto snapshot = publisher.Acquire();
+    const RoomSummary* rooms[ROOM_PAGE_MAX_SIZE];
+    int32_t roomCount = 0;
+    int32_t nextCursor = snapshot->QueryPage(query, rooms, roomCount);
+
+    SendRoomPage(network, sessionId, requestId, rooms, roomCount, nextCursor);
+}
+
+void SendRoomRequestFailed(CIOCPServer& network, int64_t sessionId, const char* data, size_t length,
+    ErrorCode code, std::initializer_list<int32_t> args)
+{
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+    uint32_t requestId = REQUEST_ID_NONE;
+
+    switch (header->type)
+    {
+    case MsgType::C2S_CREATE_ROOM:
+    {
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_CREATE_ROOM msg;
+        if (!msg.Decode(reader))
+        {
+            return;
+        }
+        requestId = msg.requestId;
+        SendRoomCreated(network, sessionId, requestId, -1, false);
+        break;
+    }
+
+    case MsgType::C2S_JOIN_ROOM:
+    {
+        if (length < sizeof(MSG_C2S_JOIN_ROOM))
+        {
+            return;
+        }
+        const MSG_C2S_JOIN_ROOM* msg = reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data);
+        requestId = msg->requestId;
+        SendRoomJoined(network, sessionId, requestId, msg->roomId, false);
+        break;
+    }
+
+    case MsgType::C2S_LEAVE_ROOM:
+        if (length < sizeof(MSG_C2S_LEAVE_ROOM))
+        {
+            return;
+        }
+        requestId = reinterpret_cast<const MSG_C2S_LEAVE_ROOM*>(data)->requestId;
+        SendRoomLeft(network, sessionId, requestId, false);
+        break;
+
+    case MsgType::C2S_QUICK_JOIN:
+        if (length < sizeof(MSG_C2S_QUICK_JOIN))
+        {
+            return;
+        }
+        requestId = reinterpret_cast<const MSG_C2S_QUICK_JOIN*>(data)->requestId;
+        SendQuickJoined(network, sessionId, requestId, QuickJoinResult::FAILED, nullptr);
+        break;
+
+    case MsgType::C2S_SPECTATE_ROOM:
+    {
+        if (length < sizeof(MSG_C2S_SPECTATE_ROOM))
+        {
+            return;
+        }
+        const MSG_C2S_SPECTATE_ROOM* msg = reinterpret_cast<const MSG_C2S_SPECTATE_ROOM*>(data);
+        requestId = msg->requestId;
+        SendSpectateState(network, sessionId, requestId, msg->roomId, false);
+        break;
+    }
+
+    case MsgType::C2S_STOP_SPECTATE:
+        // 그만두기는 처리할 곳에서만 상태를 알 수 있음 -> 에러만 보내고 클라가 다시 요청
+        if (length < sizeof(MSG_C2S_STOP_SPECTATE))
+        {
+            return;
+        }
+        requestId = reinterpret_cast<const MSG_C2S_STOP_SPECTATE*>(data)->requestId;
+        break;
+
+    default:
+        return;
+    }
+
+    SendError(network, sessionId, requestId, code, args);
+}
+
+RoomPageQuery ParseRoomPageQuery(const MSG_C2S_REQUEST_ROOM_PAGE& msg)
+{
+    RoomPageQuery query;
+    query.cursor = (msg.cursor > 0) ? msg.cursor : 0;
+    query.pageSize = (std::min)(static_cast<int32_t>(msg.pageSize), static_cast<int32_t>(ROOM_PAGE_MAX_SIZE));
+    if (query.pageSize <= 0)
+    {
+        query.pageSize = ROOM_PAGE_DEFAULT_SIZE;
+    }
+
+    query.joinableOnly = (msg.filterFlags & ROOM_FILTER_JOINABLE) != 0;
+    query.filterStatus = (msg.filterFlags & ROOM_FILTER_STATUS) != 0;
+    query.status = static_cast<RoomStatus>(msg.status);
+
+    if (msg.filterFlags & ROOM_FILTER_MIN_FREE)
+    {
+        query.minFreeSlots = msg.minFreeSlots;
+    }
+
+    if (msg.filterFlags & ROOM_FILTER_TITLE_PREFIX)
+    {
+        query.titlePrefix = msg.titlePrefix; // 길이는 디코딩할 때 제한됨 (수신 버퍼를 그대로 가리킴)
+    }
+
+    return query;
+}
+
+RoomInfo MakeRoomInfo(const CRoom& room)
+{
+    RoomInfo info;
+    info.roomId = room.GetRoomId();
+    info.title = room.GetTitle();
+    info.currentPlayers = room.GetCurrentPlayerCount();
+    info.maxPlayers = room.GetMaxPlayers();
+    info.status = static_cast<uint8_t>(room.GetStatus());
+    return info;
+}
+
+// __________________________________________________________________
+//
+// 방 입장 계열 요청 결과
+// __________________________________________________________________
+
+void RoomRequestResult::SetError(ErrorCode code, std::initializer_list<int32_t> errorArgs)
+{
+    error = code;
+    argCount = 0;
+    for (int32_t arg : errorArgs)
+    {
+        if (argCount >= ERROR_MAX_ARGS)
+            break;
+        args[argCount++] = arg;
+    }
+}
+
+void SendRoomRequestResult(CIOCPServer& network, int64_t sessionId, const RoomRequestResult& result)
+{
+    bool success = result.IsSuccess();
+
+    switch (result.type)
+    {
+    case MsgType::C2S_CREATE_ROOM:
+        SendRoomCreated(network, sessionId, result.requestId, result.roomId, success);
+        break;
+
+    case MsgType::C2S_JOIN_ROOM:
+        SendRoomJoined(network, sessionId, result.requestId, result.roomId, success);
+        break;
+
+    case MsgType::C2S_QUICK_JOIN:
+        SendQuickJoined(network, sessionId, result.requestId,
+            result.created ? QuickJoinResult::CREATED : QuickJoinResult::JOINED, success ? result.room : nullptr);
+        break;
+
+    case MsgType::C2S_LEAVE_ROOM:
+        SendRoomLeft(network, sessionId, result.requestId, success);
+        break;
+
+    default:
+        return;
+    }
+
+    if (!success)
+    {
+        SendError(network, sessionId, result.requestId, result.error, result.args, result.argCount);
+    }
+}
+
+// __________________________________________________________________
+//
+// CRoomRequestHandler
+// __________________________________________________________________
+
+RoomRequestResult CRoomRequestHandler::LeaveRoom(uint32_t requestId, bool left)
+{
+    RoomRequestResult result = MakeResult(MsgType::C2S_LEAVE_ROOM, requestId, -1);
+    if (!left)
+    {
+        result.SetError(ErrorCode::NOT_IN_ROOM);
+    }
+    return result;
+}
+
+bool CRoomRequestHandler::IsValidQuickJoinSize(int32_t maxPlayers)
+{
+    return maxPlayers == 0 || (maxPlayers >= ROOM_MIN_PLAYERS && maxPlayers <= ROOM_MAX_PLAYERS);
+}
+
+RoomRequestResult CRoomRequestHandler::MakeResult(MsgType type, uint32_t requestId, int32_t roomId)
+{
+    RoomRequestResult result;
+    result.type = type;
+    result.requestId = requestId;
+    result.roomId = roomId;
+    return result;
+}
+
+void CRoomRequestHandler::SetSeatError(RoomRequestResult& result, ErrorCode code, bool created)
+{
+    if (code == ErrorCode::GAME_IN_PROGRESS)
+    {
+        // 판정 뒤 seat가 최신 상태로 다시 확인해서 거절한 경우 (JoinRoom의 검사와 같은 응답)
+        result.SetError(code, { result.roomId });
+        return;
+    }
+
+    if (code != ErrorCode::ROOM_JOIN_FAILED)
+    {
+        // 방과 관계없는 실패 (SERVER_BUSY 등). 생성 응답에는 지운 방 번호를 싣지 않음
+        if (created)
+        {
+            result.roomId = -1;
+        }
+        result.SetError(code);
+        return;
+    }
+
+    result.SetError(created ? ErrorCode::CREATED_ROOM_JOIN_FAILED : ErrorCode::ROOM_JOIN_FAILED, { result.roomId });
+}
+
+void CRoomRequestHandler::DiscardCreatedRoom(int32_t roomId)
+{
+    CRoom* room = _roomManager.FindRoom(roomId);
+    if (room && room->IsEmpty())
+    {
+        _roomManager.DeleteRoom(roomId);
+    }
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "Protocol.h"
+#include "RoomManager.h"
+#include "RoomListSnapshot.h"
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+
+class CIOCPServer;
+
+// __________________________________________________________________
+//
+// 로비 요청 공용 처리 (모든 서버 모드)
+//  - 패킷 전송 헬퍼: 세션 ID로 바로 인코딩 / 전송 (아무 스레드)
+//  - CRoomRequestHandler: 방 생성/입장/빠른 입장 판정. 모드마다 다른 부분(좌석을 잡고 확정하는 방법)만 콜백으로 받음
+// 모드는 판정 앞뒤로 자기 단계(멤버십 예약 확정/취소, 방 액터 알림 등)를 끼우고 같은 응답 함수로 응답
+// __________________________________________________________________
+
+// roomId는 1부터 발급하므로 0은 "방 없음"
+constexpr int32_t ROOM_ID_NONE = 0;
+
+// 빠른 입장에서 seat가 GAME_IN_PROGRESS로 거절했을 때 다른 방을 다시 고르는 최대 횟수
+constexpr int32_t QUICK_JOIN_MAX_RESELECT = 3;
+
+// 패킷 전송 헬퍼 (requestId: 응답할 요청 ID, 서버가 먼저 보내는 경우 REQUEST_ID_NONE) ////////
+void SendRoomCreated(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool success);
+void SendRoomJoined(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool success);
+void SendRoomLeft(CIOCPServer& network, int64_t sessionId, uint32_t requestId, bool success);
+void SendQuickJoined(CIOCPServer& network, int64_t sessionId, uint32_t requestId, QuickJoinResult result, const CRoom* room);
+void SendSpectateState(CIOCPServer& network, int64_t sessionId, uint32_t requestId, int32_t roomId, bool watching);
+void SendError(CIOCPServer& network, int64_t sessionId, uint32_t requestId, ErrorCode code, std::initializer_list<int32_t> args = {});
+void SendError(CIOCPServer& network, int64_t sessionId, uint32_t requestId, ErrorCode code, const int32_t* args, size_t argCount); // ERROR_MAX_ARGS개까지
+
+// 접속 직후 / 구버전 목록 요청용. 게시할 때 인코딩해둔 첫 페이지를 그대로 전송
+void SendRoomList(CIOCPServer& network, int64_t sessionId, uint32_t requestId, const CRoomListPublisher& publisher);
+
+// 조회가 끝난 페이지 인코딩 (샤드를 합친 페이지는 호출한 쪽이 스냅샷을 잡은 채로 넘김)
+void SendRoomPage(CIOCPServer& network, int64_t sessionId, uint32_t requestId,
+    const RoomSummary* const* rooms, int32_t roomCount, int32_t nextCursor);
+void SendRoomPage(CIOCPServer& network, int64_t sessionId, uint32_t requestId,
+    const RoomPageQuery& query, const CRoomListPublisher& publisher);
+
+// 로비 요청(생성/입장/빠른 입장/퇴장/관전/관전 그만두기)에 종류에 맞는 실패 응답 + 에러
+// 요청을 처리할 곳까지 보내지 못했을 때 (메일박스가 가득 참, 재시도 초과 등). 관전 그만두기는 에러만
+void SendRoomRequestFailed(CIOCPServer& network, int64_t sessionId, const char* data, size_t length,
+    ErrorCode code, std::initializer_list<int32_t> args = {});
+////////////////////////////////////////////////////////////////////////////////
+
+// 페이지 요청 검증 (cursor / pageSize 범위, 필터). titlePrefix는 msg 버퍼를 가리킴
+RoomPageQuery ParseRoomPageQuery(const MSG_C2S_REQUEST_ROOM_PAGE& msg);
+
+// 응답용 방 정보. title은 방 객체가 가진 문자열을 가리킴 (인코딩할 때까지만 유효)
+RoomInfo MakeRoomInfo(const CRoom& room);
+
+// 방 입장 계열 요청 결과 (응답 종류 + 실패 사유). 모드는 응답 전에 자기 확정 단계를 처리
+struct RoomRequestResult
+{
+    MsgType type = MsgType::C2S_CREATE_ROOM; // 요청 종류 (C2S_CREATE_ROOM / C2S_JOIN_ROOM / C2S_QUICK_JOIN / C2S_LEAVE_ROOM)
+    uint32_t requestId = REQUEST_ID_NONE;
+    int32_t roomId = -1;          // 응답에 실을 roomId. 성공하면 들어간 방
+    const CRoom* room = nullptr;  // 들어간 방 (성공했을 때만, 같은 스레드에서 응답할 때까지 유효)
+    bool created = false;         // 방을 새로 만들어서 들어갔는지
+
+    ErrorCode error = ErrorCode::NONE;
+    uint8_t argCount = 0;
+    int32_t args[ERROR_MAX_ARGS] = {};
+
+    bool IsSuccess() const { return error == ErrorCode::NONE; }
+    void SetError(ErrorCode code, std::initializer_list<int32_t> errorArgs = {});
+};
+
+// 결과에 맞는 응답 (S2C_ROOM_CREATED / ROOM_JOINED / QUICK_JOINED / ROOM_LEFT) + 실패면 에러
+void SendRoomRequestResult(CIOCPServer& network, int64_t sessionId, const RoomRequestResult& result);
+
+// 방 생성/입장/빠른 입장 판정 (방 디렉터리를 가진 스레드 전용, 요청마다 스택에 만들어서 씀)
+// 검증, 제목 중복, 방 풀, 인원, 게임 중 여부는 여기서 판단하고 좌석을 잡는 방법만 seat 콜백으로 받음
+//  - seat(CRoom& room, bool created) -> ErrorCode
+//    성공이면 ErrorCode::NONE. 실패면 좌석을 잡기 전 상태로 되돌리고 사유 (ROOM_JOIN_FAILED, SERVER_BUSY 등)
+//    방 상태를 다른 스레드가 가진 모드는 seat에서 최신 상태로 맞추고 GAME_IN_PROGRESS를 낼 수 있음 (빠른 입장은 다른 방을 다시 고름)
+//  - 새로 만든 방에 못 들어갔으면 빈 방은 여기서 삭제
+// currentRoomId: 요청한 세션이 이미 들어가 있는 방 (없으면 ROOM_ID_NONE)
+class CRoomRequestHandler
+{
+public:
+    explicit CRoomRequestHandler(CRoomManager& roomManager)
+        : _roomManager(roomManager)
+    {
+    }
+
+    template <typename SeatFunc>
+    RoomRequestResult CreateRoom(const MSG_C2S_CREATE_ROOM& msg, int32_t currentRoomId, SeatFunc&& seat);
+
+    template <typename SeatFunc>
+    RoomRequestResult JoinRoom(const MSG_C2S_JOIN_ROOM& msg, int32_t currentRoomId, SeatFunc&& seat);
+
+    // 빈 자리가 가장 적은 입장 가능한 방, 없으면 새로 만들어서 입장
+    template <typename SeatFunc>
+    RoomRequestResult QuickJoin(const MSG_C2S_QUICK_JOIN& msg, int32_t currentRoomId, SeatFunc&& seat);
+
+    // 퇴장은 모드마다 정리할 것이 달라서 결과만 (방에 없었으면 NOT_IN_ROOM)
+    static RoomRequestResult LeaveRoom(uint32_t requestId, bool left);
+
+    // 빠른 입장 인원 조건: 0(상관없음) 또는 방 생성과 같은 범위
+    static bool IsValidQuickJoinSize(int32_t maxPlayers);
+
+private:
+    static RoomRequestResult MakeResult(MsgType type, uint32_t requestId, int32_t roomId);
+
+    // seat 실패 사유를 응답 에러로 (ROOM_JOIN_FAILED면 방 번호를 붙임)
+    static void SetSeatError(RoomRequestResult& result, ErrorCode code, bool created);
+
+    // 새로 만든 방에 못 들어갔을 때 비어있으면 삭제 (seat가 퇴장 처리로 이미 지웠을 수 있음)
+    void DiscardCreatedRoom(int32_t roomId);
+
+    CRoomManager& _roomManager;
+};
+
+template <typename SeatFunc>
+RoomRequestResult CRoomRequestHandler::CreateRoom(const MSG_C2S_CREATE_ROOM& msg, int32_t currentRoomId, SeatFunc&& seat)
+{
+    RoomRequestResult result = MakeResult(MsgType::C2S_CREATE_ROOM, msg.requestId, -1);
+
+    if (currentRoomId != ROOM_ID_NONE)
+    {
+        result.SetError(ErrorCode::ALREADY_IN_ROOM, { currentRoomId });
+        return result;
+    }
+
+    // 유효성 검증
+    if (msg.title.empty() || msg.maxPlayers < ROOM_MIN_PLAYERS || msg.maxPlayers > ROOM_MAX_PLAYERS)
+    {
+        result.SetError(ErrorCode::INVALID_ROOM_PARAMS);
+        return result;
+    }
+
+    // 방 이름 중복 체크 (샤드로 나뉘어 있으면 같은 제목은 모두 같은 샤드로 오므로 샤드 안에서 끝남)
+    if (_roomManager.FindRoomByTitle(msg.title))
+    {
+        result.SetError(ErrorCode::ROOM_TITLE_EXISTS);
+        return result;
+    }
+
+    // 제목은 수신 버퍼를 가리킴 (방에는 복사되어 저장)
+    CRoom* room = _roomManager.CreateRoom(msg.title, msg.maxPlayers);
+    if (!room)
+    {
+        result.SetError(ErrorCode::ROOM_LIMIT_REACHED, { static_cast<int32_t>(_roomManager.GetMaxRoomCount()) });
+        return result;
+    }
+
+    int32_t roomId = room->GetRoomId();
+    ErrorCode seatError = seat(*room, true);
+    if (seatError != ErrorCode::NONE)
+    {
+        // 아무도 없는 방이 풀 슬롯을 계속 차지하지 않도록 바로 삭제
+        DiscardCreatedRoom(roomId);
+        result.roomId = roomId;
+        SetSeatError(result, seatError, true);
+        return result;
+    }
+
+    result.roomId = roomId;
+    result.room = room;
+    result.created = true;
+    return result;
+}
+
+template <typename SeatFunc>
+RoomRequestResult CRoomRequestHandler::JoinRoom(const MSG_C2S_JOIN_ROOM& msg, int32_t currentRoomId, SeatFunc&& seat)
+{
+    int32_t roomId = msg.roomId;
+    RoomRequestResult result = MakeResult(MsgType::C2S_JOIN_ROOM, msg.requestId, roomId);
+
+    if (currentRoomId != ROOM_ID_NONE)
+    {
+        result.SetError(ErrorCode::ALREADY_IN_ROOM, { currentRoomId });
+        return result;
+    }
+
+    CRoom* room = _roomManager.FindRoom(roomId);
+    if (!room)
+    {
+        result.SetError(ErrorCode::ROOM_NOT_FOUND, { roomId });
+        return result;
+    }
+
+    if (room->IsFull())
+    {
+        result.SetError(ErrorCode::ROOM_FULL, { roomId, room->GetMaxPlayers() });
+        return result;
+    }
+
+    if (room->GetStatus() == RoomStatus::PLAYING)
+    {
+        result.SetError(ErrorCode::GAME_IN_PROGRESS, { roomId });
+        return result;
+    }
+
+    ErrorCode seatError = seat(*room, false);
+    if (seatError != ErrorCode::NONE)
+    {
+        SetSeatError(result, seatError, false);
+        return result;
+    }
+
+    result.room = room;
+    return result;
+}
+
+template <typename SeatFunc>
+RoomRequestResult CRoomRequestHandler::QuickJoin(const MSG_C2S_QUICK_JOIN& msg, int32_t currentRoomId, SeatFunc&& seat)
+{
+    int32_t maxPlayers = msg.maxPlayers;
+    RoomRequestResult result = MakeResult(MsgType::C2S_QUICK_JOIN, msg.requestId, -1);
+
+    if (currentRoomId != ROOM_ID_NONE)
+    {
+        result.SetError(ErrorCode::ALREADY_IN_ROOM, { currentRoomId });
+        return result;
+    }
+
+    if (!IsValidQuickJoinSize(maxPlayers))
+    {
+        result.SetError(ErrorCode::INVALID_ROOM_PARAMS);
+        return result;
+    }
+
+    // 방 선택과 입장이 같은 스레드 안에서 한 번에 처리되므로 목록 조회 후 입장 사이의 경합이 없음
+    // 인덱스에 있는 방은 모두 입장 가능 (WAITING && 빈 자리)
+    // seat가 방 상태를 최신으로 맞춘 뒤 게임 중이라고 거절한 방은 인덱스에서 빠졌으므로 다른 방을 다시 고름
+    bool created = false;
+    CRoom* room = nullptr;
+    int32_t roomId = -1;
+    ErrorCode seatError = ErrorCode::NONE;
+    for (int32_t attempt = 0; attempt <= QUICK_JOIN_MAX_RESELECT; ++attempt)
+    {
+        room = _roomManager.FindQuickJoinRoom(maxPlayers);
+        created = (room == nullptr);
+        if (created)
+        {
+            room = _roomManager.CreateQuickJoinRoom(maxPlayers);
+        }
+
+        if (!room)
+        {
+            result.SetError(ErrorCode::ROOM_LIMIT_REACHED, { static_cast<int32_t>(_roomManager.GetMaxRoomCount()) });
+            return result;
+        }
+
+        roomId = room->GetRoomId();
+        seatError = seat(*room, created);
+        if (seatError != ErrorCode::GAME_IN_PROGRESS || created)
+        {
+            break;
+        }
+    }
+
+    if (seatError != ErrorCode::NONE)
+    {
+        if (created)
+        {
+            DiscardCreatedRoom(roomId);
+        }
+        result.roomId = roomId;
+        SetSeatError(result, seatError, false);
+        return result;
+    }
+
+    result.roomId = roomId;
+    result.room = room;
+    result.created = created;
+    return result;
+}
@@ -0,0 +1,270 @@
+#include "LockstepRelay.h"
+#include <algorithm>
+
+CLockstepRelay::CLockstepRelay()
+    : _boards(ROOM_MAX_PLAYERS)
+    , _attacks()
+    , _inputs()
+    , _received()
+    , _closedAt()
+    , _resigned()
+    , _alive()
+    , _playerCount(0)
+    , _aliveCount(0)
+    , _seed(0)
+    , _confirmed(0)
+    , _winner(-1)
+    , _running(false)
+    , _finished(false)
+    , _filledFrames(0)
+    , _rejectedInputs(0)
+{
+}
+
+void CLockstepRelay::Start(uint32_t seed, int32_t playerCount)
+{
+    _playerCount = (std::max)(0, (std::min)(playerCount, ROOM_MAX_PLAYERS));
+    _aliveCount = _playerCount;
+    _seed = seed;
+    _confirmed = 0;
+    _winner = -1;
+    _running = true;
+    _finished = false;
+    _filledFrames = 0;
+    _rejectedInputs = 0;
+
+    // 모든 보드가 같은 seed (같은 블록 순서)
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        _boards.Start(static_cast<size_t>(slot), seed);
+        _received[slot] = 0;
+        _closedAt[slot] = SLOT_OPEN;
+        _resigned[slot] = false;
+        _alive[slot] = true;
+    }
+    _attacks.Start(seed, _playerCount);
+}
+
+void CLockstepRelay::Stop()
+{
+    _running = false;
+}
+
+LockstepInputResult CLockstepRelay::SubmitInputs(int32_t slot, uint32_t firstFrame, const uint8_t* inputs, size_t count)
+{
+    if (!_running || _finished || slot < 0 || slot >= _playerCount || _closedAt[slot] != SLOT_OPEN)
+    {
+        return LockstepInputResult::STALE;
+    }
+
+    uint32_t received = _received[slot];
+    if (firstFrame > received)
+    {
+        ++_rejectedInputs;
+        return LockstepInputResult::GAP;
+    }
+
+    uint64_t end = static_cast<uint64_t>(firstFrame) + count;
+    if (end <= received)
+    {
+        return LockstepInputResult::STALE;
+    }
+
+    // 아직 확정하지 않은 프레임을 덮어쓰지 않도록 창 안에서만 받음
+    if (end > static_cast<uint64_t>(_confirmed) + LOCKSTEP_INPUT_WINDOW)
+    {
+        ++_rejectedInputs;
+        return LockstepInputResult::TOO_FAR;
+    }
+
+    // 이미 받은(또는 채운) 앞부분은 건너뜀
+    for (uint32_t frame = received; frame < end; ++frame)
+    {
+        _inputs[frame % LOCKSTEP_INPUT_WINDOW][slot] = static_cast<uint8_t>(inputs[frame - firstFrame] & TETRIS_INPUT_PLAYER_MASK);
+    }
+    _received[slot] = static_cast<uint32_t>(end);
+    return LockstepInputResult::ACCEPTED;
+}
+
+void CLockstepRelay::Resign(int32_t slot)
+{
+    if (!_running || _finished || slot < 0 || slot >= _playerCount || _closedAt[slot] != SLOT_OPEN)
+    {
+        return;
+    }
+
+    // 받아둔 앞선 입력은 버리고 바로 다음 확정 프레임에 기권
+    _closedAt[slot] = _confirmed;
+    _resigned[slot] = true;
+}
+
+void CLockstepRelay::FillLaggingSlots()
+{
+    uint32_t maxReceived = 0;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        if (_closedAt[slot] == SLOT_OPEN)
+        {
+            maxReceived = (std::max)(maxReceived, _received[slot]);
+        }
+    }
+
+    if (maxReceived <= LOCKSTEP_MAX_LAG_FRAMES)
+    {
+        return;
+    }
+
+    uint32_t limit = maxReceived - LOCKSTEP_MAX_LAG_FRAMES;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        if (_closedAt[slot] != SLOT_OPEN || _received[slot] >= limit)
+        {
+            continue;
+        }
+
+        for (uint32_t frame = _received[slot]; frame < limit; ++frame)
+        {
+            _inputs[frame % LOCKSTEP_INPUT_WINDOW][slot] = TETRIS_INPUT_NONE;
+        }
+        _filledFrames += limit - _received[slot];
+        _received[slot] = limit;
+    }
+}
+
+uint8_t CLockstepRelay::GetInput(int32_t slot, uint32_t frame) const
+{
+    if (frame < _closedAt[slot])
+    {
+        return _inputs[frame % LOCKSTEP_INPUT_WINDOW][slot];
+    }
+    return (frame == _closedAt[slot] && _resigned[slot]) ? TETRIS_INPUT_RESIGN : TETRIS_INPUT_NONE;
+}
+
+size_t CLockstepRelay::PopConfirmed(LockstepFrameBatch& out)
+{
+    out.firstFrame = _confirmed;
+    out.frameCount = 0;
+    out.garbageCount = 0;
+    if (!_running || _finished)
+    {
+        return 0;
+    }
+
+    FillLaggingSlots();
+
+    // 아직 입력을 기다리는 슬롯이 모두 받은 프레임까지 (모두 닫혔으면 끝날 때까지)
+    uint32_t ready = UINT32_MAX;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        if (_closedAt[slot] == SLOT_OPEN)
+        {
+            ready = (std::min)(ready, _received[slot]);
+        }
+    }
+
+    // 프레임 하나가 낼 수 있는 최대 삽입 수가 남아 있을 때만 다음 프레임을 진행 (나머지는 다음 메시지로)
+    size_t maxGarbagePerFrame = static_cast<size_t>(_playerCount) * GARBAGE_MAX_CHUNKS_PER_LOCK;
+
+    TetrisStepResult results[ROOM_MAX_PLAYERS];
+    GarbageInsertion insertions[ROOM_MAX_PLAYERS * GARBAGE_MAX_CHUNKS_PER_LOCK];
+    while (out.frameCount < LOCKSTEP_MAX_FRAMES_PER_MSG && _confirmed < ready
+        && out.garbageCount + maxGarbagePerFrame <= LOCKSTEP_MAX_GARBAGE_PER_MSG)
+    {
+        uint8_t* row = out.inputs + out.frameCount * static_cast<size_t>(_playerCount);
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            row[slot] = GetInput(slot, _confirmed);
+        }
+
+        _boards.StepAll(static_cast<size_t>(_playerCount), row, results);
+
+        // 공격은 이번 프레임 진행 뒤 살아 있는 보드끼리만
+        bool alive[ROOM_MAX_PLAYERS];
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            alive[slot] = _alive[slot] && !_boards.GetEngine(static_cast<size_t>(slot)).IsGameOver();
+        }
+
+        size_t insertionCount = _attacks.ResolveFrame(_confirmed, results, alive, _boards, insertions);
+        if (insertionCount > 0)
+        {
+            ApplyGarbage(insertions, insertionCount, out);
+        }
+
+        // 방해 줄에 밀려 탈락한 보드까지 같이 판정
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (_alive[slot] && _boards.GetEngine(static_cast<size_t>(slot)).IsGameOver())
+            {
+                _alive[slot] = false;
+                --_aliveCount;
+                if (_closedAt[slot] == SLOT_OPEN)
+                {
+                    _closedAt[slot] = _confirmed + 1; // 탈락한 슬롯은 더 기다리지 않음
+                }
+            }
+        }
+
+        ++_confirmed;
+        ++out.frameCount;
+
+        if (_aliveCount <= 1)
+        {
+            _finished = true;
+            for (int32_t slot = 0; slot < _playerCount; ++slot)
+            {
+                if (_alive[slot])
+                {
+                    _winner = slot;
+                }
+            }
+            break;
+        }
+    }
+
+    return out.frameCount;
+}
+
+void CLockstepRelay::ApplyGarbage(const GarbageInsertion* insertions, size_t count, LockstepFrameBatch& out)
+{
+    // 삽입 목록은 슬롯 순이므로 슬롯마다 i번째 묶음을 모아 보드 묶음 커널 한 번에 (묶음 수만큼 반복)
+    uint8_t lines[ROOM_MAX_PLAYERS];
+    uint8_t holes[ROOM_MAX_PLAYERS];
+    uint8_t alive[ROOM_MAX_PLAYERS];
+    for (size_t round = 0; round < GARBAGE_MAX_CHUNKS_PER_LOCK; ++round)
+    {
+        std::fill(lines, lines + _playerCount, static_cast<uint8_t>(0));
+        std::fill(holes, holes + _playerCount, static_cast<uint8_t>(0));
+
+        bool any = false;
+        int32_t previousSlot = -1;
+        size_t nth = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            nth = (insertions[i].slot == previousSlot) ? nth + 1 : 0;
+            previousSlot = insertions[i].slot;
+            if (nth == round)
+            {
+                lines[insertions[i].slot] = insertions[i].lines;
+                holes[insertions[i].slot] = insertions[i].hole;
+                any = true;
+            }
+        }
+
+        if (!any)
+        {
+            break;
+        }
+        _boards.InsertGarbage(static_cast<size_t>(_playerCount), lines, holes, alive);
+    }
+
+    // 클라는 같은 프레임 안에서 메시지 순서대로 넣음 (보드끼리는 독립이라 슬롯 순이어도 결과가 같음)
+    uint8_t frameOffset = static_cast<uint8_t>(out.frameCount);
+    for (size_t i = 0; i < count; ++i)
+    {
+        GarbageEvent& event = out.garbage[out.garbageCount++];
+        event.frameOffset = frameOffset;
+        event.slot = insertions[i].slot;
+        event.Set(insertions[i].lines, insertions[i].hole);
+    }
+}
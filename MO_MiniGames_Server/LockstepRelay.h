@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "AttackRouter.h"
+#include "Protocol.h"
+#include "TetrisBoardBatch.h"
+
+// 입력이 가장 앞선 플레이어보다 이 프레임 수 이상 밀린 플레이어는 빈 입력으로 채우고 진행 (0.5초)
+// 한 명이 느리거나 멈춰도 방 전체가 그 사람을 기다리며 서지 않도록
+constexpr uint32_t LOCKSTEP_MAX_LAG_FRAMES = 30;
+static_assert(LOCKSTEP_MAX_LAG_FRAMES < LOCKSTEP_INPUT_WINDOW, "lag fill must stay inside the input window");
+
+// 프레임 하나에서 나올 수 있는 방해 줄 삽입이 항상 한 메시지에 들어가야 함
+static_assert(ROOM_MAX_PLAYERS * GARBAGE_MAX_CHUNKS_PER_LOCK <= LOCKSTEP_MAX_GARBAGE_PER_MSG, "one frame of garbage must fit S2C_GAME_FRAMES");
+
+// 프레임 입력 검증 결과
+enum class LockstepInputResult : uint8_t
+{
+    ACCEPTED,  // 새 프레임이 하나 이상 들어감
+    STALE,     // 전부 이미 받았거나 빈 입력으로 채워진 프레임 (재전송 / 늦게 도착), 또는 탈락한 슬롯
+    GAP,       // 받은 프레임 다음이 아닌 곳부터 시작 (중간 프레임 누락)
+    TOO_FAR    // 확정 프레임 + LOCKSTEP_INPUT_WINDOW를 넘음 (너무 앞질러 보냄)
+};
+
+// PopConfirmed 한 번 분량 (S2C_GAME_FRAMES 하나)
+struct LockstepFrameBatch
+{
+    uint32_t firstFrame = 0;
+    size_t frameCount = 0;
+    uint8_t inputs[LOCKSTEP_MAX_FRAMES_PER_MSG * ROOM_MAX_PLAYERS]; // [frame * playerCount + slot]
+    size_t garbageCount = 0;
+    GarbageEvent garbage[LOCKSTEP_MAX_GARBAGE_PER_MSG];             // frameOffset 순
+};
+
+// __________________________________________________________________
+//
+// 락스텝 입력 릴레이 (방 하나, 방 액터 전용)
+// 슬롯(0 ~ playerCount-1)마다 프레임 입력을 받아 두고, 모든 슬롯의 입력이 모인 프레임부터 순서대로 확정
+//  - 입력 저장: [프레임 % LOCKSTEP_INPUT_WINDOW][슬롯] 고정 배열 (할당 없음)
+//  - 슬롯마다 "여기까지 받음" 프레임 하나만 관리 -> 재전송은 건너뛰고, 중간이 빠진 입력은 버림
+//  - 밀린 슬롯은 LOCKSTEP_MAX_LAG_FRAMES 뒤부터 빈 입력으로 채움 (늦게 온 실제 입력은 STALE)
+//  - 퇴장한 슬롯은 다음 확정 프레임에 TETRIS_INPUT_RESIGN, 그 뒤로는 빈 입력 (기다리지 않음)
+// 확정한 프레임은 서버 보드 묶음으로 같이 진행해서 탈락 / 승자를 판정 (클라가 보낸 결과는 믿지 않음)
+// 프레임마다 공격 라우터(CAttackRouter)로 공격을 처리하고, 나온 방해 줄을 서버 보드에 넣은 뒤 같은 묶음에 기록
+// 클라는 PopConfirmed가 내놓은 입력 + 방해 줄을 그대로 받아 같은 순서로 진행하므로 모든 보드가 같은 상태가 됨
+// __________________________________________________________________
+
+class CLockstepRelay
+{
+public:
+    CLockstepRelay();
+
+    CLockstepRelay(const CLockstepRelay&) = delete;
+    CLockstepRelay& operator=(const CLockstepRelay&) = delete;
+
+    void Start(uint32_t seed, int32_t playerCount);
+    void Stop();
+
+    bool IsRunning() const { return _running; }
+    bool IsFinished() const { return _finished; }
+    int32_t GetPlayerCount() const { return _playerCount; }
+    uint32_t GetSeed() const { return _seed; }
+
+    // 확정된 프레임 수 (= 다음에 확정할 프레임 번호)
+    uint32_t GetConfirmedFrameCount() const { return _confirmed; }
+
+    // 승자 슬롯 (IsFinished 이후, 마지막 남은 플레이어가 같은 프레임에 탈락했으면 -1)
+    int32_t GetWinner() const { return _winner; }
+
+    // slot의 firstFrame부터 count프레임 입력. 플레이어가 보낼 수 없는 비트는 지움
+    LockstepInputResult SubmitInputs(int32_t slot, uint32_t firstFrame, const uint8_t* inputs, size_t count);
+
+    // 퇴장 (다음 확정 프레임에 기권 입력, 이후 입력은 기다리지 않음)
+    void Resign(int32_t slot);
+
+    // 공격 대상 고르기 방식 (다음 공격부터)
+    void SetTargetMode(int32_t slot, GarbageTargetMode mode) { _attacks.SetTargetMode(slot, mode); }
+
+    // 확정할 수 있는 프레임을 한 메시지 분량까지 꺼내 서버 보드를 진행 (공격 처리, 방해 줄 삽입 포함)
+    // out에 기록하고 꺼낸 프레임 수를 리턴 (0: 아직 모자란 슬롯이 있음)
+    // 게임이 끝난 프레임까지 꺼내면 IsFinished가 true가 되고 더 꺼내지 않음
+    size_t PopConfirmed(LockstepFrameBatch& out);
+
+    const CTetrisBoardBatch& GetBoards() const { return _boards; }
+    const CAttackRouter& GetAttackRouter() const { return _attacks; }
+
+    // 통계 (게임 시작 시 초기화)
+    uint64_t GetFilledFrames() const { return _filledFrames; }
+    uint64_t GetRejectedInputs() const { return _rejectedInputs; }
+
+private:
+    // 가장 앞선 슬롯보다 LOCKSTEP_MAX_LAG_FRAMES 이상 밀린 슬롯을 빈 입력으로 채움
+    void FillLaggingSlots();
+
+    // 이 프레임에 slot이 낸 입력 (닫힌 슬롯은 기권 / 빈 입력)
+    uint8_t GetInput(int32_t slot, uint32_t frame) const;
+
+    // 라우터가 고른 방해 줄을 서버 보드에 넣고 out에 기록 (같은 슬롯은 순서대로)
+    void ApplyGarbage(const GarbageInsertion* insertions, size_t count, LockstepFrameBatch& out);
+
+    static constexpr uint32_t SLOT_OPEN = UINT32_MAX;
+
+    CTetrisBoardBatch _boards;
+    CAttackRouter _attacks;
+
+    uint8_t _inputs[LOCKSTEP_INPUT_WINDOW][ROOM_MAX_PLAYERS];
+    uint32_t _received[ROOM_MAX_PLAYERS];  // 이 슬롯에서 다음에 받을 프레임 (앞은 모두 받았거나 채움)
+    uint32_t _closedAt[ROOM_MAX_PLAYERS];  // 이 프레임부터 입력을 기다리지 않음 (SLOT_OPEN: 기다림)
+    bool _resigned[ROOM_MAX_PLAYERS];      // _closedAt 프레임에 기권 입력
+    bool _alive[ROOM_MAX_PLAYERS];         // 서버 보드가 아직 게임 오버가 아님
+
+    int32_t _playerCount;
+    int32_t _aliveCount;
+    uint32_t _seed;
+    uint32_t _confirmed;
+    int32_t _winner;
+    bool _running;
+    bool _finished;
+
+    uint64_t _filledFrames;
+    uint64_t _rejectedInputs;
+};
@@ -0,0 +1,939 @@
+//
+#include "PartitionedServer.h"
+#include "AsyncLogger.h"
+
+// 풀 점유율 로그 주기
+constexpr auto POOL_STATS_LOG_INTERVAL = std::chrono::seconds(60);
+
+// 샤드별 방 목록 스냅샷 최소 게시 간격
+constexpr auto ROOM_LIST_PUBLISH_INTERVAL = std::chrono::milliseconds(50);
+
+// 방 안에서 이 시간 동안 요청이 없으면 방에서 내보냄
+constexpr auto ROOM_AFK_TIMEOUT = std::chrono::minutes(10);
+
+// 샤드 플레이어당 타이머 수 (잠수 검사 1개 + 방/게임 타이머 여유분)
+constexpr size_t TIMERS_PER_PLAYER = 4;
+
+// 샤드 루프 단계별 시간 예산 (틱 간격 대비 %, 중앙 모드와 같은 비율). 남는 시간은 틱이 밀렸을 때의 여유
+// 이 샤드의 방에 있는 플레이어의 명령을 먼저 처리하고, 로비 명령(방 만들기 / 입장, 다른 샤드에서 넘어온 명령)은 따로 정한 예산 안에서 처리
+constexpr int64_t GAME_EVENT_BUDGET_PERCENT = 30;
+constexpr int64_t LOBBY_EVENT_BUDGET_PERCENT = 20;
+constexpr int64_t TIMER_BUDGET_PERCENT = 15;
+constexpr int64_t PUBLISH_BUDGET_PERCENT = 10;
+
+// 예약하지 못한 입장 요청을 다시 라우팅하는 최대 횟수 (앞선 요청이 끝나기를 기다리는 용도라 보통 1번)
+constexpr uint8_t ROOM_REQUEST_MAX_RETRIES = 4;
+
+CPartitionedServer::ShardContext::ShardContext(int32_t shardIndex, size_t maxClients, std::chrono::milliseconds tickInterval)
+    : index(shardIndex)
+    , queue()
+    , thread()
+    , tickScheduler(tickInterval)
+    , logName("PartitionedServer shard " + std::to_string(shardIndex))
+    , gameCommandBudget("GameCommands", tickScheduler.GetInterval() * GAME_EVENT_BUDGET_PERCENT / 100)
+    , lobbyCommandBudget("LobbyCommands", tickScheduler.GetInterval() * LOBBY_EVENT_BUDGET_PERCENT / 100)
+    , timerBudget("Timers", tickScheduler.GetInterval() * TIMER_BUDGET_PERCENT / 100)
+    , publishBudget("RoomList", tickScheduler.GetInterval() * PUBLISH_BUDGET_PERCENT / 100)
+    , lobbyBacklog()
+    , deferredCommands(maxClients, 0)
+    , timers(maxClients * TIMERS_PER_PLAYER)
+    , afkTimeoutTicks(tickScheduler.ToTicks(ROOM_AFK_TIMEOUT))
+    , owedTimerTicks(0)
+    , players(maxClients)
+    , sessionToPlayer(maxClients)
+    , listPublisher(maxClients)
+    , nextListPublish()
+    , lastPoolStatsLog(std::chrono::steady_clock::now())
+{
+}
+
+// 방은 제목 해시로 샤드가 정해지므로 한 샤드에 몰릴 수 있음 -> 샤드마다 방 풀을 maxClients 크기로
+CPartitionedServer::CPartitionedServer(int port, int maxClients, int shardCount, int mainlogicTickMs)
+    : _networkServer(std::make_shared<CIOCPServer>(port, maxClients, ServerArchitectureType::Partitioned))
+    , _roomManager(shardCount, static_cast<size_t>(maxClients), static_cast<size_t>(maxClients))
+    , _shards()
+    , _mergedRoomListMutex()
+    , _mergedRoomList()
+    , _running(false)
+{
+    _shards.reserve(_roomManager.GetShardCount());
+    for (int32_t i = 0; i < _roomManager.GetShardCount(); ++i)
+    {
+        _shards.push_back(std::make_unique<ShardContext>(i, static_cast<size_t>(maxClients), std::chrono::milliseconds(mainlogicTickMs)));
+    }
+
+    // 모든 네트워크 이벤트를 워커 스레드에서 바로 샤드 큐로 분배
+    _networkServer->SetNetworkEventRouter([this](NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)
+    {
+        RouteNetworkEvent(type, sessionId, data, length);
+    });
+}
+
+CPartitionedServer::~CPartitionedServer()
+{
+    Stop();
+    _networkServer->Disconnect();
+}
+
+bool CPartitionedServer::Start()
+{
+    // 샤드 스레드를 먼저 띄워서 첫 이벤트부터 처리할 수 있게
+    _running = true;
+    for (auto& shard : _shards)
+    {
+        shard->thread = std::thread(&CPartitionedServer::ShardLogicThread, this, std::ref(*shard));
+    }
+
+    if (!_networkServer->Start())
+    {
+        Stop();
+        return false;
+    }
+
+    LOG_INFO("[PartitionedServer] {} shard logic threads started", _shards.size());
+    return true;
+}
+
+void CPartitionedServer::Stop()
+{
+    if (!_running)
+    {
+        return;
+    }
+
+    _running = false;
+
+    for (auto& shard : _shards)
+    {
+        shard->tickScheduler.Notify();
+    }
+
+    for (auto& shard : _shards)
+    {
+        if (shard->thread.joinable())
+        {
+            shard->thread.join();
+        }
+    }
+
+    LOG_INFO("[PartitionedServer] Shard logic threads stopped");
+}
+
+// __________________________________________________________________
+//
+// 라우팅 (IOCP 워커 스레드)
+// __________________________________________________________________
+
+void CPartitionedServer::RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)
+{
+    switch (type)
+    {
+    case NetworkEvent::Type::CONNECTED:
+        // 방 밖의 세션은 서버 상태가 없으므로 목록만 보냄
+        SendMergedRoomList(sessionId, REQUEST_ID_NONE);
+        break;
+
+    case NetworkEvent::Type::DISCONNECTED:
+    {
+        // 방에 있거나 입장 요청 중일 때만 그 샤드에서 정리
+        CRoomMembershipTable::Entry entry = _roomManager.GetMembership().Get(
+            CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+        int32_t owner = _roomManager.GetOwnerShard(entry);
+        if (owner >= 0)
+        {
+            PostToShard(owner, NetworkEvent::Type::DISCONNECTED, sessionId, nullptr, 0, false, 0, 0);
+        }
+        break;
+    }
+
+    case NetworkEvent::Type::RECEIVED:
+        RouteDataReceived(sessionId, data, length);
+        break;
+    }
+}
+
+void CPartitionedServer::RouteDataReceived(int64_t sessionId, const char* data, size_t length)
+{
+    if (length < sizeof(MsgHeader))
+    {
+        LOG_WARNING("[PartitionedServer] Invalid msg size from SessionId: {}", sessionId);
+        return;
+    }
+
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+
+    // 패킷 크기 검증
+    if (header->size != length)
+    {
+        LOG_WARNING("[PartitionedServer] Msg size mismatch from SessionId: {}", sessionId);
+        return;
+    }
+
+    switch (header->type)
+    {
+    case MsgType::C2S_REQUEST_ROOM_LIST:
+        if (length >= sizeof(MSG_C2S_REQUEST_ROOM_LIST))
+        {
+            SendMergedRoomList(sessionId, reinterpret_cast<const MSG_C2S_REQUEST_ROOM_LIST*>(data)->requestId);
+        }
+        break;
+
+    case MsgType::C2S_REQUEST_ROOM_PAGE:
+    {
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_REQUEST_ROOM_PAGE msg;
+        if (msg.Decode(reader))
+        {
+            HandleRequestRoomPage(sessionId, msg);
+        }
+        break;
+    }
+
+    case MsgType::C2S_CREATE_ROOM:
+    case MsgType::C2S_JOIN_ROOM:
+    case MsgType::C2S_QUICK_JOIN:
+        RouteRoomRequest(sessionId, data, length, 0);
+        break;
+
+    default:
+    {
+        // 퇴장 등 방 안의 요청은 플레이어가 있는 샤드로
+        CRoomMembershipTable::Entry entry = _roomManager.GetMembership().Get(
+            CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+        int32_t owner = _roomManager.GetOwnerShard(entry);
+        if (owner >= 0)
+        {
+            PostToShard(owner, NetworkEvent::Type::RECEIVED, sessionId, data, length, false, 0, 0);
+        }
+        else if (header->type == MsgType::C2S_LEAVE_ROOM && length >= sizeof(MSG_C2S_LEAVE_ROOM))
+        {
+            uint32_t requestId = reinterpret_cast<const MSG_C2S_LEAVE_ROOM*>(data)->requestId;
+            SendRoomRequestResult(*_networkServer, sessionId, CRoomRequestHandler::LeaveRoom(requestId, false));
+        }
+        else
+        {
+            LOG_WARNING("[PartitionedServer] Unknown msg type: {}", static_cast<int>(header->type));
+        }
+        break;
+    }
+    }
+}
+
+// 생성/입장/빠른 입장 요청을 대상 샤드로 보냄 (워커 스레드, 재시도 시 샤드 스레드)
+void CPartitionedServer::RouteRoomRequest(int64_t sessionId, const char* data, size_t length, uint8_t retries)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    int64_t uniqueId = CSession::ExtractUniqueId(sessionId);
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+
+    int32_t target = 0;
+    switch (header->type)
+    {
+    case MsgType::C2S_CREATE_ROOM:
+    {
+        // 같은 제목은 항상 같은 샤드로 -> 중복 체크가 그 샤드 안에서 끝남
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_CREATE_ROOM msg;
+        if (!msg.Decode(reader))
+        {
+            return;
+        }
+        target = _roomManager.GetShardOfTitle(msg.title);
+        break;
+    }
+
+    case MsgType::C2S_JOIN_ROOM:
+        if (length < sizeof(MSG_C2S_JOIN_ROOM))
+        {
+            return;
+        }
+        target = _roomManager.GetShardOfRoom(reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data)->roomId);
+        break;
+
+    case MsgType::C2S_QUICK_JOIN:
+        if (length < sizeof(MSG_C2S_QUICK_JOIN))
+        {
+            return;
+        }
+        target = _roomManager.GetHomeShard(index); // 여기서부터 샤드를 넘기며 찾음
+        break;
+
+    default:
+        return;
+    }
+
+    CRoomMembershipTable& membership = _roomManager.GetMembership();
+    if (membership.TryReserve(index, uniqueId, target))
+    {
+        PostToShard(target, NetworkEvent::Type::RECEIVED, sessionId, data, length, true, 0, retries);
+        return;
+    }
+
+    // 이미 방에 있거나 앞선 입장 요청이 처리 중: 그 샤드에서 앞선 요청 뒤에 처리 (응답 순서 유지)
+    int32_t owner = _roomManager.GetOwnerShard(membership.Get(index, uniqueId));
+    PostToShard((owner >= 0) ? owner : target, NetworkEvent::Type::RECEIVED, sessionId, data, length, false, 0, retries);
+}
+
+void CPartitionedServer::PostToShard(int32_t shardIndex, NetworkEvent::Type type, int64_t sessionId,
+    const char* data, size_t length, bool reserved, uint8_t hops, uint8_t retries)
+{
+    ShardCommand command;
+    command.type = type;
+    command.sessionId = sessionId;
+    command.reserved = reserved;
+    command.hops = hops;
+    command.retries = retries;
+    if (data)
+    {
+        command.data.assign(data, data + length);
+    }
+
+    ShardContext& shard = *_shards[shardIndex];
+    shard.queue.Push(std::move(command));
+    shard.tickScheduler.Notify();
+}
+
+void CPartitionedServer::HandleRequestRoomPage(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_PAGE& msg)
+{
+    SendMergedRoomPage(sessionId, msg.requestId, ParseRoomPageQuery(msg));
+}
+
+// __________________________________________________________________
+//
+// 샤드 스레드
+// __________________________________________________________________
+
+void CPartitionedServer::ShardLogicThread(ShardContext& shard)
+{
+    shard.tickScheduler.Start();
+
+    while (_running)
+    {
+        // 샤드 큐 / 밀린 타이머 처리 (단계마다 예산만큼)
+        bool backlog = ProcessShardCommands(shard);
+        backlog |= ProcessTimers(shard);
+
+        // 다음 틱 시각까지 대기 (명령이 들어오면 바로 깨어나서 위에서 처리), 틱이 되면 샤드 로직 처리
+        // 예산을 넘겨 미룬 일이 있으면 잠들지 않고 틱 시각 전까지 이어서 처리
+        shard.tickScheduler.WaitAndRunTicks([&] { ProcessShardLogic(shard); }, !backlog);
+    }
+}
+
+bool CPartitionedServer::ProcessShardCommands(ShardContext& shard)
+{
+    // 1. 샤드 큐: 이 샤드의 방에 있는 플레이어의 명령은 바로 처리하고 로비 명령은 대기열로 (게임 명령 예산)
+    //    입장 요청이 한 샤드로 몰려도 그 샤드에서 게임 중인 플레이어의 요청이 그 뒤에서 기다리지 않음
+    uint64_t items = 0;
+    bool queueLeft = false;
+    shard.gameCommandBudget.Begin();
+
+    ShardCommand command;
+    while (true)
+    {
+        if (items > 0 && shard.gameCommandBudget.IsOver())
+        {
+            queueLeft = true; // 남은 명령은 샤드 큐에 둔 채로 다음 루프에서
+            break;
+        }
+        if (!shard.queue.TryPop(command))
+        {
+            break;
+        }
+        ++items;
+
+        uint16_t index = CSession::ExtractIndex(command.sessionId);
+        if (IsGameCommand(shard, command) || index >= shard.deferredCommands.size())
+        {
+            DispatchShardCommand(shard, command);
+            continue;
+        }
+
+        ++shard.deferredCommands[index];
+        shard.lobbyBacklog.push(std::move(command));
+    }
+    shard.gameCommandBudget.End(items, queueLeft);
+
+    // 2. 로비 대기열 (로비 명령 예산). 게임 명령이 예산을 다 써도 하나는 처리해서 굶지 않게
+    items = 0;
+    shard.lobbyCommandBudget.Begin();
+    while (!shard.lobbyBacklog.empty() && (items == 0 || !shard.lobbyCommandBudget.IsOver()))
+    {
+        const ShardCommand& front = shard.lobbyBacklog.front();
+        --shard.deferredCommands[CSession::ExtractIndex(front.sessionId)];
+        DispatchShardCommand(shard, front);
+        shard.lobbyBacklog.pop();
+        ++items;
+    }
+    shard.lobbyCommandBudget.End(items, !shard.lobbyBacklog.empty());
+
+    return queueLeft || !shard.lobbyBacklog.empty();
+}
+
+bool CPartitionedServer::IsGameCommand(ShardContext& shard, const ShardCommand& command)
+{
+    // 이 세션의 앞선 명령이 대기열에 있으면 순서를 지키기 위해 뒤에 붙임
+    uint16_t index = CSession::ExtractIndex(command.sessionId);
+    if (index < shard.deferredCommands.size() && shard.deferredCommands[index] > 0)
+    {
+        return false;
+    }
+
+    // 샤드의 플레이어는 항상 방 안
+    return GetPlayer(shard, command.sessionId) != nullptr;
+}
+
+void CPartitionedServer::DispatchShardCommand(ShardContext& shard, const ShardCommand& command)
+{
+    if (command.type == NetworkEvent::Type::DISCONNECTED)
+    {
+        HandleDisconnected(shard, command);
+        return;
+    }
+
+    // 크기 검증은 라우팅할 때 끝남
+    const char* data = command.data.data();
+    size_t length = command.data.size();
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+
+    // 이 샤드의 방에 있는 플레이어면 요청 시각 기록 (잠수 검사)
+    if (CPlayer* player = GetPlayer(shard, command.sessionId))
+    {
+        player->SetLastActivityTick(shard.timers.GetCurrentTick());
+    }
+
+    switch (header->type)
+    {
+    case MsgType::C2S_CREATE_ROOM:
+    case MsgType::C2S_JOIN_ROOM:
+    case MsgType::C2S_QUICK_JOIN:
+        if (!command.reserved)
+        {
+            HandleUnreservedRoomRequest(shard, command);
+        }
+        else if (header->type == MsgType::C2S_CREATE_ROOM)
+        {
+            CMsgReader reader(data, length, sizeof(MsgHeader));
+            MSG_C2S_CREATE_ROOM msg;
+            if (msg.Decode(reader))
+            {
+                HandleCreateRoom(shard, command.sessionId, msg);
+            }
+        }
+        else if (header->type == MsgType::C2S_JOIN_ROOM)
+        {
+            HandleJoinRoom(shard, command.sessionId, reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data));
+        }
+        else
+        {
+            HandleQuickJoin(shard, command, reinterpret_cast<const MSG_C2S_QUICK_JOIN*>(data));
+        }
+        break;
+
+    case MsgType::C2S_LEAVE_ROOM:
+        if (length >= sizeof(MSG_C2S_LEAVE_ROOM))
+        {
+            HandleLeaveRoom(shard, command, reinterpret_cast<const MSG_C2S_LEAVE_ROOM*>(data));
+        }
+        break;
+
+    default:
+        if (!ForwardToOwnerShard(shard, command))
+        {
+            LOG_WARNING("[PartitionedServer] Unknown msg type: {}", static_cast<int>(header->type));
+        }
+        break;
+    }
+
+    // 이 샤드의 방에 들어갔으면 잠수 검사 시작
+    if (CPlayer* player = GetPlayer(shard, command.sessionId))
+    {
+        ArmAfkTimer(shard, *player);
+    }
+}
+
+bool CPartitionedServer::ForwardToOwnerShard(ShardContext& shard, const ShardCommand& command)
+{
+    if (GetPlayer(shard, command.sessionId))
+    {
+        return false;
+    }
+
+    // 빠른 입장이 다른 샤드로 넘어간 뒤에 도착한 명령 (퇴장, 접속 종료)
+    CRoomMembershipTable::Entry entry = _roomManager.GetMembership().Get(
+        CSession::ExtractIndex(command.sessionId), CSession::ExtractUniqueId(command.sessionId));
+    int32_t owner = _roomManager.GetOwnerShard(entry);
+    if (owner < 0 || owner == shard.index)
+    {
+        return false;
+    }
+
+    const char* data = command.data.empty() ? nullptr : command.data.data();
+    PostToShard(owner, command.type, command.sessionId, data, command.data.size(), false, command.hops, command.retries);
+    return true;
+}
+
+void CPartitionedServer::HandleDisconnected(ShardContext& shard, const ShardCommand& command)
+{
+    int64_t sessionId = command.sessionId;
+    CPlayer* player = GetPlayer(shard, sessionId);
+    if (!player)
+    {
+        ForwardToOwnerShard(shard, command);
+        return;
+    }
+
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    const CRoom* room = roomManager.FindRoomByPlayer(*player);
+    int32_t roomId = room ? room->GetRoomId() : 0;
+
+    roomManager.LeaveRoom(*player);
+    RemovePlayer(shard, sessionId);
+
+    // 같은 슬롯에 새 세션이 이미 들어왔으면 태그가 달라 실패 (새 세션 상태는 그대로)
+    _roomManager.GetMembership().Release(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId), roomId);
+}
+
+// 입장 계열 요청은 라우팅할 때 멤버십을 이 샤드 앞으로 예약했으므로 방에 있는 세션은 오지 않음 (currentRoomId 없음)
+// 판정은 다른 모드와 같은 CRoomRequestHandler, 예약 확정 / 취소만 앞뒤로
+void CPartitionedServer::HandleCreateRoom(ShardContext& shard, int64_t sessionId, const MSG_C2S_CREATE_ROOM& msg)
+{
+    // 같은 제목은 모두 이 샤드로 오므로 중복 체크가 샤드 안에서 끝남
+    CRoomRequestHandler handler(_roomManager.GetShard(shard.index));
+    RoomRequestResult result = handler.CreateRoom(msg, ROOM_ID_NONE,
+        [&](CRoom& room, bool) { return SeatPlayer(shard, sessionId, room); });
+
+    CompleteReservation(shard, sessionId, result);
+}
+
+void CPartitionedServer::HandleJoinRoom(ShardContext& shard, int64_t sessionId, const MSG_C2S_JOIN_ROOM* msg)
+{
+    CRoomRequestHandler handler(_roomManager.GetShard(shard.index));
+    RoomRequestResult result = handler.JoinRoom(*msg, ROOM_ID_NONE,
+        [&](CRoom& room, bool) { return SeatPlayer(shard, sessionId, room); });
+
+    CompleteReservation(shard, sessionId, result);
+}
+
+void CPartitionedServer::HandleLeaveRoom(ShardContext& shard, const ShardCommand& command, const MSG_C2S_LEAVE_ROOM* msg)
+{
+    int64_t sessionId = command.sessionId;
+    CPlayer* player = GetPlayer(shard, sessionId);
+    if (!player)
+    {
+        if (!ForwardToOwnerShard(shard, command))
+        {
+            SendRoomRequestResult(*_networkServer, sessionId, CRoomRequestHandler::LeaveRoom(msg->requestId, false));
+        }
+        return;
+    }
+
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    const CRoom* room = roomManager.FindRoomByPlayer(*player);
+    int32_t roomId = room ? room->GetRoomId() : 0;
+
+    bool left = roomManager.LeaveRoom(*player);
+    RemovePlayer(shard, sessionId); // 방 밖의 세션은 샤드에 남기지 않음
+    _roomManager.GetMembership().Release(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId), roomId);
+
+    SendRoomRequestResult(*_networkServer, sessionId, CRoomRequestHandler::LeaveRoom(msg->requestId, left));
+}
+
+void CPartitionedServer::HandleQuickJoin(ShardContext& shard, const ShardCommand& command, const MSG_C2S_QUICK_JOIN* msg)
+{
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    CRoomMembershipTable& membership = _roomManager.GetMembership();
+    int64_t sessionId = command.sessionId;
+    int32_t maxPlayers = msg->maxPlayers;
+
+    // 이 샤드에 맞는 방이 없으면 예약을 다음 샤드로 옮기고 넘김. 모든 샤드를 돌았으면 여기서 생성
+    // (샤드마다 자기 인덱스만 보므로 다른 샤드 상태를 읽지 않음. 잘못된 인원 조건은 넘기지 않고 바로 판정)
+    bool lastShard = command.hops + 1 >= _roomManager.GetShardCount();
+    if (!lastShard && CRoomRequestHandler::IsValidQuickJoinSize(maxPlayers) && !roomManager.FindQuickJoinRoom(maxPlayers))
+    {
+        int32_t nextShard = _roomManager.GetNextShard(shard.index);
+        if (membership.MovePending(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId), shard.index, nextShard))
+        {
+            PostToShard(nextShard, command.type, sessionId, command.data.data(), command.data.size(),
+                true, static_cast<uint8_t>(command.hops + 1), command.retries);
+        }
+        return; // 실패하면 이미 접속이 끊기고 슬롯이 재사용된 세션
+    }
+
+    CRoomRequestHandler handler(roomManager);
+    RoomRequestResult result = handler.QuickJoin(*msg, ROOM_ID_NONE,
+        [&](CRoom& room, bool) { return SeatPlayer(shard, sessionId, room); });
+
+    CompleteReservation(shard, sessionId, result);
+}
+
+ErrorCode CPartitionedServer::SeatPlayer(ShardContext& shard, int64_t sessionId, CRoom& room)
+{
+    CPlayer* player = AddPlayer(shard, sessionId);
+    if (!player)
+    {
+        return ErrorCode::ROOM_JOIN_FAILED;
+    }
+
+    if (!_roomManager.GetShard(shard.index).JoinRoom(room, *player))
+    {
+        RemovePlayer(shard, sessionId);
+        return ErrorCode::ROOM_JOIN_FAILED;
+    }
+    return ErrorCode::NONE;
+}
+
+void CPartitionedServer::CompleteReservation(ShardContext& shard, int64_t sessionId, const RoomRequestResult& result)
+{
+    CRoomMembershipTable& membership = _roomManager.GetMembership();
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    int64_t uniqueId = CSession::ExtractUniqueId(sessionId);
+
+    // 응답보다 먼저 확정해야 응답을 받은 클라의 방 안 메시지가 이 샤드로 라우팅됨
+    if (result.IsSuccess())
+    {
+        membership.Commit(index, uniqueId, shard.index, result.roomId);
+    }
+    else
+    {
+        membership.Cancel(index, uniqueId, shard.index);
+    }
+
+    SendRoomRequestResult(*_networkServer, sessionId, result);
+}
+
+// 예약하지 못한 입장 요청: 앞선 요청이 끝난 지금 상태로 다시 판단
+void CPartitionedServer::HandleUnreservedRoomRequest(ShardContext& shard, const ShardCommand& command)
+{
+    const char* data = command.data.data();
+    size_t length = command.data.size();
+
+    CRoomMembershipTable::Entry entry = _roomManager.GetMembership().Get(
+        CSession::ExtractIndex(command.sessionId), CSession::ExtractUniqueId(command.sessionId));
+
+    if (entry.state == CRoomMembershipTable::State::JOINED)
+    {
+        SendRoomRequestFailed(*_networkServer, command.sessionId, data, length, ErrorCode::ALREADY_IN_ROOM, { entry.value });
+        return;
+    }
+
+    if (command.retries >= ROOM_REQUEST_MAX_RETRIES)
+    {
+        SendRoomRequestFailed(*_networkServer, command.sessionId, data, length, ErrorCode::ROOM_JOIN_FAILED, { 0 });
+        return;
+    }
+
+    RouteRoomRequest(command.sessionId, data, length, static_cast<uint8_t>(command.retries + 1));
+}
+
+void CPartitionedServer::ProcessShardLogic(ShardContext& shard)
+{
+    ++shard.owedTimerTicks;
+    ProcessTimers(shard);
+
+    PublishRoomList(shard);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - shard.lastPoolStatsLog >= POOL_STATS_LOG_INTERVAL)
+    {
+        shard.lastPoolStatsLog = now;
+        LogPoolStats(shard);
+        shard.tickScheduler.LogStats(shard.logName.c_str());
+        LogPhaseStats(shard);
+    }
+}
+
+bool CPartitionedServer::ProcessTimers(ShardContext& shard)
+{
+    if (shard.owedTimerTicks == 0)
+    {
+        return false;
+    }
+
+    // 만료가 몰린 틱은 예산까지만 처리하고 나머지는 다음 루프에서 이어서 (타이머 시각은 그만큼 늦게 감)
+    size_t expired = 0;
+    shard.timerBudget.Begin();
+    shard.owedTimerTicks -= shard.timers.AdvanceBudgeted(shard.owedTimerTicks,
+        [&](const TimerEvent& event) { DispatchTimer(shard, event); },
+        [&] { return shard.timerBudget.IsOver(); },
+        expired);
+    shard.timerBudget.End(expired, shard.owedTimerTicks > 0);
+
+    return shard.owedTimerTicks > 0;
+}
+
+void CPartitionedServer::PublishRoomList(ShardContext& shard)
+{
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    if (roomManager.GetVersion() == shard.listPublisher.GetPublishedVersion())
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < shard.nextListPublish)
+    {
+        return;
+    }
+
+    // 모든 버퍼를 reader가 잡고 있으면 다음 틱에 다시 시도
+    RoomListSnapshot* snapshot = shard.listPublisher.BeginWrite();
+    if (!snapshot)
+    {
+        return;
+    }
+
+    // 샤드의 방 전체를 복사하는 나눌 수 없는 작업이라 예산을 넘긴 만큼 다음 게시를 늦춤
+    shard.publishBudget.Begin();
+    roomManager.FillSnapshot(*snapshot);
+    shard.listPublisher.Publish();
+    shard.publishBudget.End(snapshot->rooms.size(), false);
+    shard.nextListPublish = now + (std::max)(std::chrono::steady_clock::duration(ROOM_LIST_PUBLISH_INTERVAL),
+        shard.publishBudget.GetAmortizedInterval(shard.tickScheduler.GetInterval()));
+}
+
+void CPartitionedServer::LogPoolStats(ShardContext& shard)
+{
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    PoolStats playerStats = shard.players.GetStats();
+    PoolStats roomStats = roomManager.GetRoomPoolStats();
+
+    LOG_INFO("[PartitionedServer] Shard {} Pool - Players: {}/{} (peak {}, fail {}), Rooms: {}/{} (peak {}, fail {}), Index nodes: {} KB",
+        shard.index, playerStats.inUse, playerStats.capacity, playerStats.peak, playerStats.allocFailures,
+        roomStats.inUse, roomStats.capacity, roomStats.peak, roomStats.allocFailures,
+        roomManager.GetIndexPoolBytes() / 1024);
+
+    PoolStats timerStats = shard.timers.GetStats();
+    LOG_INFO("[PartitionedServer] Shard {} Pool - Timers: {}/{} (peak {}, fail {})",
+        shard.index, timerStats.inUse, timerStats.capacity, timerStats.peak, timerStats.allocFailures);
+}
+
+void CPartitionedServer::LogPhaseStats(ShardContext& shard)
+{
+    const char* owner = shard.logName.c_str();
+    shard.gameCommandBudget.LogStats(owner);
+    shard.lobbyCommandBudget.LogStats(owner);
+    shard.timerBudget.LogStats(owner);
+    shard.publishBudget.LogStats(owner);
+
+    if (!shard.lobbyBacklog.empty() || shard.owedTimerTicks > 0)
+    {
+        LOG_WARNING("[PartitionedServer] Shard {} deferred work at report time: {} lobby commands, {} timer ticks",
+            shard.index, shard.lobbyBacklog.size(), shard.owedTimerTicks);
+    }
+}
+
+void CPartitionedServer::DispatchTimer(ShardContext& shard, const TimerEvent& event)
+{
+    switch (event.type)
+    {
+    case TimerType::PLAYER_AFK_CHECK:
+        HandleAfkCheck(shard, event);
+        break;
+    }
+}
+
+void CPartitionedServer::ArmAfkTimer(ShardContext& shard, CPlayer& player)
+{
+    if (shard.timers.IsActive(player.GetAfkTimer()))
+    {
+        return;
+    }
+
+    TimerEvent event;
+    event.type = TimerType::PLAYER_AFK_CHECK;
+    event.player = player.GetHandle();
+    player.SetAfkTimer(shard.timers.Schedule(shard.afkTimeoutTicks, event)); // 가득 차서 실패하면 다음 요청 때 다시 시도
+}
+
+void CPartitionedServer::HandleAfkCheck(ShardContext& shard, const TimerEvent& event)
+{
+    // 그 사이 퇴장/접속 종료로 샤드에서 빠졌으면 핸들이 무효
+    CPlayer* player = shard.players.Get(event.player);
+    if (!player)
+    {
+        return;
+    }
+
+    uint64_t idleTicks = shard.timers.GetCurrentTick() - player->GetLastActivityTick();
+    if (idleTicks < shard.afkTimeoutTicks)
+    {
+        // 그 사이 요청이 있었음: 마지막 요청 기준으로 남은 시간만큼 다시 검
+        player->SetAfkTimer(shard.timers.Schedule(static_cast<uint32_t>(shard.afkTimeoutTicks - idleTicks), event));
+        return;
+    }
+
+    int64_t sessionId = player->GetSessionId();
+    CRoomManager& roomManager = _roomManager.GetShard(shard.index);
+    const CRoom* room = roomManager.FindRoomByPlayer(*player);
+    int32_t roomId = room ? room->GetRoomId() : 0;
+    int32_t idleSeconds = static_cast<int32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        shard.tickScheduler.GetInterval() * static_cast<int64_t>(idleTicks)).count());
+
+    LOG_INFO("[PartitionedServer] AFK kick - Shard {}, SessionId: {}, RoomId: {}, idle {}s", shard.index, sessionId, roomId, idleSeconds);
+
+    // 퇴장 요청과 같은 처리 (방 밖의 세션은 샤드에 남기지 않음)
+    roomManager.LeaveRoom(*player);
+    RemovePlayer(shard, sessionId);
+    _roomManager.GetMembership().Release(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId), roomId);
+
+    SendRoomLeft(*_networkServer, sessionId, REQUEST_ID_NONE, true);
+    SendError(*_networkServer, sessionId, REQUEST_ID_NONE, ErrorCode::AFK_KICKED, { roomId, idleSeconds });
+}
+
+CPlayer* CPartitionedServer::GetPlayer(ShardContext& shard, int64_t sessionId)
+{
+    return shard.sessionToPlayer.Find(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+}
+
+CPlayer* CPartitionedServer::AddPlayer(ShardContext& shard, int64_t sessionId)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+
+    // 같은 슬롯의 이전 세션이 이 샤드에 남아있으면 (종료 명령 누락) 먼저 정리
+    if (CPlayer* stalePlayer = shard.sessionToPlayer.Peek(index))
+    {
+        LOG_WARNING("[PartitionedServer] Stale player in shard {} session slot {} (SessionId: {}), removing",
+            shard.index, index, stalePlayer->GetSessionId());
+        _roomManager.GetShard(shard.index).LeaveRoom(*stalePlayer);
+        RemovePlayer(shard, stalePlayer->GetSessionId());
+    }
+
+    PlayerHandle handle = shard.players.Create(sessionId);
+    CPlayer* player = shard.players.Get(handle);
+    if (!player)
+    {
+        return nullptr;
+    }
+
+    player->SetHandle(handle);
+
+    if (!shard.sessionToPlayer.Insert(index, CSession::ExtractUniqueId(sessionId), player))
+    {
+        shard.players.Release(handle);
+        return nullptr;
+    }
+
+    return player;
+}
+
+void CPartitionedServer::RemovePlayer(ShardContext& shard, int64_t sessionId)
+{
+    CPlayer* player = GetPlayer(shard, sessionId);
+    if (!player)
+    {
+        return;
+    }
+
+    // 걸려있는 타이머 노드 반환 (남겨둬도 만료 시 핸들 검증에서 걸러지지만, 입장/퇴장이 잦으면 노드가 쌓임)
+    shard.timers.Cancel(player->GetAfkTimer());
+
+    shard.sessionToPlayer.Erase(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+    shard.players.Release(player->GetHandle());
+}
+
+// __________________________________________________________________
+//
+// 방 목록 / 전송 (아무 스레드)
+// __________________________________________________________________
+
+int32_t CPartitionedServer::AcquireRoomLists(RoomListReadGuards& guards, const RoomListSnapshot** outSnapshots) const
+{
+    int32_t shardCount = _roomManager.GetShardCount();
+    for (int32_t i = 0; i < shardCount; ++i)
+    {
+        guards.guards[i].emplace(_shards[i]->listPublisher.Acquire());
+        outSnapshots[i] = &**guards.guards[i];
+    }
+    return shardCount;
+}
+
+int32_t CPartitionedServer::QueryRoomPage(const RoomPageQuery& query, RoomListReadGuards& guards,
+    const RoomSummary** outRooms, int32_t& outCount) const
+{
+    const RoomListSnapshot* snapshots[ROOM_SHARD_MAX_COUNT];
+    int32_t shardCount = AcquireRoomLists(guards, snapshots);
+
+    return RoomListSnapshot::QueryMergedPage(snapshots, shardCount, query, outRooms, outCount);
+}
+
+std::shared_ptr<const CPartitionedServer::MergedRoomListPayload> CPartitionedServer::GetMergedRoomList()
+{
+    RoomListReadGuards guards;
+    const RoomListSnapshot* snapshots[ROOM_SHARD_MAX_COUNT];
+    int32_t shardCount = AcquireRoomLists(guards, snapshots);
+
+    std::shared_ptr<const MergedRoomListPayload> cached;
+    {
+        std::lock_guard<std::mutex> lock(_mergedRoomListMutex);
+        cached = _mergedRoomList;
+    }
+
+    // 잡고 있는 스냅샷과 버전이 하나라도 다르면 다시 합침
+    bool sameVersions = (cached != nullptr);
+    bool cachedIsNewer = (cached != nullptr);
+    for (int32_t i = 0; i < shardCount && cached; ++i)
+    {
+        sameVersions = sameVersions && cached->versions[i] == snapshots[i]->version;
+        cachedIsNewer = cachedIsNewer && cached->versions[i] >= snapshots[i]->version;
+    }
+
+    if (sameVersions)
+    {
+        return cached;
+    }
+
+    // 목록이 바뀐 뒤 첫 요청만 합쳐서 인코딩 (여러 워커가 동시에 만들어도 결과는 같음)
+    auto merged = std::make_shared<MergedRoomListPayload>();
+    for (int32_t i = 0; i < shardCount; ++i)
+    {
+        merged->versions[i] = snapshots[i]->version;
+    }
+
+    RoomPageQuery query;
+    query.pageSize = ROOM_PAGE_MAX_SIZE;
+    const RoomSummary* rooms[ROOM_PAGE_MAX_SIZE];
+    int32_t roomCount = 0;
+    RoomListSnapshot::QueryMergedPage(snapshots, shardCount, query, rooms, roomCount);
+    merged->size = RoomListSnapshot::EncodeListPayload(rooms, roomCount, merged->payload);
+
+    // 다른 워커가 더 새 목록을 이미 올렸으면 그대로 둠 (이번 요청에는 잡고 있던 스냅샷 기준으로 응답)
+    if (!cachedIsNewer)
+    {
+        std::lock_guard<std::mutex> lock(_mergedRoomListMutex);
+        if (_mergedRoomList == cached)
+        {
+            _mergedRoomList = merged;
+        }
+    }
+
+    return merged;
+}
+
+// 접속 직후 / 구버전 목록 요청용. 최근 방 1페이지만 전송
+void CPartitionedServer::SendMergedRoomList(int64_t sessionId, uint32_t requestId)
+{
+    if (_roomManager.GetShardCount() == 1)
+    {
+        // 샤드가 하나면 게시할 때 인코딩해둔 본문을 그대로 씀
+        SendRoomList(*_networkServer, sessionId, requestId, _shards[0]->listPublisher);
+        return;
+    }
+
+    // 합친 본문을 참조로 잡고 requestId만 붙여서 복사 (목록이 바뀌기 전까지 모든 요청이 공유)
+    char buffer[ROOM_LIST_MSG_MAX_SIZE];
+    std::shared_ptr<const MergedRoomListPayload> merged = GetMergedRoomList();
+    size_t size = RoomListSnapshot::WriteRoomListMsg(buffer, requestId, merged->payload, merged->size);
+
+    _networkServer->RequestSendMsg(sessionId, buffer, static_cast<int>(size));
+}
+
+void CPartitionedServer::SendMergedRoomPage(int64_t sessionId, uint32_t requestId, const RoomPageQuery& query)
+{
+    // 인코딩이 끝날 때까지 샤드 스냅샷을 잡고 있음
+    RoomListReadGuards guards;
+    const RoomSummary* rooms[ROOM_PAGE_MAX_SIZE];
+    int32_t roomCount = 0;
+    int32_t nextCursor = QueryRoomPage(query, guards, rooms, roomCount);
+
+    SendRoomPage(*_networkServer, sessionId, requestId, rooms, roomCount, nextCursor);
+}
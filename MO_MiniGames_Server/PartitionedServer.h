@@ -0,0 +1,172 @@
+#pragma once
+
+#include "IOCPServer.h"
+#include "ShardedRoomManager.h"
+#include "RoomListSnapshot.h"
+#include "Protocol.h"
+#include "Player.h"
+#include "HandleTable.h"
+#include "SessionSlotTable.h"
+#include "TickScheduler.h"
+#include "TimerWheel.h"
+#include "LobbyHandler.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+// 분산형 게임 로직 레이어 - 방을 샤드로 나누고 샤드마다 로직 스레드 하나
+// 중앙 큐 없이 IOCP 워커가 멤버십 테이블을 보고 세션의 메시지를 담당 샤드 큐에 바로 넣음
+//  - 방에 있거나 입장 요청 중인 세션: 멤버십이 가리키는 샤드
+//  - 방 입장 계열 요청(생성/입장/빠른 입장): 대상 샤드 앞으로 멤버십을 예약(CAS)한 뒤 전달
+//    예약이 안 되면(이미 방에 있음 / 요청 처리 중) 현재 샤드로 보내서 앞선 요청 뒤에 처리
+//  - 방 목록: 워커가 샤드별 스냅샷을 합쳐서 바로 응답
+// 플레이어 객체는 들어간 방의 샤드에만 있음 (방 밖에 있는 세션은 서버 상태가 없음)
+class CPartitionedServer
+{
+public:
+    // mainlogicTickMs: 샤드 로직 틱 간격 (0 이하면 TICK_DEFAULT_INTERVAL). 샤드 큐에 들어온 명령은 틱과 관계없이 바로 처리
+    // (게임 / 로비 명령, 타이머마다 틱 간격의 일부를 예산으로 나누고 넘치면 다음 루프로)
+    explicit CPartitionedServer(int port, int maxClients, int shardCount, int mainlogicTickMs = -1);
+    virtual ~CPartitionedServer();
+
+    bool Start();
+    void Stop();
+
+private:
+    // 샤드 큐 명령
+    struct ShardCommand
+    {
+        NetworkEvent::Type type = NetworkEvent::Type::RECEIVED; // DISCONNECTED / RECEIVED
+        int64_t sessionId = -1;
+        bool reserved = false; // 입장 계열 요청: 멤버십을 이 샤드 앞으로 예약했는지
+        uint8_t hops = 0;      // 빠른 입장이 지나온 샤드 수
+        uint8_t retries = 0;   // 예약 실패로 다시 라우팅한 횟수
+        std::vector<char> data;
+    };
+
+    // 샤드 하나의 실행 상태. queue, tickScheduler 깨우기, listPublisher 읽기만 다른 스레드에서 접근하고 나머지는 샤드 스레드 전용
+    struct ShardContext
+    {
+        ShardContext(int32_t shardIndex, size_t maxClients, std::chrono::milliseconds tickInterval);
+
+        int32_t index;
+        ThreadSafeQueue<ShardCommand> queue;
+        std::thread thread;
+
+        // 고정 간격 틱 + 큐에 명령이 들어오면 바로 깨어남 (PostToShard가 Notify)
+        CTickScheduler tickScheduler;
+        std::string logName; // 틱 지표 로그 앞머리
+
+        // 샤드 루프 단계별 시간 예산 (틱 간격의 일부, 중앙 모드와 같은 비율). 넘으면 남은 일은 다음 루프로
+        CPhaseBudget gameCommandBudget;
+        CPhaseBudget lobbyCommandBudget;
+        CPhaseBudget timerBudget;
+        CPhaseBudget publishBudget; // 나눌 수 없는 작업이라 넘긴 만큼 다음 게시를 미룸
+
+        // 로비 명령 대기열 (이 샤드에 플레이어가 없는 세션: 입장 계열 요청, 넘겨받은 명령). 게임 명령 뒤에 로비 예산만큼 처리
+        // 세션 index마다 대기열에 있는 명령 수 -> 0이 아니면 그 세션의 이후 명령도 대기열로 (세션 안 순서 유지)
+        std::queue<ShardCommand> lobbyBacklog;
+        std::vector<uint32_t> deferredCommands;
+
+        // 이 샤드의 게임 로직 타이머 (시간 단위는 샤드 로직 틱)
+        CTimerWheel timers;
+        uint32_t afkTimeoutTicks;
+        uint32_t owedTimerTicks; // 예산을 넘겨 아직 진행하지 못한 타이머 틱
+
+        // 이 샤드의 방에 들어와 있는 플레이어
+        CHandleTable<CPlayer> players;
+        CSessionSlotTable<CPlayer> sessionToPlayer;
+
+        CRoomListPublisher listPublisher;
+        std::chrono::steady_clock::time_point nextListPublish; // 게시 간격 + 예산을 넘긴 만큼 미룸
+        std::chrono::steady_clock::time_point lastPoolStatsLog;
+    };
+
+    // 여러 샤드의 방 목록 스냅샷을 응답 인코딩이 끝날 때까지 잡아둠
+    struct RoomListReadGuards
+    {
+        std::optional<CRoomListPublisher::CReadGuard> guards[ROOM_SHARD_MAX_COUNT];
+    };
+
+    // 샤드 목록을 합친 첫 페이지 S2C_ROOM_LIST 본문. 만든 뒤에는 읽기 전용
+    // 샤드 스냅샷 버전이 모두 같은 동안 모든 목록 요청이 이 버퍼 하나를 참조로 공유
+    struct MergedRoomListPayload
+    {
+        uint64_t versions[ROOM_SHARD_MAX_COUNT];
+        size_t size;
+        char payload[ROOM_LIST_PAYLOAD_MAX_SIZE];
+    };
+
+    // 라우팅 (IOCP 워커 스레드, 재시도는 샤드 스레드에서도) ///////////////////////////
+    void RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length);
+    void RouteDataReceived(int64_t sessionId, const char* data, size_t length);
+    void RouteRoomRequest(int64_t sessionId, const char* data, size_t length, uint8_t retries);
+    void PostToShard(int32_t shardIndex, NetworkEvent::Type type, int64_t sessionId,
+        const char* data, size_t length, bool reserved, uint8_t hops, uint8_t retries);
+    void HandleRequestRoomPage(int64_t sessionId, const MSG_C2S_REQUEST_ROOM_PAGE& msg);
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 샤드 스레드 ////////////////////////////////////////////////////////////////
+    void ShardLogicThread(ShardContext& shard);
+    bool ProcessShardCommands(ShardContext& shard); // 단계별 예산 안에서 처리. 남은 명령이 있으면 true
+    bool IsGameCommand(ShardContext& shard, const ShardCommand& command);
+    void DispatchShardCommand(ShardContext& shard, const ShardCommand& command);
+
+    // 플레이어가 이 샤드에 없으면 멤버십이 가리키는 샤드로 명령을 넘김 (넘겼으면 true)
+    bool ForwardToOwnerShard(ShardContext& shard, const ShardCommand& command);
+
+    void HandleDisconnected(ShardContext& shard, const ShardCommand& command);
+    void HandleCreateRoom(ShardContext& shard, int64_t sessionId, const MSG_C2S_CREATE_ROOM& msg);
+    void HandleJoinRoom(ShardContext& shard, int64_t sessionId, const MSG_C2S_JOIN_ROOM* msg);
+    void HandleLeaveRoom(ShardContext& shard, const ShardCommand& command, const MSG_C2S_LEAVE_ROOM* msg);
+    void HandleQuickJoin(ShardContext& shard, const ShardCommand& command, const MSG_C2S_QUICK_JOIN* msg);
+    void HandleUnreservedRoomRequest(ShardContext& shard, const ShardCommand& command);
+
+    // 공용 판정(CRoomRequestHandler)에 넘기는 좌석 처리: 이 샤드에 플레이어를 만들어서 방에 넣음 (실패하면 되돌림)
+    ErrorCode SeatPlayer(ShardContext& shard, int64_t sessionId, CRoom& room);
+
+    // 예약한 멤버십을 결과대로 확정(Commit) / 취소(Cancel)하고 응답
+    void CompleteReservation(ShardContext& shard, int64_t sessionId, const RoomRequestResult& result);
+
+    void ProcessShardLogic(ShardContext& shard);
+    bool ProcessTimers(ShardContext& shard); // 밀린 타이머 틱을 예산 안에서 진행. 남았으면 true
+    void PublishRoomList(ShardContext& shard);
+    void LogPoolStats(ShardContext& shard);
+    void LogPhaseStats(ShardContext& shard);
+
+    // 타이머 (샤드 스레드, 틱마다 만료분 처리)
+    void DispatchTimer(ShardContext& shard, const TimerEvent& event);
+    void ArmAfkTimer(ShardContext& shard, CPlayer& player); // 검사 타이머가 없으면 건다 (샤드의 플레이어는 항상 방 안)
+    void HandleAfkCheck(ShardContext& shard, const TimerEvent& event);
+
+    // 샤드 플레이어 관리
+    CPlayer* GetPlayer(ShardContext& shard, int64_t sessionId);
+    CPlayer* AddPlayer(ShardContext& shard, int64_t sessionId);
+    void RemovePlayer(ShardContext& shard, int64_t sessionId);
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 방 목록 (아무 스레드)
+    int32_t AcquireRoomLists(RoomListReadGuards& guards, const RoomListSnapshot** outSnapshots) const; // 반환값은 샤드 수
+    int32_t QueryRoomPage(const RoomPageQuery& query, RoomListReadGuards& guards, const RoomSummary** outRooms, int32_t& outCount) const;
+    std::shared_ptr<const MergedRoomListPayload> GetMergedRoomList(); // 버전이 바뀌었으면 새로 합쳐서 교체
+
+    // 샤드 목록을 합친 응답 (아무 스레드). 샤드가 하나면 그 샤드의 스냅샷을 그대로
+    void SendMergedRoomList(int64_t sessionId, uint32_t requestId);
+    void SendMergedRoomPage(int64_t sessionId, uint32_t requestId, const RoomPageQuery& query);
+
+private:
+    std::shared_ptr<CIOCPServer> _networkServer;
+    CShardedRoomManager _roomManager;
+    std::vector<std::unique_ptr<ShardContext>> _shards;
+
+    // 목록이 바뀐 뒤 첫 요청이 만들어서 교체 (락은 포인터 복사 동안만)
+    std::mutex _mergedRoomListMutex;
+    std::shared_ptr<const MergedRoomListPayload> _mergedRoomList;
+    std::atomic<bool> _running;
+};
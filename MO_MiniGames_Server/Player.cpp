@@ -2,7 +2,8 @@
 
 CPlayer::CPlayer(int64_t sessionId)
     : _sessionId(sessionId)
-    , _accountId(0)  // ʱⰪ 0 ( )
+    , _accountId(0)  // 초기값 0 (미인증 상태)
+    , _lastActivityTick(0)
     , _score(0)
 {
 }
@@ -26,6 +27,46 @@ void CPlayer::SetAccountId(int64_t accountId)
     _accountId = accountId;
 }
 
+PlayerHandle CPlayer::GetHandle() const
+{
+    return _handle;
+}
+
+void CPlayer::SetHandle(PlayerHandle handle)
+{
+    _handle = handle;
+}
+
+RoomHandle CPlayer::GetRoomHandle() const
+{
+    return _roomHandle;
+}
+
+void CPlayer::SetRoomHandle(RoomHandle handle)
+{
+    _roomHandle = handle;
+}
+
+uint64_t CPlayer::GetLastActivityTick() const
+{
+    return _lastActivityTick;
+}
+
+void CPlayer::SetLastActivityTick(uint64_t tick)
+{
+    _lastActivityTick = tick;
+}
+
+TimerHandle CPlayer::GetAfkTimer() const
+{
+    return _afkTimer;
+}
+
+void CPlayer::SetAfkTimer(TimerHandle timer)
+{
+    _afkTimer = timer;
+}
+
 int32_t CPlayer::GetScore() const
 {
     return _score;
@@ -3,25 +3,46 @@
 #include <cstdint>
 #include <string>
 
+#include "HandleTable.h"
+#include "TimerWheel.h"
+
 class CPlayer
 {
 public:
     explicit CPlayer(int64_t sessionId);
     ~CPlayer();
 
-    // Ʈũ  ĺ (IOCPServer ſ)
+    // 네트워크 계층 식별자 (IOCPServer와 통신용)
     int64_t GetSessionId() const;
 
-    //    ĺ (CentralizedServer, RoomManager)
+    // 게임 로직 계층 식별자 (CentralizedServer, RoomManager용)
     int64_t GetAccountId() const;
     void SetAccountId(int64_t accountId);
 
+    // 플레이어 테이블 핸들 (생성 시 CCentralizedServer가 설정)
+    PlayerHandle GetHandle() const;
+    void SetHandle(PlayerHandle handle);
+
+    // 현재 입장한 방 (없으면 null 핸들, 방이 삭제됐으면 RoomManager 조회 시 무효 처리)
+    RoomHandle GetRoomHandle() const;
+    void SetRoomHandle(RoomHandle handle);
+
+    // 방 안 잠수 검사 (마지막 요청을 받은 타이머 휠 틱, 걸려있는 검사 타이머)
+    uint64_t GetLastActivityTick() const;
+    void SetLastActivityTick(uint64_t tick);
+    TimerHandle GetAfkTimer() const;
+    void SetAfkTimer(TimerHandle timer);
+
     int32_t GetScore() const;
     void SetScore(int32_t score);
     void AddScore(int32_t delta);
 
 private:
-    int64_t _sessionId;   // Ʈũ  ID (IOCPServer )
-    int64_t _accountId;   //  ID (  )
-    int32_t _score;       // ÷̾ 
+    int64_t _sessionId;   // 네트워크 세션 ID (IOCPServer에서 관리)
+    int64_t _accountId;   // 계정 ID (게임 로직에서 사용)
+    PlayerHandle _handle;
+    RoomHandle _roomHandle;
+    uint64_t _lastActivityTick;
+    TimerHandle _afkTimer;
+    int32_t _score;       // 플레이어 점수
 };
\ No newline at end of file
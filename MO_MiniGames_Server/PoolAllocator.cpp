@@ -0,0 +1,74 @@
+#include "PoolAllocator.h"
+
+CNodePool::CNodePool(size_t nodesPerChunk)
+    : _freeLists()
+    , _nodesPerChunk(nodesPerChunk > 0 ? nodesPerChunk : 1)
+    , _reservedBytes(0)
+{
+}
+
+CNodePool::~CNodePool()
+{
+    for (void* chunk : _chunks)
+    {
+        ::operator delete(chunk);
+    }
+    _chunks.clear();
+}
+
+void* CNodePool::Allocate(size_t size)
+{
+    if (size == 0 || size > MAX_NODE_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    if (!_freeLists[sizeClass])
+    {
+        Refill(sizeClass);
+    }
+
+    FreeNode* node = _freeLists[sizeClass];
+    _freeLists[sizeClass] = node->next;
+    return node;
+}
+
+void CNodePool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    if (size == 0 || size > MAX_NODE_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // 청크는 풀이 소멸할 때까지 유지, 노드는 free list로 돌아가서 재사용
+    size_t sizeClass = GetSizeClass(size);
+    FreeNode* node = static_cast<FreeNode*>(ptr);
+    node->next = _freeLists[sizeClass];
+    _freeLists[sizeClass] = node;
+}
+
+void CNodePool::Refill(size_t sizeClass)
+{
+    size_t nodeSize = (sizeClass + 1) * SIZE_CLASS_UNIT;
+    size_t chunkBytes = nodeSize * _nodesPerChunk;
+
+    // operator new는 기본 정렬(16바이트 이상)을 보장하고 노드 크기가 16의 배수라 모든 노드가 정렬됨
+    char* chunk = static_cast<char*>(::operator new(chunkBytes));
+    _chunks.push_back(chunk);
+    _reservedBytes += chunkBytes;
+
+    // 청크를 노드 단위로 잘라 free list에 연결 (앞쪽 노드부터 나가도록 역순으로)
+    for (size_t i = _nodesPerChunk; i > 0; --i)
+    {
+        FreeNode* node = reinterpret_cast<FreeNode*>(chunk + (i - 1) * nodeSize);
+        node->next = _freeLists[sizeClass];
+        _freeLists[sizeClass] = node;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// __________________________________________________________________
+//
+// 노드 풀 (컨테이너 노드 전용 할당기)
+// unordered_map / set은 원소마다 노드를 new/delete 하므로, 크기별 free list에서 노드를 재사용한다.
+// 청크 단위로 늘어나고 해제된 노드는 OS에 돌려주지 않으므로 최대 사용량까지 한 번 늘어난 뒤로는 힙 할당 없음.
+// 크기 16바이트 단위 클래스, MAX_NODE_SIZE 초과나 배열(n > 1, 버킷 배열 등)은 일반 new로 처리
+// 단일 스레드 전용 (게임 로직 스레드 또는 소유자의 락 안에서만 사용)
+// __________________________________________________________________
+
+class CNodePool
+{
+public:
+    explicit CNodePool(size_t nodesPerChunk = 256);
+    ~CNodePool();
+
+    CNodePool(const CNodePool&) = delete;
+    CNodePool& operator=(const CNodePool&) = delete;
+
+    void* Allocate(size_t size);
+    void Deallocate(void* ptr, size_t size);
+
+    // 모니터링용
+    size_t GetChunkCount() const { return _chunks.size(); }
+    size_t GetReservedBytes() const { return _reservedBytes; }
+
+    static constexpr size_t SIZE_CLASS_UNIT = 16;
+    static constexpr size_t MAX_NODE_SIZE = 256;
+
+private:
+    static constexpr size_t SIZE_CLASS_COUNT = MAX_NODE_SIZE / SIZE_CLASS_UNIT;
+
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    static size_t GetSizeClass(size_t size) { return (size + SIZE_CLASS_UNIT - 1) / SIZE_CLASS_UNIT - 1; }
+
+    // 해당 크기 클래스의 free list가 비었을 때 청크 하나를 잘라서 채움
+    void Refill(size_t sizeClass);
+
+    FreeNode* _freeLists[SIZE_CLASS_COUNT];
+    std::vector<void*> _chunks;
+    size_t _nodesPerChunk;
+    size_t _reservedBytes;
+};
+
+// STL 할당기 어댑터. 같은 CNodePool을 가리키면 서로 호환 (rebind된 노드 타입도 같은 풀 사용)
+template <typename T>
+class TPoolAllocator
+{
+public:
+    using value_type = T;
+
+    explicit TPoolAllocator(CNodePool* pool) noexcept : _pool(pool) {}
+
+    template <typename U>
+    TPoolAllocator(const TPoolAllocator<U>& other) noexcept : _pool(other.GetPool()) {}
+
+    T* allocate(size_t n)
+    {
+        if (n == 1 && sizeof(T) <= CNodePool::MAX_NODE_SIZE && alignof(T) <= CNodePool::SIZE_CLASS_UNIT)
+        {
+            return static_cast<T*>(_pool->Allocate(sizeof(T)));
+        }
+
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if (n == 1 && sizeof(T) <= CNodePool::MAX_NODE_SIZE && alignof(T) <= CNodePool::SIZE_CLASS_UNIT)
+        {
+            _pool->Deallocate(ptr, sizeof(T));
+            return;
+        }
+
+        ::operator delete(ptr);
+    }
+
+    CNodePool* GetPool() const noexcept { return _pool; }
+
+    template <typename U>
+    bool operator==(const TPoolAllocator<U>& other) const noexcept { return _pool == other.GetPool(); }
+
+    template <typename U>
+    bool operator!=(const TPoolAllocator<U>& other) const noexcept { return _pool != other.GetPool(); }
+
+private:
+    CNodePool* _pool;
+};
+
+// 노드 풀을 쓰는 컨테이너 별칭 (생성자에 TPoolAllocator<...>(&pool) 전달)
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+using TPoolUnorderedMap = std::unordered_map<Key, Value, Hash, std::equal_to<Key>, TPoolAllocator<std::pair<const Key, Value>>>;
+
+template <typename Key, typename Compare = std::less<Key>>
+using TPoolSet = std::set<Key, Compare, TPoolAllocator<Key>>;
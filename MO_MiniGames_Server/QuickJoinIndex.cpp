@@ -0,0 +1,149 @@
+#include "QuickJoinIndex.h"
+#include "Room.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // mask != 0 이어야 함
+    int32_t LowestSetBit(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int32_t>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+}
+
+CQuickJoinIndex::CQuickJoinIndex()
+    : _buckets()
+    , _freeSlotMasks()
+    , _count(0)
+{
+}
+
+void CQuickJoinIndex::Update(CRoom& room)
+{
+    int32_t maxPlayers = room.GetMaxPlayers();
+    int32_t freeSlots = maxPlayers - room.GetCurrentPlayerCount();
+    bool joinable = room.GetStatus() == RoomStatus::WAITING && freeSlots > 0;
+
+    // 이미 맞는 버킷에 있으면 그대로 (버킷 안 순서 유지)
+    if (joinable && room._quickMaxPlayers == maxPlayers && room._quickFreeSlots == freeSlots)
+    {
+        return;
+    }
+
+    Unlink(room);
+    if (joinable)
+    {
+        Link(room, maxPlayers, freeSlots);
+    }
+}
+
+void CQuickJoinIndex::Remove(CRoom& room)
+{
+    Unlink(room);
+}
+
+CRoom* CQuickJoinIndex::FindBest(int32_t maxPlayers) const
+{
+    if (maxPlayers > 0)
+    {
+        if (maxPlayers >= BUCKET_DIM || _freeSlotMasks[maxPlayers] == 0)
+        {
+            return nullptr;
+        }
+
+        return _buckets[maxPlayers][LowestSetBit(_freeSlotMasks[maxPlayers])].head;
+    }
+
+    // 인원 조건 없음: 빈 자리가 가장 적은 방. 같으면 작은 방 (빨리 꽉 참)
+    int32_t bestMaxPlayers = 0;
+    int32_t bestFreeSlots = BUCKET_DIM;
+    for (int32_t i = 1; i < BUCKET_DIM; ++i)
+    {
+        if (_freeSlotMasks[i] == 0)
+        {
+            continue;
+        }
+
+        int32_t freeSlots = LowestSetBit(_freeSlotMasks[i]);
+        if (freeSlots < bestFreeSlots)
+        {
+            bestFreeSlots = freeSlots;
+            bestMaxPlayers = i;
+        }
+    }
+
+    return (bestMaxPlayers > 0) ? _buckets[bestMaxPlayers][bestFreeSlots].head : nullptr;
+}
+
+void CQuickJoinIndex::Link(CRoom& room, int32_t maxPlayers, int32_t freeSlots)
+{
+    // 뒤에 붙이고 앞에서 꺼냄 (먼저 들어온 방 우선)
+    Bucket& bucket = _buckets[maxPlayers][freeSlots];
+    room._quickPrev = bucket.tail;
+    room._quickNext = nullptr;
+
+    if (bucket.tail)
+    {
+        bucket.tail->_quickNext = &room;
+    }
+    else
+    {
+        bucket.head = &room;
+    }
+    bucket.tail = &room;
+
+    room._quickMaxPlayers = static_cast<int8_t>(maxPlayers);
+    room._quickFreeSlots = static_cast<int8_t>(freeSlots);
+    _freeSlotMasks[maxPlayers] |= (1u << freeSlots);
+    ++_count;
+}
+
+void CQuickJoinIndex::Unlink(CRoom& room)
+{
+    if (room._quickFreeSlots == 0)
+    {
+        return; // 인덱스에 없음
+    }
+
+    int32_t maxPlayers = room._quickMaxPlayers;
+    int32_t freeSlots = room._quickFreeSlots;
+    Bucket& bucket = _buckets[maxPlayers][freeSlots];
+
+    if (room._quickPrev)
+    {
+        room._quickPrev->_quickNext = room._quickNext;
+    }
+    else
+    {
+        bucket.head = room._quickNext;
+    }
+
+    if (room._quickNext)
+    {
+        room._quickNext->_quickPrev = room._quickPrev;
+    }
+    else
+    {
+        bucket.tail = room._quickPrev;
+    }
+
+    if (!bucket.head)
+    {
+        _freeSlotMasks[maxPlayers] &= ~(1u << freeSlots);
+    }
+
+    room._quickPrev = nullptr;
+    room._quickNext = nullptr;
+    room._quickMaxPlayers = 0;
+    room._quickFreeSlots = 0;
+    --_count;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Protocol.h"
+
+class CRoom;
+
+// __________________________________________________________________
+//
+// 빠른 입장 인덱스
+// 입장 가능한 방(WAITING && !IsFull)을 [maxPlayers][빈 자리 수] 버킷으로 나눈 intrusive 리스트
+// 버킷마다 비어있지 않은 빈 자리 수를 비트마스크로 들고 있어서
+// "빈 자리가 가장 적은 방"(= 가장 빨리 시작할 방)을 비트 연산 한 번으로 찾음
+// maxPlayers 조건이 없으면 ROOM_MAX_PLAYERS개 마스크만 비교 -> 방 개수와 관계없이 상수 시간
+// 같은 버킷 안에서는 먼저 들어온 방부터 (오래 기다린 방 우선)
+// 링크는 CRoom 안에 있으므로 노드 할당 없음. CRoomManager 전용
+// __________________________________________________________________
+
+class CQuickJoinIndex
+{
+public:
+    CQuickJoinIndex();
+
+    // 방 상태/인원이 바뀔 때마다 호출. 입장 가능하면 맞는 버킷으로 옮기고 아니면 제거
+    void Update(CRoom& room);
+    void Remove(CRoom& room);
+
+    // maxPlayers: 0이면 인원 조건 없음. 맞는 방이 없으면 nullptr
+    CRoom* FindBest(int32_t maxPlayers) const;
+
+    int32_t GetCount() const { return _count; }
+
+private:
+    struct Bucket
+    {
+        CRoom* head = nullptr;
+        CRoom* tail = nullptr;
+    };
+
+    static constexpr int32_t BUCKET_DIM = ROOM_MAX_PLAYERS + 1; // 1 ~ ROOM_MAX_PLAYERS 를 그대로 첨자로 사용
+
+    void Link(CRoom& room, int32_t maxPlayers, int32_t freeSlots);
+    void Unlink(CRoom& room);
+
+    Bucket _buckets[BUCKET_DIM][BUCKET_DIM];
+    uint32_t _freeSlotMasks[BUCKET_DIM]; // bit n: [maxPlayers][n] 버킷이 비어있지 않음
+    int32_t _count;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "MsgCodec.h"
+#include "Protocol.h"
+#include "TetrisEngine.h"
+
+// __________________________________________________________________
+//
+// 경기 리플레이 파일 형식 (방 하나의 게임 한 판 = 파일 하나)
+// 보드는 seed + 확정 프레임 입력 + 방해 줄로 다시 돌리면 그대로 나오므로 보드 상태는 저장하지 않음
+//  [ReplayFileHeader][레코드 ...][ReplayFileTrailer]
+// 레코드: [varuint (앞 레코드와의 프레임 차 << 4) | code][code별 본문]
+//  code 0 ~ 9 (슬롯)      입력이 바뀜: [uint8 input] (그 프레임부터 이 값. 같은 입력이 이어지는 동안은 레코드 없음)
+//  REPLAY_CODE_TARGET     [uint8 slot][uint8 GarbageTargetMode] (그 프레임의 공격부터)
+//  REPLAY_CODE_GARBAGE    [uint8 slot][uint8 linesAndHole] (그 프레임을 진행한 직후, 기록 순서대로 = S2C_GAME_FRAMES와 같은 순서)
+//  REPLAY_CODE_CHECKSUM   [uint32 서버 보드 체크섬] (그 프레임 진행 + 방해 줄까지 끝난 상태)
+// 같은 프레임 안에서는 대상 / 입력 -> 방해 줄 -> 체크섬 순. 입력이 거의 바뀌지 않으므로 1분에 몇 KB
+// 트레일러는 경기가 끝날 때 붙음. 없으면(서버 중단) 끝까지 읽을 수 있는 레코드만 씀
+// 고정 크기 부분은 패킷과 같이 리틀 엔디언 그대로
+// __________________________________________________________________
+
+constexpr char REPLAY_FILE_MAGIC[4] = { 'M', 'O', 'R', 'P' };
+constexpr char REPLAY_TRAILER_MAGIC[4] = { 'M', 'O', 'R', 'E' };
+constexpr uint16_t REPLAY_FILE_VERSION = 1;
+
+// 레코드 code (하위 4비트). 0 ~ ROOM_MAX_PLAYERS-1은 슬롯 입력
+constexpr uint8_t REPLAY_CODE_TARGET = 12;
+constexpr uint8_t REPLAY_CODE_GARBAGE = 13;
+constexpr uint8_t REPLAY_CODE_CHECKSUM = 14;
+constexpr uint8_t REPLAY_CODE_BITS = 4;
+constexpr uint8_t REPLAY_CODE_MASK = (1 << REPLAY_CODE_BITS) - 1;
+static_assert(ROOM_MAX_PLAYERS <= REPLAY_CODE_TARGET, "slot codes must not overlap record codes");
+
+// 레코드 하나의 최대 크기 (헤드 varint + 가장 긴 본문)
+constexpr size_t REPLAY_RECORD_MAX_SIZE = MAX_VARINT32_SIZE + sizeof(uint32_t);
+
+// 서버 보드 체크섬 간격 (확정 프레임, 1초). 게임 끝에도 하나
+constexpr uint32_t REPLAY_CHECKSUM_INTERVAL = 60;
+
+enum ReplayTrailerFlags : uint8_t
+{
+    REPLAY_TRAILER_TRUNCATED = 1 << 0, // 기록 버퍼가 모자라 중간부터 빠짐 (frameCount까지만 온전함)
+    REPLAY_TRAILER_ABORTED   = 1 << 1  // 게임이 끝나기 전에 방이 닫힘
+};
+
+#pragma pack(push, 1)
+
+struct ReplayFileHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint8_t playerCount;
+    uint8_t reserved;
+    uint32_t matchId;  // 서버 프로세스 안에서 경기마다 다름
+    int32_t roomId;
+    uint32_t seed;     // 모든 보드 + 공격 라우터가 같은 seed
+    int64_t startTime; // 유닉스 시간 ms
+};
+
+struct ReplayFileTrailer
+{
+    uint32_t recordBytes; // 헤더 뒤 레코드 바이트 수
+    uint32_t frameCount;  // 확정된 전체 프레임 수
+    uint8_t winnerSlot;   // LOCKSTEP_SLOT_NONE: 무승부 / 승자 없음
+    uint8_t flags;        // ReplayTrailerFlags
+    uint16_t reserved;
+    char magic[4];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ReplayFileHeader) == 28, "ReplayFileHeader layout changed");
+static_assert(sizeof(ReplayFileTrailer) == 16, "ReplayFileTrailer layout changed");
+
+constexpr uint32_t REPLAY_CHECKSUM_SEED = 2166136261u;
+
+// 보드 하나를 체크섬에 더함 (FNV-1a). 숨은 행, 현재 블록, 점수까지 -> 시뮬레이션이 조금만 어긋나도 다름
+inline uint32_t UpdateReplayChecksum(uint32_t hash, const CTetrisEngine& engine)
+{
+    auto mix = [&hash](uint32_t value)
+    {
+        for (int32_t i = 0; i < 4; ++i)
+        {
+            hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 16777619u;
+        }
+    };
+
+    for (int32_t y = 0; y < TETRIS_BOARD_HEIGHT; ++y)
+    {
+        mix(engine.GetRow(y));
+    }
+    mix(static_cast<uint32_t>(engine.GetPiece()));
+    mix(static_cast<uint32_t>(engine.GetRotation()));
+    mix(static_cast<uint32_t>(engine.GetPieceX()));
+    mix(static_cast<uint32_t>(engine.GetPieceY()));
+    mix(engine.GetScore());
+    mix(engine.GetLines());
+    mix(engine.IsGameOver() ? 1u : 0u);
+    return hash;
+}
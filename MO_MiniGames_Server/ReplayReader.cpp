@@ -0,0 +1,423 @@
+#include "ReplayReader.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CReplayReader::CReplayReader()
+    : _data(nullptr)
+    , _size(0)
+    , _header()
+    , _trailer()
+    , _hasTrailer(false)
+    , _records(nullptr)
+    , _recordsSize(0)
+    , _frameCount(0)
+    , _error("not open")
+    , _frame(0)
+    , _offset(0)
+    , _pending()
+    , _hasPending(false)
+    , _decodeError(false)
+    , _boards()
+    , _inputs()
+    , _targets()
+    , _checkpoints()
+    , _checkpointBoards()
+    , _checksumsVerified(0)
+    , _checksumMismatches(0)
+    , _firstMismatchFrame(-1)
+    , _verifiedFrames(0)
+{
+}
+
+CReplayReader::~CReplayReader()
+{
+    Close();
+}
+
+bool CReplayReader::Open(const std::string& path)
+{
+    Close();
+
+    if (!MapFile(path))
+    {
+        _error = "cannot map file";
+        return false;
+    }
+
+    if (!ReadLayout())
+    {
+        UnmapFile();
+        return false;
+    }
+
+    _checksumsVerified = 0;
+    _checksumMismatches = 0;
+    _firstMismatchFrame = -1;
+    _verifiedFrames = 0;
+    _error = nullptr;
+
+    Rewind();
+    return true;
+}
+
+void CReplayReader::Close()
+{
+    UnmapFile();
+    _checkpoints.clear();
+    _checkpointBoards.clear();
+    _hasTrailer = false;
+    _records = nullptr;
+    _recordsSize = 0;
+    _frameCount = 0;
+    _frame = 0;
+    _error = "not open";
+}
+
+bool CReplayReader::MapFile(const std::string& path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size = {};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return false;
+    }
+
+    // 뷰가 매핑 객체를 붙잡고 있으므로 핸들은 바로 닫아도 됨
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+    {
+        return false;
+    }
+
+    _data = static_cast<const char*>(view);
+    _size = static_cast<size_t>(size.QuadPart);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info = {};
+    void* view = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+
+    _data = static_cast<const char*>(view);
+    _size = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void CReplayReader::UnmapFile()
+{
+    if (!_data)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<char*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+bool CReplayReader::ReadLayout()
+{
+    if (_size < sizeof(ReplayFileHeader))
+    {
+        _error = "file too small";
+        return false;
+    }
+
+    std::memcpy(&_header, _data, sizeof(_header));
+    if (std::memcmp(_header.magic, REPLAY_FILE_MAGIC, sizeof(_header.magic)) != 0)
+    {
+        _error = "not a replay file";
+        return false;
+    }
+    if (_header.version != REPLAY_FILE_VERSION)
+    {
+        _error = "unsupported replay version";
+        return false;
+    }
+    if (_header.playerCount == 0 || _header.playerCount > ROOM_MAX_PLAYERS)
+    {
+        _error = "bad player count";
+        return false;
+    }
+
+    // 트레일러는 매직 + 레코드 길이가 파일 크기와 맞을 때만 믿음
+    _records = _data + sizeof(ReplayFileHeader);
+    _recordsSize = _size - sizeof(ReplayFileHeader);
+    _hasTrailer = false;
+    if (_recordsSize >= sizeof(ReplayFileTrailer))
+    {
+        std::memcpy(&_trailer, _data + _size - sizeof(ReplayFileTrailer), sizeof(_trailer));
+        if (std::memcmp(_trailer.magic, REPLAY_TRAILER_MAGIC, sizeof(_trailer.magic)) == 0
+            && _trailer.recordBytes == _recordsSize - sizeof(ReplayFileTrailer))
+        {
+            _hasTrailer = true;
+            _recordsSize -= sizeof(ReplayFileTrailer);
+        }
+    }
+
+    _frameCount = _hasTrailer ? _trailer.frameCount : ScanFrameCount();
+    return true;
+}
+
+uint32_t CReplayReader::ScanFrameCount()
+{
+    // 끝이 잘린 레코드가 있을 수 있으므로 체크섬(프레임의 마지막 레코드)까지만 온전하다고 봄
+    uint32_t frameCount = 0;
+    _offset = 0;
+    _pending = Record();
+    _decodeError = false;
+    while (DecodeNext() && _hasPending)
+    {
+        if (_pending.code == REPLAY_CODE_CHECKSUM)
+        {
+            frameCount = _pending.frame + 1;
+        }
+    }
+    return frameCount;
+}
+
+void CReplayReader::Rewind()
+{
+    _frame = 0;
+    _offset = 0;
+    _pending = Record();
+    _decodeError = false;
+    std::fill(std::begin(_inputs), std::end(_inputs), static_cast<uint8_t>(TETRIS_INPUT_NONE));
+    std::fill(std::begin(_targets), std::end(_targets), static_cast<uint8_t>(GarbageTargetMode::RANDOM));
+
+    // 모든 보드가 같은 seed (서버 CLockstepRelay::Start와 같음)
+    for (int32_t slot = 0; slot < GetPlayerCount(); ++slot)
+    {
+        _boards[slot].Start(_header.seed);
+    }
+
+    DecodeNext();
+    if (_checkpoints.empty())
+    {
+        SaveCheckpoint();
+    }
+}
+
+bool CReplayReader::DecodeNext()
+{
+    _hasPending = false;
+    if (_offset >= _recordsSize)
+    {
+        return true;
+    }
+
+    CMsgReader reader(_records + _offset, _recordsSize - _offset, 0);
+    uint32_t head = 0;
+    Record record;
+    bool ok = reader.ReadVarUInt(head);
+    record.frame = _pending.frame + (head >> REPLAY_CODE_BITS);
+    record.code = static_cast<uint8_t>(head & REPLAY_CODE_MASK);
+
+    if (ok)
+    {
+        if (record.code < GetPlayerCount())
+        {
+            ok = reader.ReadUInt8(record.a);
+        }
+        else if (record.code == REPLAY_CODE_TARGET || record.code == REPLAY_CODE_GARBAGE)
+        {
+            ok = reader.ReadUInt8(record.a) && reader.ReadUInt8(record.b) && record.a < GetPlayerCount();
+        }
+        else if (record.code == REPLAY_CODE_CHECKSUM)
+        {
+            const uint8_t* bytes = nullptr;
+            ok = reader.ReadBytes(bytes, sizeof(record.checksum));
+            if (ok)
+            {
+                std::memcpy(&record.checksum, bytes, sizeof(record.checksum));
+            }
+        }
+        else
+        {
+            ok = false;
+        }
+    }
+
+    if (!ok)
+    {
+        _decodeError = true;
+        return false;
+    }
+
+    _offset = _recordsSize - reader.GetRemainSize();
+    _pending = record;
+    _hasPending = true;
+    return true;
+}
+
+bool CReplayReader::StepFrame()
+{
+    // 입력 / 대상 -> 진행 -> 방해 줄 -> 체크섬 (서버가 쓴 순서, 클라가 S2C_GAME_FRAMES를 적용하는 순서)
+    // 다음 레코드를 못 읽어도(끝이 잘린 파일) 이 프레임은 마저 진행하고 다음부터 멈춤
+    while (_hasPending && _pending.frame == _frame && (_pending.code < GetPlayerCount() || _pending.code == REPLAY_CODE_TARGET))
+    {
+        if (_pending.code == REPLAY_CODE_TARGET)
+        {
+            _targets[_pending.a] = _pending.b;
+        }
+        else
+        {
+            _inputs[_pending.code] = _pending.a;
+        }
+
+        DecodeNext();
+    }
+
+    for (int32_t slot = 0; slot < GetPlayerCount(); ++slot)
+    {
+        _boards[slot].Step(_inputs[slot]);
+    }
+
+    while (_hasPending && _pending.frame == _frame && _pending.code == REPLAY_CODE_GARBAGE)
+    {
+        GarbageEvent garbage = {};
+        garbage.linesAndHole = _pending.b;
+        _boards[_pending.a].InsertGarbage(garbage.GetLines(), garbage.GetHole());
+
+        DecodeNext();
+    }
+
+    if (_hasPending && _pending.frame == _frame && _pending.code == REPLAY_CODE_CHECKSUM)
+    {
+        if (_frame >= _verifiedFrames)
+        {
+            uint32_t hash = REPLAY_CHECKSUM_SEED;
+            for (int32_t slot = 0; slot < GetPlayerCount(); ++slot)
+            {
+                hash = UpdateReplayChecksum(hash, _boards[slot]);
+            }
+
+            ++_checksumsVerified;
+            if (hash != _pending.checksum)
+            {
+                ++_checksumMismatches;
+                if (_firstMismatchFrame < 0)
+                {
+                    _firstMismatchFrame = _frame;
+                }
+            }
+        }
+
+        DecodeNext();
+    }
+
+    // 이 프레임의 레코드가 순서와 다르게 남아있으면 손상된 파일
+    if (_hasPending && _pending.frame <= _frame)
+    {
+        _decodeError = true;
+        return false;
+    }
+
+    ++_frame;
+    _verifiedFrames = (std::max)(_verifiedFrames, _frame);
+    if (_frame % REPLAY_SEEK_INTERVAL == 0 && _frame / REPLAY_SEEK_INTERVAL == _checkpoints.size())
+    {
+        SaveCheckpoint();
+    }
+    return true;
+}
+
+uint32_t CReplayReader::Advance(uint32_t frames)
+{
+    uint32_t advanced = 0;
+    while (advanced < frames && !IsFinished() && StepFrame())
+    {
+        ++advanced;
+    }
+    return advanced;
+}
+
+bool CReplayReader::Seek(uint32_t frame)
+{
+    if (!IsOpen() || frame > _frameCount)
+    {
+        return false;
+    }
+
+    // 지금 위치가 가장 가까운 체크포인트보다 앞이 아니면 그대로 진행
+    size_t index = (std::min)(static_cast<size_t>(frame / REPLAY_SEEK_INTERVAL), _checkpoints.size() - 1);
+    const Checkpoint& checkpoint = _checkpoints[index];
+    if (_decodeError || _frame > frame || _frame < checkpoint.frame)
+    {
+        RestoreCheckpoint(checkpoint);
+        for (int32_t slot = 0; slot < GetPlayerCount(); ++slot)
+        {
+            _boards[slot] = _checkpointBoards[index * GetPlayerCount() + slot];
+        }
+    }
+
+    Advance(frame - _frame);
+    return _frame == frame;
+}
+
+void CReplayReader::SaveCheckpoint()
+{
+    Checkpoint checkpoint;
+    checkpoint.frame = _frame;
+    checkpoint.offset = _offset;
+    checkpoint.pending = _pending;
+    checkpoint.hasPending = _hasPending;
+    std::memcpy(checkpoint.inputs, _inputs, sizeof(_inputs));
+    std::memcpy(checkpoint.targets, _targets, sizeof(_targets));
+    _checkpoints.push_back(checkpoint);
+
+    for (int32_t slot = 0; slot < GetPlayerCount(); ++slot)
+    {
+        _checkpointBoards.push_back(_boards[slot]);
+    }
+}
+
+void CReplayReader::RestoreCheckpoint(const Checkpoint& checkpoint)
+{
+    _frame = checkpoint.frame;
+    _offset = checkpoint.offset;
+    _pending = checkpoint.pending;
+    _hasPending = checkpoint.hasPending;
+    _decodeError = false;
+    std::memcpy(_inputs, checkpoint.inputs, sizeof(_inputs));
+    std::memcpy(_targets, checkpoint.targets, sizeof(_targets));
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ReplayFormat.h"
+
+// 되감기용 체크포인트 간격 (프레임, 10초). 재생하면서 처음 지나갈 때 만듦
+constexpr uint32_t REPLAY_SEEK_INTERVAL = 600;
+
+// __________________________________________________________________
+//
+// 리플레이 파일 재생 (디싱크 조사, 오프라인 부하 테스트용)
+// 파일을 메모리 매핑해서 레코드를 그 자리에서 디코딩 (파일 전체를 읽어 들이지 않음)
+// seed로 보드를 시작하고 기록된 입력 / 방해 줄을 클라와 같은 순서로 적용해서 진행
+//  - 프레임 진행: 입력 / 대상 레코드 적용 -> 전원 Step -> 방해 줄 삽입 -> 체크섬 레코드와 비교
+//  - Advance: 빨리 감기 (그리기 없이 엔진만 돌림)
+//  - Seek: 가까운 앞 체크포인트(REPLAY_SEEK_INTERVAL마다 보드 복사본)에서 다시 진행
+// 체크섬이 다르면 그 프레임까지 서버와 같은 시뮬레이션이 아님 (GetFirstMismatchFrame)
+// 트레일러가 없는 파일(서버 중단)은 마지막 체크섬 프레임까지만 재생
+// __________________________________________________________________
+
+class CReplayReader
+{
+public:
+    CReplayReader();
+    ~CReplayReader();
+
+    CReplayReader(const CReplayReader&) = delete;
+    CReplayReader& operator=(const CReplayReader&) = delete;
+
+    // 파일 매핑 + 헤더 / 트레일러 확인 후 0프레임으로. 실패하면 false (GetError)
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return _data != nullptr; }
+    const char* GetError() const { return _error; }
+
+    const ReplayFileHeader& GetHeader() const { return _header; }
+    bool HasTrailer() const { return _hasTrailer; }
+    const ReplayFileTrailer& GetTrailer() const { return _trailer; } // HasTrailer일 때만
+    size_t GetFileSize() const { return _size; }
+    int32_t GetPlayerCount() const { return _header.playerCount; }
+
+    // 재생할 수 있는 프레임 수
+    uint32_t GetFrameCount() const { return _frameCount; }
+
+    // 진행한 프레임 수 (= 다음에 진행할 프레임 번호)
+    uint32_t GetCurrentFrame() const { return _frame; }
+    bool IsFinished() const { return _frame >= _frameCount || _decodeError; }
+
+    void Rewind();
+
+    // frames만큼 진행 (끝이나 디코딩 오류에서 멈춤). 실제로 진행한 프레임 수를 리턴
+    uint32_t Advance(uint32_t frames);
+
+    // frame 프레임까지 진행한 상태로 (뒤로 가기 포함)
+    bool Seek(uint32_t frame);
+
+    const CTetrisEngine& GetBoard(int32_t slot) const { return _boards[slot]; }
+
+    // 마지막으로 진행한 프레임에서 slot이 낸 입력 (부하 테스트에서 그대로 보낼 값)
+    uint8_t GetInput(int32_t slot) const { return _inputs[slot]; }
+    GarbageTargetMode GetTargetMode(int32_t slot) const { return static_cast<GarbageTargetMode>(_targets[slot]); }
+
+    // 검증 결과 (Rewind / Seek로 다시 지나간 체크섬은 다시 세지 않음)
+    uint32_t GetChecksumsVerified() const { return _checksumsVerified; }
+    uint32_t GetChecksumMismatches() const { return _checksumMismatches; }
+    int64_t GetFirstMismatchFrame() const { return _firstMismatchFrame; } // -1: 없음
+    bool HasDecodeError() const { return _decodeError; }
+
+private:
+    // 디코딩한 다음 레코드 (아직 적용 전)
+    struct Record
+    {
+        uint32_t frame = 0;
+        uint8_t code = 0;
+        uint8_t a = 0;
+        uint8_t b = 0;
+        uint32_t checksum = 0;
+    };
+
+    struct Checkpoint
+    {
+        uint32_t frame;
+        size_t offset;
+        Record pending;
+        bool hasPending;
+        uint8_t inputs[ROOM_MAX_PLAYERS];
+        uint8_t targets[ROOM_MAX_PLAYERS];
+    };
+
+    bool MapFile(const std::string& path);
+    void UnmapFile();
+    bool ReadLayout(); // 헤더 / 트레일러 / 레코드 범위
+    uint32_t ScanFrameCount(); // 트레일러 없음: 마지막 체크섬 프레임 + 1
+
+    bool DecodeNext(); // _offset의 레코드를 _pending으로 (끝이면 _hasPending = false)
+    bool StepFrame();
+    void SaveCheckpoint();
+    void RestoreCheckpoint(const Checkpoint& checkpoint);
+
+    // 매핑 (파일 / 매핑 핸들은 매핑한 뒤 바로 닫음)
+    const char* _data;
+    size_t _size;
+
+    ReplayFileHeader _header;
+    ReplayFileTrailer _trailer;
+    bool _hasTrailer;
+    const char* _records;
+    size_t _recordsSize;
+    uint32_t _frameCount;
+    const char* _error;
+
+    // 재생 상태
+    uint32_t _frame;
+    size_t _offset;
+    Record _pending;
+    bool _hasPending;
+    bool _decodeError;
+    CTetrisEngine _boards[ROOM_MAX_PLAYERS];
+    uint8_t _inputs[ROOM_MAX_PLAYERS];
+    uint8_t _targets[ROOM_MAX_PLAYERS];
+
+    std::vector<Checkpoint> _checkpoints;     // frame = index * REPLAY_SEEK_INTERVAL
+    std::vector<CTetrisEngine> _checkpointBoards; // [index * playerCount + slot]
+
+    uint32_t _checksumsVerified;
+    uint32_t _checksumMismatches;
+    int64_t _firstMismatchFrame;
+    uint32_t _verifiedFrames; // 여기까지는 이미 검증함 (다시 지나갈 때 세지 않음)
+};
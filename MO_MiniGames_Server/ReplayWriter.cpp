@@ -0,0 +1,468 @@
+#include "ReplayWriter.h"
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+
+// __________________________________________________________________
+//
+// CReplayWriter
+// __________________________________________________________________
+
+CReplayWriter::CReplayWriter(std::string directory, size_t blockCount)
+    : _directory(std::move(directory))
+    , _blocks(std::make_unique<ReplayBlock[]>(blockCount))
+    , _blockCount(blockCount)
+    , _free(blockCount)
+    , _pending(blockCount)
+    , _nextMatchId(1)
+    , _accepting(false)
+    , _threadMutex()
+    , _cv()
+    , _thread()
+    , _running(false)
+    , _files()
+    , _writtenBytes(0)
+    , _finishedMatches(0)
+    , _failedMatches(0)
+{
+    for (size_t i = 0; i < _blockCount; ++i)
+    {
+        ReplayBlock* block = &_blocks[i];
+        _free.TryPush([block](ReplayBlock*& cell) { cell = block; });
+    }
+}
+
+CReplayWriter::~CReplayWriter()
+{
+    Stop();
+}
+
+bool CReplayWriter::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        if (_running)
+        {
+            return true;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(_directory, error);
+        if (error)
+        {
+            LOG_ERROR("[ReplayWriter] Cannot create directory: {} ({})", _directory, error.message());
+            return false;
+        }
+        _running = true;
+    }
+
+    _thread = std::thread(&CReplayWriter::WriterThread, this);
+    _accepting.store(true, std::memory_order_release);
+    return true;
+}
+
+void CReplayWriter::Stop()
+{
+    _accepting.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        if (!_running)
+        {
+            return;
+        }
+        _running = false;
+    }
+
+    _cv.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+ReplayBlock* CReplayWriter::AcquireBlock()
+{
+    if (!_accepting.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    ReplayBlock* block = nullptr;
+    if (!_free.TryConsume([&block](ReplayBlock* cell) { block = cell; }))
+    {
+        return nullptr;
+    }
+
+    block->matchId = 0;
+    block->flags = 0;
+    block->size = 0;
+    return block;
+}
+
+void CReplayWriter::Submit(ReplayBlock* block)
+{
+    // 블록은 모두 풀에서 나오므로 대기 큐(풀 크기 이상)는 넘치지 않음
+    _pending.TryPush([block](ReplayBlock*& cell) { cell = block; });
+}
+
+void CReplayWriter::Release(ReplayBlock* block)
+{
+    _free.TryPush([block](ReplayBlock*& cell) { cell = block; });
+}
+
+void CReplayWriter::WriterThread()
+{
+    while (true)
+    {
+        bool running = false;
+        {
+            std::unique_lock<std::mutex> lock(_threadMutex);
+            _cv.wait_for(lock, REPLAY_FLUSH_INTERVAL, [this] { return !_running; });
+            running = _running;
+        }
+
+        // 밀린 만큼 다 씀 (종료할 때도 넘겨받은 블록은 모두)
+        while (DrainPending())
+        {
+        }
+
+        for (auto& [matchId, file] : _files)
+        {
+            if (file)
+            {
+                std::fflush(file);
+            }
+        }
+
+        if (!running)
+        {
+            CloseAll();
+            return;
+        }
+    }
+}
+
+bool CReplayWriter::DrainPending()
+{
+    bool wrote = false;
+    ReplayBlock* block = nullptr;
+    while (_pending.TryConsume([&block](ReplayBlock* cell) { block = cell; }))
+    {
+        WriteBlock(*block);
+        Release(block);
+        wrote = true;
+    }
+    return wrote;
+}
+
+void CReplayWriter::WriteBlock(const ReplayBlock& block)
+{
+    if (block.flags & ReplayBlock::FIRST)
+    {
+        ReplayFileHeader header;
+        std::memcpy(&header, block.data, sizeof(header));
+
+        std::time_t seconds = static_cast<std::time_t>(header.startTime / 1000);
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+        char name[96];
+        std::snprintf(name, sizeof(name), "match_%s_r%d_%u.mor", stamp, header.roomId, header.matchId);
+        std::string path = (std::filesystem::path(_directory) / name).string();
+
+        FILE* file = nullptr;
+#ifdef _WIN32
+        if (fopen_s(&file, path.c_str(), "wb") != 0)
+        {
+            file = nullptr;
+        }
+#else
+        file = std::fopen(path.c_str(), "wb");
+#endif
+        if (!file)
+        {
+            LOG_ERROR("[ReplayWriter] Cannot open replay file: {}", path);
+            _failedMatches.fetch_add(1, std::memory_order_relaxed);
+        }
+        _files[block.matchId] = file;
+    }
+
+    auto it = _files.find(block.matchId);
+    if (it == _files.end())
+    {
+        return; // 파일을 열기 전에 시작한 경기 (서버 시작 직후 등) 또는 이미 닫힘
+    }
+
+    FILE*& file = it->second;
+    if (file)
+    {
+        if (std::fwrite(block.data, 1, block.size, file) == block.size)
+        {
+            _writtenBytes.fetch_add(block.size, std::memory_order_relaxed);
+        }
+        else
+        {
+            // 남은 블록은 버림 (반쯤 쓴 파일은 리더가 끝까지 읽을 수 있는 레코드만 씀)
+            LOG_ERROR("[ReplayWriter] Write failed - MatchId: {}", block.matchId);
+            _failedMatches.fetch_add(1, std::memory_order_relaxed);
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    if (block.flags & ReplayBlock::LAST)
+    {
+        if (file)
+        {
+            std::fclose(file);
+            _finishedMatches.fetch_add(1, std::memory_order_relaxed);
+        }
+        _files.erase(it);
+    }
+}
+
+void CReplayWriter::CloseAll()
+{
+    for (auto& [matchId, file] : _files)
+    {
+        if (file)
+        {
+            std::fclose(file);
+        }
+    }
+    _files.clear();
+}
+
+// __________________________________________________________________
+//
+// CReplayRecorder
+// __________________________________________________________________
+
+CReplayRecorder::CReplayRecorder(CReplayWriter* writer)
+    : _writer(writer)
+    , _block(nullptr)
+    , _out(nullptr, 0, 0)
+    , _matchId(0)
+    , _playerCount(0)
+    , _lastRecordFrame(0)
+    , _recordBytes(0)
+    , _completeFrames(0)
+    , _checksumFrames(0)
+    , _truncated(false)
+    , _inputs()
+{
+}
+
+CReplayRecorder::~CReplayRecorder()
+{
+    if (_block)
+    {
+        _writer->Release(_block);
+    }
+}
+
+void CReplayRecorder::Begin(int32_t roomId, uint32_t seed, int32_t playerCount)
+{
+    Abort(); // 이전 경기가 끝나지 않은 채로 남아있으면 정리
+
+    if (!_writer)
+    {
+        return;
+    }
+
+    _block = _writer->AcquireBlock();
+    if (!_block)
+    {
+        return;
+    }
+
+    _matchId = _writer->NextMatchId();
+    _playerCount = playerCount;
+    _lastRecordFrame = 0;
+    _recordBytes = 0;
+    _completeFrames = 0;
+    _checksumFrames = 0;
+    _truncated = false;
+    std::fill(std::begin(_inputs), std::end(_inputs), static_cast<uint8_t>(TETRIS_INPUT_NONE));
+
+    ReplayFileHeader header = {};
+    std::memcpy(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_FILE_VERSION;
+    header.playerCount = static_cast<uint8_t>(playerCount);
+    header.matchId = _matchId;
+    header.roomId = roomId;
+    header.seed = seed;
+    header.startTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    _block->matchId = _matchId;
+    _block->flags = ReplayBlock::FIRST;
+    _out = CMsgWriter(_block->data, REPLAY_BLOCK_SIZE - sizeof(ReplayFileTrailer), 0);
+    _out.WriteBytes(&header, sizeof(header));
+}
+
+bool CReplayRecorder::BeginRecord(uint32_t frame, uint8_t code)
+{
+    if (!_block || _truncated)
+    {
+        return false;
+    }
+
+    size_t before = _out.GetSize();
+    if (REPLAY_BLOCK_SIZE - sizeof(ReplayFileTrailer) - before < REPLAY_RECORD_MAX_SIZE)
+    {
+        // 다음 블록을 못 받으면 지금 블록을 들고 있다가 트레일러만 붙임 (방 액터는 기다리지 않음)
+        ReplayBlock* next = _writer->AcquireBlock();
+        if (!next)
+        {
+            _truncated = true;
+            return false;
+        }
+
+        _block->size = static_cast<uint16_t>(before);
+        _writer->Submit(_block);
+
+        _block = next;
+        _block->matchId = _matchId;
+        _block->flags = 0;
+        _out = CMsgWriter(_block->data, REPLAY_BLOCK_SIZE - sizeof(ReplayFileTrailer), 0);
+        before = 0;
+    }
+
+    _out.WriteVarUInt(((frame - _lastRecordFrame) << REPLAY_CODE_BITS) | code);
+    _lastRecordFrame = frame;
+    _recordBytes += static_cast<uint32_t>(_out.GetSize() - before); // 본문은 각자 더함
+    return true;
+}
+
+void CReplayRecorder::OnTargetMode(uint32_t frame, int32_t slot, GarbageTargetMode mode)
+{
+    if (BeginRecord(frame, REPLAY_CODE_TARGET))
+    {
+        _out.WriteUInt8(static_cast<uint8_t>(slot));
+        _out.WriteUInt8(static_cast<uint8_t>(mode));
+        _recordBytes += 2;
+    }
+}
+
+void CReplayRecorder::OnFrames(const LockstepFrameBatch& batch, const CTetrisBoardBatch& boards)
+{
+    if (!_block || _truncated)
+    {
+        return;
+    }
+
+    size_t garbage = 0;
+    for (size_t offset = 0; offset < batch.frameCount; ++offset)
+    {
+        uint32_t frame = batch.firstFrame + static_cast<uint32_t>(offset);
+        const uint8_t* inputs = &batch.inputs[offset * _playerCount];
+
+        // 입력은 바뀐 슬롯만 (누르고 있는 동안은 같은 값)
+        for (int32_t slot = 0; slot < _playerCount; ++slot)
+        {
+            if (inputs[slot] == _inputs[slot])
+            {
+                continue;
+            }
+            if (!BeginRecord(frame, static_cast<uint8_t>(slot)))
+            {
+                return;
+            }
+            _out.WriteUInt8(inputs[slot]);
+            _inputs[slot] = inputs[slot];
+            _recordBytes += 1;
+        }
+
+        for (; garbage < batch.garbageCount && batch.garbage[garbage].frameOffset == offset; ++garbage)
+        {
+            if (!BeginRecord(frame, REPLAY_CODE_GARBAGE))
+            {
+                return;
+            }
+            _out.WriteUInt8(batch.garbage[garbage].slot);
+            _out.WriteUInt8(batch.garbage[garbage].linesAndHole);
+            _recordBytes += 2;
+        }
+
+        _completeFrames = frame + 1;
+    }
+
+    // 서버 보드는 묶음 끝 상태만 볼 수 있으므로 체크섬은 간격을 넘긴 묶음의 마지막 프레임에
+    if (_completeFrames >= _checksumFrames + REPLAY_CHECKSUM_INTERVAL)
+    {
+        WriteChecksum(_completeFrames - 1, boards);
+    }
+}
+
+void CReplayRecorder::WriteChecksum(uint32_t frame, const CTetrisBoardBatch& boards)
+{
+    if (!BeginRecord(frame, REPLAY_CODE_CHECKSUM))
+    {
+        return;
+    }
+
+    uint32_t hash = REPLAY_CHECKSUM_SEED;
+    for (int32_t slot = 0; slot < _playerCount; ++slot)
+    {
+        hash = UpdateReplayChecksum(hash, boards.GetEngine(static_cast<size_t>(slot)));
+    }
+    _out.WriteBytes(&hash, sizeof(hash));
+    _recordBytes += sizeof(hash);
+    _checksumFrames = frame + 1;
+}
+
+void CReplayRecorder::End(uint32_t frameCount, int32_t winner, const CTetrisBoardBatch& boards)
+{
+    if (!_block)
+    {
+        return;
+    }
+
+    if (frameCount > 0 && _completeFrames == frameCount && _checksumFrames != frameCount)
+    {
+        WriteChecksum(frameCount - 1, boards);
+    }
+    Finish(frameCount, winner, 0);
+}
+
+void CReplayRecorder::Abort()
+{
+    if (_block)
+    {
+        Finish(_completeFrames, -1, REPLAY_TRAILER_ABORTED);
+    }
+}
+
+void CReplayRecorder::Finish(uint32_t frameCount, int32_t winner, uint8_t flags)
+{
+    ReplayFileTrailer trailer = {};
+    trailer.recordBytes = _recordBytes;
+    trailer.frameCount = _truncated ? _completeFrames : frameCount;
+    trailer.winnerSlot = (winner >= 0) ? static_cast<uint8_t>(winner) : LOCKSTEP_SLOT_NONE;
+    trailer.flags = static_cast<uint8_t>(flags | (_truncated ? REPLAY_TRAILER_TRUNCATED : 0));
+    std::memcpy(trailer.magic, REPLAY_TRAILER_MAGIC, sizeof(trailer.magic));
+
+    // 트레일러 자리는 항상 남겨둠 (_out의 용량 밖)
+    size_t size = _out.GetSize();
+    std::memcpy(_block->data + size, &trailer, sizeof(trailer));
+    _block->size = static_cast<uint16_t>(size + sizeof(trailer));
+    _block->flags |= ReplayBlock::LAST;
+    _writer->Submit(_block);
+
+    if (_truncated)
+    {
+        LOG_WARNING("[ReplayRecorder] Replay truncated (no free block) - MatchId: {}, Frames: {}/{}",
+            _matchId, _completeFrames, frameCount);
+    }
+    _block = nullptr;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "BoundedMailbox.h"
+#include "LockstepRelay.h"
+#include "ReplayFormat.h"
+
+// 리플레이 블록 하나의 크기. 보통 경기(입력이 바뀔 때만 기록)는 블록 한두 개로 끝남
+constexpr size_t REPLAY_BLOCK_SIZE = 2048;
+static_assert(REPLAY_BLOCK_SIZE >= sizeof(ReplayFileHeader) + REPLAY_RECORD_MAX_SIZE + sizeof(ReplayFileTrailer), "replay block must fit header + record + trailer");
+
+// 기록 스레드가 쌓인 블록을 파일에 쓰는 주기 (방 액터는 블록을 넘기기만 하고 깨우지 않음)
+constexpr auto REPLAY_FLUSH_INTERVAL = std::chrono::milliseconds(100);
+
+// 방 액터 -> 기록 스레드로 넘기는 파일 조각 (경기 하나의 바이트를 순서대로 자른 것)
+struct ReplayBlock
+{
+    enum Flags : uint8_t
+    {
+        FIRST = 1 << 0, // 파일 열기 (data 앞이 ReplayFileHeader)
+        LAST  = 1 << 1  // 쓰고 파일 닫기 (data 끝이 ReplayFileTrailer)
+    };
+
+    uint32_t matchId;
+    uint8_t flags;
+    uint16_t size;
+    char data[REPLAY_BLOCK_SIZE];
+};
+
+// __________________________________________________________________
+//
+// 리플레이 기록 스레드 (서버에 하나)
+// 블록 풀을 가지고, 방 액터가 채운 블록을 경기별 파일에 이어 씀 -> 방 액터는 파일 I/O를 기다리지 않음
+//  - 블록 풀 / 대기 큐 모두 고정 크기 메일박스 (게임 중 할당 없음)
+//  - 빈 블록이 없으면 방 쪽은 기다리지 않고 그 경기를 잘라서 끝냄 (REPLAY_TRAILER_TRUNCATED)
+//  - 파일: <directory>/match_<시작 시각>_r<roomId>_<matchId>.mor (FIRST 블록의 헤더로 만듦)
+// 종료(Stop) 시 넘겨받은 블록까지 쓰고 열린 파일을 닫음. 그때 진행 중이던 경기는 트레일러 없이 남음
+// __________________________________________________________________
+
+class CReplayWriter
+{
+public:
+    // blockCount: 블록 풀 크기 (방마다 하나씩 들고 있으므로 방 수보다 여유 있게)
+    CReplayWriter(std::string directory, size_t blockCount);
+    ~CReplayWriter();
+
+    CReplayWriter(const CReplayWriter&) = delete;
+    CReplayWriter& operator=(const CReplayWriter&) = delete;
+
+    // 디렉터리를 만들고 기록 스레드 시작 (실패하면 false, 기록은 꺼진 채로 동작)
+    bool Start();
+    void Stop();
+
+    const std::string& GetDirectory() const { return _directory; }
+
+    // 아무 스레드 ////////////////////////////////////////////////////////////////
+    uint32_t NextMatchId() { return _nextMatchId.fetch_add(1, std::memory_order_relaxed); }
+
+    // 빈 블록 (없으면 nullptr). 기록 스레드가 돌지 않으면 항상 nullptr
+    ReplayBlock* AcquireBlock();
+
+    // 채운 블록을 넘김 (이후 기록 스레드 소유) / 쓰지 않은 블록을 돌려줌
+    void Submit(ReplayBlock* block);
+    void Release(ReplayBlock* block);
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 통계
+    uint64_t GetWrittenBytes() const { return _writtenBytes.load(std::memory_order_relaxed); }
+    uint64_t GetFinishedMatches() const { return _finishedMatches.load(std::memory_order_relaxed); }
+    uint64_t GetFailedMatches() const { return _failedMatches.load(std::memory_order_relaxed); }
+    size_t GetFreeBlockCount() const { return _free.GetCapacity() - _free.GetFreeCount(); } // 풀에 남은 빈 블록
+
+private:
+    void WriterThread();
+    bool DrainPending(); // 하나라도 썼으면 true
+    void WriteBlock(const ReplayBlock& block);
+    void CloseAll();
+
+    std::string _directory;
+    std::unique_ptr<ReplayBlock[]> _blocks;
+    size_t _blockCount;
+    CBoundedMailbox<ReplayBlock*> _free;
+    CBoundedMailbox<ReplayBlock*> _pending; // 풀 크기 이상 -> 넘기기는 실패하지 않음
+
+    std::atomic<uint32_t> _nextMatchId;
+    std::atomic<bool> _accepting; // 기록 스레드가 도는 동안만 블록을 내줌
+
+    std::mutex _threadMutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+    bool _running; // _threadMutex
+
+    std::unordered_map<uint32_t, FILE*> _files; // 기록 스레드 전용 (matchId -> 파일, 쓰기 실패하면 nullptr)
+
+    std::atomic<uint64_t> _writtenBytes;
+    std::atomic<uint64_t> _finishedMatches;
+    std::atomic<uint64_t> _failedMatches;
+};
+
+// __________________________________________________________________
+//
+// 방 하나의 리플레이 기록 (방 액터 전용)
+// 확정 프레임을 받을 때마다 바뀐 입력 / 방해 줄 / 주기적인 보드 체크섬을 레코드로 블록에 붙이고,
+// 블록이 차면 기록 스레드로 넘김. 블록에는 항상 트레일러 자리를 남겨둠
+// writer가 nullptr이면 아무것도 하지 않음
+// __________________________________________________________________
+
+class CReplayRecorder
+{
+public:
+    explicit CReplayRecorder(CReplayWriter* writer);
+    ~CReplayRecorder();
+
+    CReplayRecorder(const CReplayRecorder&) = delete;
+    CReplayRecorder& operator=(const CReplayRecorder&) = delete;
+
+    bool IsRecording() const { return _block != nullptr; }
+
+    // 게임 시작 (빈 블록이 없으면 이 경기는 기록하지 않음)
+    void Begin(int32_t roomId, uint32_t seed, int32_t playerCount);
+
+    // 공격 대상 방식 변경. frame = 아직 확정하지 않은 첫 프레임 (그 프레임의 공격부터 적용)
+    void OnTargetMode(uint32_t frame, int32_t slot, GarbageTargetMode mode);
+
+    // PopConfirmed 한 번 분량. boards = 그 묶음의 마지막 프레임까지 진행한 서버 보드
+    void OnFrames(const LockstepFrameBatch& batch, const CTetrisBoardBatch& boards);
+
+    // 게임 종료 (마지막 체크섬 + 트레일러) / 게임 중 방이 닫힘
+    void End(uint32_t frameCount, int32_t winner, const CTetrisBoardBatch& boards);
+    void Abort();
+
+    uint32_t GetMatchId() const { return _matchId; }
+
+private:
+    // 레코드 하나가 들어갈 자리를 만들고 머리를 씀 (블록을 바꿀 수 없으면 잘린 경기로 표시하고 false)
+    bool BeginRecord(uint32_t frame, uint8_t code);
+    void WriteChecksum(uint32_t frame, const CTetrisBoardBatch& boards);
+    void Finish(uint32_t frameCount, int32_t winner, uint8_t flags);
+
+    CReplayWriter* _writer;
+    ReplayBlock* _block; // 쓰는 중인 블록 (기록 중일 때만)
+    CMsgWriter _out;     // _block에 이어 쓰기 (트레일러 자리는 빼고)
+
+    uint32_t _matchId;
+    int32_t _playerCount;
+    uint32_t _lastRecordFrame;
+    uint32_t _recordBytes;
+    uint32_t _completeFrames; // 레코드를 빠짐없이 쓴 프레임 수
+    uint32_t _checksumFrames; // 마지막 체크섬을 쓴 프레임 + 1
+    bool _truncated;
+    uint8_t _inputs[ROOM_MAX_PLAYERS]; // 슬롯별 마지막으로 기록한 입력
+};
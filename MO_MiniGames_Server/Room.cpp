@@ -1,25 +1,36 @@
 #include "Room.h"
-#include "Player.h"
 #include <algorithm>
+#include <cstring>
 
-CRoom::CRoom(int32_t roomId, const std::string& title, int32_t maxPlayers)
+CRoom::CRoom(int32_t roomId, std::string_view title, int32_t maxPlayers)
     : _roomId(roomId)
-    , _title(title)
+    , _handle()
+    , _title()
+    , _titleLength(static_cast<uint8_t>((std::min)(title.size(), ROOM_TITLE_MAX_LEN)))
     , _currentPlayers(0)
-    , _maxPlayers(maxPlayers)
+    , _maxPlayers((std::max)(1, (std::min)(maxPlayers, ROOM_MAX_PLAYERS)))
     , _status(RoomStatus::WAITING)
-    , _owner(nullptr)
+    , _owner()
+    , _players()
+    , _recentPrev(nullptr)
+    , _recentNext(nullptr)
+    , _listIndex(0)
+    , _quickPrev(nullptr)
+    , _quickNext(nullptr)
+    , _quickMaxPlayers(0)
+    , _quickFreeSlots(0)
 {
-    _players.reserve(maxPlayers);
+    std::memcpy(_title, title.data(), _titleLength);
+    _title[_titleLength] = '\0';
 }
 
 CRoom::~CRoom()
 {
 }
 
-bool CRoom::AddPlayer(std::shared_ptr<CPlayer> player)
+bool CRoom::AddPlayer(PlayerHandle player)
 {
-    if (!player)
+    if (player.IsNull())
     {
         return false;
     }
@@ -29,17 +40,16 @@ bool CRoom::AddPlayer(std::shared_ptr<CPlayer> player)
         return false;
     }
 
-    // ߺ üũ
+    // 중복 체크
     if (IsPlayerInRoom(player))
     {
         return false;
     }
 
-    _players.push_back(player);
-    _currentPlayers = static_cast<int32_t>(_players.size());
+    _players[_currentPlayers++] = player;
 
-    // 濡 ù  ÷̾  
-    if (_owner == nullptr)
+    // 방에 첫 입장한 플레이어를 방장으로 지정
+    if (_owner.IsNull())
     {
         _owner = player;
     }
@@ -47,53 +57,79 @@ bool CRoom::AddPlayer(std::shared_ptr<CPlayer> player)
     return true;
 }
 
-bool CRoom::RemovePlayer(std::shared_ptr<CPlayer> player)
+bool CRoom::RemovePlayer(PlayerHandle player)
 {
-    if (!player)
+    if (player.IsNull())
     {
         return false;
     }
 
-    auto it = std::find(_players.begin(), _players.end(), player);
-    if (it == _players.end())
+    PlayerHandle* end = _players + _currentPlayers;
+    PlayerHandle* it = std::find(_players, end, player);
+    if (it == end)
     {
         return false;
     }
 
-    //      ó
+    // 방장이 나가는 경우 방장 변경 처리
     UpdateOwnerOnLeave(player);
 
-    _players.erase(it);
-    _currentPlayers = static_cast<int32_t>(_players.size());
+    // 입장 순서 유지 (다음 방장 = 가장 먼저 들어온 플레이어)
+    std::copy(it + 1, end, it);
+    _players[--_currentPlayers] = PlayerHandle();
     return true;
 }
 
-void CRoom::UpdateOwnerOnLeave(std::shared_ptr<CPlayer> leavingPlayer)
+bool CRoom::AddSeat()
 {
-    //   
+    if (IsFull())
+    {
+        return false;
+    }
+
+    // 빈 핸들로 채워서 GetPlayers / IsPlayerInRoom이 항상 "없음"으로 보이게 함
+    _players[_currentPlayers++] = PlayerHandle();
+    return true;
+}
+
+bool CRoom::RemoveSeat()
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    --_currentPlayers;
+    return true;
+}
+
+void CRoom::UpdateOwnerOnLeave(PlayerHandle leavingPlayer)
+{
+    // 방장이 나가는 경우
     if (_owner == leavingPlayer)
     {
-        //  ÷̾ ϰ  ÷̾ ã
-        for (auto& player : _players)
+        // 나가는 플레이어를 제외하고 다음 플레이어를 찾음
+        for (int32_t i = 0; i < _currentPlayers; ++i)
         {
-            if (player != leavingPlayer)
+            if (_players[i] != leavingPlayer)
             {
-                _owner = player;
+                _owner = _players[i];
                 return;
             }
         }
         
-        // 濡 ƹ  nullptr
-        _owner = nullptr;
+        // 방에 아무도 없으면 null 핸들
+        _owner = PlayerHandle();
     }
 }
 
-bool CRoom::IsPlayerInRoom(std::shared_ptr<CPlayer> player) const
+bool CRoom::IsPlayerInRoom(PlayerHandle player) const
 {
-    if (!player)
+    if (player.IsNull())
     {
         return false;
     }
 
-    return std::find(_players.begin(), _players.end(), player) != _players.end();
+    const PlayerHandle* end = _players + _currentPlayers;
+    return std::find(_players, end, player) != end;
 }
\ No newline at end of file
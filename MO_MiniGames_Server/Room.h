@@ -1,61 +1,85 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 #include <atomic>
-#include <vector>
 #include <memory>
 #include <cstdint>
 
-//  
-class CPlayer;
+#include "HandleTable.h"
+#include "Protocol.h"
 
-//  
+// 방 상태
 enum class RoomStatus
 {
-    WAITING,  //  
-    PLAYING   //  
+    WAITING,  // 대기 중
+    PLAYING   // 게임 중
 };
 
-//  Ŭ
+// 방 클래스
+// 제목과 플레이어 목록을 객체 안에 고정 크기로 저장 (풀 슬롯 하나에 방 전체가 들어가고 별도 힙 할당 없음)
 class CRoom
 {
 public:
-    explicit CRoom(int32_t roomId, const std::string& title, int32_t maxPlayers = 10);
+    // title은 ROOM_TITLE_MAX_LEN, maxPlayers는 [1, ROOM_MAX_PLAYERS]로 잘림
+    explicit CRoom(int32_t roomId, std::string_view title, int32_t maxPlayers = ROOM_MAX_PLAYERS);
     ~CRoom();
 
     // Getter
     int32_t GetRoomId() const { return _roomId; }
-    std::string GetTitle() const { return _title; }
+    RoomHandle GetHandle() const { return _handle; }
+    std::string_view GetTitle() const { return std::string_view(_title, _titleLength); }
     int32_t GetCurrentPlayerCount() const { return _currentPlayers; }
     int32_t GetMaxPlayers() const { return _maxPlayers; }
     RoomStatus GetStatus() const { return _status; }
     
-    //  
-    std::shared_ptr<CPlayer> GetOwner() const { return _owner; }
+    // 방장 관련
+    PlayerHandle GetOwner() const { return _owner; }
 
-    // ÷̾  (CPlayer )
-    bool AddPlayer(std::shared_ptr<CPlayer> player);
-    bool RemovePlayer(std::shared_ptr<CPlayer> player);
-    bool IsPlayerInRoom(std::shared_ptr<CPlayer> player) const;
-    const std::vector<std::shared_ptr<CPlayer>>& GetPlayers() const { return _players; }
+    // 플레이어 관리 (핸들 기반, 비교는 정수 2개)
+    bool AddPlayer(PlayerHandle player);
+    bool RemovePlayer(PlayerHandle player);
+    bool IsPlayerInRoom(PlayerHandle player) const;
+    const PlayerHandle* GetPlayers() const { return _players; } // GetCurrentPlayerCount()개
 
-    //  
+    // 디렉터리 전용 좌석 (플레이어 핸들 없이 인원만, 방장 없음). 방 안 상태를 다른 곳(방 액터)이 가질 때
+    // 한 방에서 AddPlayer와 섞어 쓰지 않음
+    bool AddSeat();
+    bool RemoveSeat();
+
+    // 상태 관리
     void SetStatus(RoomStatus status) { _status = status; }
     
-    //   á Ȯ
+    // 방이 가득 찼는지 확인
     bool IsFull() const { return _currentPlayers >= _maxPlayers; }
     bool IsEmpty() const { return _currentPlayers == 0; }
 
 private:
-    void UpdateOwnerOnLeave(std::shared_ptr<CPlayer> leavingPlayer);
+    // 핸들과 최근 생성 순 리스트 링크는 CRoomManager만, 빠른 입장 버킷 링크는 CQuickJoinIndex만 조작
+    friend class CRoomManager;
+    friend class CQuickJoinIndex;
+
+    void UpdateOwnerOnLeave(PlayerHandle leavingPlayer);
 
     int32_t _roomId;
-    std::string _title;
+    RoomHandle _handle; // CRoomManager 테이블 핸들 (생성 직후 설정)
+    char _title[ROOM_TITLE_MAX_LEN + 1];
+    uint8_t _titleLength;
     int32_t _currentPlayers;
     int32_t _maxPlayers;
     RoomStatus _status;
-    std::shared_ptr<CPlayer> _owner; // 
+    PlayerHandle _owner; // 방장
+
+    PlayerHandle _players[ROOM_MAX_PLAYERS]; // 방에 있는 플레이어 핸들 목록 (앞에서부터 _currentPlayers개)
+    // 최대 10명이라 선형 탐색이 가장 빠름
+
+    // CRoomManager의 최근 생성 순 리스트 (intrusive, 노드 별도 할당 없이 O(1) 삽입/삭제)
+    CRoom* _recentPrev;
+    CRoom* _recentNext;
+    uint32_t _listIndex; // 마지막으로 채운 목록 스냅샷에서의 rooms 첨자 (FillSnapshot이 titleOrder를 만들 때 사용)
 
-    std::vector<std::shared_ptr<CPlayer>> _players; // 濡 ִ ÷̾ ü 
-    // ڼ 1~200 ϶  κ vector 
+    // CQuickJoinIndex 버킷 리스트 링크와 현재 버킷 위치 (_quickFreeSlots == 0: 인덱스에 없음)
+    CRoom* _quickPrev;
+    CRoom* _quickNext;
+    int8_t _quickMaxPlayers;
+    int8_t _quickFreeSlots;
 };
\ No newline at end of file
@@ -0,0 +1,583 @@
+#include "RoomActor.h"
+#include "AsyncLogger.h"
+#include "IOCPServer.h"
+#include "LobbyHandler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+CRoomActor::CRoomActor(CActorWorkerPool& pool, uint32_t slot, CIOCPServer& network, CChangedSlotList& statusChanges,
+    uint32_t spectatorDelayFrames, CReplayWriter* replayWriter)
+    : CActor(pool)
+    , _slot(slot)
+    , _network(network)
+    , _control(ROOM_CONTROL_MAILBOX_CAPACITY)
+    , _game(ROOM_GAME_MAILBOX_CAPACITY)
+    , _room()
+    , _tag(0)
+    , _members(ROOM_MAX_PLAYERS)
+    , _lockstep()
+    , _gameSlots()
+    , _spectators(spectatorDelayFrames)
+    , _replay(replayWriter)
+    , _spectatorDraining(false)
+    , _spectatorTick(false)
+    , _publishedStatus(0)
+    , _statusChanged(false)
+    , _statusChanges(statusChanges)
+{
+}
+
+CRoomActor::~CRoomActor()
+{
+}
+
+int32_t CRoomActor::MakeAddress(RoomHandle handle)
+{
+    uint32_t address = ((handle.generation & 0xFFFF) << 16) | (handle.index & 0xFFFF);
+    return static_cast<int32_t>(address);
+}
+
+bool CRoomActor::HasRoomForJoin(int32_t postCount, int32_t membersAfterJoin) const
+{
+    size_t required = static_cast<size_t>(postCount) + static_cast<size_t>(membersAfterJoin) + 1; // +1: 닫기
+    return _control.GetFreeCount() >= required;
+}
+
+bool CRoomActor::PostOpen(const CRoom& room)
+{
+    return PostControl(RoomControlMessage::Type::OPEN, -1, &room);
+}
+
+bool CRoomActor::PostJoin(int64_t sessionId)
+{
+    return PostControl(RoomControlMessage::Type::JOIN, sessionId);
+}
+
+bool CRoomActor::PostLeave(int64_t sessionId)
+{
+    return PostControl(RoomControlMessage::Type::LEAVE, sessionId);
+}
+
+bool CRoomActor::PostClose()
+{
+    return PostControl(RoomControlMessage::Type::CLOSE, -1);
+}
+
+bool CRoomActor::PostControl(RoomControlMessage::Type type, int64_t sessionId, const CRoom* room)
+{
+    bool pushed = _control.TryPush([&](RoomControlMessage& msg)
+    {
+        msg.type = type;
+        msg.sessionId = sessionId;
+        if (room)
+        {
+            std::string_view title = room->GetTitle();
+            msg.tag = static_cast<uint16_t>(room->GetHandle().generation);
+            msg.roomId = room->GetRoomId();
+            msg.maxPlayers = room->GetMaxPlayers();
+            msg.titleLength = static_cast<uint8_t>(title.size());
+            std::memcpy(msg.title, title.data(), title.size());
+        }
+    });
+
+    if (!pushed)
+    {
+        // 로비가 HasRoomForJoin으로 자리를 확인하므로 정상적으로는 오지 않는 경로
+        LOG_ERROR("[RoomActor] Control mailbox full - Slot: {}, Type: {}", _slot, static_cast<int>(type));
+        return false;
+    }
+
+    Notify();
+    return true;
+}
+
+bool CRoomActor::PostGame(int64_t sessionId, uint16_t tag, const char* data, size_t length)
+{
+    if (length > ROOM_GAME_MSG_MAX_SIZE)
+    {
+        return false;
+    }
+
+    bool pushed = _game.TryPush([&](RoomGameMessage& msg)
+    {
+        msg.sessionId = sessionId;
+        msg.tag = tag;
+        msg.length = static_cast<uint16_t>(length);
+        std::memcpy(msg.data, data, length);
+    });
+
+    if (pushed)
+    {
+        Notify();
+    }
+    return pushed;
+}
+
+bool CRoomActor::TakeStatusChange(int32_t& outRoomId, RoomStatus& outStatus)
+{
+    // 대부분의 틱에는 바뀐 방이 없으므로 읽기만 먼저
+    if (!_statusChanged.load(std::memory_order_relaxed) || !_statusChanged.exchange(false, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    uint64_t packed = _publishedStatus.load(std::memory_order_acquire);
+    outRoomId = static_cast<int32_t>(packed >> 32);
+    outStatus = static_cast<RoomStatus>(static_cast<uint32_t>(packed));
+    return true;
+}
+
+void CRoomActor::PostSpectatorTick()
+{
+    if (!_spectatorTick.exchange(true))
+    {
+        Notify();
+    }
+}
+
+void CRoomActor::ProcessMessages(size_t budget)
+{
+    // 좌석 변경을 먼저 반영해야 그 뒤에 들어온 새 멤버의 게임 메시지를 알아봄
+    DrainControl();
+
+    for (size_t i = 0; i < budget; ++i)
+    {
+        if (!_game.TryConsume([this](const RoomGameMessage& msg) { HandleGame(msg); }))
+        {
+            break;
+        }
+    }
+
+    if (_spectatorTick.exchange(false))
+    {
+        _spectators.Drain(std::chrono::steady_clock::now());
+    }
+    _spectatorDraining.store(_spectators.IsDraining(), std::memory_order_relaxed);
+}
+
+bool CRoomActor::HasPendingMessages() const
+{
+    return _control.HasPending() || _game.HasPending() || _spectatorTick.load();
+}
+
+void CRoomActor::DrainControl()
+{
+    // 제어 메시지는 용량이 작고 모두 짧은 처리라 예산 없이 전부
+    while (_control.TryConsume([this](const RoomControlMessage& msg) { HandleControl(msg); }))
+    {
+    }
+}
+
+void CRoomActor::HandleControl(const RoomControlMessage& msg)
+{
+    switch (msg.type)
+    {
+    case RoomControlMessage::Type::OPEN:
+        // 이전 방의 CLOSE가 먼저 처리되므로 보통 비어있음
+        _lockstep.Stop();
+        _spectators.Stop();
+        _replay.Abort();
+        RemoveAllMembers();
+        _room.emplace(msg.roomId, std::string_view(msg.title, msg.titleLength), msg.maxPlayers);
+        _tag = msg.tag;
+        break;
+
+    case RoomControlMessage::Type::JOIN:
+    {
+        if (!_room)
+        {
+            break;
+        }
+
+        PlayerHandle handle = _members.Create(msg.sessionId);
+        CPlayer* player = _members.Get(handle);
+        if (!player)
+        {
+            LOG_ERROR("[RoomActor] Member table full - RoomId: {}", _room->GetRoomId());
+            break;
+        }
+
+        player->SetHandle(handle);
+        if (!_room->AddPlayer(handle))
+        {
+            // 로비가 좌석을 확인한 뒤 보내므로 정상적으로는 오지 않는 경로
+            LOG_ERROR("[RoomActor] Join rejected - RoomId: {}, SessionId: {}", _room->GetRoomId(), msg.sessionId);
+            _members.Release(handle);
+        }
+        break;
+    }
+
+    case RoomControlMessage::Type::LEAVE:
+        if (CPlayer* player = FindMember(msg.sessionId))
+        {
+            int32_t slot = FindGameSlot(player->GetHandle());
+            RemoveMember(*player);
+            if (slot >= 0)
+            {
+                ResignGameSlot(slot);
+            }
+        }
+        break;
+
+    case RoomControlMessage::Type::CLOSE:
+        // 마지막 인원이 나간 방 (로비가 이미 디렉터리에서 지웠으므로 상태는 알리지 않음)
+        _lockstep.Stop();
+        _spectators.Stop();
+        _replay.Abort();
+        RemoveAllMembers();
+        _room.reset();
+        break;
+    }
+}
+
+void CRoomActor::HandleGame(const RoomGameMessage& msg)
+{
+    if (!_room || msg.tag != _tag)
+    {
+        return; // 이미 닫혔거나 슬롯이 재사용된 뒤 도착한 이전 방의 메시지
+    }
+
+    CPlayer* player = FindMember(msg.sessionId);
+    if (!player)
+    {
+        // 입장 직후 보낸 메시지가 JOIN보다 먼저 보일 수 있음 (제어 메일박스를 다 비운 뒤 JOIN이 들어온 경우)
+        DrainControl();
+
+        // 비우는 사이 CLOSE 후 재사용 슬롯의 OPEN까지 처리됐으면 이 메시지는 이전 방 것
+        if (!_room || msg.tag != _tag)
+        {
+            return;
+        }
+
+        player = FindMember(msg.sessionId);
+        if (!player)
+        {
+            return; // 이미 퇴장한 세션
+        }
+    }
+
+    // 크기 검증은 IOCP 워커가 라우팅할 때 끝남 (player, _room 모두 이 워커 전용)
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(msg.data);
+
+    switch (header->type)
+    {
+    case MsgType::C2S_GAME_START:
+        if (msg.length >= sizeof(MSG_C2S_GAME_START))
+        {
+            HandleGameStart(*player, reinterpret_cast<const MSG_C2S_GAME_START*>(msg.data));
+        }
+        break;
+
+    case MsgType::C2S_GAME_INPUT:
+    {
+        // inputs는 메일박스 셀을 가리킴 (핸들러 안에서 복사)
+        CMsgReader reader(msg.data, msg.length, sizeof(MsgHeader));
+        MSG_C2S_GAME_INPUT inputMsg;
+        if (inputMsg.Decode(reader))
+        {
+            HandleGameInput(*player, inputMsg);
+        }
+        break;
+    }
+
+    case MsgType::C2S_GAME_TARGET:
+        if (msg.length >= sizeof(MSG_C2S_GAME_TARGET))
+        {
+            HandleGameTarget(*player, reinterpret_cast<const MSG_C2S_GAME_TARGET*>(msg.data));
+        }
+        break;
+
+    default:
+        LOG_WARNING("[RoomActor] Unknown room msg type: {} - RoomId: {}, SessionId: {}",
+            static_cast<int>(header->type), _room->GetRoomId(), player->GetSessionId());
+        break;
+    }
+}
+
+// __________________________________________________________________
+//
+// 락스텝 게임
+// __________________________________________________________________
+
+void CRoomActor::HandleGameStart(CPlayer& player, const MSG_C2S_GAME_START* msg)
+{
+    int64_t sessionId = player.GetSessionId();
+    int32_t playerCount = _room->GetCurrentPlayerCount();
+
+    if (_lockstep.IsRunning())
+    {
+        SendError(_network, sessionId, msg->requestId, ErrorCode::GAME_IN_PROGRESS, { _room->GetRoomId() });
+        return;
+    }
+
+    if (_room->GetOwner() != player.GetHandle())
+    {
+        SendError(_network, sessionId, msg->requestId, ErrorCode::NOT_ROOM_OWNER);
+        return;
+    }
+
+    if (playerCount < ROOM_MIN_PLAYERS)
+    {
+        SendError(_network, sessionId, msg->requestId, ErrorCode::NOT_ENOUGH_PLAYERS, { playerCount, ROOM_MIN_PLAYERS });
+        return;
+    }
+
+    // 슬롯 순서 = 입장 순서. seed는 방마다 다르면 충분 (공정성은 모든 보드가 같은 seed라는 데서 옴)
+    uint32_t seed = static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+        ^ (static_cast<uint32_t>(_room->GetRoomId()) * 2654435761u);
+    const PlayerHandle* players = _room->GetPlayers();
+    for (int32_t slot = 0; slot < ROOM_MAX_PLAYERS; ++slot)
+    {
+        _gameSlots[slot] = (slot < playerCount) ? players[slot] : PlayerHandle();
+    }
+
+    _lockstep.Start(seed, playerCount);
+    _spectators.StartGame(_room->GetRoomId(), playerCount);
+    _replay.Begin(_room->GetRoomId(), seed, playerCount);
+    SetStatus(RoomStatus::PLAYING);
+
+    for (int32_t slot = 0; slot < playerCount; ++slot)
+    {
+        if (const CPlayer* member = _members.Get(_gameSlots[slot]))
+        {
+            uint32_t requestId = (member == &player) ? msg->requestId : REQUEST_ID_NONE;
+            SendGameStarted(member->GetSessionId(), requestId, slot);
+        }
+    }
+
+    LOG_INFO("[RoomActor] Game started - RoomId: {}, Players: {}, Seed: {}", _room->GetRoomId(), playerCount, seed);
+}
+
+void CRoomActor::HandleGameInput(CPlayer& player, const MSG_C2S_GAME_INPUT& msg)
+{
+    // 게임 밖(시작 뒤 입장)이거나 이미 끝난 게임의 늦은 입력
+    int32_t slot = FindGameSlot(player.GetHandle());
+    if (slot < 0)
+    {
+        return;
+    }
+
+    LockstepInputResult result = _lockstep.SubmitInputs(slot, msg.firstFrame, msg.inputs, msg.count);
+    switch (result)
+    {
+    case LockstepInputResult::ACCEPTED:
+        FlushConfirmedFrames();
+        break;
+
+    case LockstepInputResult::STALE:
+        break;
+
+    case LockstepInputResult::GAP:
+    case LockstepInputResult::TOO_FAR:
+        LOG_WARNING("[RoomActor] Input rejected ({}) - RoomId: {}, SessionId: {}, Frame: {}, Confirmed: {}",
+            result == LockstepInputResult::GAP ? "gap" : "too far", _room->GetRoomId(), player.GetSessionId(),
+            msg.firstFrame, _lockstep.GetConfirmedFrameCount());
+        break;
+    }
+}
+
+void CRoomActor::HandleGameTarget(CPlayer& player, const MSG_C2S_GAME_TARGET* msg)
+{
+    // 대상 규칙은 서버만 씀 (클라는 결과 방해 줄만 받음). 잘못된 값은 무시
+    int32_t slot = FindGameSlot(player.GetHandle());
+    if (slot >= 0 && msg->mode < static_cast<uint8_t>(GarbageTargetMode::COUNT))
+    {
+        _lockstep.SetTargetMode(slot, static_cast<GarbageTargetMode>(msg->mode));
+        _replay.OnTargetMode(_lockstep.GetConfirmedFrameCount(), slot, static_cast<GarbageTargetMode>(msg->mode));
+    }
+}
+
+void CRoomActor::FlushConfirmedFrames()
+{
+    // 한 번 인코딩해서 참가자 전원에게 같은 바이트를 보냄 (확정 프레임 한 번당 인원 수만큼의 바이트)
+    // 그 사이에 처리한 공격의 방해 줄도 같은 메시지에 실림 -> 받는 사람당 메시지 하나
+    LockstepFrameBatch batch;
+    char buffer[GAME_FRAMES_MSG_MAX_SIZE];
+
+    MSG_S2C_GAME_FRAMES msg;
+    msg.playerCount = static_cast<uint8_t>(_lockstep.GetPlayerCount());
+    msg.inputs = batch.inputs;
+    msg.garbage = batch.garbage;
+
+    while (_lockstep.PopConfirmed(batch) > 0)
+    {
+        msg.firstFrame = batch.firstFrame;
+        msg.frameCount = static_cast<uint8_t>(batch.frameCount);
+        msg.garbageCount = static_cast<uint8_t>(batch.garbageCount);
+
+        CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+        msg.Encode(writer);
+
+        MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+        header->size = static_cast<uint16_t>(writer.GetSize());
+        header->type = MsgType::S2C_GAME_FRAMES;
+
+        BroadcastToGame(buffer, writer.GetSize());
+        _replay.OnFrames(batch, _lockstep.GetBoards());
+    }
+
+    // 관전 화면은 확정된 보드를 그대로 떠서 보냄 (참가자처럼 입력을 받아 돌리지 않음)
+    _spectators.OnConfirmedFrames(_lockstep.GetConfirmedFrameCount(), _lockstep.GetBoards());
+
+    if (_lockstep.IsFinished())
+    {
+        EndGame();
+    }
+}
+
+void CRoomActor::EndGame()
+{
+    SendGameOver();
+
+    const CAttackRouter& attacks = _lockstep.GetAttackRouter();
+    LOG_INFO("[RoomActor] Game over - RoomId: {}, Winner slot: {}, Frames: {}, Lag filled: {}, Rejected inputs: {}, "
+        "Garbage sent/cancelled/inserted: {}/{}/{}",
+        _room->GetRoomId(), _lockstep.GetWinner(), _lockstep.GetConfirmedFrameCount(),
+        _lockstep.GetFilledFrames(), _lockstep.GetRejectedInputs(),
+        attacks.GetSentLines(), attacks.GetCancelledLines(), attacks.GetInsertedLines());
+
+    _replay.End(_lockstep.GetConfirmedFrameCount(), _lockstep.GetWinner(), _lockstep.GetBoards());
+    _lockstep.Stop();
+    for (PlayerHandle& handle : _gameSlots)
+    {
+        handle = PlayerHandle();
+    }
+    SetStatus(RoomStatus::WAITING);
+}
+
+void CRoomActor::ResignGameSlot(int32_t slot)
+{
+    // 기권 입력 뒤로는 이 슬롯을 기다리지 않으므로 남은 인원의 프레임이 바로 확정될 수 있음
+    _lockstep.Resign(slot);
+    _gameSlots[slot] = PlayerHandle();
+    FlushConfirmedFrames();
+}
+
+int32_t CRoomActor::FindGameSlot(PlayerHandle handle) const
+{
+    if (!_lockstep.IsRunning())
+    {
+        return -1;
+    }
+
+    for (int32_t slot = 0; slot < _lockstep.GetPlayerCount(); ++slot)
+    {
+        if (_gameSlots[slot] == handle)
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void CRoomActor::SetStatus(RoomStatus status)
+{
+    _room->SetStatus(status);
+
+    // 값을 먼저 쓰고 플래그를 세운 뒤 슬롯을 목록에 넣음 (로비가 플래그를 본 뒤 읽는 값은 이 값이거나 더 최신 값)
+    uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(_room->GetRoomId())) << 32) | static_cast<uint32_t>(status);
+    _publishedStatus.store(packed, std::memory_order_release);
+    _statusChanged.store(true, std::memory_order_release);
+    _statusChanges.Push(_slot);
+}
+
+void CRoomActor::BroadcastToGame(const char* data, size_t size)
+{
+    for (int32_t slot = 0; slot < _lockstep.GetPlayerCount(); ++slot)
+    {
+        if (const CPlayer* member = _members.Get(_gameSlots[slot]))
+        {
+            _network.RequestSendMsg(member->GetSessionId(), data, static_cast<int>(size));
+        }
+    }
+}
+
+void CRoomActor::SendGameStarted(int64_t sessionId, uint32_t requestId, int32_t slot)
+{
+    MSG_S2C_GAME_STARTED msg;
+    msg.requestId = requestId;
+    msg.seed = _lockstep.GetSeed();
+    msg.playerCount = static_cast<uint8_t>(_lockstep.GetPlayerCount());
+    msg.yourSlot = static_cast<uint8_t>(slot);
+
+    char buffer[GAME_STARTED_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_GAME_STARTED;
+
+    _network.RequestSendMsg(sessionId, buffer, static_cast<int>(writer.GetSize()));
+}
+
+void CRoomActor::SendGameOver()
+{
+    MSG_S2C_GAME_OVER msg;
+    msg.frameCount = _lockstep.GetConfirmedFrameCount();
+    msg.winnerSlot = (_lockstep.GetWinner() >= 0) ? static_cast<uint8_t>(_lockstep.GetWinner()) : LOCKSTEP_SLOT_NONE;
+
+    char buffer[GAME_OVER_MSG_MAX_SIZE];
+    CMsgWriter writer(buffer, sizeof(buffer), sizeof(MsgHeader));
+    msg.Encode(writer);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(buffer);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_GAME_OVER;
+
+    // 시작 뒤 들어온 인원도 방이 다시 WAITING이 된 것을 알 수 있도록 방 전원에게
+    const PlayerHandle* players = _room->GetPlayers();
+    for (int32_t i = 0; i < _room->GetCurrentPlayerCount(); ++i)
+    {
+        if (const CPlayer* member = _members.Get(players[i]))
+        {
+            _network.RequestSendMsg(member->GetSessionId(), buffer, static_cast<int>(writer.GetSize()));
+        }
+    }
+
+    // 관전자에게는 지연 중인 화면과 마지막 화면 뒤에 같은 바이트로 (지연만큼 늦게 나감)
+    _spectators.EndGame(_lockstep.GetConfirmedFrameCount(), _lockstep.GetBoards(), buffer, writer.GetSize());
+}
+
+CPlayer* CRoomActor::FindMember(int64_t sessionId)
+{
+    if (!_room)
+    {
+        return nullptr;
+    }
+
+    const PlayerHandle* players = _room->GetPlayers();
+    for (int32_t i = 0; i < _room->GetCurrentPlayerCount(); ++i)
+    {
+        CPlayer* player = _members.Get(players[i]);
+        if (player && player->GetSessionId() == sessionId)
+        {
+            return player;
+        }
+    }
+    return nullptr;
+}
+
+void CRoomActor::RemoveMember(CPlayer& player)
+{
+    PlayerHandle handle = player.GetHandle();
+    if (_room)
+    {
+        _room->RemovePlayer(handle);
+    }
+    _members.Release(handle);
+}
+
+void CRoomActor::RemoveAllMembers()
+{
+    if (_room)
+    {
+        while (!_room->IsEmpty())
+        {
+            PlayerHandle handle = _room->GetPlayers()[0];
+            _room->RemovePlayer(handle);
+            _members.Release(handle);
+        }
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+#include "ActorScheduler.h"
+#include "BoundedMailbox.h"
+#include "ChangedSlotList.h"
+#include "HandleTable.h"
+#include "LockstepRelay.h"
+#include "Player.h"
+#include "Room.h"
+#include "Protocol.h"
+#include "ReplayWriter.h"
+#include "SpectatorRelay.h"
+
+class CIOCPServer; // 전방 선언
+
+// 방 액터 메일박스 크기
+// 제어 메시지: 로비만 넣고 입장 허가 전에 자리를 확인하므로 넘치지 않음 (최대 인원 전원 퇴장 + 닫기가 항상 들어가야 함)
+// 게임 메시지: IOCP 워커가 넣고 가득 차면 버림
+constexpr size_t ROOM_CONTROL_MAILBOX_CAPACITY = 32;
+constexpr size_t ROOM_GAME_MAILBOX_CAPACITY = 64;
+static_assert(ROOM_CONTROL_MAILBOX_CAPACITY >= ROOM_MAX_PLAYERS + 3, "control mailbox must fit open + join + every leave + close");
+
+// 방 안 게임 메시지 최대 크기 (헤더 포함). 넘는 패킷은 방으로 보내지 않음
+constexpr size_t ROOM_GAME_MSG_MAX_SIZE = 128;
+
+// 로비 -> 방 (방 열기/닫기, 입장/퇴장). 로비 액터 하나만 보내므로 보낸 순서대로 처리됨
+struct RoomControlMessage
+{
+    enum class Type : uint8_t
+    {
+        OPEN,  // 방 생성 (roomId, title, maxPlayers, tag)
+        JOIN,  // sessionId 입장
+        LEAVE, // sessionId 퇴장
+        CLOSE  // 방 삭제 (남은 인원 정리)
+    };
+
+    Type type = Type::OPEN;
+    uint16_t tag = 0;
+    int64_t sessionId = -1;
+    int32_t roomId = 0;
+    int32_t maxPlayers = 0;
+    uint8_t titleLength = 0;
+    char title[ROOM_TITLE_MAX_LEN + 1];
+};
+
+// 클라 -> 방 (방 안에서만 의미 있는 패킷). IOCP 워커가 멤버십을 보고 바로 넣음
+struct RoomGameMessage
+{
+    int64_t sessionId = -1;
+    uint16_t tag = 0; // 보낸 쪽이 본 방 세대 (슬롯이 재사용된 뒤 도착한 이전 방 메시지를 거름)
+    uint16_t length = 0;
+    char data[ROOM_GAME_MSG_MAX_SIZE];
+};
+
+// __________________________________________________________________
+//
+// 방 액터 (통합 스트랜드 / UnifiedStrand)
+// 방 하나의 게임 상태(멤버, 방장, 상태)를 가지고 공용 워커 풀에서 한 번에 한 워커만 실행
+// 방 안 상태는 이 액터의 CRoom 하나가 기준. 로비 액터의 CRoomManager는 디렉터리(목록, 제목, 빠른 입장, 좌석 수)만 가지고
+// 좌석이 바뀌면 로비가 제어 메시지로 알려줌 -> 방 코드 안에는 락이 없음
+// 방 액터는 로비의 방 슬롯 index마다 하나씩 미리 만들어두고 방이 생기고 없어질 때마다 다시 씀 (OPEN ~ CLOSE)
+// 주소(멤버십 테이블 값) = [세대 하위 16비트 | 슬롯 index 16비트]
+// 게임: 방장이 시작하면 그때의 인원으로 락스텝 릴레이를 돌림 (CLockstepRelay)
+//  - 입력 패킷이 올 때마다 확정된 프레임을 방 전원에게 같은 바이트로 보냄 (틱 없음, 입력이 시계)
+//  - 줄 삭제 공격은 릴레이 안의 CAttackRouter가 확정 프레임마다 모아서 처리하고, 방해 줄은 같은 메시지에 실어 보냄
+//  - 게임 중 퇴장은 기권, 한 명 남으면 종료
+//  - 방 상태(시작/종료)는 메일박스 대신 액터마다 있는 원자 변수 하나에 [roomId | 상태]로 게시하고 바뀐 슬롯 목록에 슬롯을 넣음
+//    로비는 틱마다 목록에 있는 슬롯만 읽어감
+//    -> 로비 메일박스가 가득 차도 잃어버리지 않음 (마지막 값만 남으므로 그 사이 바뀐 중간 상태는 건너뜀)
+//  - 관전: 확정 프레임의 보드 화면을 CSpectatorFeed로 한 번 인코딩해서 로비가 붙여준 관전 트리의 첫 릴레이에만 넘김
+//    게임이 끝난 뒤 지연 중인 화면은 틱 스레드가 PostSpectatorTick으로 깨울 때마다 같은 간격으로 마저 넘김
+//  - 리플레이: 확정 프레임의 바뀐 입력 / 방해 줄을 CReplayRecorder로 블록에 붙여 기록 스레드로 넘김 (파일 I/O 없음)
+// __________________________________________________________________
+
+class CRoomActor : public CActor
+{
+public:
+    // spectatorDelayFrames: 관전 화면 지연 (확정 프레임, 0이면 바로)
+    // statusChanges: 방 상태를 게시할 때 슬롯을 넣을 목록 (로비가 비움)
+    // replayWriter: 경기 리플레이 기록 (nullptr이면 기록하지 않음)
+    CRoomActor(CActorWorkerPool& pool, uint32_t slot, CIOCPServer& network, CChangedSlotList& statusChanges,
+        uint32_t spectatorDelayFrames = 0, CReplayWriter* replayWriter = nullptr);
+    ~CRoomActor() override;
+
+    // 주소 (로비 방 핸들 <-> 멤버십 테이블 값)
+    static int32_t MakeAddress(RoomHandle handle);
+    static uint32_t GetSlotOfAddress(int32_t address) { return static_cast<uint32_t>(address) & 0xFFFF; }
+    static uint16_t GetTagOfAddress(int32_t address) { return static_cast<uint16_t>(static_cast<uint32_t>(address) >> 16); }
+
+    // 로비 액터 전용 ////////////////////////////////////////////////////////////////
+    // 제어 메시지 postCount개를 넣은 뒤 membersAfterJoin명 전원 퇴장 + 닫기가 들어갈 자리가 남는지
+    // 입장 계열 메시지를 넣기 전에 확인 -> 퇴장 / 닫기는 항상 들어감
+    bool HasRoomForJoin(int32_t postCount, int32_t membersAfterJoin) const;
+
+    bool PostOpen(const CRoom& room);
+    bool PostJoin(int64_t sessionId);
+    bool PostLeave(int64_t sessionId);
+    bool PostClose();
+
+    // 관전 트리의 첫 릴레이 (nullptr: 관전자 없음) / 새 구독자를 위한 키프레임 요청. 메일박스를 거치지 않음
+    void SetSpectatorRoot(CSpectatorRelay* root) { _spectators.SetRoot(root); }
+    void RequestSpectatorKeyframe() { _spectators.RequestKeyframe(); }
+
+    // 마지막으로 읽은 뒤 방 상태가 바뀌었으면 true + 게시된 값. 이미 닫힌 방의 값일 수 있으므로 roomId로 확인할 것
+    bool TakeStatusChange(int32_t& outRoomId, RoomStatus& outStatus);
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 아무 스레드 (IOCP 워커). 메일박스가 가득 찼거나 너무 큰 패킷이면 false (버림)
+    bool PostGame(int64_t sessionId, uint16_t tag, const char* data, size_t length);
+
+    // 틱 스레드 전용. 끝난 게임의 관전 지연 큐가 남아있으면 다음 실행 때 Drain (메일박스를 거치지 않는 플래그)
+    bool IsSpectatorDraining() const { return _spectatorDraining.load(std::memory_order_relaxed); }
+    void PostSpectatorTick();
+
+    uint32_t GetSlot() const { return _slot; }
+
+protected:
+    void ProcessMessages(size_t budget) override;
+    bool HasPendingMessages() const override;
+
+private:
+    bool PostControl(RoomControlMessage::Type type, int64_t sessionId, const CRoom* room = nullptr);
+
+    void DrainControl();
+    void HandleControl(const RoomControlMessage& msg);
+    void HandleGame(const RoomGameMessage& msg);
+
+    // 락스텝 게임 //////////////////////////////////////////////////////////////////
+    void HandleGameStart(CPlayer& player, const MSG_C2S_GAME_START* msg);
+    void HandleGameInput(CPlayer& player, const MSG_C2S_GAME_INPUT& msg);
+    void HandleGameTarget(CPlayer& player, const MSG_C2S_GAME_TARGET* msg);
+    void FlushConfirmedFrames(); // 확정된 프레임 전송, 끝났으면 종료 처리
+    void EndGame();
+    void ResignGameSlot(int32_t slot); // 게임 중 퇴장 (멤버를 지운 뒤 호출)
+    int32_t FindGameSlot(PlayerHandle handle) const;
+    void SetStatus(RoomStatus status);
+
+    // 전송 (게임 참가자 중 아직 방에 있는 사람)
+    void BroadcastToGame(const char* data, size_t size);
+    void SendGameStarted(int64_t sessionId, uint32_t requestId, int32_t slot);
+    void SendGameOver();
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 방 안 플레이어 (최대 ROOM_MAX_PLAYERS명이라 선형 탐색)
+    CPlayer* FindMember(int64_t sessionId);
+    void RemoveMember(CPlayer& player);
+    void RemoveAllMembers();
+
+    uint32_t _slot;
+    CIOCPServer& _network;
+    CBoundedMailbox<RoomControlMessage> _control;
+    CBoundedMailbox<RoomGameMessage> _game;
+
+    // 아래는 워커 스레드 전용 (한 번에 한 워커)
+    std::optional<CRoom> _room; // OPEN ~ CLOSE 사이에만 있음. 멤버 / 방장 / 상태의 기준
+    uint16_t _tag;
+    CHandleTable<CPlayer> _members;
+
+    // 게임 (액터 생성 시 보드까지 미리 할당, 방이 바뀌어도 재사용)
+    CLockstepRelay _lockstep;
+    PlayerHandle _gameSlots[ROOM_MAX_PLAYERS]; // 슬롯 -> 시작할 때의 멤버 (퇴장하면 Get이 실패)
+    CSpectatorFeed _spectators;
+    CReplayRecorder _replay;
+
+    std::atomic<bool> _spectatorDraining; // _spectators.IsDraining()을 실행이 끝날 때마다 옮겨둠
+    std::atomic<bool> _spectatorTick;
+
+    // 방 액터가 쓰고 로비가 읽는 방 상태 [roomId 상위 32비트 | RoomStatus 하위 32비트]
+    std::atomic<uint64_t> _publishedStatus;
+    std::atomic<bool> _statusChanged;
+    CChangedSlotList& _statusChanges;
+};
@@ -0,0 +1,335 @@
+#include "RoomListSnapshot.h"
+#include <algorithm>
+#include <cstring>
+
+// 한 번의 페이지 조회에서 필터 검사할 최대 방 개수 (pageSize 배수)
+// 조건에 맞는 방이 드물어도 요청 1회 비용은 O(page)로 제한되고, 나머지는 nextCursor로 이어서 조회
+constexpr int32_t ROOM_PAGE_SCAN_FACTOR = 8;
+
+int32_t RoomListSnapshot::QueryPage(const RoomPageQuery& query, const RoomSummary** outRooms, int32_t& outCount) const
+{
+    outCount = 0;
+
+    int32_t pageSize = (std::min)(query.pageSize, static_cast<int32_t>(ROOM_PAGE_MAX_SIZE));
+    if (pageSize <= 0)
+    {
+        return 0;
+    }
+
+    int32_t scanLimit = pageSize * ROOM_PAGE_SCAN_FACTOR;
+
+    // 제목 접두어 범위가 한 번의 검사 한도 안이면 그 범위만 보고 바로 답함 (드문 접두어도 빈 페이지 없이 한 번에)
+    // 범위가 넓으면 아래처럼 roomId 순으로 순회하면서 접두어를 검사 (비용은 마찬가지로 O(page))
+    if (!query.titlePrefix.empty())
+    {
+        size_t first = 0, last = 0;
+        FindTitlePrefixRange(query.titlePrefix, first, last);
+        if (last - first <= static_cast<size_t>(scanLimit))
+        {
+            return QueryTitleRangePage(query, pageSize, first, last, outRooms, outCount);
+        }
+    }
+
+    // 입장 가능 조건이면 좁은 첨자 목록을 순회. 나머지 조건은 순회하면서 검사
+    bool joinableOnly = query.joinableOnly
+        || (query.filterStatus && query.status == RoomStatus::WAITING && query.minFreeSlots > 0);
+
+    // 커서는 마지막으로 검사한 roomId. 내림차순이므로 커서보다 작은 첫 방부터 (그 사이 삭제됐어도 위치를 바로 찾음)
+    size_t count = joinableOnly ? joinable.size() : rooms.size();
+    auto roomAt = [&](size_t pos) -> const RoomSummary& { return joinableOnly ? rooms[joinable[pos]] : rooms[pos]; };
+
+    size_t pos = 0;
+    if (query.cursor > 0)
+    {
+        size_t low = 0, high = count;
+        while (low < high)
+        {
+            size_t mid = (low + high) / 2;
+            if (roomAt(mid).roomId >= query.cursor)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        pos = low;
+    }
+
+    int32_t lastScannedId = 0;
+
+    for (; pos < count; ++pos)
+    {
+        if (outCount >= pageSize || scanLimit-- <= 0)
+        {
+            return lastScannedId;
+        }
+
+        const RoomSummary& room = roomAt(pos);
+        lastScannedId = room.roomId;
+
+        if (MatchPageQuery(room, query))
+        {
+            outRooms[outCount++] = &room;
+        }
+    }
+
+    return 0;
+}
+
+void RoomListSnapshot::FindTitlePrefixRange(std::string_view prefix, size_t& outFirst, size_t& outLast) const
+{
+    outFirst = outLast = 0;
+    if (prefix.size() > ROOM_TITLE_MAX_LEN)
+    {
+        return; // 이보다 긴 제목은 없음
+    }
+
+    // 접두어로 시작하는 제목은 titleOrder에서 연속 구간 [접두어 이상, 접두어의 다음 문자열 이상)
+    // 다음 문자열은 마지막 바이트를 1 올린 것 (0xFF로 끝나면 떼고 앞 바이트를 올림, 전부 0xFF면 끝까지)
+    auto titleLess = [&](uint32_t index, std::string_view key) { return rooms[index].GetTitle() < key; };
+
+    auto first = std::lower_bound(titleOrder.begin(), titleOrder.end(), prefix, titleLess);
+    auto last = titleOrder.end();
+
+    char upper[ROOM_TITLE_MAX_LEN];
+    size_t upperLength = prefix.size();
+    std::memcpy(upper, prefix.data(), upperLength);
+    while (upperLength > 0 && static_cast<uint8_t>(upper[upperLength - 1]) == 0xFF)
+    {
+        --upperLength;
+    }
+
+    if (upperLength > 0)
+    {
+        upper[upperLength - 1] = static_cast<char>(static_cast<uint8_t>(upper[upperLength - 1]) + 1);
+        last = std::lower_bound(first, titleOrder.end(), std::string_view(upper, upperLength), titleLess);
+    }
+
+    outFirst = static_cast<size_t>(first - titleOrder.begin());
+    outLast = static_cast<size_t>(last - titleOrder.begin());
+}
+
+int32_t RoomListSnapshot::QueryTitleRangePage(const RoomPageQuery& query, int32_t pageSize, size_t first, size_t last,
+    const RoomSummary** outRooms, int32_t& outCount) const
+{
+    // 범위는 pageSize * ROOM_PAGE_SCAN_FACTOR개 이하
+    // rooms 첨자 순서가 곧 roomId 내림차순이므로 조건에 맞는 첨자만 모아 정렬하면 페이지 순서가 됨
+    uint32_t matched[ROOM_PAGE_MAX_SIZE * ROOM_PAGE_SCAN_FACTOR];
+    int32_t matchedCount = 0;
+
+    for (size_t pos = first; pos < last; ++pos)
+    {
+        const RoomSummary& room = rooms[titleOrder[pos]];
+        if ((query.cursor > 0 && room.roomId >= query.cursor) || !MatchPageQuery(room, query))
+            continue;
+
+        matched[matchedCount++] = titleOrder[pos];
+    }
+
+    std::sort(matched, matched + matchedCount);
+
+    outCount = (std::min)(matchedCount, pageSize);
+    for (int32_t i = 0; i < outCount; ++i)
+    {
+        outRooms[i] = &rooms[matched[i]];
+    }
+
+    return (matchedCount > pageSize) ? outRooms[outCount - 1]->roomId : 0;
+}
+
+int32_t RoomListSnapshot::QueryMergedPage(const RoomListSnapshot* const* snapshots, int32_t snapshotCount,
+    const RoomPageQuery& query, const RoomSummary** outRooms, int32_t& outCount)
+{
+    outCount = 0;
+
+    int32_t pageSize = (std::min)(query.pageSize, static_cast<int32_t>(ROOM_PAGE_MAX_SIZE));
+    snapshotCount = (std::min)(snapshotCount, ROOM_LIST_MAX_MERGE);
+    if (pageSize <= 0 || snapshotCount <= 0)
+    {
+        return 0;
+    }
+
+    // 스냅샷마다 같은 조건으로 한 페이지씩 받아 합침
+    // 검사가 중간에 끊긴 스냅샷은 자기 커서보다 작은 방을 아직 안 봤으므로,
+    // 그 커서들 중 가장 큰 값(bound) 이상인 방까지만 이번 페이지에 확정할 수 있음
+    const RoomSummary* candidates[ROOM_LIST_MAX_MERGE * ROOM_PAGE_MAX_SIZE];
+    int32_t candidateCount = 0;
+    int32_t bound = 0;
+
+    for (int32_t i = 0; i < snapshotCount; ++i)
+    {
+        int32_t count = 0;
+        int32_t nextCursor = snapshots[i]->QueryPage(query, candidates + candidateCount, count);
+        candidateCount += count;
+        bound = (std::max)(bound, nextCursor);
+    }
+
+    std::sort(candidates, candidates + candidateCount,
+        [](const RoomSummary* a, const RoomSummary* b) { return a->roomId > b->roomId; });
+
+    int32_t taken = 0;
+    while (taken < candidateCount && outCount < pageSize && candidates[taken]->roomId >= bound)
+    {
+        outRooms[outCount++] = candidates[taken++];
+    }
+
+    if (outCount == pageSize && (taken < candidateCount || bound > 0))
+    {
+        return outRooms[outCount - 1]->roomId;
+    }
+
+    return bound;
+}
+
+void RoomSummary::Encode(CMsgWriter& writer) const
+{
+    RoomInfo info;
+    info.roomId = roomId;
+    info.title = GetTitle();
+    info.currentPlayers = currentPlayers;
+    info.maxPlayers = maxPlayers;
+    info.status = static_cast<uint8_t>(status);
+    info.Encode(writer);
+}
+
+void RoomListSnapshot::CacheListPayload()
+{
+    RoomPageQuery query;
+    query.pageSize = ROOM_PAGE_MAX_SIZE;
+
+    const RoomSummary* firstPage[ROOM_PAGE_MAX_SIZE];
+    int32_t count = 0;
+    QueryPage(query, firstPage, count);
+
+    listPayloadSize = EncodeListPayload(firstPage, count, listPayload);
+}
+
+size_t RoomListSnapshot::EncodeListPayload(const RoomSummary* const* rooms, int32_t roomCount, char* outPayload)
+{
+    CMsgWriter writer(outPayload, ROOM_LIST_PAYLOAD_MAX_SIZE, 0);
+    writer.WriteVarUInt(static_cast<uint32_t>(roomCount));
+    for (int32_t i = 0; i < roomCount; ++i)
+    {
+        rooms[i]->Encode(writer);
+    }
+    return writer.GetSize();
+}
+
+size_t RoomListSnapshot::WriteRoomListMsg(char* outBuffer, uint32_t requestId, const char* payload, size_t payloadSize)
+{
+    // requestId만 요청마다 다르고 나머지는 인코딩된 본문을 그대로 복사
+    CMsgWriter writer(outBuffer, ROOM_LIST_MSG_MAX_SIZE, sizeof(MsgHeader));
+    writer.WriteVarUInt(requestId);
+
+    size_t size = writer.GetSize() + payloadSize;
+    std::memcpy(outBuffer + writer.GetSize(), payload, payloadSize);
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(outBuffer);
+    header->size = static_cast<uint16_t>(size);
+    header->type = MsgType::S2C_ROOM_LIST;
+    return size;
+}
+
+bool RoomListSnapshot::MatchPageQuery(const RoomSummary& room, const RoomPageQuery& query)
+{
+    if (!query.titlePrefix.empty() && room.GetTitle().substr(0, query.titlePrefix.size()) != query.titlePrefix)
+    {
+        return false;
+    }
+
+    if (query.joinableOnly && !room.IsJoinable())
+    {
+        return false;
+    }
+
+    if (query.filterStatus && room.status != query.status)
+    {
+        return false;
+    }
+
+    if (room.maxPlayers - room.currentPlayers < query.minFreeSlots)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+CRoomListPublisher::CRoomListPublisher(size_t maxRooms)
+    : _current(0)
+    , _writing(-1)
+    , _publishedVersion(0)
+{
+    for (Buffer& buffer : _buffers)
+    {
+        buffer.snapshot.rooms.reserve(maxRooms);
+        buffer.snapshot.joinable.reserve(maxRooms);
+        buffer.snapshot.titleOrder.reserve(maxRooms);
+    }
+}
+
+CRoomListPublisher::CReadGuard::CReadGuard(const CRoomListPublisher& publisher, int32_t index)
+    : _publisher(&publisher)
+    , _index(index)
+{
+}
+
+CRoomListPublisher::CReadGuard::CReadGuard(CReadGuard&& other) noexcept
+    : _publisher(other._publisher)
+    , _index(other._index)
+{
+    other._index = -1;
+}
+
+CRoomListPublisher::CReadGuard::~CReadGuard()
+{
+    if (_index >= 0)
+    {
+        _publisher->_buffers[_index].readers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+CRoomListPublisher::CReadGuard CRoomListPublisher::Acquire() const
+{
+    while (true)
+    {
+        int32_t index = _current.load();
+
+        // 카운트를 올린 뒤에도 여전히 게시본이면 writer가 이 버퍼를 다시 쓰지 않음
+        // (writer는 게시본을 바꾼 뒤에 reader 카운트를 확인하므로 둘 다 seq_cst)
+        _buffers[index].readers.fetch_add(1);
+        if (_current.load() == index)
+        {
+            return CReadGuard(*this, index);
+        }
+
+        _buffers[index].readers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+RoomListSnapshot* CRoomListPublisher::BeginWrite()
+{
+    int32_t current = _current.load(std::memory_order_relaxed); // writer만 바꾸므로 relaxed
+
+    for (int32_t i = 1; i < SNAPSHOT_BUFFER_COUNT; ++i)
+    {
+        int32_t index = (current + i) % SNAPSHOT_BUFFER_COUNT;
+        if (_buffers[index].readers.load() == 0)
+        {
+            _writing = index;
+            return &_buffers[index].snapshot;
+        }
+    }
+
+    return nullptr;
+}
+
+void CRoomListPublisher::Publish()
+{
+    if (_writing < 0)
+    {
+        return;
+    }
+
+    _publishedVersion = _buffers[_writing].snapshot.version;
+    _current.store(_writing);
+    _writing = -1;
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Room.h"
+#include "Protocol.h"
+
+// QueryMergedPage로 한 번에 합칠 수 있는 최대 스냅샷 수 (샤드로 나눈 방 목록용)
+constexpr int32_t ROOM_LIST_MAX_MERGE = 16;
+
+// 방 목록 / 페이지 응답의 최대 크기 (스택 버퍼 크기)
+constexpr size_t ROOM_LIST_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE * 3 + ROOM_INFO_MAX_ENCODED_SIZE * ROOM_PAGE_MAX_SIZE;
+static_assert(ROOM_LIST_MSG_MAX_SIZE <= UINT16_MAX, "room list message must fit in uint16_t size header");
+
+// S2C_ROOM_LIST 본문 중 requestId 뒤 부분([varuint roomCount][RoomInfo * roomCount])의 최대 크기
+constexpr size_t ROOM_LIST_PAYLOAD_MAX_SIZE = MAX_VARINT32_SIZE + ROOM_INFO_MAX_ENCODED_SIZE * ROOM_PAGE_MAX_SIZE;
+
+// 방 목록 페이지 조회 조건
+struct RoomPageQuery
+{
+    int32_t cursor = 0;          // 이전 페이지의 nextCursor (0: 처음부터)
+    int32_t pageSize = 0;
+    bool joinableOnly = false;   // WAITING && 빈 자리 있는 방만
+    bool filterStatus = false;
+    RoomStatus status = RoomStatus::WAITING;
+    int32_t minFreeSlots = 0;
+    std::string_view titlePrefix; // 비어있으면 제목 조건 없음 (요청 버퍼를 가리킴, 조회 중에만 유효)
+};
+
+// 방 목록용 요약 (CRoom에서 목록에 필요한 값만 복사, 포인터 없음)
+struct RoomSummary
+{
+    int32_t roomId;
+    int32_t currentPlayers;
+    int32_t maxPlayers;
+    RoomStatus status;
+    uint8_t titleLength;
+    char title[ROOM_TITLE_MAX_LEN + 1];
+
+    std::string_view GetTitle() const { return std::string_view(title, titleLength); }
+    bool IsJoinable() const { return status == RoomStatus::WAITING && currentPlayers < maxPlayers; }
+
+    // RoomInfo 와이어 포맷으로 인코딩
+    void Encode(CMsgWriter& writer) const;
+};
+
+// __________________________________________________________________
+//
+// 방 목록 스냅샷 (게시된 뒤에는 읽기 전용)
+// rooms는 최근 생성 순 = roomId 내림차순이라 커서 위치를 이진 탐색으로 찾음
+// joinable은 입장 가능한 방의 rooms 첨자 (같은 순서)
+// titleOrder는 rooms 첨자를 제목 순으로 나열한 것 (방 관리자의 제목 인덱스 순서) -> 제목 접두어 범위는 lower_bound 두 번으로 찾음
+// listPayload는 첫 페이지 S2C_ROOM_LIST 본문을 게시 전에 한 번만 인코딩해둔 것
+//  -> 접속 직후 목록 요청이 몰려도 요청마다 헤더 + requestId만 붙여서 복사
+// __________________________________________________________________
+struct RoomListSnapshot
+{
+    uint64_t version = 0; // CRoomManager::GetVersion() 시점
+    std::vector<RoomSummary> rooms;
+    std::vector<uint32_t> joinable;
+    std::vector<uint32_t> titleOrder;
+
+    size_t listPayloadSize = 0;
+    char listPayload[ROOM_LIST_PAYLOAD_MAX_SIZE];
+
+    // rooms / titleOrder를 채운 뒤 게시 전에 호출 (writer 스레드)
+    void CacheListPayload();
+
+    // 캐시된 본문으로 S2C_ROOM_LIST 패킷 작성. outBuffer는 ROOM_LIST_MSG_MAX_SIZE 이상. 반환값은 패킷 크기
+    size_t WriteRoomListMsg(char* outBuffer, uint32_t requestId) const { return WriteRoomListMsg(outBuffer, requestId, listPayload, listPayloadSize); }
+
+    // [varuint roomCount][RoomInfo * roomCount] 인코딩. outPayload는 ROOM_LIST_PAYLOAD_MAX_SIZE 이상, roomCount는 ROOM_PAGE_MAX_SIZE 이하
+    static size_t EncodeListPayload(const RoomSummary* const* rooms, int32_t roomCount, char* outPayload);
+    static size_t WriteRoomListMsg(char* outBuffer, uint32_t requestId, const char* payload, size_t payloadSize);
+
+    // 페이지 조회. outRooms는 ROOM_PAGE_MAX_SIZE개 이상. 반환값은 다음 커서 (0: 마지막 페이지)
+    int32_t QueryPage(const RoomPageQuery& query, const RoomSummary** outRooms, int32_t& outCount) const;
+
+    // 여러 스냅샷(샤드별 방 목록)을 roomId 내림차순으로 합친 페이지 조회. 커서 의미는 QueryPage와 같음
+    // snapshotCount는 ROOM_LIST_MAX_MERGE 이하
+    static int32_t QueryMergedPage(const RoomListSnapshot* const* snapshots, int32_t snapshotCount,
+        const RoomPageQuery& query, const RoomSummary** outRooms, int32_t& outCount);
+
+private:
+    // 제목이 prefix로 시작하는 방의 titleOrder 구간 [outFirst, outLast)
+    void FindTitlePrefixRange(std::string_view prefix, size_t& outFirst, size_t& outLast) const;
+
+    // 좁은 제목 구간(검사 한도 이하) 안에서 커서보다 작은 roomId 중 큰 순서로 pageSize개
+    int32_t QueryTitleRangePage(const RoomPageQuery& query, int32_t pageSize, size_t first, size_t last,
+        const RoomSummary** outRooms, int32_t& outCount) const;
+
+    static bool MatchPageQuery(const RoomSummary& room, const RoomPageQuery& query);
+};
+
+// __________________________________________________________________
+//
+// 방 목록 게시자 (단일 writer, 다중 reader)
+// 버퍼 SNAPSHOT_BUFFER_COUNT개를 돌려쓰는 RCU 방식:
+//  - writer(로직 스레드)는 현재 게시본도 아니고 읽는 중인 reader도 없는 버퍼에 새 목록을 채운 뒤 첨자만 바꿔서 게시
+//  - reader(IOCP 워커 등)는 락 없이 현재 첨자의 reader 카운트를 올리고 읽음.
+//    카운트를 올리는 사이 게시가 바뀐 경우에만 다시 시도 (게시는 틱당 최대 1번이라 사실상 1회에 끝남)
+// 로직 스레드의 CRoom / 인덱스는 건드리지 않으므로 목록 요청이 로직 스레드 큐를 거치지 않아도 됨
+// 모든 버퍼는 생성 시 maxRooms 크기로 잡아두므로 게시할 때 힙 할당 없음
+// __________________________________________________________________
+class CRoomListPublisher
+{
+public:
+    static constexpr int32_t SNAPSHOT_BUFFER_COUNT = 3;
+
+    explicit CRoomListPublisher(size_t maxRooms);
+
+    CRoomListPublisher(const CRoomListPublisher&) = delete;
+    CRoomListPublisher& operator=(const CRoomListPublisher&) = delete;
+
+    // 읽기 핸들. 살아있는 동안 스냅샷 내용이 바뀌지 않음 (짧게 쓰고 바로 해제할 것)
+    // 이동만 가능 (여러 샤드의 스냅샷을 배열로 잡아둘 때)
+    class CReadGuard
+    {
+    public:
+        CReadGuard(const CRoomListPublisher& publisher, int32_t index);
+        CReadGuard(CReadGuard&& other) noexcept;
+        ~CReadGuard();
+
+        CReadGuard(const CReadGuard&) = delete;
+        CReadGuard& operator=(const CReadGuard&) = delete;
+        CReadGuard& operator=(CReadGuard&&) = delete;
+
+        const RoomListSnapshot& operator*() const { return _publisher->_buffers[_index].snapshot; }
+        const RoomListSnapshot* operator->() const { return &_publisher->_buffers[_index].snapshot; }
+
+    private:
+        const CRoomListPublisher* _publisher;
+        int32_t _index; // -1: 이동됨
+    };
+
+    // reader (아무 스레드)
+    CReadGuard Acquire() const;
+
+    // writer (한 스레드 전용). 쓸 수 있는 버퍼가 없으면 nullptr (다음 틱에 다시 시도)
+    RoomListSnapshot* BeginWrite();
+    void Publish(); // BeginWrite로 받은 버퍼를 게시
+
+    uint64_t GetPublishedVersion() const { return _publishedVersion; } // writer 스레드에서만
+
+private:
+    struct Buffer
+    {
+        RoomListSnapshot snapshot;
+        mutable std::atomic<int32_t> readers{ 0 };
+    };
+
+    Buffer _buffers[SNAPSHOT_BUFFER_COUNT];
+    std::atomic<int32_t> _current;
+    int32_t _writing; // BeginWrite로 잡은 버퍼 (-1: 없음)
+    uint64_t _publishedVersion;
+};
@@ -1,166 +1,338 @@
 //
 #include "RoomManager.h"
-#include <iostream>
-
-CRoomManager::CRoomManager()
-    : _roomIdCounter(1)
+#include "AsyncLogger.h"
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+CRoomManager::CRoomManager(size_t maxRooms, int32_t shardIndex, int32_t shardCount)
+    : _shardIndex(shardIndex)
+    , _shardCount((shardCount > 0) ? shardCount : 1)
+    , _roomSeq(1)
+    , _rooms(maxRooms)
+    , _indexPool()
+    , _recentHead(nullptr)
+    , _roomIdMap(TPoolAllocator<std::pair<const int32_t, RoomHandle>>(&_indexPool))
+    , _titleMap(TPoolAllocator<std::pair<const std::string_view, RoomHandle>>(&_indexPool))
+    , _titleOrder(TPoolAllocator<CRoom*>(&_indexPool))
+    , _quickJoinIndex()
+    , _quickRoomSeq(0)
+    , _totalPlayers(0)
+    , _version(0)
 {
+    // 버킷 배열은 여기서 한 번만 할당. 방 개수가 maxRooms를 넘지 않으므로 rehash 없음
+    _roomIdMap.reserve(maxRooms);
+    _titleMap.reserve(maxRooms);
 }
 
 CRoomManager::~CRoomManager()
 {
-    _roomList.clear();
-    _roomMap.clear();
-    _playerToRoomMap.clear();
+    _recentHead = nullptr;
+    _titleOrder.clear();
+    _titleMap.clear();
+    _roomIdMap.clear();
+}
+
+int32_t CRoomManager::GetShardOfRoom(int32_t roomId, int32_t shardCount)
+{
+    return (roomId > 0 && shardCount > 1) ? roomId % shardCount : 0;
 }
 
-std::shared_ptr<CRoom> CRoomManager::CreateRoom(const std::string& title, int32_t maxPlayers)
+int32_t CRoomManager::GetShardOfTitle(std::string_view title, int32_t shardCount)
 {
-    int32_t roomId = _roomIdCounter++;
-    auto room = std::make_shared<CRoom>(roomId, title, maxPlayers);
+    if (shardCount <= 1)
+    {
+        return 0;
+    }
+
+    return static_cast<int32_t>(std::hash<std::string_view>()(title) % static_cast<size_t>(shardCount));
+}
+
+CRoom* CRoomManager::CreateRoom(std::string_view title, int32_t maxPlayers)
+{
+    int32_t roomId = _roomSeq++ * _shardCount + _shardIndex;
+    RoomHandle handle = _rooms.Create(roomId, title, maxPlayers);
+    CRoom* room = _rooms.Get(handle);
+    if (!room)
+    {
+        LOG_ERROR("[RoomManager] Room pool exhausted (capacity: {})", _rooms.GetCapacity());
+        return nullptr;
+    }
 
-    _roomList.push_front(room); // Ʈ տ ߰ (ֱ  )
-    _roomMap[roomId] = room; // ʿ ߰ (˻)
+    room->_handle = handle;
 
-    std::cout << "[RoomManager] Room created - ID: " << roomId 
-              << ", Title: " << title << std::endl;
+    _roomIdMap.emplace(roomId, handle); // 맵에 추가 (검색용)
+    _titleMap.emplace(room->GetTitle(), handle); // 키는 방이 가진 문자열을 가리킴
+    _titleOrder.insert(room);
+    LinkRecent(room); // 리스트 앞에 추가 (최근 생성 순)
+
+    _quickJoinIndex.Update(*room);
+    ++_version;
+
+    LOG_INFO("[RoomManager] Room created - ID: {}, Title: {}", roomId, room->GetTitle());
 
     return room;
 }
 
 bool CRoomManager::DeleteRoom(int32_t roomId)
 {
-    auto it = _roomMap.find(roomId);
-    if (it == _roomMap.end())
+    auto it = _roomIdMap.find(roomId);
+    if (it == _roomIdMap.end())
     {
         return false;
     }
 
-    auto room = it->second;
+    RoomHandle handle = it->second;
+    CRoom* room = _rooms.Get(handle);
 
-    // 濡 ִ  ÷̾  
-    for (auto& player : room->GetPlayers())
-    {
-        _playerToRoomMap.erase(player);
-    }
+    // 남아있던 플레이어의 방 핸들은 generation이 바뀌면서 자동으로 무효가 됨
+    _totalPlayers -= room->GetCurrentPlayerCount();
+
+    // 인덱스에서 제거 (_titleMap 키가 room의 제목을 가리키므로 해제 전에)
+    UnlinkRecent(room);
+    _titleMap.erase(room->GetTitle());
+    _titleOrder.erase(room);
+    _quickJoinIndex.Remove(*room);
+    ++_version;
 
-    // Ʈ 
-    _roomList.remove(room);
-    _roomMap.erase(it);
+    _roomIdMap.erase(it);
+    _rooms.Release(handle);
 
-    std::cout << "[RoomManager] Room deleted - ID: " << roomId << std::endl;
+    LOG_INFO("[RoomManager] Room deleted - ID: {}", roomId);
 
     return true;
 }
 
-std::shared_ptr<CRoom> CRoomManager::FindRoom(int32_t roomId)
+CRoom* CRoomManager::GetRoom(RoomHandle handle)
+{
+    return _rooms.Get(handle);
+}
+
+CRoom* CRoomManager::FindRoom(int32_t roomId)
 {
-    auto it = _roomMap.find(roomId);
-    return (it != _roomMap.end()) ? it->second : nullptr;
+    auto it = _roomIdMap.find(roomId);
+    return (it != _roomIdMap.end()) ? _rooms.Get(it->second) : nullptr;
 }
 
-std::shared_ptr<CRoom> CRoomManager::FindRoomByPlayer(std::shared_ptr<CPlayer> player)
+CRoom* CRoomManager::FindRoomByPlayer(const CPlayer& player)
 {
-    if (!player)
+    return _rooms.Get(player.GetRoomHandle());
+}
+
+CRoom* CRoomManager::FindRoomByTitle(std::string_view title)
+{
+    auto it = _titleMap.find(title);
+    return (it != _titleMap.end()) ? _rooms.Get(it->second) : nullptr;
+}
+
+void CRoomManager::FillSnapshot(RoomListSnapshot& outSnapshot) const
+{
+    // 버퍼는 게시자가 최대 방 개수만큼 미리 잡아두므로 clear 후 다시 채워도 할당 없음
+    outSnapshot.version = _version;
+    outSnapshot.rooms.clear();
+    outSnapshot.joinable.clear();
+    outSnapshot.titleOrder.clear();
+
+    for (CRoom* room = _recentHead; room != nullptr; room = room->_recentNext)
     {
-        return nullptr;
+        room->_listIndex = static_cast<uint32_t>(outSnapshot.rooms.size());
+
+        RoomSummary summary;
+        summary.roomId = room->GetRoomId();
+        summary.currentPlayers = room->GetCurrentPlayerCount();
+        summary.maxPlayers = room->GetMaxPlayers();
+        summary.status = room->GetStatus();
+        summary.titleLength = room->_titleLength;
+        std::memcpy(summary.title, room->_title, sizeof(summary.title));
+
+        if (summary.IsJoinable())
+        {
+            outSnapshot.joinable.push_back(static_cast<uint32_t>(outSnapshot.rooms.size()));
+        }
+        outSnapshot.rooms.push_back(summary);
     }
 
-    auto it = _playerToRoomMap.find(player);
-    if (it == _playerToRoomMap.end())
+    // 제목 순서는 인덱스가 이미 가지고 있으므로 첨자만 옮겨 적음 (정렬 없음)
+    for (const CRoom* room : _titleOrder)
     {
-        return nullptr;
+        outSnapshot.titleOrder.push_back(room->_listIndex);
     }
 
-    return FindRoom(it->second);
+    // 첫 페이지는 목록이 바뀐 버전마다 한 번만 인코딩 (요청마다 다시 하지 않음)
+    outSnapshot.CacheListPayload();
 }
 
-std::shared_ptr<CRoom> CRoomManager::FindRoomByTitle(const std::string& title)
+void CRoomManager::LinkRecent(CRoom* room)
 {
-    for (const auto& room : _roomList)
+    room->_recentPrev = nullptr;
+    room->_recentNext = _recentHead;
+
+    if (_recentHead)
     {
-        if (room->GetTitle() == title)
-            return room;
+        _recentHead->_recentPrev = room;
     }
-    return nullptr;
+    _recentHead = room;
 }
 
-std::list<std::shared_ptr<CRoom>> CRoomManager::GetRoomList() const
+void CRoomManager::UnlinkRecent(CRoom* room)
 {
-    return _roomList;
+    if (room->_recentPrev)
+    {
+        room->_recentPrev->_recentNext = room->_recentNext;
+    }
+    else
+    {
+        _recentHead = room->_recentNext;
+    }
+
+    if (room->_recentNext)
+    {
+        room->_recentNext->_recentPrev = room->_recentPrev;
+    }
+
+    room->_recentPrev = nullptr;
+    room->_recentNext = nullptr;
 }
 
-bool CRoomManager::JoinRoom(int32_t roomId, std::shared_ptr<CPlayer> player)
+bool CRoomManager::JoinRoom(int32_t roomId, CPlayer& player)
 {
-    if (!player)
+    CRoom* room = FindRoom(roomId);
+    if (!room)
     {
         return false;
     }
 
-    // ̹ ٸ 濡 ִ Ȯ
-    if (_playerToRoomMap.find(player) != _playerToRoomMap.end())
+    return JoinRoom(*room, player);
+}
+
+bool CRoomManager::JoinRoom(CRoom& room, CPlayer& player)
+{
+    // 이미 다른 방에 있는지 확인 (삭제된 방의 핸들이면 Get이 nullptr)
+    if (_rooms.Get(player.GetRoomHandle()))
     {
         return false; 
     }
 
-    auto room = FindRoom(roomId);
-    if (!room)
+    if (!room.AddPlayer(player.GetHandle()))
     {
         return false;
     }
 
-    if (!room->AddPlayer(player))
+    player.SetRoomHandle(room.GetHandle());
+    ++_totalPlayers;
+    UpdateJoinableIndex(room);
+    return true;
+}
+
+bool CRoomManager::LeaveRoom(CPlayer& player)
+{
+    CRoom* room = _rooms.Get(player.GetRoomHandle());
+    if (!room)
     {
+        player.SetRoomHandle(RoomHandle());
         return false;
     }
 
-    _playerToRoomMap[player] = roomId;
+    int32_t roomId = room->GetRoomId();
+    room->RemovePlayer(player.GetHandle());
+    player.SetRoomHandle(RoomHandle());
+    --_totalPlayers;
+
+    LOG_INFO("[RoomManager] Player (AccountId: {}, SessionId: {}) left room {}",
+        player.GetAccountId(), player.GetSessionId(), roomId);
+
+    // 방이 비면 자동 삭제
+    if (room->IsEmpty())
+    {
+        DeleteRoom(roomId);
+    }
+    else
+    {
+        UpdateJoinableIndex(*room);
+    }
+
     return true;
 }
 
-bool CRoomManager::LeaveRoom(std::shared_ptr<CPlayer> player)
+bool CRoomManager::TakeSeat(CRoom& room)
 {
-    if (!player)
+    if (!room.AddSeat())
     {
         return false;
     }
 
-    auto it = _playerToRoomMap.find(player);
-    if (it == _playerToRoomMap.end())
+    ++_totalPlayers;
+    UpdateJoinableIndex(room);
+    return true;
+}
+
+bool CRoomManager::ReleaseSeat(RoomHandle handle)
+{
+    CRoom* room = _rooms.Get(handle);
+    if (!room || !room->RemoveSeat())
     {
         return false;
     }
 
-    int32_t roomId = it->second;
-    auto room = FindRoom(roomId);
+    --_totalPlayers;
+
+    // 방이 비면 자동 삭제
+    if (room->IsEmpty())
+    {
+        DeleteRoom(room->GetRoomId());
+    }
+    else
+    {
+        UpdateJoinableIndex(*room);
+    }
+
+    return true;
+}
+
+bool CRoomManager::SetRoomStatus(int32_t roomId, RoomStatus status)
+{
+    CRoom* room = FindRoom(roomId);
     if (!room)
     {
-        _playerToRoomMap.erase(it);
         return false;
     }
 
-    room->RemovePlayer(player);
-    _playerToRoomMap.erase(it);
+    room->SetStatus(status);
+    UpdateJoinableIndex(*room);
+    return true;
+}
 
-    std::cout << "[RoomManager] Player (AccountId: " << player->GetAccountId() 
-              << ", SessionId: " << player->GetSessionId()
-              << ") left room " << roomId << std::endl;
+// 인원/상태가 바뀐 뒤 호출 (빈 자리 수가 바뀌었을 수 있으므로 버킷 갱신 + 목록 버전 증가)
+void CRoomManager::UpdateJoinableIndex(CRoom& room)
+{
+    _quickJoinIndex.Update(room);
+    ++_version;
+}
 
-    //   ڵ 
-    if (room->IsEmpty())
+CRoom* CRoomManager::CreateQuickJoinRoom(int32_t maxPlayers)
+{
+    // 사용자가 같은 제목을 먼저 썼을 수 있으므로 빈 번호를 찾음
+    // 샤드로 나뉘어 있으면 제목 중복 체크가 이 샤드 안에서 끝나도록 이 샤드로 배정되는 제목만 사용
+    char title[ROOM_TITLE_MAX_LEN + 1];
+    do
     {
-        DeleteRoom(roomId);
-    }
+        std::snprintf(title, sizeof(title), "Quick #%u", ++_quickRoomSeq);
+    } while (GetShardOfTitle(title, _shardCount) != _shardIndex || FindRoomByTitle(title));
 
-    return true;
+    return CreateRoom(title, (maxPlayers > 0) ? maxPlayers : QUICK_JOIN_DEFAULT_MAX_PLAYERS);
+}
+
+CRoom* CRoomManager::FindQuickJoinRoom(int32_t maxPlayers) const
+{
+    return _quickJoinIndex.FindBest(maxPlayers);
 }
 
 int32_t CRoomManager::GetRoomCount() const
 {
-    return static_cast<int32_t>(_roomMap.size());
+    return static_cast<int32_t>(_rooms.GetCount());
 }
 
 int32_t CRoomManager::GetTotalPlayerCount() const
 {
-    return static_cast<int32_t>(_playerToRoomMap.size());
+    return _totalPlayers;
 }
\ No newline at end of file
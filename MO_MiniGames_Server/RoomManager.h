@@ -2,53 +2,113 @@
 
 #include "Room.h"
 #include "Player.h"
+#include "HandleTable.h"
+#include "PoolAllocator.h"
+#include "QuickJoinIndex.h"
+#include "RoomListSnapshot.h"
 #include <memory>
-#include <list>
-#include <unordered_map>
-#include <mutex>
+#include <string_view>
 #include <cstdint>
 
-//   Ŭ
+// 방 관리자 클래스
+// 방은 세대 핸들 테이블에 보관. 반환하는 CRoom* 는 그 방이 삭제되기 전까지만 유효하므로
+// 보관이 필요하면 RoomHandle을 저장하고 GetRoom으로 다시 조회할 것
+// 방 슬롯과 인덱스 노드는 모두 미리 잡아둔 풀에서 할당 -> 최대 방 개수 이하에서는 힙 할당 없음
+// 로직 스레드 전용. 다른 스레드는 FillSnapshot으로 게시된 RoomListSnapshot만 읽을 것
+// 샤드로 나눠 쓸 때는 샤드마다 하나씩 두고 각자 다른 스레드에서 사용 (CShardedRoomManager)
+// roomId % shardCount == shardIndex 가 되도록 발급하므로 roomId만 보고 어느 샤드의 방인지 알 수 있음
 class CRoomManager
 {
 public:
-    CRoomManager();
+    explicit CRoomManager(size_t maxRooms, int32_t shardIndex = 0, int32_t shardCount = 1);
     ~CRoomManager();
 
-    //    
-    std::shared_ptr<CRoom> CreateRoom(const std::string& title, int32_t maxPlayers = 10);
+    // 샤드 결정 함수 (아무 스레드). shardCount가 1이면 항상 0
+    static int32_t GetShardOfRoom(int32_t roomId, int32_t shardCount);
+    static int32_t GetShardOfTitle(std::string_view title, int32_t shardCount); // 제목 중복 체크를 샤드 안에서 끝내기 위함
+
+    // 방 생성 및 삭제 (방 풀이 가득 차면 nullptr)
+    CRoom* CreateRoom(std::string_view title, int32_t maxPlayers = ROOM_MAX_PLAYERS);
     bool DeleteRoom(int32_t roomId);
 
-    //  ˻
-    std::shared_ptr<CRoom> FindRoom(int32_t roomId);
-    std::shared_ptr<CRoom> FindRoomByPlayer(std::shared_ptr<CPlayer> player);
+    // 방 검색
+    CRoom* GetRoom(RoomHandle handle); // 핸들 검증만 (해싱 없음)
+    CRoom* FindRoom(int32_t roomId);   // 클라가 보낸 roomId로 조회
+    CRoom* FindRoomByPlayer(const CPlayer& player);
+
+    // 방 이름으로 방 찾기 (중복 체크용)
+    CRoom* FindRoomByTitle(std::string_view title);
+
+    // 방 목록 스냅샷 채우기 (최근 생성 순, 첫 페이지 S2C_ROOM_LIST 본문 인코딩 포함). 목록이 바뀔 때마다 GetVersion이 올라감
+    void FillSnapshot(RoomListSnapshot& outSnapshot) const;
+    uint64_t GetVersion() const { return _version; }
+
+    // 방 상태 변경 (인덱스 갱신을 위해 RoomManager를 통해서 변경)
+    bool SetRoomStatus(int32_t roomId, RoomStatus status);
 
-    //  ̸  ã (ߺ üũ)
-    std::shared_ptr<CRoom> FindRoomByTitle(const std::string& title);
+    // 플레이어 입장/퇴장 (플레이어의 방 핸들도 같이 갱신)
+    bool JoinRoom(int32_t roomId, CPlayer& player);
+    bool JoinRoom(CRoom& room, CPlayer& player);
+    bool LeaveRoom(CPlayer& player);
 
-    //   ȸ (ֱ  )
-    std::list<std::shared_ptr<CRoom>> GetRoomList() const;
+    // 디렉터리 좌석 (플레이어 객체 없이 인원만). 방 안 상태(멤버, 방장)를 방 액터가 가지는 모드용
+    // 마지막 좌석을 비우면 LeaveRoom처럼 방 삭제. 방이 없거나 가득 찼으면 false
+    bool TakeSeat(CRoom& room);
+    bool ReleaseSeat(RoomHandle handle);
 
-    // ÷̾ / (CPlayer )
-    bool JoinRoom(int32_t roomId, std::shared_ptr<CPlayer> player);
-    bool LeaveRoom(std::shared_ptr<CPlayer> player);
+    // 빠른 입장 (CRoomRequestHandler가 판정과 입장을 나눠서 씀). maxPlayers: 0이면 인원 조건 없음
+    CRoom* FindQuickJoinRoom(int32_t maxPlayers) const; // 빈 자리가 가장 적은 입장 가능한 방
+    CRoom* CreateQuickJoinRoom(int32_t maxPlayers);     // 맞는 방이 없을 때 "Quick #n" 방 생성 (방 풀이 가득 차면 nullptr)
 
-    // 
+    // 통계
+    int32_t GetShardIndex() const { return _shardIndex; }
     int32_t GetRoomCount() const;
     int32_t GetTotalPlayerCount() const;
+    size_t GetMaxRoomCount() const { return _rooms.GetCapacity(); }
+    PoolStats GetRoomPoolStats() const { return _rooms.GetStats(); }
+    size_t GetIndexPoolBytes() const { return _indexPool.GetReservedBytes(); }
 
 private:
-    std::atomic<int32_t> _roomIdCounter;
-    
-    // ֱ    (Ʈ)
-    std::list<std::shared_ptr<CRoom>> _roomList;
-    
-    //  ˻   <roomId, CRoom>
-    std::unordered_map<int32_t, std::shared_ptr<CRoom>> _roomMap;
-    
-    // ÷̾   (÷̾   濡 ִ) <player, roomId>
-    std::unordered_map<std::shared_ptr<CPlayer>, int32_t> _playerToRoomMap;
-    
-    // const Լ    ֵ mutable 
-    mutable std::mutex _mutex;
+    // 최근 생성 순 리스트 (CRoom 안의 링크 사용)
+    void LinkRecent(CRoom* room);
+    void UnlinkRecent(CRoom* room);
+
+    void UpdateJoinableIndex(CRoom& room);
+
+    int32_t _shardIndex;
+    int32_t _shardCount;
+    int32_t _roomSeq; // 이 샤드에서 만든 방 번호 (roomId = _roomSeq * _shardCount + _shardIndex)
+
+    // 방 저장소 (고정 용량 풀, 슬롯 재사용, 주소 고정)
+    CHandleTable<CRoom> _rooms;
+
+    // 아래 인덱스 컨테이너들의 노드 풀 (컨테이너보다 먼저 생성, 나중에 소멸되도록 선언 순서 유지)
+    CNodePool _indexPool;
+
+    // 최근 생성 순 리스트의 머리 (가장 최근 방)
+    CRoom* _recentHead;
+
+    // 클라가 보낸 roomId -> 핸들 (외부 입력 조회용. 내부 경로는 핸들 사용)
+    TPoolUnorderedMap<int32_t, RoomHandle> _roomIdMap;
+
+    // 제목 해시 인덱스 <title, 핸들> (중복 체크용)
+    // 키는 CRoom::_title을 가리키는 string_view. 방 주소가 고정이고 살아있는 동안만 맵에 있으므로 안전
+    TPoolUnorderedMap<std::string_view, RoomHandle> _titleMap;
+
+    // 제목 순 인덱스 (목록 스냅샷의 titleOrder용). 생성/삭제 때만 O(log N)으로 갱신하므로 게시할 때 정렬하지 않음
+    struct RoomTitleLess
+    {
+        bool operator()(const CRoom* a, const CRoom* b) const { return a->GetTitle() < b->GetTitle(); }
+    };
+    TPoolSet<CRoom*, RoomTitleLess> _titleOrder;
+
+    // 입장 가능한 방 (WAITING && !IsFull)을 [maxPlayers][빈 자리] 버킷으로 나눈 인덱스 (빠른 입장용)
+    CQuickJoinIndex _quickJoinIndex;
+    uint32_t _quickRoomSeq; // 빠른 입장으로 만든 방 제목 번호
+
+    // 방에 들어가 있는 플레이어 수 (플레이어별 방은 CPlayer::GetRoomHandle)
+    int32_t _totalPlayers;
+
+    // 목록에 보이는 값(방 추가/삭제, 인원, 상태)이 바뀔 때마다 증가
+    uint64_t _version;
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// __________________________________________________________________
+//
+// 플레이어 - 방 멤버십 테이블 (lock-free, 아무 스레드)
+// 세션 슬롯 index마다 64비트 원자 변수 하나: [세션 태그 30비트 | 상태 2비트 | 값 32비트]
+//  - NONE    : 방에 없음
+//  - PENDING : 입장 계열 요청 처리 중. 값은 그 요청을 가진 샤드 (빠른 입장이 샤드를 넘어가면 같이 바뀜)
+//  - JOINED  : 값은 입장한 방 (분산형: roomId, 통합 스트랜드: 방 액터 주소)
+// 상태 전이는 모두 CAS이므로 한 세션의 입장 요청이 두 샤드에서 동시에 처리되지 않음
+// 태그가 다르면 같은 슬롯을 쓰던 이전 세션의 흔적이라 NONE으로 봄
+// (이전 세션을 처리하던 샤드가 나중에 상태를 바꾸려 해도 CAS가 실패하므로 새 세션 상태를 덮지 않음)
+// 비트 분리는 호출하는 쪽에서 (CSessionSlotTable과 같음)
+// __________________________________________________________________
+
+class CRoomMembershipTable
+{
+public:
+    enum class State : uint8_t
+    {
+        NONE = 0,
+        PENDING = 1,
+        JOINED = 2
+    };
+
+    struct Entry
+    {
+        State state = State::NONE;
+        int32_t value = 0; // PENDING: 샤드 index, JOINED: roomId 또는 방 액터 주소
+    };
+
+    explicit CRoomMembershipTable(size_t capacity)
+        : _entries(std::make_unique<std::atomic<uint64_t>[]>(capacity))
+        , _capacity(capacity)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            _entries[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    CRoomMembershipTable(const CRoomMembershipTable&) = delete;
+    CRoomMembershipTable& operator=(const CRoomMembershipTable&) = delete;
+
+    Entry Get(uint16_t index, int64_t uniqueId) const
+    {
+        Entry entry;
+        if (index >= _capacity)
+            return entry;
+
+        uint64_t word = _entries[index].load();
+        if ((word >> TAG_SHIFT) != Tag(uniqueId))
+            return entry; // 이전 세션의 흔적
+
+        entry.state = static_cast<State>((word >> STATE_SHIFT) & STATE_MASK);
+        entry.value = static_cast<int32_t>(static_cast<uint32_t>(word));
+        return entry;
+    }
+
+    // NONE -> PENDING(shardIndex). 이미 방에 있거나 다른 요청이 처리 중이면 false
+    bool TryReserve(uint16_t index, int64_t uniqueId, int32_t shardIndex)
+    {
+        return TryClaim(index, uniqueId, State::PENDING, shardIndex);
+    }
+
+    // NONE -> JOINED(value). 쓰는 쪽이 하나뿐이라 예약 단계가 필요 없을 때 (통합 스트랜드의 로비)
+    bool TryJoin(uint16_t index, int64_t uniqueId, int32_t value)
+    {
+        return TryClaim(index, uniqueId, State::JOINED, value);
+    }
+
+    // PENDING(fromShard) -> PENDING(toShard) (요청을 다른 샤드로 넘길 때)
+    bool MovePending(uint16_t index, int64_t uniqueId, int32_t fromShard, int32_t toShard)
+    {
+        return Transition(index, Pack(uniqueId, State::PENDING, fromShard), Pack(uniqueId, State::PENDING, toShard));
+    }
+
+    // PENDING(shardIndex) -> JOINED(roomId)
+    bool Commit(uint16_t index, int64_t uniqueId, int32_t shardIndex, int32_t roomId)
+    {
+        return Transition(index, Pack(uniqueId, State::PENDING, shardIndex), Pack(uniqueId, State::JOINED, roomId));
+    }
+
+    // PENDING(shardIndex) -> NONE (입장 실패)
+    bool Cancel(uint16_t index, int64_t uniqueId, int32_t shardIndex)
+    {
+        return Transition(index, Pack(uniqueId, State::PENDING, shardIndex), Pack(uniqueId, State::NONE, 0));
+    }
+
+    // JOINED(roomId) -> NONE (퇴장)
+    bool Release(uint16_t index, int64_t uniqueId, int32_t roomId)
+    {
+        return Transition(index, Pack(uniqueId, State::JOINED, roomId), Pack(uniqueId, State::NONE, 0));
+    }
+
+    size_t GetCapacity() const { return _capacity; }
+
+private:
+    static constexpr int TAG_SHIFT = 34;
+    static constexpr int STATE_SHIFT = 32;
+    static constexpr uint64_t STATE_MASK = 0x3;
+    static constexpr uint64_t TAG_MASK = (1ULL << (64 - TAG_SHIFT)) - 1;
+
+    static uint64_t Tag(int64_t uniqueId)
+    {
+        return static_cast<uint64_t>(uniqueId) & TAG_MASK;
+    }
+
+    static uint64_t Pack(int64_t uniqueId, State state, int32_t value)
+    {
+        return (Tag(uniqueId) << TAG_SHIFT)
+            | (static_cast<uint64_t>(state) << STATE_SHIFT)
+            | static_cast<uint32_t>(value);
+    }
+
+    // 같은 세션이 NONE일 때만 (이전 세션의 흔적은 덮어씀)
+    bool TryClaim(uint16_t index, int64_t uniqueId, State state, int32_t value)
+    {
+        if (index >= _capacity)
+            return false;
+
+        uint64_t desired = Pack(uniqueId, state, value);
+        uint64_t word = _entries[index].load();
+        while (true)
+        {
+            bool sameSession = (word >> TAG_SHIFT) == Tag(uniqueId);
+            if (sameSession && static_cast<State>((word >> STATE_SHIFT) & STATE_MASK) != State::NONE)
+                return false;
+
+            // 실패하면 word가 현재 값으로 갱신되므로 다시 판단
+            if (_entries[index].compare_exchange_weak(word, desired))
+                return true;
+        }
+    }
+
+    bool Transition(uint16_t index, uint64_t expected, uint64_t desired)
+    {
+        if (index >= _capacity)
+            return false;
+
+        return _entries[index].compare_exchange_strong(expected, desired);
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> _entries;
+    size_t _capacity;
+};
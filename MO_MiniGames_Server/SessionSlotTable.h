@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// __________________________________________________________________
+//
+// 세션 슬롯 테이블
+// 세션 ID = 16비트 슬롯 index + 48비트 uniqueId (CSession::MakeSessionId)
+// 네트워크 레이어가 이미 index를 0 ~ maxClients-1 범위로 발급하므로 index를 그대로 배열 첨자로 쓰고,
+// 같은 슬롯을 재사용한 이전 세션과는 uniqueId로 구분한다 -> 해싱 없이 배열 접근 1번 + 정수 비교 1번
+// 비트 분리는 호출하는 쪽에서 (CSession 헤더 의존 없이 벤치에서도 사용)
+// 단일 스레드(게임 로직 스레드) 전용
+// __________________________________________________________________
+
+template <typename T>
+class CSessionSlotTable
+{
+public:
+    explicit CSessionSlotTable(size_t capacity)
+        : _entries(std::make_unique<Entry[]>(capacity))
+        , _capacity(capacity)
+        , _count(0)
+    {
+    }
+
+    CSessionSlotTable(const CSessionSlotTable&) = delete;
+    CSessionSlotTable& operator=(const CSessionSlotTable&) = delete;
+
+    // 슬롯이 비어있을 때만 성공 (이전 세션이 남아있으면 false, Peek으로 확인 후 정리할 것)
+    bool Insert(uint16_t index, int64_t uniqueId, T* value)
+    {
+        if (index >= _capacity || !value || _entries[index].value)
+            return false;
+
+        _entries[index].uniqueId = uniqueId;
+        _entries[index].value = value;
+        ++_count;
+        return true;
+    }
+
+    T* Find(uint16_t index, int64_t uniqueId) const
+    {
+        if (index >= _capacity)
+            return nullptr;
+
+        const Entry& entry = _entries[index];
+        return (entry.uniqueId == uniqueId) ? entry.value : nullptr;
+    }
+
+    // uniqueId와 관계없이 슬롯에 들어있는 값 (슬롯 재사용 시 남은 세션 정리용)
+    T* Peek(uint16_t index) const
+    {
+        return (index < _capacity) ? _entries[index].value : nullptr;
+    }
+
+    bool Erase(uint16_t index, int64_t uniqueId)
+    {
+        if (!Find(index, uniqueId))
+            return false;
+
+        _entries[index] = Entry();
+        --_count;
+        return true;
+    }
+
+    size_t GetCount() const { return _count; }
+    size_t GetCapacity() const { return _capacity; }
+
+private:
+    struct Entry
+    {
+        int64_t uniqueId = -1; // uniqueId는 48비트 양수이므로 -1은 빈 슬롯
+        T* value = nullptr;
+    };
+
+    std::unique_ptr<Entry[]> _entries;
+    size_t _capacity;
+    size_t _count;
+};
@@ -0,0 +1,28 @@
+#include "ShardedRoomManager.h"
+#include <algorithm>
+
+CShardedRoomManager::CShardedRoomManager(int32_t shardCount, size_t maxRoomsPerShard, size_t maxSessions)
+    : _shardCount((std::max)(1, (std::min)(shardCount, ROOM_SHARD_MAX_COUNT)))
+    , _shards()
+    , _membership(maxSessions)
+{
+    // 샤드마다 따로 할당 (서로 다른 스레드가 쓰는 풀과 인덱스가 같은 캐시 라인에 섞이지 않게)
+    _shards.reserve(_shardCount);
+    for (int32_t i = 0; i < _shardCount; ++i)
+    {
+        _shards.push_back(std::make_unique<CRoomManager>(maxRoomsPerShard, i, _shardCount));
+    }
+}
+
+int32_t CShardedRoomManager::GetOwnerShard(const CRoomMembershipTable::Entry& entry) const
+{
+    switch (entry.state)
+    {
+    case CRoomMembershipTable::State::PENDING:
+        return entry.value;
+    case CRoomMembershipTable::State::JOINED:
+        return GetShardOfRoom(entry.value);
+    default:
+        return -1;
+    }
+}
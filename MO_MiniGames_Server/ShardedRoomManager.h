@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "RoomManager.h"
+#include "RoomMembershipTable.h"
+#include "RoomListSnapshot.h"
+
+// 최대 샤드 수 (방 목록 페이지를 샤드별 스냅샷에서 합쳐 만들 수 있는 개수)
+constexpr int32_t ROOM_SHARD_MAX_COUNT = ROOM_LIST_MAX_MERGE;
+
+// __________________________________________________________________
+//
+// 샤드로 나눈 방 관리자 (분산형 / Partitioned)
+// 샤드마다 독립된 CRoomManager를 두고 샤드 하나를 스레드 하나가 맡음 -> 샤드 간 공유 상태나 락이 없음
+//  - 방: roomId % shardCount 샤드 (roomId를 샤드가 발급)
+//  - 방 생성: 제목 해시로 샤드를 정하므로 제목 중복 체크가 그 샤드 안에서 끝남
+//  - 빠른 입장: 세션의 홈 샤드부터 한 칸씩 넘기며 찾고, 끝까지 없으면 마지막 샤드에서 생성
+//  - 플레이어 - 방 멤버십: lock-free 테이블 (CRoomMembershipTable)
+//    라우팅하는 쪽(IOCP 워커)이 대상 샤드로 예약한 뒤 요청을 넘기고, 샤드가 확정/취소
+// 샤드 결정 함수와 멤버십 테이블은 아무 스레드, GetShard로 얻은 CRoomManager는 그 샤드 스레드 전용
+// __________________________________________________________________
+
+class CShardedRoomManager
+{
+public:
+    // maxRoomsPerShard: 제목 해시가 한 샤드로 몰려도 받을 수 있게 보통 최대 접속자 수
+    CShardedRoomManager(int32_t shardCount, size_t maxRoomsPerShard, size_t maxSessions);
+
+    CShardedRoomManager(const CShardedRoomManager&) = delete;
+    CShardedRoomManager& operator=(const CShardedRoomManager&) = delete;
+
+    int32_t GetShardCount() const { return _shardCount; }
+    CRoomManager& GetShard(int32_t shardIndex) { return *_shards[shardIndex]; }
+
+    // 샤드 결정 (아무 스레드)
+    int32_t GetShardOfRoom(int32_t roomId) const { return CRoomManager::GetShardOfRoom(roomId, _shardCount); }
+    int32_t GetShardOfTitle(std::string_view title) const { return CRoomManager::GetShardOfTitle(title, _shardCount); }
+    int32_t GetHomeShard(uint16_t sessionIndex) const { return sessionIndex % _shardCount; }
+    int32_t GetNextShard(int32_t shardIndex) const { return (shardIndex + 1) % _shardCount; }
+
+    // 멤버십이 가리키는 샤드 (NONE이면 -1)
+    int32_t GetOwnerShard(const CRoomMembershipTable::Entry& entry) const;
+
+    CRoomMembershipTable& GetMembership() { return _membership; }
+
+private:
+    int32_t _shardCount;
+    std::vector<std::unique_ptr<CRoomManager>> _shards;
+    CRoomMembershipTable _membership;
+};
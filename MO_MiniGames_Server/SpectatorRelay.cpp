@@ -0,0 +1,490 @@
+#include "SpectatorRelay.h"
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cstring>
+
+// 릴레이 제어 메일박스 크기 (로비만 넣고 구독 전에 자리를 확인하므로 넘치지 않음)
+// 붙이기 + 구독 + 구독자 전원 제거 + 자식 추가 + 정리가 항상 들어가야 하고, 나머지는 구독/제거가 몰릴 때의 여유
+constexpr size_t SPECTATOR_RELAY_CONTROL_CAPACITY = SPECTATOR_RELAY_SESSIONS * 2 + SPECTATOR_RELAY_CHILDREN + 4;
+static_assert(SPECTATOR_RELAY_CONTROL_CAPACITY >= 2 + SPECTATOR_RELAY_SESSIONS + SPECTATOR_RELAY_CHILDREN + 1,
+    "control mailbox must fit attach + subscribe + every unsubscribe + every child + reset");
+
+// __________________________________________________________________
+//
+// 관전 릴레이
+// __________________________________________________________________
+
+CSpectatorRelay::CSpectatorRelay(CActorWorkerPool& pool, uint32_t index, SpectatorSender sender)
+    : CActor(pool)
+    , _index(index)
+    , _sender(std::move(sender))
+    , _control(SPECTATOR_RELAY_CONTROL_CAPACITY)
+    , _frames(SPECTATOR_FRAMES_IN_FLIGHT)
+    , _roomId(-1)
+    , _subscribers()
+    , _subscriberCount(0)
+    , _children()
+    , _childGap()
+    , _childCount(0)
+    , _sent(0)
+    , _dropped(0)
+{
+}
+
+CSpectatorRelay::~CSpectatorRelay()
+{
+    // 종료 시 남은 메시지의 참조를 돌려줌 (방 액터가 먼저 소멸해도 버퍼를 건드리지 않도록 소멸 순서는 서버가 보장)
+    while (_frames.TryConsume([](const SpectatorRelayFrame& msg) { msg.frame->Release(); }))
+    {
+    }
+}
+
+bool CSpectatorRelay::HasRoomForSubscribe(int32_t postCount, int32_t subscribersAfter) const
+{
+    size_t required = static_cast<size_t>(postCount) + static_cast<size_t>(subscribersAfter) + SPECTATOR_RELAY_CHILDREN + 1; // +1: 정리
+    return _control.GetFreeCount() >= required;
+}
+
+bool CSpectatorRelay::PostAttach(int32_t roomId)
+{
+    return PostControl(SpectatorRelayControl::Type::ATTACH, -1, roomId, nullptr);
+}
+
+bool CSpectatorRelay::PostSubscribe(int64_t sessionId)
+{
+    return PostControl(SpectatorRelayControl::Type::SUBSCRIBE, sessionId, -1, nullptr);
+}
+
+bool CSpectatorRelay::PostUnsubscribe(int64_t sessionId)
+{
+    return PostControl(SpectatorRelayControl::Type::UNSUBSCRIBE, sessionId, -1, nullptr);
+}
+
+bool CSpectatorRelay::PostAddChild(CSpectatorRelay* child)
+{
+    return PostControl(SpectatorRelayControl::Type::ADD_CHILD, -1, -1, child);
+}
+
+bool CSpectatorRelay::PostReset()
+{
+    return PostControl(SpectatorRelayControl::Type::RESET, -1, -1, nullptr);
+}
+
+bool CSpectatorRelay::PostControl(SpectatorRelayControl::Type type, int64_t sessionId, int32_t roomId, CSpectatorRelay* child)
+{
+    bool pushed = _control.TryPush([&](SpectatorRelayControl& msg)
+    {
+        msg.type = type;
+        msg.sessionId = sessionId;
+        msg.roomId = roomId;
+        msg.child = child;
+    });
+
+    if (!pushed)
+    {
+        // 로비가 HasRoomForSubscribe로 자리를 확인하므로 정상적으로는 오지 않는 경로
+        LOG_ERROR("[SpectatorRelay] Control mailbox full - Relay: {}, Type: {}", _index, static_cast<int>(type));
+        return false;
+    }
+
+    Notify();
+    return true;
+}
+
+bool CSpectatorRelay::PostFrame(SpectatorFrame* frame, bool gap)
+{
+    bool pushed = _frames.TryPush([&](SpectatorRelayFrame& msg)
+    {
+        msg.frame = frame;
+        msg.gap = gap;
+    });
+
+    if (pushed)
+    {
+        Notify();
+    }
+    return pushed;
+}
+
+void CSpectatorRelay::ProcessMessages(size_t budget)
+{
+    // 붙이기/구독을 먼저 반영해야 그 뒤에 넘어온 메시지를 새 구독자에게도 보냄
+    DrainControl();
+
+    for (size_t i = 0; i < budget; ++i)
+    {
+        if (!_frames.TryConsume([this](const SpectatorRelayFrame& msg) { HandleFrame(msg); }))
+        {
+            break;
+        }
+    }
+}
+
+bool CSpectatorRelay::HasPendingMessages() const
+{
+    return _control.HasPending() || _frames.HasPending();
+}
+
+void CSpectatorRelay::DrainControl()
+{
+    while (_control.TryConsume([this](const SpectatorRelayControl& msg) { HandleControl(msg); }))
+    {
+    }
+}
+
+void CSpectatorRelay::HandleControl(const SpectatorRelayControl& msg)
+{
+    switch (msg.type)
+    {
+    case SpectatorRelayControl::Type::ATTACH:
+        _roomId = msg.roomId;
+        break;
+
+    case SpectatorRelayControl::Type::SUBSCRIBE:
+        if (_subscriberCount >= SPECTATOR_RELAY_SESSIONS)
+        {
+            // 로비가 릴레이마다 인원을 세므로 정상적으로는 오지 않는 경로
+            LOG_ERROR("[SpectatorRelay] Subscriber table full - Relay: {}, SessionId: {}", _index, msg.sessionId);
+            break;
+        }
+        _subscribers[_subscriberCount++] = Subscriber{ msg.sessionId, true };
+        break;
+
+    case SpectatorRelayControl::Type::UNSUBSCRIBE:
+        for (int32_t i = 0; i < _subscriberCount; ++i)
+        {
+            if (_subscribers[i].sessionId == msg.sessionId)
+            {
+                _subscribers[i] = _subscribers[--_subscriberCount];
+                break;
+            }
+        }
+        break;
+
+    case SpectatorRelayControl::Type::ADD_CHILD:
+        if (_childCount >= SPECTATOR_RELAY_CHILDREN || !msg.child)
+        {
+            LOG_ERROR("[SpectatorRelay] Child table full - Relay: {}", _index);
+            break;
+        }
+        _childGap[_childCount] = false; // 새 자식의 구독자는 어차피 키프레임부터
+        _children[_childCount++] = msg.child;
+        break;
+
+    case SpectatorRelayControl::Type::RESET:
+        _roomId = -1;
+        _subscriberCount = 0;
+        _childCount = 0;
+        break;
+    }
+}
+
+void CSpectatorRelay::HandleFrame(const SpectatorRelayFrame& msg)
+{
+    // 붙이기/구독 직후 넘어온 메시지가 그 제어 메시지보다 먼저 보일 수 있음 (제어 메일박스를 다 비운 뒤 들어온 경우)
+    // 로비가 구독을 넣은 뒤 키프레임을 요청하므로 여기서 한 번 더 비워야 새 구독자가 그 키프레임을 받음
+    DrainControl();
+
+    SpectatorFrame* frame = msg.frame;
+    if (frame->roomId != _roomId)
+    {
+        frame->Release(); // 트리에서 빠졌거나 다른 방으로 옮긴 뒤 도착한 이전 방의 메시지
+        return;
+    }
+
+    // 자식 먼저 (다른 워커가 바로 다음 단계를 시작하도록). 바이트는 복사하지 않고 참조만 넘김
+    for (int32_t i = 0; i < _childCount; ++i)
+    {
+        frame->AddRef();
+        if (_children[i]->PostFrame(frame, msg.gap || _childGap[i]))
+        {
+            _childGap[i] = false;
+        }
+        else
+        {
+            frame->Release();
+            _childGap[i] = true;
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t sent = 0;
+    for (int32_t i = 0; i < _subscriberCount; ++i)
+    {
+        Subscriber& subscriber = _subscribers[i];
+        if (msg.gap)
+        {
+            subscriber.waitingKeyframe = true;
+        }
+        if (subscriber.waitingKeyframe && frame->keyframe)
+        {
+            subscriber.waitingKeyframe = false;
+        }
+        if (subscriber.waitingKeyframe && !frame->broadcast)
+        {
+            continue; // 기준 상태가 없는 델타는 보내지 않음
+        }
+
+        _sender(subscriber.sessionId, frame->data, frame->size);
+        ++sent;
+    }
+
+    _sent.fetch_add(sent, std::memory_order_relaxed);
+    frame->Release();
+}
+
+// __________________________________________________________________
+//
+// 관전 스트림
+// __________________________________________________________________
+
+CSpectatorFeed::CSpectatorFeed(uint32_t delayFrames)
+    : _delayFrames((std::min)(delayFrames, SPECTATOR_MAX_DELAY_FRAMES))
+    , _stream()
+    , _pool()
+    , _delayed()
+    , _poolSize(0)
+    , _poolCursor(0)
+    , _delayedHead(0)
+    , _delayedCount(0)
+    , _roomId(-1)
+    , _running(false)
+    , _clockBase(0)
+    , _draining(false)
+    , _drainStart()
+    , _nextEncodeFrame(0)
+    , _lastRoot(nullptr)
+    , _rootGap(false)
+    , _root(nullptr)
+    , _keyframeRequested(false)
+    , _encoded(0)
+    , _skipped(0)
+    , _delivered(0)
+{
+}
+
+void CSpectatorFeed::StartGame(int32_t roomId, int32_t playerCount)
+{
+    // 이전 게임의 지연 큐가 남았으면 지금 시계에서 이어감 (남은 메시지는 이번 게임 확정 프레임에 맞춰 계속 나감)
+    if (_draining)
+    {
+        Drain(std::chrono::steady_clock::now());
+        _draining = false;
+    }
+    else
+    {
+        _clockBase = 0;
+    }
+
+    _roomId = roomId;
+    _running = true;
+    _nextEncodeFrame = 0;
+
+    // 인원이 적으면 떨어지는 블록까지, 많으면 고정된 칸만 (관전 화면에서 보드가 작아짐)
+    _stream.Reset(playerCount);
+    if (playerCount <= SPECTATOR_FULL_DETAIL_PLAYERS)
+    {
+        for (int32_t board = 0; board < playerCount; ++board)
+        {
+            _stream.SetDetail(board, BoardStreamDetail::FULL);
+        }
+    }
+}
+
+void CSpectatorFeed::OnConfirmedFrames(uint32_t confirmedFrames, const CTetrisBoardBatch& boards)
+{
+    if (!_running)
+    {
+        return;
+    }
+
+    if (confirmedFrames >= _nextEncodeFrame && confirmedFrames > 0)
+    {
+        _nextEncodeFrame = confirmedFrames + SPECTATOR_STREAM_INTERVAL;
+        EncodeStream(confirmedFrames, boards);
+    }
+
+    ReleaseDue(_clockBase + confirmedFrames);
+}
+
+void CSpectatorFeed::EndGame(uint32_t confirmedFrames, const CTetrisBoardBatch& boards, const char* gameOverMsg, size_t size)
+{
+    if (!_running)
+    {
+        return;
+    }
+    _running = false;
+
+    uint32_t clock = _clockBase + confirmedFrames;
+    if (_root.load() && confirmedFrames > 0)
+    {
+        // 지연 중인 화면은 그대로 두고 뒤에 붙임 (한꺼번에 넘기지 않고 Drain이 같은 간격으로 넘김)
+        EncodeStream(confirmedFrames, boards);
+
+        if (SpectatorFrame* frame = AcquireFrame())
+        {
+            std::memcpy(frame->data, gameOverMsg, size);
+            frame->size = static_cast<uint16_t>(size);
+            frame->roomId = _roomId;
+            frame->frame = clock;
+            frame->keyframe = false;
+            frame->broadcast = true;
+            frame->refs.store(1, std::memory_order_relaxed);
+            _delayed[(_delayedHead + _delayedCount++) % _poolSize] = frame;
+        }
+    }
+
+    // 이제부터는 실제 시간이 시계
+    _clockBase = clock;
+    _drainStart = std::chrono::steady_clock::now();
+    ReleaseDue(clock);
+    _draining = _delayedCount > 0;
+}
+
+void CSpectatorFeed::Drain(std::chrono::steady_clock::time_point now)
+{
+    if (!_draining)
+    {
+        return;
+    }
+
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _drainStart).count();
+    uint32_t elapsedFrames = static_cast<uint32_t>((std::max)(elapsed, int64_t(0)) * TETRIS_FRAME_RATE / 1000000000LL);
+    ReleaseDue(_clockBase + elapsedFrames);
+
+    if (_delayedCount == 0)
+    {
+        _draining = false;
+        _clockBase = 0;
+    }
+    else if (elapsedFrames > 0)
+    {
+        // 다음 호출은 여기서부터 (시계를 틱마다 다시 계산하지 않도록 기준을 옮김)
+        _clockBase += elapsedFrames;
+        _drainStart += std::chrono::nanoseconds(static_cast<int64_t>(elapsedFrames) * 1000000000LL / TETRIS_FRAME_RATE);
+    }
+}
+
+void CSpectatorFeed::Stop()
+{
+    _running = false;
+    _draining = false;
+    _clockBase = 0;
+    while (_delayedCount > 0)
+    {
+        _delayed[_delayedHead]->Release();
+        _delayedHead = (_delayedHead + 1) % _poolSize;
+        --_delayedCount;
+    }
+}
+
+bool CSpectatorFeed::EncodeStream(uint32_t confirmedFrames, const CTetrisBoardBatch& boards)
+{
+    // 관전자가 없으면 인코딩도 하지 않음 (다시 생기면 키프레임부터)
+    CSpectatorRelay* root = _root.load();
+    if (!root)
+    {
+        _lastRoot = nullptr;
+        return false;
+    }
+
+    SpectatorFrame* frame = AcquireFrame();
+    if (!frame)
+    {
+        ++_skipped;
+        return false;
+    }
+
+    if (root != _lastRoot)
+    {
+        _lastRoot = root;
+        _stream.RequestKeyframe();
+    }
+    if (_keyframeRequested.exchange(false))
+    {
+        _stream.RequestKeyframe();
+    }
+
+    CMsgWriter writer(frame->data, sizeof(frame->data), sizeof(MsgHeader));
+    if (!_stream.Encode(confirmedFrames - 1, boards, writer))
+    {
+        return false; // 바뀐 보드가 없음 (버퍼는 참조 0 그대로 다시 씀)
+    }
+
+    MsgHeader* header = reinterpret_cast<MsgHeader*>(frame->data);
+    header->size = static_cast<uint16_t>(writer.GetSize());
+    header->type = MsgType::S2C_BOARD_STREAM;
+
+    frame->size = static_cast<uint16_t>(writer.GetSize());
+    frame->roomId = _roomId;
+    frame->frame = _clockBase + confirmedFrames;
+    frame->keyframe = _stream.WasKeyframe();
+    frame->broadcast = false;
+    frame->refs.store(1, std::memory_order_relaxed); // 지연 큐가 가진 참조
+    _delayed[(_delayedHead + _delayedCount++) % _poolSize] = frame;
+
+    ++_encoded;
+    return true;
+}
+
+SpectatorFrame* CSpectatorFeed::AcquireFrame()
+{
+    if (!_pool)
+    {
+        // 지연 동안 쌓이는 메시지 + 릴레이가 아직 보내는 중인 메시지 + 게임 종료 때의 마지막 화면 / 종료 메시지
+        _poolSize = (_delayFrames + SPECTATOR_STREAM_INTERVAL - 1) / SPECTATOR_STREAM_INTERVAL + SPECTATOR_FRAMES_IN_FLIGHT + 2;
+        _pool = std::make_unique<SpectatorFrame[]>(_poolSize);
+        _delayed = std::make_unique<SpectatorFrame*[]>(_poolSize);
+    }
+
+    // 참조가 0인 버퍼 = 지연 큐에도 없고 어느 릴레이도 보내고 있지 않음
+    for (size_t i = 0; i < _poolSize; ++i)
+    {
+        SpectatorFrame& frame = _pool[_poolCursor];
+        _poolCursor = (_poolCursor + 1) % _poolSize;
+        if (frame.refs.load(std::memory_order_acquire) == 0)
+        {
+            return &frame;
+        }
+    }
+    return nullptr;
+}
+
+void CSpectatorFeed::ReleaseDue(uint32_t clock)
+{
+    while (_delayedCount > 0)
+    {
+        SpectatorFrame* frame = _delayed[_delayedHead];
+        if (clock < frame->frame + _delayFrames)
+        {
+            break;
+        }
+
+        _delayedHead = (_delayedHead + 1) % _poolSize;
+        --_delayedCount;
+        Deliver(frame);
+    }
+}
+
+void CSpectatorFeed::Deliver(SpectatorFrame* frame)
+{
+    // 지연 중에 트리가 바뀌었어도 새 트리의 구독자는 키프레임을 기다리므로 그대로 넘김
+    CSpectatorRelay* root = _root.load();
+    if (!root)
+    {
+        frame->Release();
+        return;
+    }
+
+    if (root->PostFrame(frame, _rootGap))
+    {
+        _rootGap = false;
+        ++_delivered;
+        return;
+    }
+
+    // 첫 릴레이가 밀려 있음 -> 이 메시지는 버리고 다음 메시지부터 키프레임을 기다리게 함
+    frame->Release();
+    _rootGap = true;
+    _stream.RequestKeyframe();
+}
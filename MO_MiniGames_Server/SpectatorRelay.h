@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "ActorScheduler.h"
+#include "BoardStream.h"
+#include "BoundedMailbox.h"
+
+// 릴레이 하나가 직접 보내는 관전 세션 수 / 다음 단계로 넘기는 자식 릴레이 수
+// 방 액터는 첫 릴레이 하나에만 넘기므로 관전자가 몇 명이든 방 쪽 비용은 같음 (한 단계 아래로 갈 때마다 x4)
+constexpr int32_t SPECTATOR_RELAY_SESSIONS = 64;
+constexpr int32_t SPECTATOR_RELAY_CHILDREN = 4;
+
+// 관전 스트림 인코딩 간격 (확정 프레임, 3 = 20Hz). 그 사이 변화는 다음 델타에 합쳐짐
+constexpr uint32_t SPECTATOR_STREAM_INTERVAL = 3;
+
+// 관전 지연 최대 (확정 프레임, 10초). 지연만큼의 인코딩된 메시지를 방 액터가 들고 있음
+constexpr uint32_t SPECTATOR_MAX_DELAY_FRAMES = 600;
+
+// 릴레이로 넘겼지만 아직 모든 세션에 보내지 못한 메시지 수 (넘으면 인코딩을 건너뛰고 다음 델타에 합침)
+constexpr size_t SPECTATOR_FRAMES_IN_FLIGHT = 16;
+
+// 이 인원 이하 게임은 모든 보드를 큰 화면(FULL)으로, 넘으면 작은 화면(MINI)으로
+constexpr int32_t SPECTATOR_FULL_DETAIL_PLAYERS = 4;
+
+constexpr size_t SPECTATOR_FRAME_MAX_SIZE = BOARD_STREAM_MSG_MAX_SIZE;
+static_assert(SPECTATOR_FRAME_MAX_SIZE >= GAME_OVER_MSG_MAX_SIZE, "spectator frame must fit S2C_GAME_OVER");
+
+// 관전 세션에 보내기 (아무 워커 스레드). 서버에서는 CIOCPServer::RequestSendMsg
+using SpectatorSender = std::function<void(int64_t sessionId, const char* data, size_t size)>;
+
+// 한 번 인코딩해서 관전 트리 전체가 같이 보내는 메시지 (헤더 포함)
+// 방 액터의 프레임 풀 안에 있고, 넘겨받은 릴레이마다 참조를 하나씩 가짐. 참조가 0이 되면 방 액터가 다시 씀
+struct SpectatorFrame
+{
+    std::atomic<int32_t> refs{ 0 };
+    int32_t roomId = 0;
+    uint32_t frame = 0;     // 인코딩할 때의 스트림 시계 (지연 계산용, CSpectatorFeed 참고)
+    bool keyframe = false;  // 보드 스트림 키프레임 (새 구독자는 여기부터 받음)
+    bool broadcast = false; // 키프레임을 기다리는 구독자에게도 보냄 (게임 종료)
+    uint16_t size = 0;
+    char data[SPECTATOR_FRAME_MAX_SIZE];
+
+    void AddRef() { refs.fetch_add(1, std::memory_order_relaxed); }
+    void Release() { refs.fetch_sub(1, std::memory_order_acq_rel); }
+};
+
+class CSpectatorRelay;
+
+// 로비 -> 릴레이 (붙이기/떼기, 구독자/자식 추가). 로비 액터 하나만 보내므로 보낸 순서대로 처리됨
+struct SpectatorRelayControl
+{
+    enum class Type : uint8_t
+    {
+        ATTACH,      // roomId 방의 관전 트리에 들어감
+        SUBSCRIBE,   // sessionId 추가 (다음 키프레임부터 받음)
+        UNSUBSCRIBE, // sessionId 제거
+        ADD_CHILD,   // 다음 단계 릴레이 추가
+        RESET        // 트리에서 빠짐 (구독자/자식 모두 정리)
+    };
+
+    Type type = Type::ATTACH;
+    int64_t sessionId = -1;
+    int32_t roomId = -1;
+    CSpectatorRelay* child = nullptr;
+};
+
+// 방 액터(첫 릴레이) 또는 부모 릴레이 -> 릴레이
+struct SpectatorRelayFrame
+{
+    SpectatorFrame* frame = nullptr; // 참조 하나를 같이 넘김
+    bool gap = false; // 이 메시지 전에 넘기지 못한 메시지가 있음 -> 아래 구독자 전원 키프레임부터 다시
+};
+
+// __________________________________________________________________
+//
+// 관전 릴레이 (통합 스트랜드 / UnifiedStrand)
+// 방 하나의 관전 트리 노드. 방 액터가 한 번 인코딩한 메시지(SpectatorFrame)를 받아
+//  - 자식 릴레이(최대 SPECTATOR_RELAY_CHILDREN)에 참조만 넘기고
+//  - 자기 구독자(최대 SPECTATOR_RELAY_SESSIONS)에게 보냄
+// 릴레이마다 액터라서 단계마다 여러 워커가 나눠 보냄. 방 액터는 관전자 수와 관계없이 첫 릴레이에 한 번만 넘김
+// 트리 모양(어느 릴레이가 어느 방의 몇 번째인지, 구독자 배치)은 로비 액터가 정하고 제어 메시지로 알려줌
+// 넘기지 못한 메시지(메일박스 가득 참)는 버리고 다음 메시지에 gap을 실어 아래 구독자 전원이 키프레임부터 다시 받게 함
+// 릴레이는 미리 만들어두고 방이 바뀔 때마다 다시 씀. 메시지의 roomId가 지금 방과 다르면 이전 방의 늦은 메시지로 보고 버림
+// __________________________________________________________________
+
+class CSpectatorRelay : public CActor
+{
+public:
+    CSpectatorRelay(CActorWorkerPool& pool, uint32_t index, SpectatorSender sender);
+    ~CSpectatorRelay() override;
+
+    // 로비 액터 전용 ////////////////////////////////////////////////////////////////
+    // 제어 메시지 postCount개를 넣은 뒤 subscribersAfter명 전원 제거 + 자식 추가 + 정리가 들어갈 자리가 남는지
+    // 구독/붙이기 전에 확인 -> 제거 / 자식 추가 / 정리는 항상 들어감
+    bool HasRoomForSubscribe(int32_t postCount, int32_t subscribersAfter) const;
+
+    bool PostAttach(int32_t roomId);
+    bool PostSubscribe(int64_t sessionId);
+    bool PostUnsubscribe(int64_t sessionId);
+    bool PostAddChild(CSpectatorRelay* child);
+    bool PostReset();
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 방 액터 또는 부모 릴레이. 성공하면 frame의 참조 하나를 가져감, 가득 차면 false (참조는 호출한 쪽에 남음)
+    bool PostFrame(SpectatorFrame* frame, bool gap);
+
+    uint32_t GetIndex() const { return _index; }
+
+    // 통계 (아무 스레드)
+    uint64_t GetSentCount() const { return _sent.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedFrames() const { return _dropped.load(std::memory_order_relaxed); } // 자식에게 넘기지 못한 메시지
+
+protected:
+    void ProcessMessages(size_t budget) override;
+    bool HasPendingMessages() const override;
+
+private:
+    bool PostControl(SpectatorRelayControl::Type type, int64_t sessionId, int32_t roomId, CSpectatorRelay* child);
+
+    void DrainControl();
+    void HandleControl(const SpectatorRelayControl& msg);
+    void HandleFrame(const SpectatorRelayFrame& msg);
+
+    struct Subscriber
+    {
+        int64_t sessionId;
+        bool waitingKeyframe;
+    };
+
+    uint32_t _index;
+    SpectatorSender _sender;
+    CBoundedMailbox<SpectatorRelayControl> _control;
+    CBoundedMailbox<SpectatorRelayFrame> _frames;
+
+    // 아래는 워커 스레드 전용 (한 번에 한 워커)
+    int32_t _roomId; // -1: 트리 밖
+    Subscriber _subscribers[SPECTATOR_RELAY_SESSIONS];
+    int32_t _subscriberCount;
+    CSpectatorRelay* _children[SPECTATOR_RELAY_CHILDREN];
+    bool _childGap[SPECTATOR_RELAY_CHILDREN]; // 그 자식에게 넘기지 못한 메시지가 있음
+    int32_t _childCount;
+
+    std::atomic<uint64_t> _sent;
+    std::atomic<uint64_t> _dropped;
+};
+
+// __________________________________________________________________
+//
+// 관전 스트림 (방 하나, 방 액터 전용)
+// 확정 프레임이 나올 때 SPECTATOR_STREAM_INTERVAL마다 보드 화면 델타(CBoardStream)를 한 번 인코딩해서
+// 방 관전 트리의 첫 릴레이에 넘김. 관전자가 없으면(첫 릴레이가 없으면) 인코딩도 하지 않음
+//  - 지연: 인코딩한 메시지를 delayFrames 프레임 뒤에 넘김. 게임 중에는 확정 프레임이 시계
+//    게임이 끝나면 마지막 화면 + 게임 종료를 지연 큐 뒤에 붙이고, 남은 메시지는 Drain으로 실제 시간(TETRIS_FRAME_RATE)에 맞춰
+//    게임 중과 같은 간격으로 계속 넘김 -> 관전자도 마지막 지연 구간까지 다 본 뒤에 종료를 받고, 첫 릴레이 메일박스도 넘치지 않음
+//    비우는 중에 다음 게임이 시작되면 그 게임의 확정 프레임이 이어서 시계가 됨 (스트림 시계 = 이전 게임까지의 프레임 + 확정 프레임)
+//  - 메시지 버퍼는 처음 관전자가 생길 때 한 번 잡아두고 방이 바뀌어도 다시 씀 (지연 + SPECTATOR_FRAMES_IN_FLIGHT개)
+//    빈 버퍼가 없으면 이번 인코딩은 건너뜀 (기준 상태가 그대로라 다음 델타가 그만큼 커질 뿐 화면은 맞음)
+// 첫 릴레이는 로비가 SetRoot로 바꿈 (아무 스레드). 바뀌면 다음 메시지를 키프레임으로
+// __________________________________________________________________
+
+class CSpectatorFeed
+{
+public:
+    explicit CSpectatorFeed(uint32_t delayFrames);
+
+    CSpectatorFeed(const CSpectatorFeed&) = delete;
+    CSpectatorFeed& operator=(const CSpectatorFeed&) = delete;
+
+    // 로비 액터 (아무 스레드) ////////////////////////////////////////////////////
+    void SetRoot(CSpectatorRelay* root) { _root.store(root); }
+    void RequestKeyframe() { _keyframeRequested.store(true); }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 방 액터 전용 ////////////////////////////////////////////////////////////////
+    void StartGame(int32_t roomId, int32_t playerCount);
+
+    // 확정 프레임을 보낸 뒤. confirmedFrames = 지금까지 확정된 전체 프레임 수
+    void OnConfirmedFrames(uint32_t confirmedFrames, const CTetrisBoardBatch& boards);
+
+    // 게임 종료: 마지막 화면 + gameOverMsg(헤더 포함)를 지연 큐 뒤에 붙임. 지연 중인 메시지가 남으면 IsDraining
+    void EndGame(uint32_t confirmedFrames, const CTetrisBoardBatch& boards, const char* gameOverMsg, size_t size);
+
+    // 게임이 끝난 뒤 지연 큐 비우기: now까지 지난 시간만큼 시계를 진행해서 지연이 끝난 메시지를 넘김
+    // 방 액터가 주기적으로 (로비 틱 간격) 호출
+    void Drain(std::chrono::steady_clock::time_point now);
+    bool IsDraining() const { return _draining; }
+
+    // 방이 닫힘: 지연 중인 메시지를 버림
+    void Stop();
+    ////////////////////////////////////////////////////////////////////////////////
+
+    uint32_t GetDelayFrames() const { return _delayFrames; }
+
+    // 통계 (방 액터 스레드)
+    uint64_t GetEncodedCount() const { return _encoded; }
+    uint64_t GetSkippedCount() const { return _skipped; } // 빈 버퍼가 없어서 건너뛴 인코딩
+    uint64_t GetDeliveredCount() const { return _delivered; } // 첫 릴레이에 넘긴 메시지 (게임 종료 포함)
+
+private:
+    bool EncodeStream(uint32_t confirmedFrames, const CTetrisBoardBatch& boards);
+    SpectatorFrame* AcquireFrame();
+    void ReleaseDue(uint32_t clock);
+    void Deliver(SpectatorFrame* frame);
+
+    uint32_t _delayFrames;
+    CBoardStream _stream;
+
+    // 메시지 버퍼 (처음 쓸 때 할당). 지연 큐는 버퍼 포인터의 원형 큐 (참조 하나씩 가짐)
+    std::unique_ptr<SpectatorFrame[]> _pool;
+    std::unique_ptr<SpectatorFrame*[]> _delayed;
+    size_t _poolSize;
+    size_t _poolCursor;
+    size_t _delayedHead;
+    size_t _delayedCount;
+
+    int32_t _roomId;
+    bool _running;
+    uint32_t _clockBase; // 스트림 시계 = _clockBase + 확정 프레임 (게임 중) / 종료 뒤 지난 프레임 (비우는 중)
+    bool _draining;
+    std::chrono::steady_clock::time_point _drainStart;
+    uint32_t _nextEncodeFrame;
+    CSpectatorRelay* _lastRoot; // 바뀌었으면 키프레임
+    bool _rootGap;              // 첫 릴레이에 넘기지 못한 메시지가 있음
+
+    std::atomic<CSpectatorRelay*> _root;
+    std::atomic<bool> _keyframeRequested;
+
+    uint64_t _encoded;
+    uint64_t _skipped;
+    uint64_t _delivered;
+};
@@ -0,0 +1,998 @@
+//
+#include "StrandServer.h"
+#include "AsyncLogger.h"
+#include <cstring>
+
+// 풀 점유율 로그 주기
+constexpr auto POOL_STATS_LOG_INTERVAL = std::chrono::seconds(60);
+
+// 로비 틱 간격 (잠수 타이머 단위)
+constexpr auto LOBBY_TICK_INTERVAL = std::chrono::milliseconds(50);
+
+// 방 목록 스냅샷 최소 게시 간격 (밀린 TICK이 연달아 처리돼도 이보다 자주 복사하지 않음)
+constexpr auto ROOM_LIST_PUBLISH_INTERVAL = std::chrono::milliseconds(50);
+
+// 방 목록 스냅샷 예산 (로비 틱 간격 대비 %, 중앙 / 파티션 모드와 같은 값)
+constexpr int64_t PUBLISH_BUDGET_PERCENT = 10;
+
+// 방 안에서 이 시간 동안 요청이 없으면 방에서 내보냄 (중앙 / 파티션 모드와 같은 값)
+constexpr auto ROOM_AFK_TIMEOUT = std::chrono::minutes(10);
+
+static_assert(LOBBY_MSG_MAX_SIZE >= sizeof(MSG_C2S_JOIN_ROOM) && LOBBY_MSG_MAX_SIZE >= sizeof(MSG_C2S_QUICK_JOIN)
+    && LOBBY_MSG_MAX_SIZE >= sizeof(MSG_C2S_LEAVE_ROOM) && LOBBY_MSG_MAX_SIZE >= sizeof(MSG_C2S_SPECTATE_ROOM)
+    && LOBBY_MSG_MAX_SIZE >= sizeof(MSG_C2S_STOP_SPECTATE), "lobby mailbox must fit every lobby request");
+static_assert(ROOM_GAME_MSG_MAX_SIZE >= GAME_INPUT_MSG_MAX_SIZE && ROOM_GAME_MSG_MAX_SIZE >= sizeof(MSG_C2S_GAME_START)
+    && ROOM_GAME_MSG_MAX_SIZE >= sizeof(MSG_C2S_GAME_TARGET),
+    "room mailbox must fit every game request");
+
+// 로비 메일박스는 접속자 한 명당 요청 2개 정도 (넘치면 SERVER_BUSY 응답, 접속 종료는 세션 index에 기록해서 TICK에 처리)
+constexpr size_t LOBBY_MAILBOX_PER_CLIENT = 2;
+
+// 관전 릴레이 수 = 접속자 수 / 이 값 + 1
+// 관전자는 방 밖의 세션이라 전체 관전자 수는 접속자 수를 넘지 않지만, 관전 중인 방마다 덜 찬 릴레이가 생기므로 넉넉히
+constexpr size_t CLIENTS_PER_SPECTATOR_RELAY = 4;
+
+static size_t GetSpectatorRelayCount(int maxClients)
+{
+    return static_cast<size_t>(maxClients) / CLIENTS_PER_SPECTATOR_RELAY + 1;
+}
+
+// 리플레이 블록 풀 = 동시에 진행할 수 있는 게임 수 (방마다 쓰는 중인 블록 하나) + 이 값
+// 여유분은 기록 스레드가 REPLAY_FLUSH_INTERVAL마다 비우기 전까지 넘겨받아 쌓이는 블록
+constexpr size_t REPLAY_SPARE_BLOCKS = 256;
+
+static size_t GetReplayBlockCount(int maxClients)
+{
+    return static_cast<size_t>(maxClients) / ROOM_MIN_PLAYERS + REPLAY_SPARE_BLOCKS;
+}
+
+CStrandServer::CLobbyActor::CLobbyActor(CActorWorkerPool& pool, CStrandServer& server, size_t capacity)
+    : CActor(pool)
+    , _server(server)
+    , _mailbox(capacity)
+{
+}
+
+bool CStrandServer::CLobbyActor::Post(LobbyMessage::Type type, int64_t sessionId, const char* data, size_t length)
+{
+    if (length > LOBBY_MSG_MAX_SIZE)
+    {
+        return false;
+    }
+
+    bool pushed = _mailbox.TryPush([&](LobbyMessage& msg)
+    {
+        msg.type = type;
+        msg.sessionId = sessionId;
+        msg.length = static_cast<uint16_t>(length);
+        if (data)
+        {
+            std::memcpy(msg.data, data, length);
+        }
+    });
+
+    if (pushed)
+    {
+        Notify();
+    }
+    return pushed;
+}
+
+void CStrandServer::CLobbyActor::ProcessMessages(size_t budget)
+{
+    for (size_t i = 0; i < budget; ++i)
+    {
+        if (!_mailbox.TryConsume([this](const LobbyMessage& msg) { _server.DispatchLobbyMessage(msg); }))
+        {
+            break;
+        }
+    }
+}
+
+bool CStrandServer::CLobbyActor::HasPendingMessages() const
+{
+    return _mailbox.HasPending();
+}
+
+// 빈 방은 바로 삭제되므로 방 개수는 접속자 수를 넘지 않음 -> 방 풀과 방 액터도 maxClients 개
+// (세션 index가 16비트이므로 방 슬롯 index도 방 액터 주소의 16비트 안에 들어감)
+CStrandServer::CStrandServer(int port, int maxClients, int workerThreadCount, uint32_t spectatorDelayFrames,
+    std::string replayDirectory)
+    : _networkServer(std::make_shared<CIOCPServer>(port, maxClients, ServerArchitectureType::UnifiedStrand))
+    , _workerPool(workerThreadCount, static_cast<size_t>(maxClients) + 1 + GetSpectatorRelayCount(maxClients))
+    , _roomManager(static_cast<size_t>(maxClients))
+    , _roomSeats(static_cast<size_t>(maxClients))
+    , _timers(static_cast<size_t>(maxClients)) // 방 안 세션마다 잠수 검사 하나
+    , _afkTimeoutTicks(0)
+    , _lastPoolStatsLog(std::chrono::steady_clock::now())
+    , _publishBudget("RoomList", LOBBY_TICK_INTERVAL * PUBLISH_BUDGET_PERCENT / 100)
+    , _nextRoomListPublish()
+    , _membership(static_cast<size_t>(maxClients))
+    , _roomListPublisher(static_cast<size_t>(maxClients))
+    , _lobbyTick(0)
+    , _lastActivityTicks(std::make_unique<std::atomic<uint64_t>[]>(static_cast<size_t>(maxClients)))
+    , _owedLobbyTicks(0)
+    , _pendingDisconnects(std::make_unique<std::atomic<int64_t>[]>(static_cast<size_t>(maxClients)))
+    , _disconnectSlots(static_cast<size_t>(maxClients))
+    , _replayWriter(replayDirectory.empty() ? nullptr
+        : std::make_unique<CReplayWriter>(std::move(replayDirectory), GetReplayBlockCount(maxClients)))
+    , _roomStatusChanges(_roomManager.GetMaxRoomCount())
+    , _roomActors()
+    , _lobby()
+    , _spectatorRelays()
+    , _spectatorTrees(_roomManager.GetMaxRoomCount())
+    , _relayStates(GetSpectatorRelayCount(maxClients))
+    , _freeRelays()
+    , _spectatorSeats(static_cast<size_t>(maxClients))
+    , _tickThread()
+    , _lobbyTickScheduler(LOBBY_TICK_INTERVAL, 1)
+    , _running(false)
+    , _droppedRoomMsgs(0)
+{
+    _afkTimeoutTicks = _lobbyTickScheduler.ToTicks(ROOM_AFK_TIMEOUT);
+
+    for (size_t i = 0; i < static_cast<size_t>(maxClients); ++i)
+    {
+        _pendingDisconnects[i].store(-1, std::memory_order_relaxed);
+    }
+
+    _roomActors.reserve(_roomManager.GetMaxRoomCount());
+    for (size_t i = 0; i < _roomManager.GetMaxRoomCount(); ++i)
+    {
+        _roomActors.push_back(std::make_unique<CRoomActor>(_workerPool, static_cast<uint32_t>(i), *_networkServer, _roomStatusChanges,
+            spectatorDelayFrames, _replayWriter.get()));
+    }
+
+    // 릴레이는 받은 바이트를 그대로 세션 송신 큐에 넣음 (인코딩은 방 액터가 한 번만)
+    size_t relayCount = _relayStates.size();
+    _spectatorRelays.reserve(relayCount);
+    _freeRelays.reserve(relayCount);
+    for (size_t i = 0; i < relayCount; ++i)
+    {
+        _spectatorRelays.push_back(std::make_unique<CSpectatorRelay>(_workerPool, static_cast<uint32_t>(i),
+            [this](int64_t sessionId, const char* data, size_t size)
+            {
+                _networkServer->RequestSendMsg(sessionId, data, static_cast<int>(size));
+            }));
+        _freeRelays.push_back(static_cast<uint32_t>(relayCount - 1 - i)); // 낮은 index부터 꺼내도록
+    }
+
+    _lobby = std::make_unique<CLobbyActor>(_workerPool, *this, static_cast<size_t>(maxClients) * LOBBY_MAILBOX_PER_CLIENT);
+
+    // 모든 네트워크 이벤트를 워커 스레드에서 바로 액터 메일박스로
+    _networkServer->SetNetworkEventRouter([this](NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)
+    {
+        RouteNetworkEvent(type, sessionId, data, length);
+    });
+}
+
+CStrandServer::~CStrandServer()
+{
+    Stop();
+    _networkServer->Disconnect();
+}
+
+bool CStrandServer::Start()
+{
+    // 기록 스레드를 못 띄우면 리플레이 없이 진행 (방 액터는 빈 블록을 못 받아서 기록하지 않음)
+    if (_replayWriter && _replayWriter->Start())
+    {
+        LOG_INFO("[StrandServer] Recording replays to {}", _replayWriter->GetDirectory());
+    }
+
+    // 액터 워커를 먼저 띄워서 첫 이벤트부터 처리할 수 있게
+    _running = true;
+    _workerPool.Start();
+    _tickThread = std::thread(&CStrandServer::TickThread, this);
+
+    if (!_networkServer->Start())
+    {
+        Stop();
+        return false;
+    }
+
+    LOG_INFO("[StrandServer] {} actor worker threads started ({} room actors, {} spectator relays)",
+        _workerPool.GetThreadCount(), _roomActors.size(), _spectatorRelays.size());
+    return true;
+}
+
+void CStrandServer::Stop()
+{
+    if (!_running)
+    {
+        return;
+    }
+
+    _running = false;
+    _lobbyTickScheduler.Notify();
+
+    if (_tickThread.joinable())
+    {
+        _tickThread.join();
+    }
+
+    _workerPool.Stop();
+
+    // 방 액터가 넘긴 블록까지 쓰고 닫음 (워커가 멈춘 뒤라 더 넘어오지 않음)
+    if (_replayWriter)
+    {
+        _replayWriter->Stop();
+        LOG_INFO("[StrandServer] Replay writer stopped - Matches: {}, Failed: {}, Bytes: {}",
+            _replayWriter->GetFinishedMatches(), _replayWriter->GetFailedMatches(), _replayWriter->GetWrittenBytes());
+    }
+
+    LOG_INFO("[StrandServer] Actor worker threads stopped");
+}
+
+void CStrandServer::TickThread()
+{
+    // 밀린 틱은 하나로 합침 (로비 틱은 목록 게시/통계뿐이라 몰아서 여러 번 돌 이유가 없음)
+    auto lastStatsLog = std::chrono::steady_clock::now();
+    _lobbyTickScheduler.Start();
+
+    while (_running)
+    {
+        _lobbyTickScheduler.WaitAndRunTicks([this]
+        {
+            // 가득 찼으면 로비가 바쁜 것이므로 이번 틱은 건너뜀 (진행할 타이머 틱은 다음 TICK이 몰아서 처리)
+            _owedLobbyTicks.fetch_add(1, std::memory_order_relaxed);
+            _lobby->Post(LobbyMessage::Type::TICK, -1);
+
+            // 끝난 게임의 관전 지연 큐를 비우는 방만 깨움 (틱 간격 = 관전 스트림 간격이라 게임 중과 같은 속도로 나감)
+            for (const auto& actor : _roomActors)
+            {
+                if (actor->IsSpectatorDraining())
+                {
+                    actor->PostSpectatorTick();
+                }
+            }
+        });
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastStatsLog >= POOL_STATS_LOG_INTERVAL)
+        {
+            lastStatsLog = now;
+            _lobbyTickScheduler.LogStats("StrandServer lobby");
+        }
+    }
+}
+
+// __________________________________________________________________
+//
+// 라우팅 (IOCP 워커 스레드)
+// __________________________________________________________________
+
+void CStrandServer::RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length)
+{
+    switch (type)
+    {
+    case NetworkEvent::Type::CONNECTED:
+        // 방 밖의 세션은 서버 상태가 없으므로 목록만 보냄
+        SendRoomList(*_networkServer, sessionId, REQUEST_ID_NONE, _roomListPublisher);
+        break;
+
+    case NetworkEvent::Type::DISCONNECTED:
+        // 입장 요청이 로비 메일박스에 남아있을 수 있으므로 멤버십과 관계없이 항상 로비로 (그 요청 뒤에 처리)
+        // 메일박스가 가득 찼으면 기다리지 않고 세션 index에 종료를 기록 -> 로비가 다음 TICK에 처리 (실패하지 않는 경로)
+        if (!_lobby->Post(LobbyMessage::Type::DISCONNECTED, sessionId))
+        {
+            uint16_t index = CSession::ExtractIndex(sessionId);
+            if (index < _roomSeats.size())
+            {
+                _pendingDisconnects[index].store(sessionId, std::memory_order_release);
+                _disconnectSlots.Push(index);
+            }
+        }
+        break;
+
+    case NetworkEvent::Type::RECEIVED:
+        RouteDataReceived(sessionId, data, length);
+        break;
+    }
+}
+
+void CStrandServer::RouteDataReceived(int64_t sessionId, const char* data, size_t length)
+{
+    if (length < sizeof(MsgHeader))
+    {
+        LOG_WARNING("[StrandServer] Invalid msg size from SessionId: {}", sessionId);
+        return;
+    }
+
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+
+    // 패킷 크기 검증
+    if (header->size != length)
+    {
+        LOG_WARNING("[StrandServer] Msg size mismatch from SessionId: {}", sessionId);
+        return;
+    }
+
+    // 잠수 검사용 활동 시각 (방 안 게임 메시지는 로비를 거치지 않으므로 여기서 기록)
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index < _roomSeats.size())
+    {
+        _lastActivityTicks[index].store(_lobbyTick.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    switch (header->type)
+    {
+    case MsgType::C2S_REQUEST_ROOM_LIST:
+        if (length >= sizeof(MSG_C2S_REQUEST_ROOM_LIST))
+        {
+            SendRoomList(*_networkServer, sessionId, reinterpret_cast<const MSG_C2S_REQUEST_ROOM_LIST*>(data)->requestId,
+                _roomListPublisher);
+        }
+        break;
+
+    case MsgType::C2S_REQUEST_ROOM_PAGE:
+    {
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_REQUEST_ROOM_PAGE msg;
+        if (msg.Decode(reader))
+        {
+            SendRoomPage(*_networkServer, sessionId, msg.requestId, ParseRoomPageQuery(msg), _roomListPublisher);
+        }
+        break;
+    }
+
+    case MsgType::C2S_CREATE_ROOM:
+    case MsgType::C2S_JOIN_ROOM:
+    case MsgType::C2S_LEAVE_ROOM:
+    case MsgType::C2S_QUICK_JOIN:
+    case MsgType::C2S_SPECTATE_ROOM:
+    case MsgType::C2S_STOP_SPECTATE:
+        if (length > LOBBY_MSG_MAX_SIZE)
+        {
+            LOG_WARNING("[StrandServer] Lobby msg too large from SessionId: {}", sessionId);
+            break;
+        }
+
+        if (!_lobby->Post(LobbyMessage::Type::REQUEST, sessionId, data, length))
+        {
+            SendRoomRequestFailed(*_networkServer, sessionId, data, length, ErrorCode::SERVER_BUSY);
+        }
+        break;
+
+    default:
+        RouteRoomMsg(sessionId, data, length);
+        break;
+    }
+}
+
+// 방 안 메시지는 로비를 거치지 않고 세션이 들어가 있는 방 액터로
+void CStrandServer::RouteRoomMsg(int64_t sessionId, const char* data, size_t length)
+{
+    CRoomMembershipTable::Entry entry = _membership.Get(CSession::ExtractIndex(sessionId), CSession::ExtractUniqueId(sessionId));
+    if (entry.state != CRoomMembershipTable::State::JOINED)
+    {
+        LOG_WARNING("[StrandServer] Room msg from SessionId: {} not in room (type: {})",
+            sessionId, static_cast<int>(reinterpret_cast<const MsgHeader*>(data)->type));
+        return;
+    }
+
+    uint32_t slot = CRoomActor::GetSlotOfAddress(entry.value);
+    if (slot >= _roomActors.size())
+    {
+        return;
+    }
+
+    // 방 메일박스가 가득 찼으면 버림 (한 방의 폭주가 다른 방이나 로비를 막지 않도록)
+    if (!_roomActors[slot]->PostGame(sessionId, CRoomActor::GetTagOfAddress(entry.value), data, length))
+    {
+        _droppedRoomMsgs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// __________________________________________________________________
+//
+// 로비 액터 (공용 워커 중 하나, 한 번에 하나)
+// __________________________________________________________________
+
+void CStrandServer::DispatchLobbyMessage(const LobbyMessage& msg)
+{
+    switch (msg.type)
+    {
+    case LobbyMessage::Type::DISCONNECTED:
+        HandleDisconnected(msg.sessionId);
+        return;
+
+    case LobbyMessage::Type::TICK:
+        ProcessLobbyTick();
+        return;
+
+    case LobbyMessage::Type::REQUEST:
+        break;
+    }
+
+    // 메일박스를 거치지 않은 종료가 이 요청보다 먼저 처리됐으면 이미 끊긴 세션 (입장시키면 유령 플레이어)
+    uint16_t index = CSession::ExtractIndex(msg.sessionId);
+    if (index < _roomSeats.size() && _pendingDisconnects[index].load(std::memory_order_acquire) == msg.sessionId)
+    {
+        return;
+    }
+
+    ReleaseStaleSeat(msg.sessionId);
+
+    // 크기 검증은 라우팅할 때 끝남
+    const char* data = msg.data;
+    size_t length = msg.length;
+    const MsgHeader* header = reinterpret_cast<const MsgHeader*>(data);
+
+    switch (header->type)
+    {
+    case MsgType::C2S_CREATE_ROOM:
+    {
+        // title은 메일박스 셀을 가리키는 view (핸들러가 끝날 때까지 유효, 방에는 복사되어 저장)
+        CMsgReader reader(data, length, sizeof(MsgHeader));
+        MSG_C2S_CREATE_ROOM createMsg;
+        if (createMsg.Decode(reader))
+        {
+            HandleCreateRoom(msg.sessionId, createMsg);
+        }
+        break;
+    }
+
+    case MsgType::C2S_JOIN_ROOM:
+        if (length >= sizeof(MSG_C2S_JOIN_ROOM))
+        {
+            HandleJoinRoom(msg.sessionId, reinterpret_cast<const MSG_C2S_JOIN_ROOM*>(data));
+        }
+        break;
+
+    case MsgType::C2S_LEAVE_ROOM:
+        if (length >= sizeof(MSG_C2S_LEAVE_ROOM))
+        {
+            HandleLeaveRoom(msg.sessionId, reinterpret_cast<const MSG_C2S_LEAVE_ROOM*>(data));
+        }
+        break;
+
+    case MsgType::C2S_QUICK_JOIN:
+        if (length >= sizeof(MSG_C2S_QUICK_JOIN))
+        {
+            HandleQuickJoin(msg.sessionId, reinterpret_cast<const MSG_C2S_QUICK_JOIN*>(data));
+        }
+        break;
+
+    case MsgType::C2S_SPECTATE_ROOM:
+        if (length >= sizeof(MSG_C2S_SPECTATE_ROOM))
+        {
+            HandleSpectateRoom(msg.sessionId, reinterpret_cast<const MSG_C2S_SPECTATE_ROOM*>(data));
+        }
+        break;
+
+    case MsgType::C2S_STOP_SPECTATE:
+        if (length >= sizeof(MSG_C2S_STOP_SPECTATE))
+        {
+            HandleStopSpectate(msg.sessionId, reinterpret_cast<const MSG_C2S_STOP_SPECTATE*>(data));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void CStrandServer::HandleDisconnected(int64_t sessionId)
+{
+    StopSpectating(sessionId, false);
+    LeaveCurrentRoom(sessionId); // 방에 들어간 적 없는 세션은 로비에 상태가 없음
+}
+
+void CStrandServer::ProcessPendingDisconnects()
+{
+    // 기록된 값은 지우지 않음 (세션 ID는 재사용하지 않으므로 남아있는 요청을 거르는 표시로 씀)
+    // 같은 index의 다음 세션이 값을 덮어썼으면 이전 세션의 좌석은 ReleaseStaleSeat이 정리
+    _disconnectSlots.Drain([this](uint32_t index)
+    {
+        int64_t sessionId = _pendingDisconnects[index].load(std::memory_order_acquire);
+        ReleaseStaleSeat(sessionId);
+        HandleDisconnected(sessionId);
+    });
+}
+
+void CStrandServer::HandleCreateRoom(int64_t sessionId, const MSG_C2S_CREATE_ROOM& msg)
+{
+    CRoomRequestHandler handler(_roomManager);
+    RoomRequestResult result = handler.CreateRoom(msg, GetCurrentRoomId(sessionId),
+        [&](CRoom& room, bool created) { return SeatSession(sessionId, room, created); });
+
+    SendRoomRequestResult(*_networkServer, sessionId, result);
+}
+
+void CStrandServer::HandleJoinRoom(int64_t sessionId, const MSG_C2S_JOIN_ROOM* msg)
+{
+    CRoomRequestHandler handler(_roomManager);
+    RoomRequestResult result = handler.JoinRoom(*msg, GetCurrentRoomId(sessionId),
+        [&](CRoom& room, bool created) { return SeatSession(sessionId, room, created); });
+
+    SendRoomRequestResult(*_networkServer, sessionId, result);
+}
+
+void CStrandServer::HandleLeaveRoom(int64_t sessionId, const MSG_C2S_LEAVE_ROOM* msg)
+{
+    bool left = LeaveCurrentRoom(sessionId);
+    SendRoomRequestResult(*_networkServer, sessionId, CRoomRequestHandler::LeaveRoom(msg->requestId, left));
+}
+
+void CStrandServer::HandleQuickJoin(int64_t sessionId, const MSG_C2S_QUICK_JOIN* msg)
+{
+    CRoomRequestHandler handler(_roomManager);
+    RoomRequestResult result = handler.QuickJoin(*msg, GetCurrentRoomId(sessionId),
+        [&](CRoom& room, bool created) { return SeatSession(sessionId, room, created); });
+
+    SendRoomRequestResult(*_networkServer, sessionId, result);
+}
+
+void CStrandServer::HandleSpectateRoom(int64_t sessionId, const MSG_C2S_SPECTATE_ROOM* msg)
+{
+    int32_t roomId = msg->roomId;
+
+    auto fail = [&](ErrorCode code, std::initializer_list<int32_t> args)
+    {
+        SendSpectateState(*_networkServer, sessionId, msg->requestId, roomId, false);
+        SendError(*_networkServer, sessionId, msg->requestId, code, args);
+    };
+
+    // 방에 있는 세션은 관전하지 않음 (자기 방은 직접 시뮬레이션으로 봄)
+    int32_t currentRoomId = GetCurrentRoomId(sessionId);
+    if (currentRoomId != ROOM_ID_NONE)
+    {
+        fail(ErrorCode::ALREADY_IN_ROOM, { currentRoomId });
+        return;
+    }
+
+    CRoom* room = _roomManager.FindRoom(roomId);
+    if (!room)
+    {
+        fail(ErrorCode::ROOM_NOT_FOUND, { roomId });
+        return;
+    }
+
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _spectatorSeats.size())
+    {
+        return;
+    }
+
+    // 이미 이 방을 관전 중이면 그대로, 다른 방이면 옮김. 같은 슬롯의 이전 세션이 남아있으면 (종료 이벤트 누락) 먼저 정리
+    SpectatorSeat& seat = _spectatorSeats[index];
+    if (seat.sessionId == sessionId && _relayStates[seat.relay].roomSlot == room->GetHandle().index)
+    {
+        SendSpectateState(*_networkServer, sessionId, msg->requestId, roomId, true);
+        return;
+    }
+    if (seat.sessionId >= 0)
+    {
+        StopSpectating(seat.sessionId, false);
+    }
+
+    uint32_t relay = AcquireSpectatorRelay(*room);
+    if (relay == SPECTATOR_RELAY_NONE)
+    {
+        fail(ErrorCode::SPECTATOR_LIMIT, { roomId });
+        return;
+    }
+
+    SpectatorRelayState& state = _relayStates[relay];
+    state.subscribers[state.subscriberCount++] = sessionId;
+    _spectatorRelays[relay]->PostSubscribe(sessionId);
+    ++_spectatorTrees[room->GetHandle().index].spectatorCount;
+    seat.sessionId = sessionId;
+    seat.relay = relay;
+
+    // 구독을 넣은 뒤에 요청해야 릴레이가 그 키프레임을 새 구독자에게도 보냄
+    GetRoomActor(*room).RequestSpectatorKeyframe();
+
+    SendSpectateState(*_networkServer, sessionId, msg->requestId, roomId, true);
+}
+
+void CStrandServer::HandleStopSpectate(int64_t sessionId, const MSG_C2S_STOP_SPECTATE* msg)
+{
+    // 관전 중이 아니었어도 결과는 같으므로 실패로 보지 않음
+    StopSpectating(sessionId, false);
+    SendSpectateState(*_networkServer, sessionId, msg->requestId, -1, false);
+}
+
+ErrorCode CStrandServer::SeatSession(int64_t sessionId, CRoom& room, bool created)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _roomSeats.size())
+    {
+        return ErrorCode::ROOM_JOIN_FAILED;
+    }
+
+    // 게임 중 여부는 방 액터가 게시한 최신 상태로 판정 (빠른 입장처럼 디렉터리 인덱스로 고른 방도 모두 여기를 거침)
+    // 게시 직전에 들어간 인원은 게임이 끝날 때까지 관전 없이 대기
+    SyncRoomStatus(room.GetHandle().index);
+    if (room.GetStatus() == RoomStatus::PLAYING)
+    {
+        return ErrorCode::GAME_IN_PROGRESS;
+    }
+
+    // 입장 메시지를 넣고도 입장 후 인원 전원의 퇴장 + 닫기가 들어갈 자리가 있을 때만 입장 허가
+    // -> 방 액터가 밀려 있어도 퇴장 / 닫기는 항상 전달됨
+    CRoomActor& actor = GetRoomActor(room);
+    int32_t postCount = created ? 2 : 1;
+    if (!actor.HasRoomForJoin(postCount, room.GetCurrentPlayerCount() + 1))
+    {
+        LOG_WARNING("[StrandServer] Room actor mailbox busy - RoomId: {}", room.GetRoomId());
+        return ErrorCode::SERVER_BUSY;
+    }
+
+    if (!_roomManager.TakeSeat(room))
+    {
+        return ErrorCode::ROOM_JOIN_FAILED;
+    }
+
+    if (created)
+    {
+        actor.PostOpen(room);
+    }
+    actor.PostJoin(sessionId);
+
+    // 방에 들어가면 관전은 끝남 (응답 전에 알려서 클라가 관전 화면을 먼저 닫도록)
+    StopSpectating(sessionId, true);
+
+    // 응답보다 먼저 확정해야 응답을 받은 클라의 방 안 메시지가 이 방으로 라우팅됨
+    _membership.TryJoin(index, CSession::ExtractUniqueId(sessionId), CRoomActor::MakeAddress(room.GetHandle()));
+
+    RoomSeat& seat = _roomSeats[index];
+    seat.sessionId = sessionId;
+    seat.room = room.GetHandle();
+    _lastActivityTicks[index].store(_timers.GetCurrentTick(), std::memory_order_relaxed);
+    ArmAfkTimer(index);
+    return ErrorCode::NONE;
+}
+
+bool CStrandServer::LeaveCurrentRoom(int64_t sessionId)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _roomSeats.size() || _roomSeats[index].sessionId != sessionId)
+    {
+        return false;
+    }
+
+    RoomSeat& seat = _roomSeats[index];
+    RoomHandle handle = seat.room;
+    _timers.Cancel(seat.afkTimer);
+    seat = RoomSeat();
+
+    CRoomActor& actor = *_roomActors[handle.index];
+    _roomManager.ReleaseSeat(handle);
+
+    // 마지막 인원이 나가서 방이 삭제됐으면 닫기만 보냄 (관전자도 정리)
+    if (_roomManager.GetRoom(handle))
+    {
+        actor.PostLeave(sessionId);
+    }
+    else
+    {
+        actor.PostClose();
+        CloseSpectatorTree(handle.index, true);
+    }
+
+    _membership.Release(index, CSession::ExtractUniqueId(sessionId), CRoomActor::MakeAddress(handle));
+    return true;
+}
+
+int32_t CStrandServer::GetCurrentRoomId(int64_t sessionId)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _roomSeats.size() || _roomSeats[index].sessionId != sessionId)
+    {
+        return ROOM_ID_NONE;
+    }
+
+    const CRoom* room = _roomManager.GetRoom(_roomSeats[index].room);
+    return room ? room->GetRoomId() : ROOM_ID_NONE;
+}
+
+void CStrandServer::ReleaseStaleSeat(int64_t sessionId)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _roomSeats.size())
+    {
+        return;
+    }
+
+    int64_t staleSessionId = _roomSeats[index].sessionId;
+    if (staleSessionId >= 0 && staleSessionId != sessionId)
+    {
+        LOG_WARNING("[StrandServer] Stale seat in session slot {} (SessionId: {}), removing", index, staleSessionId);
+        LeaveCurrentRoom(staleSessionId);
+    }
+}
+
+void CStrandServer::ArmAfkTimer(uint16_t index)
+{
+    RoomSeat& seat = _roomSeats[index];
+    if (_timers.IsActive(seat.afkTimer))
+    {
+        return;
+    }
+
+    TimerEvent event;
+    event.type = TimerType::PLAYER_AFK_CHECK;
+    event.room = seat.room;
+    event.param = index;
+    seat.afkTimer = _timers.Schedule(_afkTimeoutTicks, event); // 가득 차면 검사 없이 (타이머 수 = 세션 수라 오지 않는 경로)
+}
+
+void CStrandServer::HandleAfkCheck(const TimerEvent& event)
+{
+    // 퇴장하면 타이머를 취소하므로 좌석이 그대로면 이 타이머의 주인 (방 핸들로 한 번 더 확인)
+    RoomSeat& seat = _roomSeats[event.param];
+    if (seat.sessionId < 0 || !(seat.room == event.room))
+    {
+        return;
+    }
+
+    uint64_t now = _timers.GetCurrentTick();
+    uint64_t lastActivity = _lastActivityTicks[event.param].load(std::memory_order_relaxed);
+    uint64_t idleTicks = (now > lastActivity) ? now - lastActivity : 0;
+    if (idleTicks < _afkTimeoutTicks)
+    {
+        // 그 사이 요청이 있었음: 마지막 요청 기준으로 남은 시간만큼 다시 검
+        seat.afkTimer = _timers.Schedule(static_cast<uint32_t>(_afkTimeoutTicks - idleTicks), event);
+        return;
+    }
+
+    int64_t sessionId = seat.sessionId;
+    int32_t roomId = GetCurrentRoomId(sessionId);
+    int32_t idleSeconds = static_cast<int32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        _lobbyTickScheduler.GetInterval() * static_cast<int64_t>(idleTicks)).count());
+
+    LOG_INFO("[StrandServer] AFK kick - SessionId: {}, RoomId: {}, idle {}s", sessionId, roomId, idleSeconds);
+
+    // 게임 중이면 방 액터가 퇴장을 기권으로 처리
+    LeaveCurrentRoom(sessionId);
+    SendRoomLeft(*_networkServer, sessionId, REQUEST_ID_NONE, true);
+    SendError(*_networkServer, sessionId, REQUEST_ID_NONE, ErrorCode::AFK_KICKED, { roomId, idleSeconds });
+}
+
+uint32_t CStrandServer::AcquireSpectatorRelay(const CRoom& room)
+{
+    uint32_t roomSlot = room.GetHandle().index;
+    SpectatorTree& tree = _spectatorTrees[roomSlot];
+
+    // 빈 자리가 있는 릴레이 (구독 + 전원 제거가 들어갈 자리도 확인)
+    uint32_t parent = SPECTATOR_RELAY_NONE;
+    for (uint32_t relay = tree.first; relay != SPECTATOR_RELAY_NONE; relay = _relayStates[relay].next)
+    {
+        const SpectatorRelayState& state = _relayStates[relay];
+        if (state.subscriberCount < SPECTATOR_RELAY_SESSIONS
+            && _spectatorRelays[relay]->HasRoomForSubscribe(1, state.subscriberCount + 1))
+        {
+            return relay;
+        }
+        if (parent == SPECTATOR_RELAY_NONE && state.childCount < SPECTATOR_RELAY_CHILDREN)
+        {
+            parent = relay;
+        }
+    }
+
+    // 새 릴레이 (정리 메시지가 아직 남아있을 수 있으므로 붙이기 + 구독 자리까지 확인)
+    if (_freeRelays.empty())
+    {
+        return SPECTATOR_RELAY_NONE;
+    }
+
+    uint32_t relay = _freeRelays.back();
+    CSpectatorRelay& actor = *_spectatorRelays[relay];
+    if (!actor.HasRoomForSubscribe(2, 1))
+    {
+        return SPECTATOR_RELAY_NONE;
+    }
+    _freeRelays.pop_back();
+
+    actor.PostAttach(room.GetRoomId());
+    SpectatorRelayState& state = _relayStates[relay];
+    state.roomSlot = roomSlot;
+    state.next = SPECTATOR_RELAY_NONE;
+    state.childCount = 0;
+    state.subscriberCount = 0;
+
+    if (tree.first == SPECTATOR_RELAY_NONE)
+    {
+        // 첫 릴레이: 방 액터가 여기에 넘김
+        tree.roomId = room.GetRoomId();
+        tree.spectatorCount = 0;
+        tree.first = relay;
+        tree.last = relay;
+        _roomActors[roomSlot]->SetSpectatorRoot(&actor);
+    }
+    else
+    {
+        // 목록이 붙인 순서이므로 자식 자리가 남은 첫 릴레이 아래에 붙이면 트리가 너비 우선으로 자람 (단계 = log4)
+        _relayStates[tree.last].next = relay;
+        tree.last = relay;
+        _spectatorRelays[parent]->PostAddChild(&actor);
+        ++_relayStates[parent].childCount;
+    }
+
+    return relay;
+}
+
+bool CStrandServer::StopSpectating(int64_t sessionId, bool notify)
+{
+    uint16_t index = CSession::ExtractIndex(sessionId);
+    if (index >= _spectatorSeats.size() || _spectatorSeats[index].sessionId != sessionId)
+    {
+        return false;
+    }
+
+    SpectatorSeat& seat = _spectatorSeats[index];
+    uint32_t relay = seat.relay;
+    seat = SpectatorSeat();
+
+    SpectatorRelayState& state = _relayStates[relay];
+    for (int32_t i = 0; i < state.subscriberCount; ++i)
+    {
+        if (state.subscribers[i] == sessionId)
+        {
+            state.subscribers[i] = state.subscribers[--state.subscriberCount];
+            break;
+        }
+    }
+    _spectatorRelays[relay]->PostUnsubscribe(sessionId);
+
+    uint32_t roomSlot = state.roomSlot;
+    SpectatorTree& tree = _spectatorTrees[roomSlot];
+    if (notify)
+    {
+        SendSpectateState(*_networkServer, sessionId, REQUEST_ID_NONE, tree.roomId, false);
+    }
+
+    // 관전자가 없으면 방 액터가 인코딩을 멈추도록 트리를 통째로 돌려줌
+    if (--tree.spectatorCount <= 0)
+    {
+        CloseSpectatorTree(roomSlot, false);
+    }
+    return true;
+}
+
+void CStrandServer::CloseSpectatorTree(uint32_t roomSlot, bool notify)
+{
+    SpectatorTree& tree = _spectatorTrees[roomSlot];
+    if (tree.first == SPECTATOR_RELAY_NONE)
+    {
+        return;
+    }
+
+    // 방 액터가 먼저 넘기기를 멈추고, 릴레이는 정리 뒤 도착한 이 방의 메시지를 roomId로 걸러서 버림
+    _roomActors[roomSlot]->SetSpectatorRoot(nullptr);
+
+    for (uint32_t relay = tree.first; relay != SPECTATOR_RELAY_NONE;)
+    {
+        SpectatorRelayState& state = _relayStates[relay];
+        for (int32_t i = 0; i < state.subscriberCount; ++i)
+        {
+            int64_t sessionId = state.subscribers[i];
+            _spectatorSeats[CSession::ExtractIndex(sessionId)] = SpectatorSeat();
+            if (notify)
+            {
+                SendSpectateState(*_networkServer, sessionId, REQUEST_ID_NONE, tree.roomId, false);
+            }
+        }
+
+        _spectatorRelays[relay]->PostReset();
+        uint32_t next = state.next;
+        state = SpectatorRelayState();
+        _freeRelays.push_back(relay);
+        relay = next;
+    }
+
+    tree = SpectatorTree();
+}
+
+void CStrandServer::ProcessLobbyTick()
+{
+    ProcessPendingDisconnects();
+    SyncRoomStatuses();
+    ProcessTimers();
+    PublishRoomList();
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - _lastPoolStatsLog >= POOL_STATS_LOG_INTERVAL)
+    {
+        _lastPoolStatsLog = now;
+        LogPoolStats();
+        _publishBudget.LogStats("StrandServer lobby");
+    }
+}
+
+void CStrandServer::SyncRoomStatuses()
+{
+    // 상태를 게시한 방 액터의 슬롯만 꺼냄 (방 수와 상관없이 바뀐 방 수만큼)
+    // TICK이 메일박스에 못 들어가도 목록과 게시된 값은 남아있으므로 다음 TICK에 반영됨
+    // SeatSession이 먼저 읽어간 슬롯은 플래그가 내려가 있으므로 SyncRoomStatus가 그냥 넘어감
+    _roomStatusChanges.Drain([this](uint32_t slot)
+    {
+        SyncRoomStatus(slot);
+    });
+}
+
+void CStrandServer::SyncRoomStatus(uint32_t roomSlot)
+{
+    int32_t roomId = 0;
+    RoomStatus status = RoomStatus::WAITING;
+    if (!_roomActors[roomSlot]->TakeStatusChange(roomId, status))
+    {
+        return;
+    }
+
+    // 그 사이 방이 삭제됐으면 없는 roomId (roomId는 재사용하지 않음)
+    if (_roomManager.SetRoomStatus(roomId, status))
+    {
+        LOG_INFO("[StrandServer] Room status - RoomId: {}, Status: {}", roomId, static_cast<int>(status));
+    }
+}
+
+void CStrandServer::ProcessTimers()
+{
+    // 로비 틱마다 만료되는 타이머는 잠수 검사뿐이라 (세션당 하나, 10분 간격) 예산 없이 전부
+    uint32_t ticks = _owedLobbyTicks.exchange(0, std::memory_order_relaxed);
+    _timers.Advance(ticks, [this](const TimerEvent& event)
+    {
+        switch (event.type)
+        {
+        case TimerType::PLAYER_AFK_CHECK:
+            HandleAfkCheck(event);
+            break;
+        }
+    });
+
+    // 워커가 활동 시각으로 기록할 틱
+    _lobbyTick.store(_timers.GetCurrentTick(), std::memory_order_relaxed);
+}
+
+void CStrandServer::PublishRoomList()
+{
+    if (_roomManager.GetVersion() == _roomListPublisher.GetPublishedVersion())
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < _nextRoomListPublish)
+    {
+        return;
+    }
+
+    // 모든 버퍼를 reader가 잡고 있으면 다음 틱에 다시 시도
+    RoomListSnapshot* snapshot = _roomListPublisher.BeginWrite();
+    if (!snapshot)
+    {
+        return;
+    }
+
+    // 방 전체를 복사하는 나눌 수 없는 작업이라 예산을 넘긴 만큼 다음 게시를 늦춤 (그동안 로비 요청을 먼저 처리)
+    _publishBudget.Begin();
+    _roomManager.FillSnapshot(*snapshot);
+    _roomListPublisher.Publish();
+    _publishBudget.End(snapshot->rooms.size(), false);
+    _nextRoomListPublish = now + (std::max)(std::chrono::steady_clock::duration(ROOM_LIST_PUBLISH_INTERVAL),
+        _publishBudget.GetAmortizedInterval(LOBBY_TICK_INTERVAL));
+}
+
+void CStrandServer::LogPoolStats()
+{
+    PoolStats roomStats = _roomManager.GetRoomPoolStats();
+    PoolStats timerStats = _timers.GetStats();
+
+    uint64_t spectatorSent = 0;
+    uint64_t spectatorDropped = 0;
+    for (const auto& relay : _spectatorRelays)
+    {
+        spectatorSent += relay->GetSentCount();
+        spectatorDropped += relay->GetDroppedFrames();
+    }
+
+    LOG_INFO("[StrandServer] Pool - Seated: {}, Rooms: {}/{} (peak {}, fail {}), Timers: {}/{} (fail {}), Index nodes: {} KB, Dropped room msgs: {}",
+        _roomManager.GetTotalPlayerCount(), roomStats.inUse, roomStats.capacity, roomStats.peak, roomStats.allocFailures,
+        timerStats.inUse, timerStats.capacity, timerStats.allocFailures,
+        _roomManager.GetIndexPoolBytes() / 1024, _droppedRoomMsgs.load(std::memory_order_relaxed));
+    LOG_INFO("[StrandServer] Spectators - Relays: {}/{}, Sent msgs: {}, Dropped relay msgs: {}",
+        _spectatorRelays.size() - _freeRelays.size(), _spectatorRelays.size(), spectatorSent, spectatorDropped);
+}
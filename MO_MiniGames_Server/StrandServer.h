@@ -0,0 +1,222 @@
+#pragma once
+
+#include "IOCPServer.h"
+#include "ActorScheduler.h"
+#include "BoundedMailbox.h"
+#include "ChangedSlotList.h"
+#include "LobbyHandler.h"
+#include "RoomActor.h"
+#include "RoomManager.h"
+#include "RoomMembershipTable.h"
+#include "RoomListSnapshot.h"
+#include "SpectatorRelay.h"
+#include "Protocol.h"
+#include "TickScheduler.h"
+#include "TimerWheel.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+// 로비 요청(방 생성/입장/빠른 입장/퇴장/관전) 최대 크기 (헤더 포함). 가장 큰 것은 방 생성
+constexpr size_t LOBBY_MSG_MAX_SIZE = sizeof(MsgHeader) + MAX_VARINT32_SIZE * 3 + ROOM_TITLE_MAX_LEN;
+
+// 통합 스트랜드 게임 로직 레이어 - 방마다 액터(스트랜드), 모든 액터가 공용 워커 풀 하나를 나눠 씀
+// 중앙 로직 스레드 없이 IOCP 워커가 이벤트를 액터 메일박스에 바로 넣음
+//  - 방 목록/페이지: 워커가 게시된 스냅샷으로 바로 응답
+//  - 방 생성/입장/빠른 입장/퇴장, 관전, 접속 종료, 잠수 검사: 로비 액터 (방 디렉터리 CRoomManager를 가짐)
+//    판정과 응답은 다른 모드와 같은 CRoomRequestHandler / 전송 헬퍼를 쓰고, 좌석을 잡는 방법만 다름
+//  - 그 밖의 방 안 메시지: 멤버십 테이블이 가리키는 방 액터
+// 방 안 상태(멤버, 방장, 게임 상태)의 기준은 방 액터 하나. 로비 디렉터리는 좌석 수 / 상태만 가지고 (플레이어 객체 없음),
+// 세션 -> 방은 세션 index마다 좌석 하나 (RoomSeat)
+// 관전자는 방 인원(maxPlayers)에 세지 않고 멤버십에도 없음. 로비가 방마다 관전 릴레이 트리를 만들어 구독자를 나눠 담고,
+// 방 액터는 한 번 인코딩한 화면을 트리의 첫 릴레이에만 넘김 (CSpectatorRelay, CSpectatorFeed)
+// 로비가 좌석을 바꾸면 방 액터에 입장/퇴장 메시지를 보내고, 방 안 게임 상태는 방 액터만 만짐
+// 경기 리플레이는 방 액터가 블록에 기록하고 기록 스레드 하나(CReplayWriter)가 경기별 파일에 씀
+// 방마다 한 번에 한 워커만 실행되므로 방 코드에는 락이 없고, 서로 다른 방은 워커 수만큼 동시에 진행
+class CStrandServer
+{
+public:
+    // workerThreadCount가 0 이하면 하드웨어 스레드 수
+    // spectatorDelayFrames: 관전 화면 지연 (확정 프레임, 최대 SPECTATOR_MAX_DELAY_FRAMES, 0이면 바로)
+    // replayDirectory: 경기 리플레이를 남길 디렉터리 (비어있으면 기록하지 않음)
+    explicit CStrandServer(int port, int maxClients, int workerThreadCount = 0, uint32_t spectatorDelayFrames = 0,
+        std::string replayDirectory = std::string());
+    virtual ~CStrandServer();
+
+    bool Start();
+    void Stop();
+
+private:
+    // 로비 액터 메시지
+    struct LobbyMessage
+    {
+        enum class Type : uint8_t
+        {
+            DISCONNECTED,
+            REQUEST,     // 방 생성/입장/빠른 입장/퇴장/관전 패킷
+            TICK         // 방 상태 반영, 잠수 타이머 진행, 방 목록 게시, 풀 통계 (틱 스레드)
+        };
+
+        Type type = Type::REQUEST;
+        int64_t sessionId = -1;
+        uint16_t length = 0;
+        char data[LOBBY_MSG_MAX_SIZE];
+    };
+
+    // 로비 액터. 방 디렉터리와 좌석 / 잠수 타이머는 이 액터가 실행될 때만 접근
+    class CLobbyActor : public CActor
+    {
+    public:
+        CLobbyActor(CActorWorkerPool& pool, CStrandServer& server, size_t capacity);
+
+        // 아무 스레드. 메일박스가 가득 차면 false
+        bool Post(LobbyMessage::Type type, int64_t sessionId, const char* data = nullptr, size_t length = 0);
+
+    protected:
+        void ProcessMessages(size_t budget) override;
+        bool HasPendingMessages() const override;
+
+    private:
+        CStrandServer& _server;
+        CBoundedMailbox<LobbyMessage> _mailbox;
+    };
+
+    // 라우팅 (IOCP 워커 스레드) ////////////////////////////////////////////////////
+    void RouteNetworkEvent(NetworkEvent::Type type, int64_t sessionId, const char* data, size_t length);
+    void RouteDataReceived(int64_t sessionId, const char* data, size_t length);
+    void RouteRoomMsg(int64_t sessionId, const char* data, size_t length);
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // 로비 액터 ////////////////////////////////////////////////////////////////////
+    void DispatchLobbyMessage(const LobbyMessage& msg);
+    void HandleDisconnected(int64_t sessionId);
+    void ProcessPendingDisconnects(); // 메일박스에 못 들어간 종료 (TICK마다)
+    void HandleCreateRoom(int64_t sessionId, const MSG_C2S_CREATE_ROOM& msg);
+    void HandleJoinRoom(int64_t sessionId, const MSG_C2S_JOIN_ROOM* msg);
+    void HandleLeaveRoom(int64_t sessionId, const MSG_C2S_LEAVE_ROOM* msg);
+    void HandleQuickJoin(int64_t sessionId, const MSG_C2S_QUICK_JOIN* msg);
+    void HandleSpectateRoom(int64_t sessionId, const MSG_C2S_SPECTATE_ROOM* msg);
+    void HandleStopSpectate(int64_t sessionId, const MSG_C2S_STOP_SPECTATE* msg);
+
+    // CRoomRequestHandler의 좌석 콜백: 디렉터리 좌석을 잡고 방 액터에 알린 뒤 멤버십 확정
+    // 방 액터 메일박스에 자리가 없으면 좌석을 잡지 않고 SERVER_BUSY (생성한 빈 방은 핸들러가 삭제)
+    // 방 액터가 게시한 상태를 먼저 반영하고 게임 중이면 GAME_IN_PROGRESS (모든 입장 경로가 여기를 거침)
+    ErrorCode SeatSession(int64_t sessionId, CRoom& room, bool created);
+    bool LeaveCurrentRoom(int64_t sessionId); // 방에 없었으면 false
+    int32_t GetCurrentRoomId(int64_t sessionId); // 방에 없으면 ROOM_ID_NONE
+
+    // 같은 세션 슬롯에 이전 세션의 좌석이 남아있으면 (종료 이벤트 누락) 먼저 정리
+    void ReleaseStaleSeat(int64_t sessionId);
+
+    // 잠수 검사 (방 안에서 일정 시간 요청이 없는 세션 내보내기). 활동 시각은 IOCP 워커가 세션 index마다 기록
+    void ArmAfkTimer(uint16_t index);
+    void HandleAfkCheck(const TimerEvent& event);
+
+    // 관전 트리 (방 슬롯 index마다 하나)
+    // 구독자가 빈 릴레이가 있으면 거기에, 없으면 새 릴레이를 자식 자리가 남은 첫 릴레이 아래에 붙임 (너비 우선)
+    uint32_t AcquireSpectatorRelay(const CRoom& room); // 없으면 SPECTATOR_RELAY_NONE
+    bool StopSpectating(int64_t sessionId, bool notify); // 관전 중이 아니었으면 false. 마지막 관전자면 트리 정리
+    void CloseSpectatorTree(uint32_t roomSlot, bool notify); // 방 삭제 / 마지막 관전자 퇴장
+
+    void ProcessLobbyTick();
+
+    // 방 액터가 게시한 방 상태(게임 시작/종료)를 디렉터리에 반영. 틱마다 바뀐 슬롯 목록에 있는 방만, 입장 판정 전에 그 방만
+    void SyncRoomStatuses();
+    void SyncRoomStatus(uint32_t roomSlot);
+    void ProcessTimers();
+    void PublishRoomList();
+    void LogPoolStats();
+
+    CRoomActor& GetRoomActor(const CRoom& room) { return *_roomActors[room.GetHandle().index]; }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    void TickThread();
+
+
+private:
+    std::shared_ptr<CIOCPServer> _networkServer;
+
+    // 액터보다 먼저 생성, 나중에 소멸
+    CActorWorkerPool _workerPool;
+
+    // 로비 액터 전용
+    CRoomManager _roomManager; // 디렉터리 (좌석 수 / 상태만, 멤버와 방장은 방 액터)
+
+    struct RoomSeat
+    {
+        int64_t sessionId = -1; // -1: 방에 없음
+        RoomHandle room;
+        TimerHandle afkTimer;
+    };
+
+    std::vector<RoomSeat> _roomSeats; // 세션 index
+    CTimerWheel _timers;              // 로비 틱 단위
+    uint32_t _afkTimeoutTicks;
+    std::chrono::steady_clock::time_point _lastPoolStatsLog;
+    CPhaseBudget _publishBudget; // 나눌 수 없는 작업이라 넘긴 만큼 다음 게시를 미룸
+    std::chrono::steady_clock::time_point _nextRoomListPublish;
+
+    // 로비가 쓰고 IOCP 워커가 읽음
+    CRoomMembershipTable _membership; // JOINED 값 = 방 액터 주소
+    CRoomListPublisher _roomListPublisher;
+    std::atomic<uint64_t> _lobbyTick; // 로비가 진행한 타이머 틱 (워커가 활동 시각으로 기록)
+
+    // IOCP 워커가 쓰고 로비가 읽음
+    std::unique_ptr<std::atomic<uint64_t>[]> _lastActivityTicks; // 세션 index -> 마지막 요청의 로비 틱
+    std::atomic<uint32_t> _owedLobbyTicks; // 틱 스레드가 센 틱 중 로비가 아직 진행하지 않은 것 (TICK을 버려도 남음)
+    std::unique_ptr<std::atomic<int64_t>[]> _pendingDisconnects; // 세션 index -> 메일박스에 못 넣은 종료의 세션 ID (-1: 없음)
+    CChangedSlotList _disconnectSlots;                           // 종료를 기록한 세션 index
+
+    // 리플레이 기록 (방 액터보다 먼저 생성, 나중에 소멸. 방 액터가 블록을 들고 있음). 기록하지 않으면 nullptr
+    std::unique_ptr<CReplayWriter> _replayWriter;
+
+    // 로비 방 슬롯 index마다 방 액터 하나 (생성 후 배열은 바뀌지 않으므로 아무 스레드에서 index 접근)
+    // 방 상태를 게시한 방 액터의 슬롯 (방 액터가 넣고 로비가 틱마다 비움. 방 액터보다 먼저 생성)
+    CChangedSlotList _roomStatusChanges;
+    std::vector<std::unique_ptr<CRoomActor>> _roomActors;
+    std::unique_ptr<CLobbyActor> _lobby;
+
+    // 관전 릴레이 (방 액터 뒤에 선언 -> 먼저 소멸. 릴레이에 남은 메시지가 방 액터의 버퍼 참조를 돌려줌)
+    std::vector<std::unique_ptr<CSpectatorRelay>> _spectatorRelays;
+
+    // 관전 트리 (로비 액터 전용)
+    static constexpr uint32_t SPECTATOR_RELAY_NONE = UINT32_MAX;
+
+    struct SpectatorTree
+    {
+        int32_t roomId = -1;
+        int32_t spectatorCount = 0;
+        uint32_t first = SPECTATOR_RELAY_NONE; // 첫 릴레이 (방 액터가 넘기는 곳)
+        uint32_t last = SPECTATOR_RELAY_NONE;  // 붙인 순서(너비 우선) 목록의 끝
+    };
+
+    struct SpectatorRelayState
+    {
+        uint32_t roomSlot = SPECTATOR_RELAY_NONE; // NONE: 빈 릴레이
+        uint32_t next = SPECTATOR_RELAY_NONE;     // 같은 트리의 다음 릴레이
+        int32_t childCount = 0;
+        int32_t subscriberCount = 0;
+        int64_t subscribers[SPECTATOR_RELAY_SESSIONS];
+    };
+
+    struct SpectatorSeat
+    {
+        int64_t sessionId = -1;
+        uint32_t relay = SPECTATOR_RELAY_NONE;
+    };
+
+    std::vector<SpectatorTree> _spectatorTrees;     // 방 슬롯 index
+    std::vector<SpectatorRelayState> _relayStates;  // 릴레이 index
+    std::vector<uint32_t> _freeRelays;
+    std::vector<SpectatorSeat> _spectatorSeats;     // 세션 index
+
+    // 로비 틱 타이머 (고정 간격으로 로비 메일박스에 TICK을 넣음, 종료 시 Notify로 깨움)
+    std::thread _tickThread;
+    CTickScheduler _lobbyTickScheduler;
+    std::atomic<bool> _running;
+
+    std::atomic<uint64_t> _droppedRoomMsgs; // 방 메일박스가 가득 차서 버린 게임 메시지
+};
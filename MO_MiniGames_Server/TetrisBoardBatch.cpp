@@ -0,0 +1,363 @@
+#include "TetrisBoardBatch.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TETRIS_BATCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC는 /arch 없이도 AVX2 내장 함수를 쓸 수 있음. GCC / Clang은 함수 단위로 대상 지정
+#if defined(TETRIS_BATCH_X86) && !defined(_MSC_VER)
+#define TETRIS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TETRIS_TARGET_AVX2
+#endif
+
+namespace
+{
+    // 충돌 검사 요청을 "8바이트 읽기 + AND" 하나로 바꾼 것
+    // 보드 행 base ~ base+3을 uint64로 읽으면 bit 16k ~ 16k+15가 행 base+k
+    struct PreparedProbe
+    {
+        uint64_t mask;   // 블록 칸 (읽은 값과 겹치면 충돌)
+        uint64_t offset; // 읽을 위치 (행 배열 시작부터 uint16_t 단위)
+        bool forced;     // 벽 밖 / 바닥 아래 / 맨 위 밖으로 나가서 읽을 필요 없이 충돌
+    };
+
+    PreparedProbe PrepareProbe(const TetrisProbe& probe)
+    {
+        PreparedProbe prepared;
+        prepared.mask = 0;
+        prepared.offset = static_cast<uint64_t>(probe.board) * TETRIS_BOARD_HEIGHT;
+        prepared.forced = true;
+
+        int32_t x = probe.x;
+        if (x < -TETRIS_WALL_BITS)
+        {
+            return prepared;
+        }
+
+        // 상자 r번째 행 = 보드 y - r 행 = 읽기 창의 3 - r번째 행
+        const uint8_t* shape = TETRIS_SHAPES.rows[static_cast<int32_t>(probe.piece)][probe.rotation & 3];
+        uint64_t mask = 0;
+        for (int32_t r = 0; r < 4; ++r)
+        {
+            uint32_t rowMask = static_cast<uint32_t>(shape[r]) << (x + TETRIS_WALL_BITS);
+            if (rowMask > 0xFFFF)
+            {
+                return prepared;
+            }
+            mask |= static_cast<uint64_t>(rowMask) << (16 * (3 - r));
+        }
+
+        // 창이 보드 밖으로 걸치면 안쪽으로 당기고, 밖에 남는 칸이 있으면 충돌
+        int32_t base = probe.y - 3;
+        if (base < 0)
+        {
+            int32_t shift = -base;
+            if (shift >= 4 || (mask & ((1ull << (16 * shift)) - 1)) != 0)
+            {
+                return prepared;
+            }
+            mask >>= 16 * shift;
+            base = 0;
+        }
+        else if (base > TETRIS_BOARD_HEIGHT - 4)
+        {
+            int32_t shift = base - (TETRIS_BOARD_HEIGHT - 4);
+            if (shift >= 4 || (mask >> (64 - 16 * shift)) != 0)
+            {
+                return prepared;
+            }
+            mask <<= 16 * shift;
+            base = TETRIS_BOARD_HEIGHT - 4;
+        }
+
+        prepared.mask = mask;
+        prepared.offset += static_cast<uint64_t>(base);
+        prepared.forced = false;
+        return prepared;
+    }
+
+    // 스칼라 ////////////////////////////////////////////////////////////////////////
+    uint32_t MatchRowsScalar(const uint16_t* rows, uint16_t value)
+    {
+        uint32_t mask = 0;
+        for (int32_t y = 0; y < TETRIS_BOARD_HEIGHT; ++y)
+        {
+            mask |= static_cast<uint32_t>(rows[y] == value) << y;
+        }
+        return mask;
+    }
+
+    bool InsertGarbageScalar(uint16_t* rows, int32_t lines, uint16_t garbage)
+    {
+        bool toppedOut = (~MatchRowsScalar(rows, TETRIS_EMPTY_ROW) >> (TETRIS_BOARD_HEIGHT - lines)) != 0;
+        for (int32_t y = TETRIS_BOARD_HEIGHT - 1; y >= lines; --y)
+        {
+            rows[y] = rows[y - lines];
+        }
+        for (int32_t y = 0; y < lines; ++y)
+        {
+            rows[y] = garbage;
+        }
+        return toppedOut;
+    }
+
+    uint8_t TestProbeScalar(const uint16_t* base, const PreparedProbe& prepared)
+    {
+        uint64_t window;
+        std::memcpy(&window, base + prepared.offset, sizeof(window));
+        return static_cast<uint8_t>(prepared.forced || (window & prepared.mask) != 0);
+    }
+
+#ifdef TETRIS_BATCH_X86
+    // SSE2: 보드 하나 = 레지스터 4개 ////////////////////////////////////////////////
+    uint32_t MatchRowsSse2(const uint16_t* rows, uint16_t value)
+    {
+        const __m128i* p = reinterpret_cast<const __m128i*>(rows);
+        __m128i v = _mm_set1_epi16(static_cast<short>(value));
+        __m128i c0 = _mm_cmpeq_epi16(_mm_load_si128(p + 0), v);
+        __m128i c1 = _mm_cmpeq_epi16(_mm_load_si128(p + 1), v);
+        __m128i c2 = _mm_cmpeq_epi16(_mm_load_si128(p + 2), v);
+        __m128i c3 = _mm_cmpeq_epi16(_mm_load_si128(p + 3), v);
+
+        // 16비트 비교 결과(0 / -1)를 8비트로 줄이면 movemask 한 번에 행 16개
+        uint32_t lo = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(c0, c1)));
+        uint32_t hi = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(c2, c3)));
+        return lo | (hi << 16);
+    }
+
+    bool InsertGarbageSse2(uint16_t* rows, int32_t lines, uint16_t garbage)
+    {
+        bool toppedOut = (~MatchRowsSse2(rows, TETRIS_EMPTY_ROW) >> (TETRIS_BOARD_HEIGHT - lines)) != 0;
+
+        // [방해 줄 32개][기존 행 32개]를 만들어 두고 (32 - lines)부터 32개를 읽으면 lines줄 올린 보드
+        alignas(16) uint16_t temp[TETRIS_BOARD_HEIGHT * 2];
+        __m128i* p = reinterpret_cast<__m128i*>(rows);
+        __m128i* t = reinterpret_cast<__m128i*>(temp);
+        __m128i g = _mm_set1_epi16(static_cast<short>(garbage));
+        for (int32_t i = 0; i < 4; ++i)
+        {
+            _mm_store_si128(t + i, g);
+            _mm_store_si128(t + 4 + i, _mm_load_si128(p + i));
+        }
+
+        const uint16_t* shifted = temp + TETRIS_BOARD_HEIGHT - lines;
+        for (int32_t i = 0; i < 4; ++i)
+        {
+            _mm_store_si128(p + i, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shifted + i * 8)));
+        }
+        return toppedOut;
+    }
+
+    // AVX2: 보드 하나 = 레지스터 2개 ////////////////////////////////////////////////
+    TETRIS_TARGET_AVX2 uint32_t MatchRowsAvx2(const uint16_t* rows, uint16_t value)
+    {
+        const __m256i* p = reinterpret_cast<const __m256i*>(rows);
+        __m256i v = _mm256_set1_epi16(static_cast<short>(value));
+        __m256i c0 = _mm256_cmpeq_epi16(_mm256_load_si256(p + 0), v);
+        __m256i c1 = _mm256_cmpeq_epi16(_mm256_load_si256(p + 1), v);
+
+        // packs는 128비트 반쪽끼리 동작 -> 행 순서가 0-7, 16-23, 8-15, 24-31이 되므로 64비트 단위로 재배치
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(c0, c1), _MM_SHUFFLE(3, 1, 2, 0));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+    }
+
+    TETRIS_TARGET_AVX2 bool InsertGarbageAvx2(uint16_t* rows, int32_t lines, uint16_t garbage)
+    {
+        bool toppedOut = (~MatchRowsAvx2(rows, TETRIS_EMPTY_ROW) >> (TETRIS_BOARD_HEIGHT - lines)) != 0;
+
+        alignas(32) uint16_t temp[TETRIS_BOARD_HEIGHT * 2];
+        __m256i* p = reinterpret_cast<__m256i*>(rows);
+        __m256i* t = reinterpret_cast<__m256i*>(temp);
+        __m256i g = _mm256_set1_epi16(static_cast<short>(garbage));
+        _mm256_store_si256(t + 0, g);
+        _mm256_store_si256(t + 1, g);
+        _mm256_store_si256(t + 2, _mm256_load_si256(p + 0));
+        _mm256_store_si256(t + 3, _mm256_load_si256(p + 1));
+
+        const uint16_t* shifted = temp + TETRIS_BOARD_HEIGHT - lines;
+        _mm256_store_si256(p + 0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shifted)));
+        _mm256_store_si256(p + 1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shifted + 16)));
+        return toppedOut;
+    }
+#endif
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SCALAR:
+        return "scalar";
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    }
+    return "unknown";
+}
+
+SimdLevel DetectSimdLevel()
+{
+#ifdef TETRIS_BATCH_X86
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    // AVX2는 CPU 지원 + OS가 YMM 레지스터를 저장해 주는지(XCR0)까지 확인
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool sse2 = __builtin_cpu_supports("sse2") != 0;
+    bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    if (avx2)
+    {
+        return SimdLevel::AVX2;
+    }
+    if (sse2)
+    {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+CTetrisBoardBatch::CTetrisBoardBatch(size_t capacity)
+    : _rows(std::make_unique<TetrisBoardRows[]>(capacity))
+    , _engines(std::make_unique<CTetrisEngine[]>(capacity))
+    , _capacity(capacity)
+    , _supportedLevel(DetectSimdLevel())
+    , _level(_supportedLevel)
+{
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        _engines[i].BindRows(_rows[i].rows);
+    }
+}
+
+void CTetrisBoardBatch::SetSimdLevel(SimdLevel level)
+{
+    _level = (level > _supportedLevel) ? _supportedLevel : level;
+}
+
+void CTetrisBoardBatch::StepAll(size_t count, const uint8_t* inputs, TetrisStepResult* outResults)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        outResults[i] = _engines[i].Step(inputs[i]);
+    }
+}
+
+void CTetrisBoardBatch::FindFullRows(size_t count, uint32_t* outMasks) const
+{
+    switch (_level)
+    {
+#ifdef TETRIS_BATCH_X86
+    case SimdLevel::AVX2:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = MatchRowsAvx2(_rows[i].rows, TETRIS_FULL_ROW);
+        }
+        return;
+    case SimdLevel::SSE2:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = MatchRowsSse2(_rows[i].rows, TETRIS_FULL_ROW);
+        }
+        return;
+#endif
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = MatchRowsScalar(_rows[i].rows, TETRIS_FULL_ROW);
+        }
+        return;
+    }
+}
+
+void CTetrisBoardBatch::FindUsedRows(size_t count, uint32_t* outMasks) const
+{
+    switch (_level)
+    {
+#ifdef TETRIS_BATCH_X86
+    case SimdLevel::AVX2:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = ~MatchRowsAvx2(_rows[i].rows, TETRIS_EMPTY_ROW);
+        }
+        return;
+    case SimdLevel::SSE2:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = ~MatchRowsSse2(_rows[i].rows, TETRIS_EMPTY_ROW);
+        }
+        return;
+#endif
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            outMasks[i] = ~MatchRowsScalar(_rows[i].rows, TETRIS_EMPTY_ROW);
+        }
+        return;
+    }
+}
+
+void CTetrisBoardBatch::TestCollisions(const TetrisProbe* probes, size_t count, uint8_t* outHits) const
+{
+    // 검사 하나가 8바이트 읽기 + AND 한 번이라 수준과 관계없이 같은 경로 (벡터로 묶어도 준비 단계가 대부분이라 이득 없음)
+    const uint16_t* base = _rows[0].rows;
+    for (size_t i = 0; i < count; ++i)
+    {
+        outHits[i] = TestProbeScalar(base, PrepareProbe(probes[i]));
+    }
+}
+
+void CTetrisBoardBatch::InsertGarbage(size_t count, const uint8_t* lines, const uint8_t* holes, uint8_t* outAlive)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        CTetrisEngine& engine = _engines[i];
+        int32_t lineCount = (lines[i] > TETRIS_BOARD_HEIGHT) ? TETRIS_BOARD_HEIGHT : lines[i];
+        if (lineCount == 0 || engine.IsGameOver())
+        {
+            outAlive[i] = static_cast<uint8_t>(!engine.IsGameOver());
+            continue;
+        }
+
+        uint16_t* rows = _rows[i].rows;
+        uint16_t garbage = CTetrisEngine::MakeGarbageRow(holes[i]);
+        bool toppedOut;
+        switch (_level)
+        {
+#ifdef TETRIS_BATCH_X86
+        case SimdLevel::AVX2:
+            toppedOut = InsertGarbageAvx2(rows, lineCount, garbage);
+            break;
+        case SimdLevel::SSE2:
+            toppedOut = InsertGarbageSse2(rows, lineCount, garbage);
+            break;
+#endif
+        default:
+            toppedOut = InsertGarbageScalar(rows, lineCount, garbage);
+            break;
+        }
+        outAlive[i] = static_cast<uint8_t>(engine.OnRowsInserted(lineCount, toppedOut));
+    }
+}
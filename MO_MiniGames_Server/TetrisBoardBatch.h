@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+#include "TetrisEngine.h"
+
+// SIMD 사용 수준 (실행 중인 CPU에서 확인. 벤치 / 검증용으로 낮출 수 있음)
+enum class SimdLevel : uint8_t
+{
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+const char* GetSimdLevelName(SimdLevel level);
+
+// 이 CPU(와 OS)가 지원하는 최고 수준
+SimdLevel DetectSimdLevel();
+
+// 충돌 검사 요청 하나: board 보드에 piece를 rotation 방향으로 상자 위치 (x, y)에 놓으면 겹치는가
+struct TetrisProbe
+{
+    uint32_t board;
+    TetrisPiece piece;
+    uint8_t rotation;
+    int8_t x;
+    int8_t y;
+};
+
+// 보드 하나의 행 (64바이트 = 캐시 라인 하나 = AVX2 레지스터 두 개)
+struct alignas(64) TetrisBoardRows
+{
+    uint16_t rows[TETRIS_BOARD_HEIGHT];
+};
+
+// __________________________________________________________________
+//
+// 보드 묶음 (서버, 로직 스레드 전용)
+// 보드 행과 블록/점수 상태를 따로 모아 둠 (structure of arrays)
+//  - 행: TetrisBoardRows 배열 (보드마다 캐시 라인 하나, 연속). 엔진은 BindRows로 여기를 씀
+//  - 블록/입력/점수: CTetrisEngine 배열
+// 행 전체를 훑는 작업(꽉 찬 행, 쌓인 행, 방해 줄 삽입)은 보드 여러 개를 한 번에 도는 커널로
+//  - AVX2: 보드 하나 = 레지스터 두 개
+//  - SSE2: 보드 하나 = 레지스터 네 개
+//  - 스칼라: 위와 같은 결과 (CTetrisEngine과 같은 규칙). SIMD가 없는 CPU / 빌드 대상이면 이걸로
+// 충돌 검사 모음은 검사마다 행 4개를 uint64 하나로 읽어 AND 한 번 (수준 무관, 같은 경로)
+// 수준은 생성 시 DetectSimdLevel로 정하고, 커널 안에서는 분기 없이 보드를 순서대로 처리
+// __________________________________________________________________
+
+class CTetrisBoardBatch
+{
+public:
+    explicit CTetrisBoardBatch(size_t capacity);
+
+    CTetrisBoardBatch(const CTetrisBoardBatch&) = delete;
+    CTetrisBoardBatch& operator=(const CTetrisBoardBatch&) = delete;
+
+    size_t GetCapacity() const { return _capacity; }
+
+    CTetrisEngine& GetEngine(size_t board) { return _engines[board]; }
+    const CTetrisEngine& GetEngine(size_t board) const { return _engines[board]; }
+    const uint16_t* GetRows(size_t board) const { return _rows[board].rows; }
+
+    void Start(size_t board, uint32_t seed, int32_t startLevel = 1) { _engines[board].Start(seed, startLevel); }
+
+    // 보드 0 ~ count-1을 한 프레임씩 진행 (inputs[i] -> 보드 i). outResults는 count개
+    void StepAll(size_t count, const uint8_t* inputs, TetrisStepResult* outResults);
+
+    // 커널 (보드 0 ~ count-1) ///////////////////////////////////////////////////////
+    // outMasks[i]의 bit y = 보드 i의 행 y가 꽉 참 (줄 삭제 대상)
+    void FindFullRows(size_t count, uint32_t* outMasks) const;
+
+    // outMasks[i]의 bit y = 보드 i의 행 y에 블록이 있음 (스택 높이, 변경 행 판단)
+    void FindUsedRows(size_t count, uint32_t* outMasks) const;
+
+    // outHits[i] = probes[i]가 벽/바닥/블록과 겹치면 1 (CTetrisEngine::Collides와 같은 규칙)
+    void TestCollisions(const TetrisProbe* probes, size_t count, uint8_t* outHits) const;
+
+    // 보드 i 아래에 lines[i]줄 삽입 (구멍 holes[i], 0줄이면 그대로). 떨어지는 블록도 같이 올림
+    // outAlive[i] = 삽입 뒤에도 게임이 계속되면 1 (밀려 나간 행에 블록이 있었거나 블록이 겹치면 0)
+    void InsertGarbage(size_t count, const uint8_t* lines, const uint8_t* holes, uint8_t* outAlive);
+
+    SimdLevel GetSimdLevel() const { return _level; }
+
+    // 지원 수준보다 높게 주면 지원 수준으로 잘림
+    void SetSimdLevel(SimdLevel level);
+
+private:
+    std::unique_ptr<TetrisBoardRows[]> _rows;
+    std::unique_ptr<CTetrisEngine[]> _engines;
+    size_t _capacity;
+
+    SimdLevel _supportedLevel;
+    SimdLevel _level;
+};
@@ -0,0 +1,241 @@
+#include "TickScheduler.h"
+#include "AsyncLogger.h"
+#include <algorithm>
+
+CWakeupSignal::CWakeupSignal()
+    : _pending(false)
+    , _sleeping(false)
+{
+}
+
+void CWakeupSignal::Notify()
+{
+    // 이미 신호가 걸려 있으면 대기 스레드가 아직 안 깼거나 곧 큐를 비울 것이므로 할 일 없음
+    if (_pending.exchange(true))
+    {
+        return;
+    }
+
+    // _pending store -> _sleeping load 순서 (WaitUntil의 _sleeping store -> _pending load와 짝, 둘 다 seq_cst)
+    // 대기 스레드가 잠들기 직전이면 둘 중 하나는 반드시 상대의 값을 봄 -> 신호 유실 없음
+    if (_sleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cv.notify_one();
+    }
+}
+
+bool CWakeupSignal::WaitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    bool signaled = _pending.exchange(false);
+    if (!signaled)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _sleeping.store(true);
+        signaled = _cv.wait_until(lock, deadline, [this] { return _pending.load(); });
+        _sleeping.store(false);
+        _pending.store(false);
+    }
+    return signaled;
+}
+
+CTickScheduler::CTickScheduler(std::chrono::steady_clock::duration interval, uint32_t maxCatchUpTicks)
+    : _interval((interval > std::chrono::steady_clock::duration::zero()) ? interval : TICK_DEFAULT_INTERVAL)
+    , _maxCatchUpTicks((std::max)(maxCatchUpTicks, 1u))
+    , _signal()
+    , _nextTick()
+    , _ticks(0)
+    , _overruns(0)
+    , _skippedTicks(0)
+    , _eventWakeups(0)
+    , _jitterSumUs(0)
+    , _jitterCount(0)
+    , _maxJitterUs(0)
+    , _maxTickUs(0)
+    , _loggedOverruns(0)
+    , _loggedSkippedTicks(0)
+{
+}
+
+void CTickScheduler::Start()
+{
+    _nextTick = std::chrono::steady_clock::now() + _interval;
+}
+
+uint32_t CTickScheduler::Wait(bool sleep)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now < _nextTick)
+    {
+        // 남은 일을 이어서 처리할 차례. 신호는 남겨두었다가 다음에 잠들 때 소비
+        if (!sleep)
+        {
+            return 0;
+        }
+
+        _signal.WaitUntil(_nextTick);
+        now = std::chrono::steady_clock::now();
+        if (now < _nextTick)
+        {
+            _eventWakeups.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+    }
+
+    // 예정 시각 대비 늦게 시작한 정도 (OS 타이머 해상도 + 이전 틱/이벤트 처리 지연)
+    int64_t jitterUs = std::chrono::duration_cast<std::chrono::microseconds>(now - _nextTick).count();
+    _jitterSumUs.fetch_add(jitterUs, std::memory_order_relaxed);
+    _jitterCount.fetch_add(1, std::memory_order_relaxed);
+    if (jitterUs > _maxJitterUs.load(std::memory_order_relaxed))
+    {
+        _maxJitterUs.store(jitterUs, std::memory_order_relaxed);
+    }
+
+    // 밀린 틱 수. 한도를 넘은 만큼은 건너뛰어서 일정을 현재 시각 근처로 당김
+    uint64_t dueTicks = static_cast<uint64_t>((now - _nextTick) / _interval) + 1;
+    if (dueTicks > _maxCatchUpTicks)
+    {
+        uint64_t skipped = dueTicks - _maxCatchUpTicks;
+        _skippedTicks.fetch_add(skipped, std::memory_order_relaxed);
+        _nextTick += _interval * static_cast<int64_t>(skipped);
+        dueTicks = _maxCatchUpTicks;
+    }
+
+    // 다음 틱은 예정 시각 기준 (지금 시각 기준이면 늦은 만큼 계속 밀림)
+    _nextTick += _interval * static_cast<int64_t>(dueTicks);
+    return static_cast<uint32_t>(dueTicks);
+}
+
+void CTickScheduler::RecordTick(std::chrono::steady_clock::duration elapsed)
+{
+    _ticks.fetch_add(1, std::memory_order_relaxed);
+    if (elapsed > _interval)
+    {
+        _overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    if (elapsedUs > _maxTickUs.load(std::memory_order_relaxed))
+    {
+        _maxTickUs.store(elapsedUs, std::memory_order_relaxed);
+    }
+}
+
+uint32_t CTickScheduler::ToTicks(std::chrono::steady_clock::duration duration) const
+{
+    int64_t ticks = (duration.count() + _interval.count() - 1) / _interval.count();
+    return static_cast<uint32_t>((std::min)((std::max)(ticks, static_cast<int64_t>(1)), static_cast<int64_t>(UINT32_MAX)));
+}
+
+TickStats CTickScheduler::TakeStats()
+{
+    TickStats stats;
+    stats.ticks = _ticks.load(std::memory_order_relaxed);
+    stats.overruns = _overruns.load(std::memory_order_relaxed);
+    stats.skippedTicks = _skippedTicks.load(std::memory_order_relaxed);
+    stats.eventWakeups = _eventWakeups.load(std::memory_order_relaxed);
+
+    int64_t jitterSumUs = _jitterSumUs.exchange(0, std::memory_order_relaxed);
+    uint64_t jitterCount = _jitterCount.exchange(0, std::memory_order_relaxed);
+    stats.avgJitterUs = (jitterCount > 0) ? jitterSumUs / static_cast<int64_t>(jitterCount) : 0;
+    stats.maxJitterUs = _maxJitterUs.exchange(0, std::memory_order_relaxed);
+    stats.maxTickUs = _maxTickUs.exchange(0, std::memory_order_relaxed);
+    return stats;
+}
+
+void CTickScheduler::LogStats(const char* name)
+{
+    TickStats stats = TakeStats();
+    int64_t intervalUs = std::chrono::duration_cast<std::chrono::microseconds>(_interval).count();
+
+    LOG_INFO("[{}] Ticks({}us): {} run, {} overrun, {} skipped, {} event wakeups / jitter avg {}us max {}us, longest tick {}us",
+        name, intervalUs, stats.ticks, stats.overruns, stats.skippedTicks, stats.eventWakeups,
+        stats.avgJitterUs, stats.maxJitterUs, stats.maxTickUs);
+
+    // 직전 로그 이후 새로 밀린 틱이 있을 때만 경고
+    if (stats.overruns != _loggedOverruns || stats.skippedTicks != _loggedSkippedTicks)
+    {
+        LOG_WARNING("[{}] Logic thread fell behind: +{} overrun ticks, +{} skipped ticks since last report",
+            name, stats.overruns - _loggedOverruns, stats.skippedTicks - _loggedSkippedTicks);
+        _loggedOverruns = stats.overruns;
+        _loggedSkippedTicks = stats.skippedTicks;
+    }
+}
+
+CPhaseBudget::CPhaseBudget(const char* name, std::chrono::steady_clock::duration budget)
+    : _name(name)
+    , _budget(budget)
+    , _start()
+    , _deadline()
+    , _lastElapsed(0)
+    , _runs(0)
+    , _items(0)
+    , _carryOvers(0)
+    , _overBudget(0)
+    , _sumUs(0)
+    , _maxUs(0)
+{
+}
+
+void CPhaseBudget::Begin()
+{
+    _start = std::chrono::steady_clock::now();
+    _deadline = _start + _budget;
+}
+
+void CPhaseBudget::End(uint64_t items, bool carriedOver)
+{
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    _lastElapsed = elapsed;
+
+    ++_runs;
+    _items += items;
+    _sumUs += elapsedUs;
+    _maxUs = (std::max)(_maxUs, elapsedUs);
+    if (carriedOver)
+    {
+        ++_carryOvers;
+    }
+    if (elapsed > _budget)
+    {
+        ++_overBudget;
+    }
+}
+
+std::chrono::steady_clock::duration CPhaseBudget::GetAmortizedInterval(std::chrono::steady_clock::duration tickInterval) const
+{
+    if (_budget.count() <= 0)
+    {
+        return tickInterval;
+    }
+    return tickInterval * _lastElapsed.count() / _budget.count();
+}
+
+PhaseStats CPhaseBudget::TakeStats()
+{
+    PhaseStats stats;
+    stats.runs = _runs;
+    stats.items = _items;
+    stats.carryOvers = _carryOvers;
+    stats.overBudget = _overBudget;
+    stats.avgUs = (_runs > 0) ? _sumUs / static_cast<int64_t>(_runs) : 0;
+    stats.maxUs = _maxUs;
+
+    _runs = 0;
+    _items = 0;
+    _carryOvers = 0;
+    _overBudget = 0;
+    _sumUs = 0;
+    _maxUs = 0;
+    return stats;
+}
+
+void CPhaseBudget::LogStats(const char* owner)
+{
+    PhaseStats stats = TakeStats();
+    int64_t budgetUs = std::chrono::duration_cast<std::chrono::microseconds>(_budget).count();
+
+    LOG_INFO("[{}] Phase {}({}us): {} runs, {} items, {} carried over, {} over budget / avg {}us max {}us",
+        owner, _name, budgetUs, stats.runs, stats.items, stats.carryOvers, stats.overBudget, stats.avgUs, stats.maxUs);
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// 로직 틱 기본 간격 (서버 생성 시 틱 간격을 0 이하로 주면 사용)
+constexpr auto TICK_DEFAULT_INTERVAL = std::chrono::milliseconds(20);
+
+// 한 번 깨어났을 때 몰아서 실행하는 최대 틱 수. 더 밀렸으면 나머지는 건너뛰고 일정을 현재 시각에 맞춤
+constexpr uint32_t TICK_MAX_CATCH_UP = 5;
+
+// __________________________________________________________________
+//
+// 깨우기 신호 (여러 생산자 -> 대기 스레드 하나)
+// 대기 스레드가 자고 있을 때만 mutex + notify. 바쁠 때의 Notify는 atomic 두 번으로 끝남
+// 신호는 쌓이지 않음: 깨어난 쪽이 큐를 전부 비운다는 가정
+// __________________________________________________________________
+
+class CWakeupSignal
+{
+public:
+    CWakeupSignal();
+
+    // 아무 스레드. 큐에 넣은 뒤 호출
+    void Notify();
+
+    // 대기 스레드 전용. 신호가 오면 true, deadline이 지나면 false (어느 쪽이든 신호는 소비)
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+private:
+    std::atomic<bool> _pending;
+    std::atomic<bool> _sleeping;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+};
+
+// 틱 지표. 누적 값과 직전 TakeStats 이후 구간 값
+struct TickStats
+{
+    uint64_t ticks;        // 실행한 틱 (누적)
+    uint64_t overruns;     // 실행 시간이 틱 간격을 넘은 틱 (누적)
+    uint64_t skippedTicks; // 따라잡기 한도를 넘어 건너뛴 틱 (누적)
+    uint64_t eventWakeups; // 틱 시각 전에 이벤트로 깨어난 횟수 (누적)
+    int64_t avgJitterUs;   // 구간: 틱이 예정 시각보다 늦게 시작한 평균
+    int64_t maxJitterUs;   // 구간: 가장 늦게 시작한 틱
+    int64_t maxTickUs;     // 구간: 가장 오래 걸린 틱
+};
+
+// __________________________________________________________________
+//
+// 고정 간격 틱 스케줄러
+// 로직 스레드는 이벤트가 없으면 다음 틱 시각까지 잠들고, 큐에 이벤트가 들어오면(Notify) 바로 깨어나서 처리
+// -> 바쁜 대기 없이, 패킷이 틱 간격만큼 기다리지도 않음
+//  - 다음 틱 시각은 시작 시각 + n * 간격 (sleep_for 반복처럼 늦은 만큼 밀리지 않음)
+//  - 틱이 밀리면 최대 TICK_MAX_CATCH_UP개까지 몰아서 실행, 그 이상은 건너뜀 (skippedTicks)
+// 사용법:
+//   scheduler.Start();
+//   while (running) { 큐 비우기; scheduler.WaitAndRunTicks([&] { 틱 처리; }); }
+// 지표(TakeStats)만 아무 스레드, 나머지는 소유 스레드 전용
+// __________________________________________________________________
+
+class CTickScheduler
+{
+public:
+    explicit CTickScheduler(std::chrono::steady_clock::duration interval, uint32_t maxCatchUpTicks = TICK_MAX_CATCH_UP);
+
+    CTickScheduler(const CTickScheduler&) = delete;
+    CTickScheduler& operator=(const CTickScheduler&) = delete;
+
+    // 첫 틱 시각을 지금 + 간격으로 잡음
+    void Start();
+
+    // 아무 스레드. 대기 중인 소유 스레드를 깨움 (이벤트 도착, 종료 요청)
+    void Notify() { _signal.Notify(); }
+
+    // 이벤트가 오거나 다음 틱 시각이 될 때까지 대기. 지금 실행할 틱 수 리턴 (0이면 이벤트로 깨어남)
+    // sleep = false: 틱 시각 전이면 잠들지 않고 바로 0 리턴 (예산을 넘겨 다음으로 미룬 일이 남아있을 때)
+    uint32_t Wait(bool sleep = true);
+
+    // 틱 하나의 실행 시간 기록 (간격을 넘으면 overrun)
+    void RecordTick(std::chrono::steady_clock::duration elapsed);
+
+    // Wait + 밀린 틱 실행. 실행한 틱 수 리턴
+    template <typename Func>
+    uint32_t WaitAndRunTicks(Func&& tick, bool sleep = true)
+    {
+        uint32_t dueTicks = Wait(sleep);
+        for (uint32_t i = 0; i < dueTicks; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            tick();
+            RecordTick(std::chrono::steady_clock::now() - start);
+        }
+        return dueTicks;
+    }
+
+    std::chrono::steady_clock::duration GetInterval() const { return _interval; }
+
+    // 시간을 틱 수로 (올림, 최소 1). 타이머 휠 지연 계산용
+    uint32_t ToTicks(std::chrono::steady_clock::duration duration) const;
+
+    // 누적 지표 + 구간 지표 (구간 값은 읽으면서 초기화)
+    TickStats TakeStats();
+
+    // TakeStats 결과를 한 줄 로그로 (name: 로그 앞머리, 예: "CentralizedServer"). 한 스레드에서만 호출
+    void LogStats(const char* name);
+
+private:
+    const std::chrono::steady_clock::duration _interval;
+    const uint32_t _maxCatchUpTicks;
+
+    CWakeupSignal _signal;
+    std::chrono::steady_clock::time_point _nextTick; // 소유 스레드 전용
+
+    // 소유 스레드가 쓰고 TakeStats가 읽음
+    std::atomic<uint64_t> _ticks;
+    std::atomic<uint64_t> _overruns;
+    std::atomic<uint64_t> _skippedTicks;
+    std::atomic<uint64_t> _eventWakeups;
+    std::atomic<int64_t> _jitterSumUs;
+    std::atomic<uint64_t> _jitterCount;
+    std::atomic<int64_t> _maxJitterUs;
+    std::atomic<int64_t> _maxTickUs;
+
+    // LogStats 전용 (직전 로그 시점의 누적 값)
+    uint64_t _loggedOverruns;
+    uint64_t _loggedSkippedTicks;
+};
+
+// 단계 지표. 직전 TakeStats 이후 구간 값
+struct PhaseStats
+{
+    uint64_t runs;       // 실행 횟수
+    uint64_t items;      // 처리한 항목 (이벤트, 타이머 등)
+    uint64_t carryOvers; // 예산을 다 써서 남은 일을 다음으로 미룬 횟수
+    uint64_t overBudget; // 실행 시간이 예산을 넘은 횟수 (항목 하나가 예산보다 길었음)
+    int64_t avgUs;       // 평균 실행 시간
+    int64_t maxUs;       // 가장 오래 걸린 실행
+};
+
+// __________________________________________________________________
+//
+// 로직 루프 한 단계의 시간 예산 (틱 간격의 일부)
+// 단계는 항목을 하나 처리할 때마다 IsOver를 보고, 예산을 다 쓰면 남은 항목을 다음 루프로 미룸
+// -> 한 단계(예: 로비 요청 폭주)가 틱 전체를 잡아먹어 다른 단계와 다음 틱이 밀리는 것을 막음
+// 항목 하나는 끝까지 처리하므로 예산보다 길어질 수 있음 (overBudget)
+// 나눌 수 없는 단계(예: 방 목록 스냅샷)는 GetAmortizedInterval만큼 띄워서 실행 -> 틱당 평균 비용이 예산 안
+// 사용법:
+//   budget.Begin();
+//   while (일이 남음 && !budget.IsOver()) { 항목 하나 처리; ++items; }
+//   budget.End(items, 일이 남음);
+// 소유 스레드 전용
+// __________________________________________________________________
+
+class CPhaseBudget
+{
+public:
+    CPhaseBudget(const char* name, std::chrono::steady_clock::duration budget);
+
+    void Begin();
+    bool IsOver() const { return std::chrono::steady_clock::now() >= _deadline; }
+    void End(uint64_t items, bool carriedOver);
+
+    std::chrono::steady_clock::duration GetBudget() const { return _budget; }
+
+    // 마지막 실행 시간을 틱마다 예산만큼씩 나눠 쓰려면 필요한 실행 간격 (예산 안에 끝났으면 tickInterval 이하)
+    std::chrono::steady_clock::duration GetAmortizedInterval(std::chrono::steady_clock::duration tickInterval) const;
+
+    // 구간 지표 (읽으면서 초기화)
+    PhaseStats TakeStats();
+
+    // TakeStats 결과를 한 줄 로그로 (owner: 로그 앞머리)
+    void LogStats(const char* owner);
+
+private:
+    const char* _name;
+    const std::chrono::steady_clock::duration _budget;
+    std::chrono::steady_clock::time_point _start;
+    std::chrono::steady_clock::time_point _deadline;
+    std::chrono::steady_clock::duration _lastElapsed;
+
+    uint64_t _runs;
+    uint64_t _items;
+    uint64_t _carryOvers;
+    uint64_t _overBudget;
+    int64_t _sumUs;
+    int64_t _maxUs;
+};
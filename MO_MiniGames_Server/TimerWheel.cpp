@@ -0,0 +1,209 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <iterator>
+
+CTimerWheel::CTimerWheel(size_t capacity)
+    : _nodes(std::make_unique<Node[]>(capacity))
+    , _capacity(static_cast<uint32_t>(capacity))
+    , _highWater(0)
+    , _freeHead(HANDLE_INDEX_NONE)
+    , _count(0)
+    , _peak(0)
+    , _allocFailures(0)
+    , _currentTick(0)
+    , _expiring(false)
+    , _expiringSlot(HANDLE_INDEX_NONE)
+{
+    std::fill(std::begin(_heads), std::end(_heads), HANDLE_INDEX_NONE);
+}
+
+TimerHandle CTimerWheel::Schedule(uint32_t delayTicks, const TimerEvent& event)
+{
+    uint32_t index;
+    if (_freeHead != HANDLE_INDEX_NONE)
+    {
+        index = _freeHead;
+        _freeHead = _nodes[index].next;
+    }
+    else if (_highWater < _capacity)
+    {
+        index = _highWater++;
+    }
+    else
+    {
+        ++_allocFailures;
+        return TimerHandle();
+    }
+
+    Node& node = _nodes[index];
+    node.event = event;
+    node.expireTick = _currentTick + (std::min)((std::max)(static_cast<uint64_t>(delayTicks), static_cast<uint64_t>(1)), MAX_DELAY);
+    Insert(index);
+
+    if (++_count > _peak)
+    {
+        _peak = _count;
+    }
+
+    TimerHandle handle;
+    handle.index = index;
+    handle.generation = node.generation;
+    return handle;
+}
+
+bool CTimerWheel::Cancel(TimerHandle handle)
+{
+    if (!IsActive(handle))
+    {
+        return false;
+    }
+
+    Unlink(handle.index);
+    Release(handle.index);
+    return true;
+}
+
+bool CTimerWheel::IsActive(TimerHandle handle) const
+{
+    if (handle.index >= _highWater)
+    {
+        return false;
+    }
+
+    const Node& node = _nodes[handle.index];
+    return node.generation == handle.generation && node.slot != HANDLE_INDEX_NONE;
+}
+
+PoolStats CTimerWheel::GetStats() const
+{
+    PoolStats stats;
+    stats.capacity = _capacity;
+    stats.inUse = _count;
+    stats.peak = _peak;
+    stats.allocFailures = _allocFailures;
+    return stats;
+}
+
+uint32_t CTimerWheel::BeginTick()
+{
+    ++_currentTick;
+    _expiring = true;
+
+    // 레벨 0이 한 바퀴 돌았으면 레벨 1의 현재 칸을 내림, 그 칸도 0번이면 레벨 2 ... (자리올림처럼)
+    uint32_t slot = static_cast<uint32_t>(_currentTick & (ROOT_SLOTS - 1));
+    if (slot == 0)
+    {
+        for (uint32_t level = 1; level < LEVEL_COUNT; ++level)
+        {
+            if (Cascade(level) != 0)
+            {
+                break;
+            }
+        }
+    }
+    return slot;
+}
+
+bool CTimerWheel::PopSlot(uint32_t slot, TimerEvent& outEvent)
+{
+    uint32_t index = _heads[slot];
+    if (index == HANDLE_INDEX_NONE)
+    {
+        return false;
+    }
+
+    outEvent = _nodes[index].event;
+    Unlink(index);
+    Release(index);
+    return true;
+}
+
+void CTimerWheel::Insert(uint32_t index)
+{
+    Node& node = _nodes[index];
+
+    // 칸 계산 기준 = 다음에 만료 처리할 틱 (만료 처리 중이면 지금 비우고 있는 틱)
+    uint64_t baseTick = _expiring ? _currentTick : _currentTick + 1;
+    uint64_t expireTick = (std::max)(node.expireTick, baseTick);
+    uint64_t delta = expireTick - baseTick;
+
+    uint32_t slot;
+    if (delta < ROOT_SLOTS)
+    {
+        slot = static_cast<uint32_t>(expireTick & (ROOT_SLOTS - 1));
+    }
+    else
+    {
+        uint32_t level = 1;
+        while (level < LEVEL_COUNT - 1 && delta >= (1ull << (ROOT_BITS + level * LEVEL_BITS)))
+        {
+            ++level;
+        }
+
+        uint32_t shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+        slot = ROOT_SLOTS + (level - 1) * LEVEL_SLOTS + static_cast<uint32_t>((expireTick >> shift) & (LEVEL_SLOTS - 1));
+    }
+
+    node.slot = slot;
+    node.prev = HANDLE_INDEX_NONE;
+    node.next = _heads[slot];
+    if (node.next != HANDLE_INDEX_NONE)
+    {
+        _nodes[node.next].prev = index;
+    }
+    _heads[slot] = index;
+}
+
+void CTimerWheel::Unlink(uint32_t index)
+{
+    Node& node = _nodes[index];
+    if (node.prev != HANDLE_INDEX_NONE)
+    {
+        _nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        _heads[node.slot] = node.next;
+    }
+
+    if (node.next != HANDLE_INDEX_NONE)
+    {
+        _nodes[node.next].prev = node.prev;
+    }
+
+    node.slot = HANDLE_INDEX_NONE;
+}
+
+void CTimerWheel::Release(uint32_t index)
+{
+    Node& node = _nodes[index];
+
+    // 0은 무효 핸들용으로 남겨둠
+    if (++node.generation == 0)
+    {
+        node.generation = 1;
+    }
+
+    node.prev = HANDLE_INDEX_NONE;
+    node.next = _freeHead;
+    _freeHead = index;
+    --_count;
+}
+
+uint32_t CTimerWheel::Cascade(uint32_t level)
+{
+    uint32_t shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+    uint32_t levelSlot = static_cast<uint32_t>((_currentTick >> shift) & (LEVEL_SLOTS - 1));
+    uint32_t slot = ROOT_SLOTS + (level - 1) * LEVEL_SLOTS + levelSlot;
+
+    // 리스트를 떼어낸 뒤 하나씩 다시 넣음 (남은 시간이 줄었으므로 아래 레벨로 감)
+    uint32_t index = _heads[slot];
+    _heads[slot] = HANDLE_INDEX_NONE;
+    while (index != HANDLE_INDEX_NONE)
+    {
+        uint32_t next = _nodes[index].next;
+        Insert(index);
+        index = next;
+    }
+    return levelSlot;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+#include "HandleTable.h"
+
+// __________________________________________________________________
+//
+// 계층형 타이머 휠 (로직 스레드 전용)
+// 시간 단위는 로직 틱. 소유 스레드가 틱마다 Advance를 호출하면 그 틱에 만료된 타이머를 한 번에 콜백
+//  - 레벨 0: 256칸 x 1틱, 레벨 1~3: 64칸 x (256, 16384, 1048576틱) -> 최대 2^26틱 (20ms 틱이면 약 15일), 넘으면 최대값으로 잘림
+//  - 상위 레벨 칸은 레벨 0이 한 바퀴 돌 때 한 칸씩 아래 레벨로 내려감(cascade)
+//  - 칸마다 이중 연결 리스트 (노드 index) -> Schedule / Cancel 모두 O(1), 우선순위 큐처럼 한 곳에 몰리는 정렬 비용 없음
+//  - 노드는 생성 시 고정 용량으로 한 번만 할당. 가득 차면 Schedule이 null 핸들 (allocFailures 증가)
+// 콜백은 std::function 대신 TimerEvent(종류 + 대상 핸들)로 넘김 -> 타이머당 할당 없음
+// 대상 객체가 이미 사라졌을 수 있으므로 콜백 쪽에서 핸들로 다시 조회해서 검증 (세대 핸들이라 재사용된 슬롯은 걸러짐)
+// __________________________________________________________________
+
+// 타이머 종류 (만료 시 소유자가 종류별로 분기)
+enum class TimerType : uint8_t
+{
+    PLAYER_AFK_CHECK, // 방 안에서 일정 시간 요청이 없는 플레이어 내보내기
+};
+
+// 만료 시 콜백에 넘어가는 값. 종류에 따라 필요한 핸들만 채움
+struct TimerEvent
+{
+    TimerType type;
+    PlayerHandle player;
+    RoomHandle room;
+    uint32_t param = 0;
+};
+
+class CTimerWheel;
+using TimerHandle = THandle<CTimerWheel>;
+
+class CTimerWheel
+{
+public:
+    explicit CTimerWheel(size_t capacity);
+
+    CTimerWheel(const CTimerWheel&) = delete;
+    CTimerWheel& operator=(const CTimerWheel&) = delete;
+
+    // delayTicks 틱 뒤에 만료 (최소 1 = 다음 Advance 틱). 가득 차면 null 핸들
+    TimerHandle Schedule(uint32_t delayTicks, const TimerEvent& event);
+
+    // 이미 만료됐거나 취소된 핸들이면 false
+    bool Cancel(TimerHandle handle);
+    bool IsActive(TimerHandle handle) const;
+
+    // ticks만큼 시간을 진행하면서 만료된 타이머마다 onExpire(const TimerEvent&) 호출. 만료된 개수 리턴
+    // 콜백 안에서 Schedule / Cancel 가능 (새 타이머는 최소 다음 틱이므로 이번 칸에 들어오지 않음)
+    template <typename Func>
+    size_t Advance(uint32_t ticks, Func&& onExpire)
+    {
+        size_t expired = 0;
+        AdvanceBudgeted(ticks, onExpire, [] { return false; }, expired);
+        return expired;
+    }
+
+    // Advance와 같지만 콜백마다 shouldStop()을 확인해서 true면 그 자리에서 멈춤 (로직 루프 시간 예산)
+    // 끝까지 처리한 틱 수를 리턴. 멈춘 틱은 다음 호출(Advance 포함)이 남은 타이머부터 이어서 처리하므로
+    // 호출한 쪽은 ticks - 리턴값을 다음에 다시 넘기면 됨. 멈춰 있는 동안에도 Schedule / Cancel 가능
+    template <typename Func, typename Stop>
+    uint32_t AdvanceBudgeted(uint32_t ticks, Func&& onExpire, Stop&& shouldStop, size_t& expired)
+    {
+        for (uint32_t done = 0; done < ticks; ++done)
+        {
+            if (_expiringSlot == HANDLE_INDEX_NONE)
+            {
+                // 타이머가 하나도 없으면 칸을 돌 필요 없이 시각만 진행
+                if (_count == 0)
+                {
+                    _currentTick += ticks - done;
+                    return ticks;
+                }
+                _expiringSlot = BeginTick();
+            }
+
+            TimerEvent event;
+            while (PopSlot(_expiringSlot, event))
+            {
+                ++expired;
+                onExpire(event);
+                if (shouldStop())
+                {
+                    return done; // 칸에 남은 타이머는 다음 호출에서 (비었으면 틱만 마무리)
+                }
+            }
+            _expiring = false;
+            _expiringSlot = HANDLE_INDEX_NONE;
+        }
+        return ticks;
+    }
+
+    // 현재 틱 (Advance로 진행한 틱 수, 만료 콜백 안에서는 처리 중인 틱)
+    uint64_t GetCurrentTick() const { return _currentTick; }
+
+    size_t GetCount() const { return _count; }
+    PoolStats GetStats() const;
+
+private:
+    static constexpr uint32_t ROOT_BITS = 8;
+    static constexpr uint32_t LEVEL_BITS = 6;
+    static constexpr uint32_t LEVEL_COUNT = 4; // 레벨 0 포함
+    static constexpr uint32_t ROOT_SLOTS = 1u << ROOT_BITS;
+    static constexpr uint32_t LEVEL_SLOTS = 1u << LEVEL_BITS;
+    static constexpr uint32_t TOTAL_SLOTS = ROOT_SLOTS + (LEVEL_COUNT - 1) * LEVEL_SLOTS;
+    static constexpr uint64_t MAX_DELAY = (1ull << (ROOT_BITS + (LEVEL_COUNT - 1) * LEVEL_BITS)) - 1;
+
+    struct Node
+    {
+        TimerEvent event;
+        uint64_t expireTick = 0;
+        uint32_t prev = HANDLE_INDEX_NONE;
+        uint32_t next = HANDLE_INDEX_NONE; // 빈 노드일 때는 빈 노드 리스트 연결
+        uint32_t slot = HANDLE_INDEX_NONE; // 들어있는 칸 (빈 노드면 NONE)
+        uint32_t generation = 1;
+    };
+
+    // 현재 틱을 하나 올리고, 이번 틱에 내려올 상위 레벨 칸을 내린 뒤 만료시킬 레벨 0 칸 번호 리턴
+    uint32_t BeginTick();
+
+    // 칸의 맨 앞 노드를 꺼내서 해제. 비었으면 false
+    bool PopSlot(uint32_t slot, TimerEvent& outEvent);
+
+    void Insert(uint32_t index); // expireTick 기준으로 칸 결정
+    void Unlink(uint32_t index);
+    void Release(uint32_t index);
+    uint32_t Cascade(uint32_t level); // 레벨의 현재 칸을 비우고 다시 넣음. 칸 번호 리턴
+
+private:
+    std::unique_ptr<Node[]> _nodes;
+    uint32_t _capacity;
+    uint32_t _highWater; // 한 번이라도 사용된 노드 수
+    uint32_t _freeHead;
+    size_t _count;
+    size_t _peak;
+    uint64_t _allocFailures;
+
+    uint64_t _currentTick;
+    bool _expiring; // 만료 처리 중 (현재 틱 칸을 비우는 중이므로 칸 계산 기준이 다음 틱이 아니라 현재 틱)
+    uint32_t _expiringSlot; // 만료 처리 중인 레벨 0 칸 (예산으로 멈춘 동안에도 유지, 없으면 NONE)
+    uint32_t _heads[TOTAL_SLOTS]; // 칸마다 리스트 맨 앞 노드 (레벨 0 다음에 레벨 1, 2, 3 순서)
+};
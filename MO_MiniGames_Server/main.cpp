@@ -6,8 +6,15 @@
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 #include "CentralizedServer.h"
+#include "PartitionedServer.h"
+#include "StrandServer.h"
+#include "AsyncLogger.h"
 
 std::atomic<bool> running{true};
 std::mutex mtx;
@@ -21,30 +28,163 @@ void SignalProcessShutdown()
     cv.notify_one();
 }
 
-int main()
+// 실행 옵션
+// MO_MiniGames_Server [centralized|partitioned|strand|echo] [--port N] [--max-clients N]
+//                     [--shards N] [--workers N] [--spectator-delay N] [--replay-dir PATH]
+struct ServerOptions
 {
-    constexpr int PORT = 6000;
-    constexpr int MAX_CLIENTS = 1000;
+    ServerArchitectureType type = ServerArchitectureType::Centralized;
+    int port = 6000;
+    int maxClients = 1000;
+    int shardCount = 4;                // partitioned
+    int workerThreadCount = 0;         // strand (0: 하드웨어 스레드 수)
+    uint32_t spectatorDelayFrames = 0; // strand
+    std::string replayDirectory;       // strand (비어있으면 기록 안 함)
+};
 
-    std::cout << "=== IOCP Mini Game Server ===" << std::endl;
-    std::cout << "Port: " << PORT << std::endl; 
-    std::cout << "Max Clients: " << MAX_CLIENTS << std::endl;
+static const char* GetModeName(ServerArchitectureType type)
+{
+    switch (type)
+    {
+    case ServerArchitectureType::EchoTest:      return "echo";
+    case ServerArchitectureType::Centralized:   return "centralized";
+    case ServerArchitectureType::Partitioned:   return "partitioned";
+    case ServerArchitectureType::UnifiedStrand: return "strand";
+    }
+    return "unknown";
+}
+
+static bool ParseMode(const char* name, ServerArchitectureType& outType)
+{
+    for (ServerArchitectureType type : { ServerArchitectureType::EchoTest, ServerArchitectureType::Centralized,
+        ServerArchitectureType::Partitioned, ServerArchitectureType::UnifiedStrand })
+    {
+        if (std::strcmp(name, GetModeName(type)) == 0)
+        {
+            outType = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ParseOptions(int argc, char* argv[], ServerOptions& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (arg[0] != '-')
+        {
+            if (!ParseMode(arg, outOptions.type))
+            {
+                std::cerr << "Unknown server mode: " << arg << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--port") == 0)
+            outOptions.port = std::atoi(value);
+        else if (std::strcmp(arg, "--max-clients") == 0)
+            outOptions.maxClients = std::atoi(value);
+        else if (std::strcmp(arg, "--shards") == 0)
+            outOptions.shardCount = std::atoi(value);
+        else if (std::strcmp(arg, "--workers") == 0)
+            outOptions.workerThreadCount = std::atoi(value);
+        else if (std::strcmp(arg, "--spectator-delay") == 0)
+            outOptions.spectatorDelayFrames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (std::strcmp(arg, "--replay-dir") == 0)
+            outOptions.replayDirectory = value;
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (outOptions.port <= 0 || outOptions.maxClients <= 0)
+    {
+        std::cerr << "Port and max clients must be positive" << std::endl;
+        return false;
+    }
 
-    // 중앙 집중형 게임 서버만 생성 (내부에서 네트워크 레이어 자동 생성)
-    auto gameServer = std::make_unique<CIOCPServer>(PORT, MAX_CLIENTS, ServerArchitectureType::EchoTest);
+    outOptions.shardCount = (std::max)(1, (std::min)(outOptions.shardCount, static_cast<int>(ROOM_SHARD_MAX_COUNT)));
+    outOptions.spectatorDelayFrames = (std::min)(outOptions.spectatorDelayFrames, SPECTATOR_MAX_DELAY_FRAMES);
+    return true;
+}
 
-    // 서버 시작
-    gameServer->Start();
+// 서버를 시작하고 종료 신호가 올 때까지 대기. 서버는 소멸자에서 로직 스레드와 네트워크 레이어를 정리
+template <typename ServerT>
+static bool RunUntilShutdown(std::unique_ptr<ServerT> server)
+{
+    if (!server->Start())
+    {
+        return false;
+    }
 
     // main 스레드는 condition_variable로 대기
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&] { return !running; });
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    ServerOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [centralized|partitioned|strand|echo] [--port N] [--max-clients N]"
+            << " [--shards N] [--workers N] [--spectator-delay N] [--replay-dir PATH]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== IOCP Mini Game Server ===" << std::endl;
+    std::cout << "Mode: " << GetModeName(options.type) << std::endl;
+    std::cout << "Port: " << options.port << std::endl;
+    std::cout << "Max Clients: " << options.maxClients << std::endl;
+
+    // 게임/네트워크 레이어 로그는 로거 스레드가 출력 (서버보다 먼저 시작, 나중에 종료)
+    CAsyncLogger::Get().Start();
+
+    // 고른 게임 서버 생성 (내부에서 네트워크 레이어 자동 생성)
+    bool started = false;
+    switch (options.type)
+    {
+    case ServerArchitectureType::EchoTest:
+        started = RunUntilShutdown(std::make_unique<CIOCPServer>(options.port, options.maxClients, ServerArchitectureType::EchoTest));
+        break;
+
+    case ServerArchitectureType::Centralized:
+        started = RunUntilShutdown(std::make_unique<CCentralizedServer>(options.port, options.maxClients));
+        break;
+
+    case ServerArchitectureType::Partitioned:
+        std::cout << "Shards: " << options.shardCount << std::endl;
+        started = RunUntilShutdown(std::make_unique<CPartitionedServer>(options.port, options.maxClients, options.shardCount));
+        break;
+
+    case ServerArchitectureType::UnifiedStrand:
+        std::cout << "Workers: " << options.workerThreadCount << ", spectator delay: " << options.spectatorDelayFrames << " frames" << std::endl;
+        started = RunUntilShutdown(std::make_unique<CStrandServer>(options.port, options.maxClients, options.workerThreadCount,
+            options.spectatorDelayFrames, options.replayDirectory));
+        break;
+    }
+
+    if (!started)
     {
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [&] { return !running; });
+        std::cerr << "Server start failed" << std::endl;
     }
 
-    // 서버 종료
-    gameServer->Disconnect();
+    // 남은 로그를 모두 출력한 뒤 종료 메시지
+    CAsyncLogger::Get().Stop();
 
     std::cout << "Server shutdown complete" << std::endl;
-    return 0;
+    return started ? 0 : 1;
 }